@@ -3,20 +3,26 @@
 * @brief Reaching definitions analysis (RDA) builds UD and DU chains.
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 *
-* Right now, this works on an entire module. But we could insert an another layer
-* that represents functions. Then it would be possible to associate BBs with
-* functions that own them and recompute RDA only for the selected function.
+* The analysis is computed and cached per function. When it is run on the same
+* module again, only functions that were invalidated, or whose loads, stores,
+* allocas, calls, or CFG changed since the last run, are recomputed.
+* The passes share one analysis per module through ReachingDefinitionsProvider,
+* so a pass that modifies only a few functions does not cause a recomputation
+* of the entire module in the following passes.
 */
 
 #ifndef RETDEC_BIN2LLVMIR_ANALYSES_REACHING_DEFINITIONS_H
 #define RETDEC_BIN2LLVMIR_ANALYSES_REACHING_DEFINITIONS_H
 
+#include <cstdint>
 #include <map>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <llvm/ADT/BitVector.h>
 #include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/Module.h>
 
@@ -41,6 +47,9 @@ using UseSet = std::unordered_set<Use*>;
 using DefVector = std::vector<Definition>;
 using UseVector = std::vector<Use>;
 
+/// Definitions of each source, as bits of function-local definition numbers.
+using SourceDefsMap = std::unordered_map<llvm::Value*, llvm::BitVector>;
+
 class Definition
 {
 	public:
@@ -83,8 +92,11 @@ class BasicBlockEntry
 				std::ostream& out,
 				const BasicBlockEntry& bbe);
 
-		void initializeKillDefSets();
-		Changed initDefsOut();
+		void initializeKillGenSets(
+				const SourceDefsMap& srcDefs,
+				unsigned firstDef,
+				unsigned defCount);
+		Changed initDefsOut(llvm::BitVector& tmp);
 
 		const DefSet& defsFromUse(const llvm::Instruction* I) const;
 		const UseSet& usesFromDef(const llvm::Instruction* I) const;
@@ -99,16 +111,18 @@ class BasicBlockEntry
 
 		BBEntrySet prevBBs;
 
-		// defsIn is union of prevBBs' defsOuts
-		DefSet defsOut;
-		DefSet genDefs;
-		std::unordered_set<llvm::Value*> killDefs;
+		// defsIn is union of prevBBs' defsOuts.
+		// Bits are numbers of definitions in the function, they are used
+		// only while the analysis is computed.
+		llvm::BitVector defsOut;
+		llvm::BitVector genDefs;
+		llvm::BitVector killDefs;
 
 		bool changed = false;
 
 	private:
 		unsigned id;
-	    static int newUID;
+	    static thread_local int newUID;
 };
 
 class ReachingDefinitionsAnalysis
@@ -122,6 +136,7 @@ class ReachingDefinitionsAnalysis
 				llvm::Function& F,
 				Abi* abi = nullptr,
 				bool trackFlagRegs = false);
+		void invalidate(const llvm::Function* F);
 		void clear();
 		bool wasRun() const;
 
@@ -146,24 +161,58 @@ class ReachingDefinitionsAnalysis
 				llvm::Instruction* I);
 
 	private:
-		void run();
+		using BasicBlockEntryMap = std::map<const llvm::BasicBlock*, BasicBlockEntry>;
+		using Signature = std::vector<std::uintptr_t>;
+
+	private:
+		void initialize(llvm::Module* M, Abi* abi, bool trackFlagRegs);
+		void update(llvm::Function& F);
+		void run(const llvm::Function* F, BasicBlockEntryMap& bbs);
 		const BasicBlockEntry& getBasicBlockEntry(const llvm::Instruction* I) const;
-		void initializeBasicBlocks(llvm::Module& M);
 		void initializeBasicBlocks(llvm::Function& F);
-		void initializeBasicBlocksPrev();
-		void initializeKillGenSets();
-		void propagate();
-		void initializeDefsAndUses();
-		void clearInternal();
+		void initializeBasicBlocksPrev(BasicBlockEntryMap& bbs);
+		void initializeKillGenSets(
+				BasicBlockEntryMap& bbs,
+				std::vector<Definition*>& defs,
+				SourceDefsMap& srcDefs);
+		void propagate(const llvm::Function* F, BasicBlockEntryMap& bbs);
+		void initializeDefsAndUses(
+				BasicBlockEntryMap& bbs,
+				const std::vector<Definition*>& defs,
+				const SourceDefsMap& srcDefs);
+		void clearInternal(BasicBlockEntryMap& bbs);
+		Signature getSignature(llvm::Function& F) const;
 
 	private:
-		std::map<const llvm::Function*, std::map<const llvm::BasicBlock*, BasicBlockEntry>> bbMap;
+		std::map<const llvm::Function*, BasicBlockEntryMap> bbMap;
+		/// Signatures of functions at the time their RDA was computed.
+		std::map<const llvm::Function*, Signature> _signatures;
 		bool _trackFlagRegs = false;
+		const llvm::Module* _module = nullptr;
 		const llvm::GlobalVariable* _specialGlobal = nullptr;
 		bool _run = false;
 		Abi* _abi = nullptr;
 };
 
+/**
+ * Reaching definitions analyses shared by the passes working on a module.
+ *
+ * A pass gets the analysis and runs it on the module -- results computed
+ * by the previous passes are reused for all unchanged functions.
+ */
+class ReachingDefinitionsProvider
+{
+	public:
+		static ReachingDefinitionsAnalysis* getReachingDefinitions(
+				llvm::Module* m);
+		static void clear(llvm::Module* m);
+		static void clear();
+
+	private:
+		static std::map<llvm::Module*, ReachingDefinitionsAnalysis> _module2rda;
+		static std::mutex _mutex;
+};
+
 } // namespace bin2llvmir
 } // namespace retdec
 
@@ -31,7 +31,7 @@ namespace bin2llvmir {
  * analysis.
  *
  * For optimization reasons, some data members of this structure are static,
- * i.e. common for all instances.
+ * i.e. common for all instances in the same thread.
  * The typical usage of this class is: creation -> simplification -> pattern
  * detection -> action based on pattern -> throwing away the current instance
  * before creating and processing the new one.
@@ -107,6 +107,7 @@ class SymbolicTree
 		static void setAbi(Abi* abi);
 		static void setConfig(Config* config);
 		static void setToDefaultConfiguration();
+		static void clear();
 		static void setTrackThroughAllocaLoads(bool b);
 		static void setTrackThroughGeneralRegisterLoads(bool b);
 		static void setTrackOnlyFlagRegisters(bool b);
@@ -114,14 +115,14 @@ class SymbolicTree
 		static void setNaryLimit(unsigned n);
 
 	private:
-		static Abi* _abi;
-		static Config* _config;
-		static bool _val2valUsed;
-		static bool _trackThroughAllocaLoads;
-		static bool _trackThroughGeneralRegisterLoads;
-		static bool _trackOnlyFlagRegisters;
-		static bool _simplifyAtCreation;
-		static unsigned _naryLimit;
+		static thread_local Abi* _abi;
+		static thread_local Config* _config;
+		static thread_local bool _val2valUsed;
+		static thread_local bool _trackThroughAllocaLoads;
+		static thread_local bool _trackThroughGeneralRegisterLoads;
+		static thread_local bool _trackOnlyFlagRegisters;
+		static thread_local bool _simplifyAtCreation;
+		static thread_local unsigned _naryLimit;
 
 	// Private methods.
 	//
@@ -0,0 +1,208 @@
+/**
+* @file include/retdec/bin2llvmir/optimizations/decoder/address_map.h
+* @brief Flat ordered map from addresses to values.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_ADDRESS_MAP_H
+#define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_ADDRESS_MAP_H
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "retdec/utils/address.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Ordered map from addresses to values kept in sorted vectors.
+ *
+ * Decoder asks for the values at, before, and after addresses for every
+ * translated instruction, so lookups must be fast. A node-based map spreads
+ * its entries all over the memory, while binary search in a sorted vector
+ * touches only a few cache lines.
+ *
+ * Inserting into a large sorted vector is slow, so new entries are inserted
+ * into a small sorted batch first. The batch is merged into the main vector
+ * once it grows to about square root of the main vector's size. Lookups
+ * search both vectors.
+ *
+ * Returned pointers are valid only until the next insertion.
+ */
+template <typename T>
+class AddressMap
+{
+	public:
+		using value_type = std::pair<utils::Address, T>;
+
+	public:
+		/**
+		 * Insert value @p v on address @p a, or replace the existing one.
+		 */
+		void insert(utils::Address a, const T& v)
+		{
+			auto it = lowerBound(_data, a);
+			if (it != _data.end() && it->first == a)
+			{
+				it->second = v;
+				return;
+			}
+
+			auto bIt = lowerBound(_batch, a);
+			if (bIt != _batch.end() && bIt->first == a)
+			{
+				bIt->second = v;
+				return;
+			}
+			_batch.emplace(bIt, a, v);
+
+			if (_batch.size() >= batchLimit())
+			{
+				merge();
+			}
+		}
+
+		/**
+		 * \return Entry exactly on address \p a, or @c nullptr.
+		 */
+		const value_type* at(utils::Address a) const
+		{
+			auto it = lowerBound(_data, a);
+			if (it != _data.end() && it->first == a)
+			{
+				return &(*it);
+			}
+			auto bIt = lowerBound(_batch, a);
+			if (bIt != _batch.end() && bIt->first == a)
+			{
+				return &(*bIt);
+			}
+			return nullptr;
+		}
+
+		/**
+		 * \return The first entry after address \p a, or @c nullptr.
+		 */
+		const value_type* after(utils::Address a) const
+		{
+			auto it = upperBound(_data, a);
+			auto bIt = upperBound(_batch, a);
+			const value_type* d = it != _data.end() ? &(*it) : nullptr;
+			const value_type* b = bIt != _batch.end() ? &(*bIt) : nullptr;
+			if (d == nullptr || b == nullptr)
+			{
+				return d ? d : b;
+			}
+			return d->first < b->first ? d : b;
+		}
+
+		/**
+		 * \return The last entry before or at address \p a, or @c nullptr.
+		 */
+		const value_type* beforeOrAt(utils::Address a) const
+		{
+			auto it = upperBound(_data, a);
+			auto bIt = upperBound(_batch, a);
+			const value_type* d = it != _data.begin() ? &(*std::prev(it)) : nullptr;
+			const value_type* b = bIt != _batch.begin() ? &(*std::prev(bIt)) : nullptr;
+			if (d == nullptr || b == nullptr)
+			{
+				return d ? d : b;
+			}
+			return d->first < b->first ? b : d;
+		}
+
+		bool empty() const
+		{
+			return _data.empty() && _batch.empty();
+		}
+
+		std::size_t size() const
+		{
+			return _data.size() + _batch.size();
+		}
+
+		void clear()
+		{
+			_data.clear();
+			_batch.clear();
+		}
+
+	private:
+		using Container = std::vector<value_type>;
+
+		static bool keyLess(const value_type& v, const utils::Address& a)
+		{
+			return v.first < a;
+		}
+
+		static bool lessKey(const utils::Address& a, const value_type& v)
+		{
+			return a < v.first;
+		}
+
+		static typename Container::iterator lowerBound(
+				Container& c,
+				utils::Address a)
+		{
+			return std::lower_bound(c.begin(), c.end(), a, keyLess);
+		}
+
+		static typename Container::const_iterator lowerBound(
+				const Container& c,
+				utils::Address a)
+		{
+			return std::lower_bound(c.begin(), c.end(), a, keyLess);
+		}
+
+		static typename Container::const_iterator upperBound(
+				const Container& c,
+				utils::Address a)
+		{
+			return std::upper_bound(c.begin(), c.end(), a, lessKey);
+		}
+
+		std::size_t batchLimit() const
+		{
+			const std::size_t minLimit = 32;
+			auto limit = static_cast<std::size_t>(
+					std::sqrt(static_cast<double>(_data.size())));
+			return std::max(limit, minLimit);
+		}
+
+		/**
+		 * Merge the batch into the main vector. Keys in them are disjoint.
+		 */
+		void merge()
+		{
+			auto mid = _data.size();
+			_data.insert(
+					_data.end(),
+					std::make_move_iterator(_batch.begin()),
+					std::make_move_iterator(_batch.end()));
+			std::inplace_merge(
+					_data.begin(),
+					_data.begin() + mid,
+					_data.end(),
+					[](const value_type& x, const value_type& y)
+					{
+						return x.first < y.first;
+					});
+			_batch.clear();
+		}
+
+	private:
+		/// Sorted entries.
+		Container _data;
+		/// Sorted entries inserted since the last merge.
+		Container _batch;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
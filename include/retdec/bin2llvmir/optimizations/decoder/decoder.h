@@ -11,6 +11,7 @@
 #include <queue>
 #include <sstream>
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/CFG.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/InstIterator.h>
@@ -27,9 +28,11 @@
 #include "retdec/bin2llvmir/providers/debugformat.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/bin2llvmir/providers/names.h"
+#include "retdec/bin2llvmir/optimizations/decoder/address_map.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder_debug.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder_ranges.h"
 #include "retdec/bin2llvmir/optimizations/decoder/jump_targets.h"
+#include "retdec/bin2llvmir/optimizations/decoder/linear_sweep.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 #include "retdec/bin2llvmir/utils/symbolic_tree_match.h"
 #include "retdec/capstone2llvmir/capstone2llvmir.h"
@@ -64,7 +67,7 @@ class Decoder : public llvm::ModulePass
 	//
 	private:
 		void initTranslator();
-		void initDryRunCsInstruction();
+		void initCsInstructions();
 		void initEnvironment();
 		void initEnvironmentAsm2LlvmMapping();
 		void initEnvironmentPseudoFunctions();
@@ -82,6 +85,7 @@ class Decoder : public llvm::ModulePass
 		void initConfigFunctions();
 		void initStaticCode();
 		void initVtables();
+		void initLinearSweep();
 
 	private:
 		void decode();
@@ -91,12 +95,23 @@ class Decoder : public llvm::ModulePass
 				const JumpTarget& jt,
 				ByteData bytes,
 				bool strict = false);
+		bool dryRunDisasm(
+				cs_mode mode,
+				ByteData& bytes,
+				uint64_t& addr,
+				LinearSweepTable::Insn& insn);
+		LinearSweepTable::Insn disasmDryRunInsn(
+				cs_mode mode,
+				ByteData bytes,
+				uint64_t addr);
 		cs_mode determineMode(cs_insn* insn, utils::Address& target);
 		capstone2llvmir::Capstone2LlvmIrTranslator::TranslationResultOne
 				translate(
 						ByteData& bytes,
 						utils::Address& addr,
-						llvm::IRBuilder<>& irb);
+						llvm::IRBuilder<>& irb,
+						cs_insn* insn);
+		void storeCapstoneInsn(cs_insn* insn);
 
 		bool getJumpTargetsFromInstruction(
 				utils::Address addr,
@@ -144,8 +159,8 @@ class Decoder : public llvm::ModulePass
 				llvm::BasicBlock* insertAfter = nullptr);
 		void addBasicBlock(utils::Address a, llvm::BasicBlock* b);
 
-		std::map<utils::Address, llvm::BasicBlock*> _addr2bb;
-		std::map<llvm::BasicBlock*, utils::Address> _bb2addr;
+		AddressMap<llvm::BasicBlock*> _addr2bb;
+		llvm::DenseMap<llvm::BasicBlock*, utils::Address> _bb2addr;
 
 	// Function related methods.
 	//
@@ -163,8 +178,8 @@ class Decoder : public llvm::ModulePass
 		void addFunction(utils::Address a, llvm::Function* f);
 		void addFunctionSize(llvm::Function* f, utils::Maybe<std::size_t> sz);
 
-		std::map<utils::Address, llvm::Function*> _addr2fnc;
-		std::map<llvm::Function*, utils::Address> _fnc2addr;
+		AddressMap<llvm::Function*> _addr2fnc;
+		llvm::DenseMap<llvm::Function*, utils::Address> _fnc2addr;
 		// Function sizes from debug info/symbol table/config/etc.
 		// Used to prevent function splitting.
 		//
@@ -174,7 +189,7 @@ class Decoder : public llvm::ModulePass
 		// __floatdidf   @ 0x16470 : size = 108
 		// It looks like there is one function in another.
 		//
-		std::map<llvm::Function*, std::size_t> _fnc2sz;
+		llvm::DenseMap<llvm::Function*, std::size_t> _fnc2sz;
 
 	// Pattern recognition methods.
 	//
@@ -190,6 +205,7 @@ class Decoder : public llvm::ModulePass
 				const JumpTarget& jt,
 				ByteData bytes,
 				bool strict = false);
+		uint16_t classifyDryRunInsn_x86(cs_insn* insn);
 
 	// ARM specific.
 	//
@@ -204,6 +220,7 @@ class Decoder : public llvm::ModulePass
 				cs_mode mode,
 				std::size_t &decodedSz,
 				bool strict = false);
+		uint16_t classifyDryRunInsn_arm(csh ce, cs_insn* insn);
 		void patternsPseudoCall_arm(llvm::CallInst*& call, AsmInstruction& pAi);
 		cs_mode determineMode_arm(cs_insn* insn, utils::Address& target);
 
@@ -220,6 +237,7 @@ class Decoder : public llvm::ModulePass
 				const JumpTarget& jt,
 				ByteData bytes,
 				bool strict = false);
+		uint16_t classifyDryRunInsn_mips(cs_insn* insn);
 		void initializeGpReg_mips();
 
 	// PowerPC specific.
@@ -229,6 +247,7 @@ class Decoder : public llvm::ModulePass
 				const JumpTarget& jt,
 				ByteData bytes,
 				bool strict = false);
+		uint16_t classifyDryRunInsn_ppc(cs_insn* insn);
 
 	// IR modifications.
 	//
@@ -284,13 +303,21 @@ class Decoder : public llvm::ModulePass
 		FileImage* _image = nullptr;
 		DebugFormat* _debug = nullptr;
 		NameContainer* _names = nullptr;
-		Llvm2CapstoneInsnMap* _llvm2capstone = nullptr;
+		CapstoneInsnStore* _insnStore = nullptr;
 		Abi* _abi = nullptr;
 
 		ReachingDefinitionsAnalysis _RDA;
 
 		std::unique_ptr<capstone2llvmir::Capstone2LlvmIrTranslator> _c2l;
 		cs_insn* _dryCsInsn = nullptr;
+		/// Instruction buffer reused by all translated instructions.
+		cs_insn* _translatedCsInsn = nullptr;
+		/// Instruction buffer reused by translated delay slot instructions,
+		/// the branch owning the delay slot is still in @c _translatedCsInsn.
+		cs_insn* _delaySlotCsInsn = nullptr;
+		/// Instructions found by the linear sweep pre-pass, used by dry runs.
+		/// Empty if the pre-pass is not enabled.
+		LinearSweepTable _sweepTable;
 
 		llvm::IRBuilder<>* _irb;
 
@@ -39,6 +39,8 @@ class RangesToDecode
 		const utils::AddressRange* getAlternative(utils::Address a) const;
 		const utils::AddressRange* get(utils::Address a) const;
 
+		const utils::AddressRangeContainer& getPrimaryRanges() const;
+
 		void setArchitectureInstructionAlignment(unsigned a);
 
 	friend std::ostream& operator<<(std::ostream &os, const RangesToDecode& rs);
@@ -0,0 +1,98 @@
+/**
+* @file include/retdec/bin2llvmir/optimizations/decoder/linear_sweep.h
+* @brief Table of instructions found by linear sweep disassembly.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_LINEAR_SWEEP_H
+#define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_LINEAR_SWEEP_H
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <capstone/capstone.h>
+
+#include "retdec/utils/address.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Flat table of instructions in the ranges to decode.
+ *
+ * It keeps only the information needed by decoder's dry runs -- instruction
+ * size and classification flags -- so that repeated dry runs over the same
+ * bytes (e.g. leftover targets in large data-in-code regions) do not have
+ * to disassemble them again.
+ *
+ * The table consists of chunks, one per swept address range and disassembly
+ * mode. Each chunk has an entry for every aligned address in its range.
+ * Entries are filled by the linear sweep pre-pass and later on demand.
+ */
+class LinearSweepTable
+{
+	public:
+		/// Instruction classification flags.
+		enum eFlag : uint16_t
+		{
+			/// Entry was filled, the other members are valid.
+			KNOWN                = 1 << 0,
+			/// Bytes on this address can not be disassembled.
+			INVALID              = 1 << 1,
+			NOP                  = 1 << 2,
+			RETURN               = 1 << 3,
+			BRANCH               = 1 << 4,
+			COND_BRANCH          = 1 << 5,
+			CALL                 = 1 << 6,
+			CONTROL_FLOW         = 1 << 7,
+			// Architecture-specific flags.
+			X86_STORE_ONE_TO_EAX = 1 << 8,
+			X86_INT_80           = 1 << 9,
+			X86_SYSCALL          = 1 << 10,
+			ARM_WRITES_PC        = 1 << 11,
+			ARM_PUSH             = 1 << 12,
+			MIPS_BAD_BRANCH      = 1 << 13,
+		};
+
+		/// Instruction entry.
+		struct Insn
+		{
+			uint8_t size = 0;
+			uint16_t flags = 0;
+
+			bool isKnown() const { return flags & KNOWN; }
+			bool isInvalid() const { return flags & INVALID; }
+			bool is(eFlag f) const { return flags & f; }
+		};
+
+	public:
+		void addChunk(
+				cs_mode mode,
+				const utils::AddressRange& range,
+				unsigned alignment);
+		Insn* get(cs_mode mode, utils::Address addr);
+
+		bool empty() const;
+		std::size_t size() const;
+		void clear();
+
+	private:
+		struct Chunk
+		{
+			utils::Address start;
+			unsigned alignment = 1;
+			std::vector<Insn> insns;
+		};
+
+	private:
+		/// Chunks ordered by their start address, for each mode.
+		std::map<cs_mode, std::map<utils::Address, Chunk>> _chunks;
+		std::size_t _size = 0;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
@@ -0,0 +1,64 @@
+/**
+* @file include/retdec/bin2llvmir/optimizations/fixpoint/fixpoint.h
+* @brief Run a group of passes until they stop changing the module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_FIXPOINT_FIXPOINT_H
+#define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_FIXPOINT_FIXPOINT_H
+
+#include <cstddef>
+
+#include <llvm/Analysis/TargetLibraryInfo.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Pass.h>
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Runs a group of passes repeatedly, until they stop changing the module
+ * or until the maximal number of iterations is reached.
+ *
+ * Pipelines are often run several times in a row so that their passes can
+ * use results of each other. The next run is wasted if the previous one
+ * did not change anything. Here, the next run is done only if the previous
+ * one changed the module: its pass manager reported a change and a
+ * fingerprint of the module differs from the one before the run.
+ * The fingerprint is needed because some passes (e.g. -instnamer) report
+ * a change even if there was none.
+ *
+ * The passes are run by an inner pass manager, so the group behaves as
+ * a single module pass in the outer one. They are added by getPassManager()
+ * before the group is run.
+ */
+class FixpointPassGroup : public llvm::ModulePass
+{
+	public:
+		static char ID;
+		/// Default maximal number of runs of the group.
+		static const unsigned DEFAULT_MAX_ITERATIONS = 2;
+
+		FixpointPassGroup(
+				const llvm::TargetLibraryInfoImpl& tlii,
+				unsigned maxIterations = DEFAULT_MAX_ITERATIONS);
+		virtual bool runOnModule(llvm::Module& M) override;
+		virtual llvm::StringRef getPassName() const override;
+
+		llvm::legacy::PassManager& getPassManager();
+		unsigned getNumOfIterations() const;
+
+		static std::size_t getFingerprint(llvm::Module& M);
+
+	private:
+		llvm::legacy::PassManager _passes;
+		unsigned _maxIterations = DEFAULT_MAX_ITERATIONS;
+		/// Number of iterations done by the last run.
+		unsigned _iterations = 0;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
@@ -10,6 +10,8 @@
 #include <llvm/IR/Module.h>
 #include <llvm/Pass.h>
 
+#include "retdec/config/config.h"
+
 namespace retdec {
 namespace bin2llvmir {
 
@@ -17,11 +19,17 @@ class ProviderInitialization : public llvm::ModulePass
 {
 	public:
 		static char ID;
-		ProviderInitialization();
+		ProviderInitialization(retdec::config::Config* c = nullptr);
 		virtual bool runOnModule(llvm::Module& m) override;
 		virtual bool doFinalization(llvm::Module& m) override;
+
+	private:
+		/// In-memory config used instead of the config file, if set.
+		retdec::config::Config* _config = nullptr;
 };
 
+void clearProviders(llvm::Module* m);
+
 } // namespace bin2llvmir
 } // namespace retdec
 
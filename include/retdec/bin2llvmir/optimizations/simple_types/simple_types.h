@@ -157,7 +157,7 @@ class EqSet
 
 	public:
 		/// Each instance gets its own unique ID for debug print purposes.
-		static unsigned newUID;
+		static thread_local unsigned newUID;
 		const unsigned id;
 
 		/// Type of an entire equivalence set.
@@ -221,7 +221,7 @@ class SimpleTypesAnalysis : public llvm::ModulePass
 		EqSetContainer eqSets;
 		ValuePairList val2PtrVal;
 
-		ReachingDefinitionsAnalysis RDA;
+		ReachingDefinitionsAnalysis* RDA = nullptr;
 		llvm::Module* module = nullptr;
 		const llvm::GlobalVariable* _specialGlobal = nullptr;
 		Config* config = nullptr;
@@ -9,6 +9,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -162,9 +163,11 @@ class AbiProvider
 		static Abi* getAbi(llvm::Module* m);
 		static bool getAbi(llvm::Module* m, Abi*& abi);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, std::unique_ptr<Abi>> _module2abi;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -7,6 +7,12 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <capstone/capstone.h>
 #include "retdec/capstone2llvmir/arm/arm_defs.h"
 #include "retdec/capstone2llvmir/mips/mips_defs.h"
@@ -23,7 +29,112 @@
 namespace retdec {
 namespace bin2llvmir {
 
-using Llvm2CapstoneInsnMap = typename std::map<llvm::StoreInst*, cs_insn*>;
+/**
+ * Deleter of Capstone instructions allocated by @c cs_malloc().
+ */
+struct CapstoneInsnDeleter
+{
+	void operator()(cs_insn* insn) const
+	{
+		cs_free(insn, 1);
+	}
+};
+
+/**
+ * Capstone instruction owned by the one who asked for it.
+ */
+using CapstoneInsnPtr = std::unique_ptr<cs_insn, CapstoneInsnDeleter>;
+
+/**
+ * Compact store of decoded Capstone instructions indexed by their addresses
+ * and modes.
+ *
+ * Keeping a full Capstone instruction (including its detail) for every
+ * decoded instruction needs a lot of memory. Only the instruction ID, size,
+ * NOP flag, bytes and assembly text are kept here, in large blocks of memory
+ * shared by all instructions. Full instructions are disassembled again from
+ * the kept bytes when somebody asks for them.
+ *
+ * The same address may be decoded in several modes (e.g. ARM and THUMB).
+ * One instruction per mode is kept. Methods without a mode use the
+ * instruction inserted last.
+ */
+class CapstoneInsnStore
+{
+	public:
+		CapstoneInsnStore();
+		~CapstoneInsnStore();
+		CapstoneInsnStore(const CapstoneInsnStore&) = delete;
+		CapstoneInsnStore& operator=(const CapstoneInsnStore&) = delete;
+
+		void insert(
+				const cs_insn* insn,
+				cs_arch arch,
+				cs_mode mode,
+				bool nop = false);
+		bool contains(retdec::utils::Address addr) const;
+		bool contains(retdec::utils::Address addr, cs_mode mode) const;
+		unsigned getId(retdec::utils::Address addr) const;
+		std::size_t getByteSize(retdec::utils::Address addr) const;
+		bool isNop(retdec::utils::Address addr) const;
+		std::string getDsm(retdec::utils::Address addr) const;
+		CapstoneInsnPtr getCapstoneInsn(retdec::utils::Address addr);
+		CapstoneInsnPtr getCapstoneInsn(
+				retdec::utils::Address addr,
+				cs_mode mode);
+		std::size_t size() const;
+		void clear();
+
+	private:
+		/// Compact form of one instruction.
+		struct Entry
+		{
+			/// Bytes, mnemonic and operands of the instruction (in this order).
+			const char* data = nullptr;
+			/// Instruction at the same address decoded in another mode.
+			const Entry* other = nullptr;
+			/// Capstone instruction ID.
+			unsigned id = 0;
+			/// Index into @c _modes.
+			uint8_t mode = 0;
+			/// Size of the instruction in bytes.
+			uint8_t size = 0;
+			uint8_t mnemonicSize = 0;
+			uint8_t opStrSize = 0;
+			/// Is this a NOP instruction (as decided by the inserter)?
+			bool nop = false;
+		};
+
+	private:
+		const Entry* getEntry(retdec::utils::Address addr) const;
+		const Entry* getEntry(retdec::utils::Address addr, cs_mode mode) const;
+		char* allocate(std::size_t size, std::size_t align = 1);
+		const Entry* allocateEntry(const Entry& e, const Entry* other);
+		uint8_t getModeIndex(cs_mode mode);
+		CapstoneInsnPtr disassemble(const Entry* e, uint64_t addr);
+		void closeHandle();
+
+	private:
+		/// The last inserted instruction for each address. Instructions
+		/// decoded in other modes are chained from it.
+		std::unordered_map<uint64_t, Entry> _entries;
+		/// Number of all kept instructions.
+		std::size_t _count = 0;
+		/// Memory blocks holding data of instructions.
+		std::vector<std::unique_ptr<char[]>> _blocks;
+		/// Number of used bytes in the last block.
+		std::size_t _blockUsed = 0;
+		/// Size of the last block.
+		std::size_t _blockSize = 0;
+
+		/// Modes used by instructions (there is only a few of them).
+		std::vector<cs_mode> _modes;
+		cs_arch _arch = CS_ARCH_ALL;
+		/// Capstone engine used to disassemble instructions again.
+		csh _handle = 0;
+		/// Mode the engine is currently set to.
+		cs_mode _handleMode = CS_MODE_LITTLE_ENDIAN;
+};
 
 /**
  * Assembly instruction representation.
@@ -84,7 +195,9 @@ class AsmInstruction
 	public:
 		bool isValid() const;
 		bool isInvalid() const;
-		cs_insn* getCapstoneInsn() const;
+		CapstoneInsnPtr getCapstoneInsn() const;
+		bool isNop() const;
+		unsigned getCapstoneInsnId() const;
 
 		std::string getDsm() const;
 		retdec::utils::Address getAddress() const;
@@ -153,7 +266,7 @@ class AsmInstruction
 		}
 
 	public:
-		static Llvm2CapstoneInsnMap& getLlvmToCapstoneInsnMap(
+		static CapstoneInsnStore& getCapstoneInsnStore(
 				const llvm::Module* m);
 		static llvm::GlobalVariable* getLlvmToAsmGlobalVariable(
 				const llvm::Module* m);
@@ -168,24 +281,21 @@ class AsmInstruction
 				llvm::Function* f);
 		static bool isLlvmToAsmInstruction(const llvm::Value* inst);
 		static void clear();
+		static void clear(const llvm::Module* m);
 
 	private:
+		CapstoneInsnStore* getCapstoneInsnStorePrivate() const;
 		const llvm::GlobalVariable* getLlvmToAsmGlobalVariablePrivate(
 				llvm::Module* m) const;
 		bool isLlvmToAsmInstructionPrivate(llvm::Value* inst) const;
 
-	private:
-		using ModuleGlobalPair = std::pair<
-				const llvm::Module*,
-				llvm::GlobalVariable*>;
-		using ModuleInstructionMap = std::pair<
-				const llvm::Module*,
-				std::map<llvm::StoreInst*, cs_insn*>>;
-
 	private:
 		llvm::StoreInst* _llvmToAsmInstr = nullptr;
-		static std::vector<ModuleGlobalPair> _module2global;
-		static std::vector<ModuleInstructionMap> _module2instMap;
+		static std::map<const llvm::Module*, llvm::GlobalVariable*> _module2global;
+		static std::map<const llvm::Module*, CapstoneInsnStore> _module2insnStore;
+		/// Guards both mappings, modules may be processed in parallel.
+		/// Instruction stores themselves are used only by their module.
+		static std::mutex _mutex;
 
 	public:
 		template<
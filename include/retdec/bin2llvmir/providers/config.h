@@ -7,6 +7,9 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_CONFIG_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_CONFIG_H
 
+#include <map>
+#include <mutex>
+
 #include "retdec/config/config.h"
 
 #include <llvm/IR/Instructions.h>
@@ -24,6 +27,9 @@ class Config
 		static Config empty(llvm::Module* m);
 		static Config fromFile(llvm::Module* m, const std::string& path);
 		static Config fromJsonString(llvm::Module* m, const std::string& json);
+		static Config fromConfig(
+				llvm::Module* m,
+				const retdec::config::Config& c);
 
 		void doFinalization();
 
@@ -173,6 +179,10 @@ class Config
 
 		// Other
 		//
+		bool isSimpleTypesAnalysed() const;
+		void setSimpleTypesAnalysed();
+		unsigned getNextDumpNumber();
+
 		llvm::GlobalVariable* getGlobalDummy();
 		utils::FilesystemPath getOutputDirectory();
 		bool getCryptoPattern(
@@ -204,6 +214,11 @@ class Config
 
 		std::map<IntrinsicFunctionCreatorPtr, llvm::Function*> _intrinsicFunctions;
 		std::set<llvm::Function*> _pseudoAsmFunctions;
+
+		/// Full simple types analysis has already run on the module.
+		bool _simpleTypesAnalysed = false;
+		/// Number of the next dump of the module into a file.
+		unsigned _dumpNumber = 0;
 };
 
 class ConfigProvider
@@ -213,13 +228,18 @@ class ConfigProvider
 		static Config* addConfigJsonString(
 				llvm::Module* m,
 				const std::string& json);
+		static Config* addConfig(
+				llvm::Module* m,
+				const retdec::config::Config& c);
 		static Config* getConfig(llvm::Module* m);
 		static bool getConfig(llvm::Module* m, Config*& c);
 		static void doFinalization(llvm::Module* m);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, Config> _module2config;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
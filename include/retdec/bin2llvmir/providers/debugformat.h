@@ -7,6 +7,9 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_DEBUGFORMAT_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_DEBUGFORMAT_H
 
+#include <map>
+#include <mutex>
+
 #include <llvm/IR/Module.h>
 
 #include "retdec/bin2llvmir/providers/fileimage.h"
@@ -49,10 +52,13 @@ class DebugFormatProvider
 		static bool getDebugFormat(llvm::Module* m, DebugFormat*& df);
 
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		/// Mapping of modules to debug info associated with them.
 		static std::map<llvm::Module*, DebugFormat> _module2debug;
+		/// Guards the mapping, modules may be processed in parallel.
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -8,6 +8,7 @@
 #define RETDEC_BIN2LLVMIR_PROVIDERS_DEMANGLER_H
 
 #include <map>
+#include <mutex>
 
 #include <llvm/IR/Module.h>
 
@@ -40,11 +41,14 @@ class DemanglerProvider
 				retdec::demangler::CDemangler*& d);
 
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		using Demangler = std::unique_ptr<retdec::demangler::CDemangler>;
 		/// Mapping of modules to demanglers associated with them.
 		static std::map<llvm::Module*, Demangler> _module2demangler;
+		/// Guards the mapping, modules may be processed in parallel.
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
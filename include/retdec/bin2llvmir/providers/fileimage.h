@@ -7,6 +7,9 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_FILEIMAGE_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_FILEIMAGE_H
 
+#include <map>
+#include <mutex>
+
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
@@ -132,6 +135,7 @@ class FileImageProvider
 				FileImage*& img);
 
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static FileImage* addFileImage(
@@ -141,6 +145,8 @@ class FileImageProvider
 	private:
 		/// Mapping of modules to file images associated with them.
 		static std::map<llvm::Module*, FileImage> _module2image;
+		/// Guards the mapping, modules may be processed in parallel.
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -7,12 +7,19 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 #include "retdec/ctypes/context.h"
 #include "retdec/ctypes/module.h"
 #include "retdec/ctypes/type.h"
 #include "retdec/ctypes/visitor.h"
+#include "retdec/ctypesparser/indexed_ctypes_parser.h"
 #include "retdec/ctypesparser/json_ctypes_parser.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
@@ -79,16 +86,36 @@ class Lti
 		FunctionPair getPairFunction(const std::string& name);
 		llvm::Function* getLlvmFunction(const std::string& name);
 
+	private:
+		/// Library type information file.
+		struct LtiFile
+		{
+			/// Functions parsed from the JSON file when it has no index.
+			std::unique_ptr<retdec::ctypes::Module> module;
+			/// Index of the file, functions from it are parsed on demand.
+			std::unique_ptr<ctypesparser::IndexedCTypesParser> index;
+			/// Memory-mapped data of @c index.
+			std::unique_ptr<llvm::MemoryBuffer> indexBuffer;
+		};
+
 	private:
 		void loadLtiFile(const std::string& filePath);
+		bool loadLtiIndex(
+				const std::string& filePath,
+				const ctypesparser::CTypesParser::TypeWidths& typeWidths,
+				const std::string& callConv);
 		llvm::Type* getLlvmType(std::shared_ptr<retdec::ctypes::Type> type);
 
 	private:
 		llvm::Module* _module = nullptr;
 		Config* _config = nullptr;
 		retdec::loader::Image* _image = nullptr;
+		/// Functions already found in @c _ltiFiles.
 		std::unique_ptr<retdec::ctypes::Module> _ltiModule;
 		ctypesparser::JSONCTypesParser _ltiParser;
+		/// Type information files in the order they were loaded. A function
+		/// is taken from the first file that has it.
+		std::vector<LtiFile> _ltiFiles;
 };
 
 class LtiProvider
@@ -101,9 +128,11 @@ class LtiProvider
 		static Lti* getLti(llvm::Module* m);
 		static bool getLti(llvm::Module* m, Lti*& lti);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, Lti> _module2lti;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -401,8 +401,10 @@ class Capstone2LlvmIrTranslator
 			/// destroyed.
 			llvm::StoreInst* llvmInsn = nullptr;
 			/// Translated capstone instruction.
-			/// Capstone instruction is dynamically allocated by this
-			/// method, and must be freed by caller to avoid memory leaks.
+			/// If no instruction buffer was passed to the method, Capstone
+			/// instruction is dynamically allocated by this method, and must
+			/// be freed by caller to avoid memory leaks. Otherwise, it is the
+			/// passed buffer.
 			cs_insn* capstoneInsn = nullptr;
 			/// Byte size of the translated binary chunk.
 			std::size_t size = 0;
@@ -425,13 +427,19 @@ class Capstone2LlvmIrTranslator
 		 * @param irb   LLVM IR builder used to create LLVM IR translation.
 		 *              Translated LLVM IR instructions are created at its
 		 *              current position.
+		 * @param insn  Instruction buffer (allocated by @c cs_malloc() on
+		 *              this translator's engine) to disassemble into. It
+		 *              stays owned by the caller and can be reused for many
+		 *              translations. If not set, a new instruction is
+		 *              allocated.
 		 * @return See @c TranslationResult structure.
 		 */
 		virtual TranslationResultOne translateOne(
 				const uint8_t*& bytes,
 				std::size_t& size,
 				retdec::utils::Address& a,
-				llvm::IRBuilder<>& irb) = 0;
+				llvm::IRBuilder<>& irb,
+				cs_insn* insn = nullptr) = 0;
 //
 //==============================================================================
 // Capstone related getters and query methods.
@@ -136,6 +136,8 @@ class AddressRangeJson : public retdec::utils::AddressRange
  * Base sequential container class.
  * Elements are stored in the same order they were inserted.
  * Method @c insert() makes sure that elements in containers are unique.
+ * Elements are stored in a list, so pointers to them stay valid until they
+ * are removed. Callers keep such pointers (e.g. from @c getElementById()).
  *
  * Elements must implement these methods:
  * <tt>Json::Value getJsonValue() const;</tt>
@@ -166,6 +168,12 @@ class BaseSequentialContainer
 			std::advance(it, n);
 			return *it;
 		}
+		const Elem& operator[](std::size_t n) const
+		{
+			auto it = _data.begin();
+			std::advance(it, n);
+			return *it;
+		}
 
 		/**
 		 * Method keeps elements in container unique.
@@ -315,8 +323,15 @@ class BaseAssociativeContainer
 		const_iterator end() const   { return _data.end(); }
 		size_t size() const          { return _data.size(); }
 		bool empty() const           { return _data.empty(); }
-		void clear()                 { _data.clear(); }
-		size_t erase(const ID& k)    { return _data.erase(k); }
+
+		/// @name Modification methods.
+		///
+		/// They are virtual so that derived containers can keep their
+		/// additional indexes consistent with the underlying container.
+		/// @{
+		virtual void clear()              { _data.clear(); }
+		virtual size_t erase(const ID& k) { return _data.erase(k); }
+		/// @}
 
 		/**
 		 * This method behaves slightly different than std::map::insert().
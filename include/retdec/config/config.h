@@ -75,6 +75,30 @@ class Config
 		void readJsonString(const std::string& json);
 		void readJsonFile(const std::string& input);
 
+		/// @name Binary format methods.
+		/// Binary format is a compact encoding of the same data as JSON,
+		/// suitable for passing config between decompilation stages.
+		/// It is several times smaller than JSON, but it is encoded from
+		/// (and decoded into) the same JSON value tree, so it is only about
+		/// 1.6x faster to read and write.
+		/// @{
+		std::string generateBinaryString() const;
+		std::string generateBinaryFile(const std::string& outputFilePath) const;
+		void readBinaryString(const std::string& data);
+		static bool isBinaryString(const std::string& data);
+		/// @}
+
+		/// @name Format-independent file methods.
+		/// Files are read in both JSON and binary format. They are written
+		/// in the format of the last read file, or in the format set by
+		/// @c setIsBinary().
+		/// @{
+		void readFile(const std::string& input);
+		std::string generateFile(const std::string& outputFilePath) const;
+		bool isBinary() const;
+		void setIsBinary(bool b);
+		/// @}
+
 	public:
 		Parameters parameters;
 		Architecture architecture;
@@ -104,6 +128,12 @@ class Config
 		retdec::utils::Address _imageBase;
 
 		bool _ida = false;
+		bool _binary = false;
+
+	private:
+		Json::Value getJsonValue() const;
+		void readJsonValue(const Json::Value& root);
+		std::string readFileContent(const std::string& input);
 };
 
 } // namespace config
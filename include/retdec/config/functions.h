@@ -7,7 +7,9 @@
 #ifndef RETDEC_CONFIG_FUNCTIONS_H
 #define RETDEC_CONFIG_FUNCTIONS_H
 
+#include <set>
 #include <string>
+#include <utility>
 
 #include "retdec/config/base.h"
 #include "retdec/config/calling_convention.h"
@@ -145,6 +147,14 @@ class Function : public retdec::utils::AddressRange
 /**
  * An associative container with functions' names as the key.
  * See Function class for details.
+ *
+ * Besides names, functions can be quickly searched by their start addresses
+ * and real names. Indexes used for these searches are updated by
+ * @c insert(), @c erase(), @c clear(), @c setFunctionStartEnd() and
+ * @c setFunctionRealName(). Use the last two to change start address or
+ * real name of a function in the container. If they are modified directly
+ * in the function, it is not found by the new value until it is inserted
+ * again.
  */
 class FunctionContainer : public BaseAssociativeContainer<std::string, Function>
 {
@@ -153,7 +163,38 @@ class FunctionContainer : public BaseAssociativeContainer<std::string, Function>
 		Function* getFunctionByName(const std::string& name);
 		const Function* getFunctionByName(const std::string& name) const;
 		Function* getFunctionByStartAddress(const retdec::utils::Address& addr);
+		const Function* getFunctionByStartAddress(
+				const retdec::utils::Address& addr) const;
 		Function* getFunctionByRealName(const std::string& name);
+		const Function* getFunctionByRealName(const std::string& name) const;
+
+		Function* setFunctionStartEnd(
+				const std::string& name,
+				const retdec::utils::Address& start,
+				const retdec::utils::Address& end);
+		Function* setFunctionRealName(
+				const std::string& name,
+				const std::string& realName);
+
+		/// @name Reimplemented base container methods.
+		///
+		/// They need to be reimplemented to modify both underlying container
+		/// and indexes.
+		/// @{
+		virtual std::pair<iterator,bool> insert(const Function& e) override;
+		virtual size_t erase(const std::string& name) override;
+		virtual void clear() override;
+		/// @}
+
+	private:
+		void addToIndexes(const Function& f);
+		void removeFromIndexes(const Function& f);
+
+	private:
+		/// Pairs (start address, function name) ordered by address.
+		std::set<std::pair<retdec::utils::Address, std::string>> _addr2name;
+		/// Pairs (real name, function name) ordered by real name.
+		std::set<std::pair<std::string, std::string>> _realName2name;
 };
 
 } // namespace config
@@ -27,6 +27,7 @@ class Parameters
 		bool isVerboseOutput() const;
 		bool isKeepAllFunctions() const;
 		bool isSelectedDecodeOnly() const;
+		bool isLinearSweepPrepass() const;
 		bool isFrontendFunction(const std::string& funcName) const;
 		/// @}
 
@@ -35,6 +36,7 @@ class Parameters
 		void setIsVerboseOutput(bool b);
 		void setIsKeepAllFunctions(bool b);
 		void setIsSelectedDecodeOnly(bool b);
+		void setIsLinearSweepPrepass(bool b);
 		void setOutputFile(const std::string& n);
 		void setOrdinalNumbersDirectory(const std::string& n);
 		/// @}
@@ -82,6 +84,12 @@ class Parameters
 		/// results.
 		bool _selectedDecodeOnly = false;
 
+		/// Disassemble ranges to decode by linear sweep before decoding.
+		/// Decoder's dry runs then use the swept instructions instead of
+		/// disassembling the same bytes repeatedly.
+		/// This speeds up decoding of binaries with a lot of data in code.
+		bool _linearSweepPrepass = false;
+
 		std::string _outputFile;
 		std::string _ordinalNumbersDirectory;
 };
@@ -32,6 +32,7 @@ class ElfHeuristics : public Heuristics
 	protected:
 		/// @name Virtual methods
 		/// @{
+		virtual void registerFormatSpecificPatterns() override;
 		virtual void getFormatSpecificCompilerHeuristics() override;
 		/// @}
 
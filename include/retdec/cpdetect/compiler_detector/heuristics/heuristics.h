@@ -52,6 +52,11 @@ class Heuristics
 		void getSymbolHeuristic();
 		/// @}
 
+		/// @name Registration of searched patterns
+		/// @{
+		void registerCommonPatterns();
+		/// @}
+
 		/// @name Heuristics methods
 		/// @{
 		void getCommonToolsHeuristics();
@@ -84,6 +89,7 @@ class Heuristics
 
 		/// @name Virtual methods
 		/// @{
+		virtual void registerFormatSpecificPatterns();
 		virtual void getFormatSpecificCompilerHeuristics();
 		virtual void getFormatSpecificLanguageHeuristics();
 		/// @}
@@ -30,6 +30,7 @@ class MachOHeuristics : public Heuristics
 	protected:
 		/// @name Virtual methods
 		/// @{
+		virtual void registerFormatSpecificPatterns() override;
 		virtual void getFormatSpecificCompilerHeuristics() override;
 		/// @}
 
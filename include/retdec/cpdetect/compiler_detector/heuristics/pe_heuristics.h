@@ -74,6 +74,7 @@ class PeHeuristics : public Heuristics
 	protected:
 		/// @name Virtual methods
 		/// @{
+		virtual void registerFormatSpecificPatterns() override;
 		virtual void getFormatSpecificCompilerHeuristics() override;
 		virtual void getFormatSpecificLanguageHeuristics() override;
 		/// @}
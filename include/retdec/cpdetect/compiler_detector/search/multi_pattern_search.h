@@ -0,0 +1,92 @@
+/**
+ * @file include/retdec/cpdetect/compiler_detector/search/multi_pattern_search.h
+ * @brief Class for simultaneous search of many patterns in one pass.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_CPDETECT_COMPILER_DETECTOR_SEARCH_MULTI_PATTERN_SEARCH_H
+#define RETDEC_CPDETECT_COMPILER_DETECTOR_SEARCH_MULTI_PATTERN_SEARCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include "retdec/cpdetect/compiler_detector/search/signature_pattern.h"
+
+namespace retdec {
+namespace cpdetect {
+
+/**
+ * Search of many plain strings and unslashed signatures in one pass
+ *
+ * Patterns are registered first. Method @c scan() then builds Aho-Corasick
+ * automaton from all registered strings and from the longest significant
+ * byte sequence of each signature and finds all occurrences of all patterns
+ * in one pass over the data. Candidates of signatures are verified against
+ * the whole signature. Found offsets form the hit table which is queried
+ * by find methods.
+ */
+class MultiPatternSearch
+{
+	public:
+		static const std::size_t npos = static_cast<std::size_t>(-1);
+	private:
+		/**
+		 * Literal searched by automaton
+		 */
+		struct Key
+		{
+			bool signature;                       ///< @c true if key belongs to signature, @c false if to string
+			std::size_t index;                    ///< index of string or signature
+			std::size_t alignment;                ///< alignment of signature (@c 0 or @c 1)
+			std::size_t offset;                   ///< offset of key from the first byte of signature
+			llvm::ArrayRef<std::uint8_t> literal; ///< searched bytes
+		};
+
+		std::vector<std::string> strings;                    ///< registered strings
+		std::vector<SignaturePattern> signatures;            ///< registered signatures
+		std::vector<bool> indexedSignatures;                 ///< @c true if signature is searched by automaton
+		std::vector<std::vector<std::size_t>> stringHits;    ///< byte offsets of found strings
+		std::vector<std::vector<std::size_t>> signatureHits; ///< nibble offsets of found signatures
+		bool scanned;                                        ///< @c true if hit table is up to date
+
+		/// @name Automaton
+		/// @{
+		std::vector<Key> keys;                         ///< all literals searched by automaton
+		std::uint16_t byteClasses[256];                ///< mapping of bytes into input classes of automaton
+		std::size_t numberOfClasses;                   ///< number of input classes
+		std::vector<std::uint32_t> transitions;        ///< transition table (state * classes + class)
+		std::vector<std::vector<std::size_t>> outputs; ///< keys which end in each state
+		/// @}
+
+		/// @name Auxiliary methods
+		/// @{
+		void buildAutomaton();
+		void runAutomaton(llvm::ArrayRef<std::uint8_t> data, bool searchStrings, bool searchSignatures);
+		std::size_t findHit(const std::vector<std::size_t> &hits, std::size_t offset) const;
+		/// @}
+	public:
+		MultiPatternSearch();
+
+		/// @name Registration of patterns
+		/// @{
+		std::size_t addString(const std::string &str);
+		std::size_t addSignature(const std::string &signPattern);
+		/// @}
+
+		/// @name Search methods
+		/// @{
+		void scan(llvm::ArrayRef<std::uint8_t> plainData, llvm::ArrayRef<std::uint8_t> signatureData);
+		bool isScanned() const;
+		bool isSignatureIndexed(std::size_t index) const;
+		std::size_t findString(std::size_t index, std::size_t startOffset) const;
+		std::size_t findSignature(std::size_t index, std::size_t startNibble) const;
+		/// @}
+};
+
+} // namespace cpdetect
+} // namespace retdec
+
+#endif
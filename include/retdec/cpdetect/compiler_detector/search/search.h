@@ -7,7 +7,14 @@
 #ifndef RETDEC_CPDETECT_COMPILER_DETECTOR_SEARCH_SEARCH_H
 #define RETDEC_CPDETECT_COMPILER_DETECTOR_SEARCH_SEARCH_H
 
+#include <unordered_map>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+
 #include "retdec/cpdetect/cptypes.h"
+#include "retdec/cpdetect/compiler_detector/search/multi_pattern_search.h"
+#include "retdec/cpdetect/compiler_detector/search/signature_pattern.h"
 #include "retdec/fileformat/file_format/file_format.h"
 
 namespace retdec {
@@ -40,18 +47,30 @@ class Search
 		};
 	private:
 		retdec::fileformat::FileFormat &parser; ///< parser of input file
-		std::string nibbles;             ///< content of file in hexadecimal string representation
-		std::string plain;               ///< content of file as plain string
-		std::vector<RelativeJump> jumps; ///< representation of supported relative jumps
-		std::size_t averageSlashLen;     ///< average length of one slash representation
-		bool fileLoaded;                 ///< @c true if file was successfully loaded, @c false otherwise
-		bool fileSupported;              ///< @c true if search of patterns is supported for input file, @c false otherwise
+		llvm::StringRef plain;                  ///< content of file as plain string
+		llvm::ArrayRef<std::uint8_t> content;   ///< content of file in little endian (searched by signatures)
+		std::vector<std::uint8_t> swappedBytes; ///< content of big endian file converted to little endian
+		std::vector<RelativeJump> jumps;        ///< representation of supported relative jumps
+		std::size_t averageSlashLen;            ///< average length of one slash representation
+		bool fileLoaded;                        ///< @c true if file was successfully loaded, @c false otherwise
+		bool fileSupported;                     ///< @c true if search of patterns is supported for input file, @c false otherwise
+		mutable std::unordered_map<std::string, SignaturePattern> patterns; ///< cache of compiled signature patterns
+		mutable MultiPatternSearch registered;                               ///< registered patterns and their hits
+		std::unordered_map<std::string, std::size_t> registeredStrings;     ///< indexes of registered strings
+		std::unordered_map<std::string, std::size_t> registeredSignatures;  ///< indexes of registered signatures
 
 		/// @name Auxiliary methods
 		/// @{
 		bool haveSlashes() const;
 		std::size_t nibblesFromBytes(std::size_t nBytes) const;
 		std::size_t bytesFromNibbles(std::size_t nNibbles) const;
+		std::size_t getNumberOfNibbles() const;
+		char getNibble(std::size_t nibbleOffset) const;
+		bool hasNibblesOnPosition(const std::string &hexString, std::size_t nibbleOffset) const;
+		const SignaturePattern& getPattern(const std::string &signPattern) const;
+		unsigned long long countImpNibbles(const SignaturePattern &pattern) const;
+		unsigned long long exactComparison(const SignaturePattern &pattern, std::size_t fileOffset, std::size_t shift) const;
+		const MultiPatternSearch& getRegistered() const;
 		/// @}
 	public:
 		Search(retdec::fileformat::FileFormat &fileParser);
@@ -65,8 +84,13 @@ class Search
 
 		/// @name Getters
 		/// @{
-		const std::string& getNibbles() const;
-		const std::string& getPlainString() const;
+		llvm::StringRef getPlainString() const;
+		/// @}
+
+		/// @name Registration of patterns
+		/// @{
+		void registerString(const std::string &str);
+		void registerSignature(const std::string &signPattern);
 		/// @}
 
 		/// @name Jump methods
@@ -86,6 +110,7 @@ class Search
 
 		/// @name Search methods based on plain-string comparison
 		/// @{
+		std::size_t findString(const std::string &str, std::size_t startOffset = 0) const;
 		bool hasString(const std::string &str) const;
 		bool hasString(const std::string &str, std::size_t fileOffset) const;
 		bool hasString(const std::string &str, std::size_t startOffset, std::size_t stopOffset) const;
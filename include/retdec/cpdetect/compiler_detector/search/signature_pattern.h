@@ -0,0 +1,88 @@
+/**
+ * @file include/retdec/cpdetect/compiler_detector/search/signature_pattern.h
+ * @brief Class for signature pattern compiled into byte values and masks.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_CPDETECT_COMPILER_DETECTOR_SEARCH_SIGNATURE_PATTERN_H
+#define RETDEC_CPDETECT_COMPILER_DETECTOR_SEARCH_SIGNATURE_PATTERN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+namespace retdec {
+namespace cpdetect {
+
+/**
+ * Signature pattern (e.g. "558BEC--/;") compiled into byte values and masks
+ *
+ * Pattern may start on the high or on the low nibble of a byte, so every
+ * part of the pattern is compiled for both alignments. Nibble offsets used
+ * by this class are counted from the first nibble of the searched data.
+ */
+class SignaturePattern
+{
+	public:
+		/**
+		 * Continuous part of pattern without relative jumps
+		 */
+		class Part
+		{
+			private:
+				std::size_t nibbleLength;            ///< length of part in nibbles
+				std::vector<std::uint8_t> values[2]; ///< byte values for even and odd start nibble
+				std::vector<std::uint8_t> masks[2];  ///< byte masks for even and odd start nibble
+				std::size_t anchors[2];              ///< index of first byte without wildcards
+				bool valid;                          ///< @c false if part can never be matched
+
+				/// @name Auxiliary methods
+				/// @{
+				bool matchesBytes(llvm::ArrayRef<std::uint8_t> data, std::size_t alignment, std::size_t byteOffset) const;
+				/// @}
+			public:
+				Part();
+
+				/// @name Construction
+				/// @{
+				void addNibble(std::uint8_t value, std::uint8_t mask);
+				void invalidate();
+				void finalize();
+				/// @}
+
+				/// @name Getters
+				/// @{
+				std::size_t getNibbleLength() const;
+				bool isValid() const;
+				llvm::ArrayRef<std::uint8_t> getLongestLiteral(std::size_t alignment, std::size_t &byteOffset) const;
+				/// @}
+
+				/// @name Matching methods
+				/// @{
+				bool matches(llvm::ArrayRef<std::uint8_t> data, std::size_t nibbleOffset) const;
+				bool find(llvm::ArrayRef<std::uint8_t> data, std::size_t startNibble, std::size_t stopNibble) const;
+				/// @}
+		};
+	private:
+		std::vector<Part> parts;        ///< parts separated by relative jumps (up to first terminator)
+		Part unslashed;                 ///< whole pattern with terminators used as wildcards
+		std::size_t significantNibbles; ///< number of significant nibbles without relative jumps
+		std::size_t numberOfJumps;      ///< number of relative jumps in whole pattern
+	public:
+		SignaturePattern(const std::string &pattern);
+
+		/// @name Getters
+		/// @{
+		const std::vector<Part>& getParts() const;
+		const Part& getUnslashed() const;
+		std::size_t getNumberOfSignificantNibbles() const;
+		std::size_t getNumberOfJumps() const;
+		/// @}
+};
+
+} // namespace cpdetect
+} // namespace retdec
+
+#endif
@@ -0,0 +1,88 @@
+/**
+* @file include/retdec/crypto/multi_hash.h
+* @brief Declaration of class MultiHash.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_CRYPTO_MULTI_HASH_H
+#define RETDEC_CRYPTO_MULTI_HASH_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "retdec/crypto/crc32.h"
+#include "retdec/crypto/hash_context.h"
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace crypto {
+
+/**
+ * Hashes computed by MultiHash. Hashes of algorithms that were not requested
+ * are empty. All of them are lowercase hex strings, the same as the ones
+ * returned by getCrc32(), getMd5(), getSha1(), and getSha256().
+ */
+struct Hashes
+{
+	std::string crc32;
+	std::string md5;
+	std::string sha1;
+	std::string sha256;
+};
+
+/**
+ * This class computes several hashes of the same data at once.
+ *
+ * The data are split into small chunks and every chunk is fed to all
+ * requested algorithms before the next one is read. Every byte is thus
+ * loaded from memory only once, and the other algorithms read it from
+ * the cache.
+ */
+class MultiHash : private retdec::utils::NonCopyable
+{
+public:
+	/// Algorithms computed by MultiHash (they can be combined).
+	enum Algorithms : unsigned
+	{
+		CRC32  = 1,
+		MD5    = 2,
+		SHA1   = 4,
+		SHA256 = 8,
+		/// Hashes computed for files and their parts in fileformat.
+		DEFAULT = CRC32 | MD5 | SHA256
+	};
+
+	/// Range of data (pointer to the start and size).
+	using Range = std::pair<const std::uint8_t*, std::size_t>;
+
+public:
+	explicit MultiHash(unsigned algorithms = DEFAULT);
+
+	void addData(const std::uint8_t* data, std::size_t size);
+	Hashes getHashes();
+
+	static Hashes compute(
+			const std::uint8_t* data,
+			std::size_t size,
+			unsigned algorithms = DEFAULT);
+	static std::vector<Hashes> compute(
+			const std::vector<Range>& ranges,
+			unsigned algorithms = DEFAULT,
+			unsigned maxThreads = 0);
+
+private:
+	bool isRequested(Algorithms algorithm) const;
+
+	unsigned _algorithms; ///< Requested algorithms.
+	::CRC32 _crc32;       ///< CRC32 of added data.
+	HashContext _md5;     ///< MD5 of added data.
+	HashContext _sha1;    ///< SHA1 of added data.
+	HashContext _sha256;  ///< SHA256 of added data.
+};
+
+} // namespace crypto
+} // namespace retdec
+
+#endif
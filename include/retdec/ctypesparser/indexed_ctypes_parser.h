@@ -0,0 +1,132 @@
+/**
+* @file include/retdec/ctypesparser/indexed_ctypes_parser.h
+* @brief Parser for C-types from indexed binary files.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_CTYPESPARSER_INDEXED_CTYPES_PARSER_H
+#define RETDEC_CTYPESPARSER_INDEXED_CTYPES_PARSER_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "retdec/ctypesparser/json_ctypes_parser.h"
+
+namespace retdec {
+namespace ctypesparser {
+
+/**
+* @brief Parser for C-types stored in an indexed binary file.
+*
+* The index is created from a JSON file by createCTypesIndex(). It contains
+* the same functions and types, but each of them is stored as a separate
+* record that is found through a hash table by its name (functions) or key
+* (types). Therefore, a single function can be materialized together with
+* the types it uses without reading the rest of the file.
+*
+* The index is accessed in place, so it can be kept in a memory-mapped file.
+* The data given to open() have to outlive the parser.
+*
+* Layout of the index (all numbers are little-endian 32-bit integers):
+* @code
+* header:   magic "RDCTIDX3", version (3), source JSON size,
+*           source JSON modification time (64-bit, lower half first),
+*           function bucket count, function table offset,
+*           type bucket count, type table offset
+* tables:   bucket count * record offset (0 = empty bucket)
+* records:  name length, name, JSON length, JSON of the function or type
+* @endcode
+* Collisions are resolved by linear probing. Bucket counts are powers of two.
+*/
+class IndexedCTypesParser: public JSONCTypesParser
+{
+	public:
+		IndexedCTypesParser();
+		IndexedCTypesParser(unsigned defaultBitWidth);
+
+		virtual std::unique_ptr<retdec::ctypes::Module> parse(
+			std::istream &stream,
+			const TypeWidths &typeWidths = {},
+			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention()) override;
+		virtual void parseInto(
+			std::istream &stream,
+			std::unique_ptr<retdec::ctypes::Module> &module,
+			const TypeWidths &typeWidths = {},
+			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention()) override;
+
+		/// @name Lazy access.
+		/// @{
+		void open(const char *data, std::size_t size,
+			const std::shared_ptr<retdec::ctypes::Context> &context,
+			const TypeWidths &typeWidths = {},
+			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention());
+		bool hasFunction(const std::string &name) const;
+		std::shared_ptr<retdec::ctypes::Function> getFunction(
+			const std::string &name);
+		bool isCreatedFrom(std::uint64_t jsonSize,
+			std::uint64_t jsonModificationTime) const;
+		/// @}
+
+		static bool isIndex(const char *data, std::size_t size);
+
+	protected:
+		virtual const rapidjson::Value &getJsonType(
+			const std::string &typeKey) override;
+
+	private:
+		/// Record found in the index.
+		struct Record
+		{
+			const char *json = nullptr;
+			std::size_t jsonSize = 0;
+		};
+
+		/// Hash table of the index.
+		struct Table
+		{
+			std::uint32_t bucketCount = 0;
+			std::uint32_t offset = 0;
+		};
+
+	private:
+		void openIndex(const char *data, std::size_t size);
+		Table readTable(std::size_t headerOffset) const;
+		bool findRecord(const Table &table, const std::string &name,
+			Record &record) const;
+		std::unique_ptr<rapidjson::Document> parseRecord(
+			const Record &record) const;
+		std::uint32_t readUint32(std::size_t offset) const;
+
+	private:
+		/// Data of the index.
+		const char *data = nullptr;
+		/// Size of the index.
+		std::size_t size = 0;
+		/// Index loaded from a stream in parse() or parseInto().
+		std::string ownedData;
+
+		/// Size of the JSON file the index was created from.
+		std::uint32_t sourceSize = 0;
+		/// Modification time of the JSON file the index was created from.
+		std::uint64_t sourceModificationTime = 0;
+		/// Hash table of functions.
+		Table functions;
+		/// Hash table of types.
+		Table types;
+
+		/// Parsed JSON records of types needed by the currently parsed
+		/// function.
+		std::unordered_map<std::string, std::unique_ptr<rapidjson::Document>> typeRecords;
+};
+
+void createCTypesIndex(std::istream &jsonStream, std::ostream &indexStream,
+	std::uint64_t jsonModificationTime = 0);
+
+} // namespace ctypesparser
+} // namespace retdec
+
+#endif
@@ -37,13 +37,10 @@ class JSONCTypesParser: public CTypesParser
 			const TypeWidths &typeWidths = {},
 			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention()) override;
 
-	private:
+	protected:
 		std::string loadJson(std::istream &stream) const;
 		std::unique_ptr<rapidjson::Document> parseJson(char *buffer) const;
-		void parseJsonIntoModule(
-			const std::unique_ptr<rapidjson::Document> &root,
-			std::unique_ptr<retdec::ctypes::Module> &module);
-		void addTypesToMap(const rapidjson::Value &types);
+		virtual const rapidjson::Value &getJsonType(const std::string &typeKey);
 
 		/// @name Parsing methods.
 		/// @{
@@ -126,14 +123,23 @@ class JSONCTypesParser: public CTypesParser
 		unsigned getBitWidthOrDefault(const std::string &typeName) const;
 		/// @}
 
-	private:
+	protected:
 		using ParserContext = std::unordered_map<std::string, std::shared_ptr<retdec::ctypes::Type>>;
-		using TypesMap = std::unordered_map<std::string, rapidjson::Value::ConstMemberIterator>;
 
-	private:
+	protected:
 		/// Context for the parser (to speedup the parsing).
 		ParserContext parserContext;
 
+	private:
+		void parseJsonIntoModule(
+			const std::unique_ptr<rapidjson::Document> &root,
+			std::unique_ptr<retdec::ctypes::Module> &module);
+		void addTypesToMap(const rapidjson::Value &types);
+
+	private:
+		using TypesMap = std::unordered_map<std::string, rapidjson::Value::ConstMemberIterator>;
+
+	private:
 		/// Map used to store pointers to JSON types (to speedup the parsing).
 		TypesMap typesMap;
 };
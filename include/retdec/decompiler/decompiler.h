@@ -0,0 +1,77 @@
+/**
+ * @file include/retdec/decompiler/decompiler.h
+ * @brief In-process decompilation of a binary file into a high-level language.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_DECOMPILER_DECOMPILER_H
+#define RETDEC_DECOMPILER_DECOMPILER_H
+
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "retdec/config/config.h"
+#include "retdec/llvmir2hll/decompiler.h"
+
+namespace retdec {
+namespace decompiler {
+
+/**
+ * Decompilation failure.
+ */
+class DecompilationError : public std::runtime_error
+{
+	public:
+		using std::runtime_error::runtime_error;
+};
+
+/**
+ * Parameters of the decompilation.
+ *
+ * They correspond to the parameters of @c retdec-decompiler.py that are
+ * relevant for decompilation of a single executable file.
+ */
+struct DecompilationParams
+{
+	/// Path to the input binary file.
+	std::string inputFile;
+	/// Path to the output file with the generated code.
+	std::string outputFile;
+	/// Path to the RetDec support directory (share/retdec/support).
+	std::string supportDir;
+	/// Path to the file the final config is written into (optional).
+	std::string outputConfigFile;
+	/// Paths to YARA rules with crypto patterns used by fileinfo.
+	std::set<std::string> cryptoPatternPaths;
+	/// Paths to additional signatures of statically linked code.
+	std::set<std::string> userSignaturePaths;
+	/// Do not use the default signatures of statically linked code.
+	bool noDefaultStaticSignatures = false;
+	/// Decompile also unreachable functions.
+	bool keepUnreachableFuncs = false;
+	/// Options of the back-end (llvmir2hll).
+	retdec::llvmir2hll::DecompilerOptions backendOptions;
+};
+
+/**
+ * Decompile the input binary according to @p params.
+ *
+ * File information detection, bin2llvmir and llvmir2hll run in the current
+ * process. The config and the LLVM module are passed between the stages in
+ * memory, so neither is serialized on the way.
+ *
+ * @param params Parameters of the decompilation.
+ * @param config Config to use. Information gathered during decompilation
+ *               is added into it.
+ *
+ * @throw DecompilationError if the decompilation fails.
+ */
+void decompile(
+		const DecompilationParams& params,
+		retdec::config::Config& config);
+
+} // namespace decompiler
+} // namespace retdec
+
+#endif
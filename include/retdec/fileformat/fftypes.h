@@ -70,7 +70,29 @@ enum LoadFlags
 	NONE              = 0,
 	NO_FILE_HASHES    = 1,
 	NO_VERBOSE_HASHES = 2,
-	DETECT_STRINGS    = 4
+	DETECT_STRINGS    = 4,
+	MEMORY_MAP_INPUT  = 8,  ///< map input file read-only instead of copying it
+	LAZY_COMPONENTS   = 16, ///< parse resources, certificates, .NET and VB headers on first access
+	SINGLE_THREADED   = 32, ///< do not start any threads (e.g. when more files are loaded in parallel)
+
+	/// Only what is needed to decompile the file (sections, symbols, imports,
+	/// exports, non-decodable ranges, ...).
+	DECOMPILATION     = NO_FILE_HASHES | NO_VERBOSE_HASHES | LAZY_COMPONENTS,
+	/// Quick identification of the file (format, architecture, compiler,
+	/// packer, ...).
+	TRIAGE            = NO_VERBOSE_HASHES | LAZY_COMPONENTS
+};
+
+/**
+ * Components of a file that can be loaded on their first access
+ * (see LoadFlags::LAZY_COMPONENTS)
+ */
+enum class LazyComponent
+{
+	RESOURCES,
+	CERTIFICATES,
+	DOTNET_HEADERS,
+	VISUAL_BASIC_HEADER
 };
 
 } // namespace fileformat
@@ -8,11 +8,17 @@
 #define RETDEC_FILEFORMAT_FILE_FORMAT_FILE_FORMAT_H
 
 #include <fstream>
+#include <functional>
 #include <initializer_list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+
 #include "retdec/utils/byte_value_storage.h"
 #include "retdec/utils/value.h"
 #include "retdec/utils/non_copyable.h"
@@ -42,18 +48,29 @@ struct LoaderErrorInfo
 class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils::NonCopyable
 {
 	private:
-		byte_array_buffer auxBuff;               ///< auxiliary input buffer
-		std::ifstream auxFStream;                ///< auxiliary input file stream
-		std::istream auxIStream;                 ///< auxiliary input stream
-		std::vector<unsigned char> *loadedBytes; ///< reference to serialized content of input file
-		LoadFlags loadFlags;                     ///< load flags for configurable file loading
+		byte_array_buffer auxBuff;                      ///< auxiliary input buffer
+		std::ifstream auxFStream;                       ///< auxiliary input file stream
+		std::istream auxIStream;                        ///< auxiliary input stream
+		std::istream &inputStream;                      ///< stream from which content of input file is read
+		std::unique_ptr<byte_array_buffer> bytesBuff;   ///< buffer over loaded content of input file
+		std::vector<unsigned char> *loadedBytes;        ///< reference to serialized content of input file
+		std::unique_ptr<llvm::MemoryBuffer> mappedFile; ///< read-only mapping of input file
+		LoadFlags loadFlags;                            ///< load flags for configurable file loading
+		mutable std::map<LazyComponent, std::function<void()>> lazyLoaders; ///< loaders of components that are not loaded yet
+		mutable std::recursive_mutex lazyLoadersMutex;  ///< mutex for loading of lazy components
 
 		/// @name Initialization methods
 		/// @{
 		void init();
+		bool initMappedFile();
 		void initStream();
 		/// @}
 
+		/// @name Hashing methods
+		/// @{
+		void computeSecSegHashes();
+		/// @}
+
 		/// @name Pure virtual initialization methods
 		/// @{
 		virtual std::size_t initSectionTableHashOffsets() = 0;
@@ -66,13 +83,13 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		std::string sectionMd5;                                           ///< MD5 of section table
 		std::string sectionSha256;                                        ///< SHA256 of section table
 		std::string filePath;                                             ///< name of input file
-		std::istream &fileStream;                                         ///< stream representation of input file
+		std::istream fileStream;                                          ///< stream over content of input file (no I/O, shared with parsers)
 		std::vector<Section*> sections;                                   ///< file sections
 		std::vector<Segment*> segments;                                   ///< file segments
 		std::vector<SymbolTable*> symbolTables;                           ///< symbol tables
 		std::vector<RelocationTable*> relocationTables;                   ///< relocation tables
 		std::vector<DynamicTable*> dynamicTables;                         ///< tables with dynamic records
-		std::vector<unsigned char> bytes;                                 ///< content of file as bytes
+		std::vector<unsigned char> bytes;                                 ///< content of file as bytes (empty if file is mapped)
 		std::vector<String> strings;                                      ///< detected strings
 		std::vector<ElfNoteSecSeg> noteSecSegs;                           ///< note sections or segemnts found in ELF file
 		std::set<std::uint64_t> unknownRelocs;                            ///< unknown relocations
@@ -107,6 +124,12 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		void setLoadedBytes(std::vector<unsigned char> *lBytes);
 		/// @}
 
+		/// @name Lazy loading methods
+		/// @{
+		void loadComponent(LazyComponent component, std::function<void()> loader);
+		void loadLazyComponent(LazyComponent component) const;
+		/// @}
+
 	public:
 		FileFormat(std::string pathToFile, LoadFlags loadFlags = LoadFlags::NONE);
 		FileFormat(std::istream &inputStream, LoadFlags loadFlags = LoadFlags::NONE);
@@ -122,12 +145,12 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 				retdec::utils::Address entryPoint = retdec::utils::Address::getUndef,
 				retdec::utils::Address sectionVMA = retdec::utils::Address::getUndef);
 		void loadStrings();
-		void loadStrings(StringType type, std::size_t charSize);
-		void loadStrings(StringType type, std::size_t charSize, const SecSeg* secSeg);
+		void loadStrings(const SecSeg* secSeg);
 		void loadImpHash();
 		void loadExpHash();
 		void loadResourceIconHash();
 		bool isInValidState() const;
+		bool isMemoryMapped() const;
 		LoadFlags getLoadFlags() const;
 		/// @}
 
@@ -258,8 +281,8 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		const std::vector<SymbolTable*>& getSymbolTables() const;
 		const std::vector<RelocationTable*>& getRelocationTables() const;
 		const std::vector<DynamicTable*>& getDynamicTables() const;
-		const std::vector<unsigned char>& getBytes() const;
-		const std::vector<unsigned char>& getLoadedBytes() const;
+		llvm::ArrayRef<unsigned char> getBytes() const;
+		llvm::ArrayRef<unsigned char> getLoadedBytes() const;
 		const unsigned char* getBytesData() const;
 		const unsigned char* getLoadedBytesData() const;
 		const std::vector<String>& getStrings() const;
@@ -51,6 +51,7 @@ class PeFormat : public FileFormat
 		/// @{
 		void initLoaderErrorInfo();
 		void initStructures();
+		bool readLazyDirectory(const std::function<void()> &read);
 		/// @}
 
 		/// @name Virtual initialization methods
@@ -13,6 +13,13 @@
 #include <llvm/ADT/StringRef.h>
 
 namespace retdec {
+
+namespace crypto {
+
+struct Hashes;
+
+} // namespace crypto
+
 namespace fileformat {
 
 class FileFormat;
@@ -53,8 +60,6 @@ class SecSeg
 		bool isInMemory;                  ///< @c true if the section or segment will appear in the memory image of a process
 		bool loaded;                      ///< @c true if content of section or segment was successfully loaded from input file
 		bool isEntropyValid;              ///< @c true if entropy has been computed
-
-		void computeHashes();
 	public:
 		SecSeg();
 		virtual ~SecSeg() = 0;
@@ -121,6 +126,7 @@ class SecSeg
 		void setSizeInMemory(unsigned long long sMemorySize);
 		void setSizeOfOneEntry(unsigned long long sEntrySize);
 		void setMemory(bool sMemory);
+		void setHashes(const retdec::crypto::Hashes &sHashes);
 		/// @}
 
 		/// @name Other methods
@@ -25,10 +25,21 @@ class String
 		std::uint64_t fileOffset;
 		std::string sectionName;
 		std::string content;
+
+		static std::string extractContent(const char* data, std::size_t length, std::size_t charStep);
 	public:
 		template <typename SectionNameT, typename ContentT>
 		String(StringType type, std::uint64_t fileOffset, SectionNameT&& sectionName, ContentT&& content)
 			: type(type), fileOffset(fileOffset), sectionName(std::forward<SectionNameT>(sectionName)), content(std::forward<ContentT>(content)) {}
+		/**
+		 * Content is made of @a length characters of @a data which are
+		 * @a charStep bytes apart. It is copied right away, so @a data
+		 * does not have to outlive the string.
+		 */
+		template <typename SectionNameT>
+		String(StringType type, std::uint64_t fileOffset, SectionNameT&& sectionName, const char* data, std::size_t length, std::size_t charStep)
+			: type(type), fileOffset(fileOffset), sectionName(std::forward<SectionNameT>(sectionName)),
+			content(extractContent(data, length, charStep)) {}
 		String(const String&) = default;
 		String(String&&) noexcept = default;
 		~String() = default;
@@ -0,0 +1,58 @@
+/**
+ * @file include/retdec/fileformat/types/strings/string_scanner.h
+ * @brief Class for finding of strings in data.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_FILEFORMAT_TYPES_STRINGS_STRING_SCANNER_H
+#define RETDEC_FILEFORMAT_TYPES_STRINGS_STRING_SCANNER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "retdec/fileformat/types/strings/character_iterator.h"
+
+namespace retdec {
+namespace fileformat {
+
+/**
+ * Run of printable characters found by StringScanner
+ */
+struct StringRun
+{
+	std::size_t offset; ///< offset of the first byte of the run in data
+	std::size_t length; ///< number of characters in the run
+};
+
+/**
+ * Finds runs of printable ASCII characters in data. Characters are either
+ * single bytes (ASCII strings) or pairs of bytes where one of them is
+ * printable and the other is zero (wide strings).
+ *
+ * Every byte of data is classified only once when the scanner is created,
+ * by SIMD instructions if the processor supports them. Strings of both
+ * types are then found in the results of the classification.
+ */
+class StringScanner
+{
+	private:
+		std::size_t size;                  ///< size of scanned data
+		std::vector<std::uint64_t> printable; ///< bit @c i is set if byte @c i is printable
+		std::vector<std::uint64_t> zero;      ///< bit @c i is set if byte @c i is zero
+
+		std::size_t findSet(const std::vector<std::uint64_t> &bits, std::size_t start, std::uint64_t mask) const;
+		std::size_t findClear(const std::vector<std::uint64_t> &bits, std::size_t start, std::uint64_t mask) const;
+	public:
+		StringScanner(const std::uint8_t *data, std::size_t size);
+
+		/// @name Searching methods
+		/// @{
+		std::vector<StringRun> findAsciiRuns(std::size_t minLength) const;
+		std::vector<StringRun> findWideRuns(std::size_t minLength, CharacterEndianness endian) const;
+		/// @}
+};
+
+} // namespace fileformat
+} // namespace retdec
+
+#endif
@@ -7,17 +7,20 @@
 #ifndef RETDEC_FILEFORMAT_UTILS_BYTE_ARRAY_BUFFER_H
 #define RETDEC_FILEFORMAT_UTILS_BYTE_ARRAY_BUFFER_H
 
+#include <cstdint>
 #include <streambuf>
 
 namespace retdec {
 namespace fileformat {
 
 /**
- * Example 2 from:
- * "A beginner's guide to writing a custom stream buffer (std::streambuf)"
- * Links:
- * http://www.voidcn.com/article/p-vjnlygmc-gy.html
- * https://stackoverflow.com/a/31597630
+ * Read-only stream buffer over an array of bytes which is not owned by it.
+ *
+ * The whole array is exposed as the get area of the buffer, so reads of
+ * multiple bytes are done by a single copy and seeks only move the read
+ * position. It is used to parse an input file which is already in memory
+ * by parsers that need @c std::istream (e.g. PeLib, ELFIO) without reading
+ * the file once again.
  */
 class byte_array_buffer : public std::streambuf
 {
@@ -26,27 +29,21 @@ class byte_array_buffer : public std::streambuf
 		byte_array_buffer(const std::uint8_t* data, const std::size_t size);
 
 	private:
-		int_type underflow();
-		int_type uflow();
-		int_type pbackfail(int_type ch);
-		std::streamsize showmanyc();
+		int_type underflow() override;
+		int_type pbackfail(int_type ch) override;
+		std::streamsize showmanyc() override;
 
 		std::streampos seekoff(
 				std::streamoff off,
 				std::ios_base::seekdir way,
-				std::ios_base::openmode which = std::ios_base::in | std::ios_base::out);
+				std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
 		std::streampos seekpos(std::streampos sp,
-				std::ios_base::openmode which = std::ios_base::in | std::ios_base::out);
+				std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
 
 		// copy ctor and assignment not implemented;
 		// copying not allowed
 		byte_array_buffer(const byte_array_buffer &);
 		byte_array_buffer &operator= (const byte_array_buffer &);
-
-	private:
-		const std::uint8_t* const begin_ = nullptr;
-		const std::uint8_t* const end_ = nullptr;
-		const std::uint8_t* current_ = nullptr;
 };
 
 } // namespace fileformat
@@ -207,7 +207,9 @@ private:
 * analysis will know that they have to validate the analysis before using it.
 * Upon calling clearCache(), the analysis gets validated automatically. If you
 * modify or remove a statement and call removeFromCache(), then you do not have
-* to call invalidate().
+* to call invalidate(). Similarly, if you modify only a few functions, you may
+* call removeFuncFromCache() for each of them instead of invalidating the
+* cached results of the whole module.
 */
 class ValueAnalysis: private OrderedAllVisitor,
 	private retdec::utils::NonCopyable, public ValidState,
@@ -223,11 +225,13 @@ public:
 	/// @{
 	void clearCache();
 	void removeFromCache(ShPtr<Value> value, bool recursive = true);
+	void removeFuncFromCache(ShPtr<Function> func);
 	/// @}
 
 	/// @name Access To Alias Analysis
 	/// @{
 	void initAliasAnalysis(ShPtr<Module> module);
+	ShPtr<AliasAnalysis> getAliasAnalysis() const;
 	const VarSet &mayPointTo(ShPtr<Variable> var) const;
 	ShPtr<Variable> pointsTo(ShPtr<Variable> var) const;
 	bool mayBePointed(ShPtr<Variable> var) const;
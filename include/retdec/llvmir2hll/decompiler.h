@@ -0,0 +1,205 @@
+/**
+* @file include/retdec/llvmir2hll/decompiler.h
+* @brief Conversion of an LLVM module into the target high-level language.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_DECOMPILER_H
+#define RETDEC_LLVMIR2HLL_DECOMPILER_H
+
+#include <string>
+
+#include <llvm/Pass.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "retdec/llvmir2hll/pattern/pattern_finder_runner.h"
+#include "retdec/llvmir2hll/support/smart_ptr.h"
+#include "retdec/llvmir2hll/support/types.h"
+
+namespace retdec {
+
+namespace config {
+class Config;
+} // namespace config
+
+namespace llvmir2hll {
+
+class AliasAnalysis;
+class ArithmExprEvaluator;
+class CallInfoObtainer;
+class Config;
+class HLLWriter;
+class Module;
+class Semantics;
+class VarNameGen;
+class VarRenamer;
+
+/**
+* @brief Options of the decompilation.
+*
+* Default values are the same as the defaults of the corresponding
+* llvmir2hll command-line parameters.
+*/
+struct DecompilerOptions {
+	/// Name of the target HLL.
+	std::string targetHll = "c";
+	/// Emission of debugging messages (e.g. the current phase).
+	bool debug = false;
+	/// The used semantics in the form 'sem1,sem2,...'.
+	std::string semantics;
+	/// Path to the configuration file.
+	std::string configPath;
+	/// Base name of the files with emitted CFGs and CG.
+	std::string outputFile;
+	bool emitDebugComments = false;
+	std::string enabledOpts;
+	std::string disabledOpts;
+	bool noOpts = false;
+	bool aggressiveOpts = false;
+	bool noVarRenaming = false;
+	bool noSymbolicNames = false;
+	bool keepAllBrackets = false;
+	bool keepLibraryFunctions = false;
+	bool noTimeVaryingInfo = false;
+	bool noCompoundOperators = false;
+	bool validateModule = false;
+	std::string findPatterns;
+	std::string aliasAnalysis = "simple";
+	std::string varNameGen = "fruit";
+	std::string varNameGenPrefix;
+	std::string varRenamer = "readable";
+	bool emitCFGs = false;
+	std::string cfgWriter = "dot";
+	bool emitCG = false;
+	std::string cgWriter = "dot";
+	std::string callInfoObtainer = "optim";
+	std::string arithmExprEvaluator = "c";
+	std::string forcedModuleName;
+	bool strictFPUSemantics = false;
+	/// Number of threads optimizing functions in parallel (0 = the number
+	/// of available CPUs).
+	unsigned optimizerThreads = 0;
+};
+
+/**
+* @brief This class is the main chunk of code that converts an LLVM
+*        module to the specified high-level language (HLL).
+*
+* The decompilation is composed of the following steps:
+* 1) Decompiler is instantiated with the output stream, where the target
+*    code will be emitted, and with the decompilation options.
+* 2) The function runOnModule() is called, which decompiles the given
+*    LLVM IR into BIR (backend IR).
+* 3) The resulting IR is then converted into the requested HLL at the end of
+*    runOnModule().
+*
+* The config is either loaded from (and saved to) @c configPath or, when
+* a config object is given to the constructor, it is used directly and
+* updated in place, without any JSON round-trip.
+*
+* The pass requires @c LoopInfoWrapperPass and @c ScalarEvolutionWrapperPass.
+*/
+class Decompiler: public llvm::ModulePass {
+public:
+	Decompiler(llvm::raw_pwrite_stream &out,
+		const DecompilerOptions &options,
+		retdec::config::Config *config = nullptr);
+
+	virtual llvm::StringRef getPassName() const override { return "Decompiler"; }
+	virtual bool runOnModule(llvm::Module &m) override;
+
+	bool wasSuccessful() const;
+
+public:
+	/// Class identification.
+	static char ID;
+
+private:
+	virtual void getAnalysisUsage(llvm::AnalysisUsage &au) const override;
+
+	void startPhase(const std::string &phaseName);
+	bool initialize(llvm::Module &m);
+	void createSemantics();
+	void createSemanticsFromParameter();
+	void createSemanticsFromLLVMIR();
+	bool loadConfig();
+	void saveConfig();
+	bool convertLLVMIRToBIR();
+	void removeLibraryFuncs();
+	void removeCodeUnreachableInCFG();
+	void removeFuncsPrefixedWith(const StringSet &prefixes);
+	void fixSignedUnsignedTypes();
+	void convertLLVMIntrinsicFunctions();
+	void obtainDebugInfo();
+	void initAliasAnalysis();
+	void runOptimizations();
+	void renameVariables();
+	void convertConstantsToSymbolicNames();
+	void validateResultingModule();
+	void findPatterns();
+	void emitCFGs();
+	void emitCG();
+	void emitTargetHLLCode();
+	void finalize();
+	void cleanup();
+
+	StringSet parseListOfOpts(const std::string &opts) const;
+	std::string getTypeOfRunOptimizations() const;
+	unsigned getNumOfOptimizerThreads() const;
+	StringVector getIdsOfPatternFindersToBeRun() const;
+	PatternFinderRunner::PatternFinders instantiatePatternFinders(
+		const StringVector &pfsIds);
+	ShPtr<PatternFinderRunner> instantiatePatternFinderRunner() const;
+	StringSet getPrefixesOfFuncsToBeRemoved() const;
+
+private:
+	/// Output stream into which the generated code will be emitted.
+	llvm::raw_pwrite_stream &out;
+
+	/// Decompilation options.
+	DecompilerOptions options;
+
+	/// In-memory config given by the user (if any).
+	retdec::config::Config *inMemoryConfig;
+
+	/// Has the decompilation finished successfully?
+	bool successful;
+
+	/// The input LLVM module.
+	llvm::Module *llvmModule;
+
+	/// The resulting module in BIR.
+	ShPtr<Module> resModule;
+
+	/// The used semantics.
+	ShPtr<Semantics> semantics;
+
+	/// The used config.
+	ShPtr<Config> config;
+
+	/// The used HLL writer.
+	ShPtr<HLLWriter> hllWriter;
+
+	/// The used alias analysis.
+	ShPtr<AliasAnalysis> aliasAnalysis;
+
+	/// The used obtainer of information about function and function calls.
+	ShPtr<CallInfoObtainer> cio;
+
+	/// The used evaluator of arithmetical expressions.
+	ShPtr<ArithmExprEvaluator> arithmExprEvaluator;
+
+	/// The used generator of variable names.
+	ShPtr<VarNameGen> varNameGen;
+
+	/// The used renamer of variables.
+	ShPtr<VarRenamer> varRenamer;
+
+	/// Level of the profiled phases of the decompilation.
+	unsigned profilerLevel;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
@@ -0,0 +1,86 @@
+/**
+* @file include/retdec/llvmir2hll/decompiler_command_line.h
+* @brief Command-line options of the conversion into the target high-level
+*        language.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_DECOMPILER_COMMAND_LINE_H
+#define RETDEC_LLVMIR2HLL_DECOMPILER_COMMAND_LINE_H
+
+#include <list>
+#include <string>
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/CommandLine.h>
+
+#include "retdec/llvmir2hll/decompiler.h"
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+/**
+* @brief Command-line options from which DecompilerOptions are created.
+*
+* The options are registered into the LLVM command-line parser when an
+* instance is created, so tools create it as a global object. Names of all
+* the options are prefixed with the given prefix, which allows a tool to have
+* them together with its own options of the same names (e.g. @c -backend-
+* in bin2llvmir).
+*
+* The path to the config and the output file are not included because every
+* tool gets them in its own way.
+*/
+class DecompilerCommandLine: private retdec::utils::NonCopyable {
+public:
+	DecompilerCommandLine(const std::string &prefix,
+		llvm::cl::OptionCategory &category, bool targetHllRequired = false);
+
+	DecompilerOptions getOptions() const;
+
+private:
+	llvm::StringRef name(const std::string &option);
+
+private:
+	/// Prefix of the names of all the options.
+	std::string prefix;
+
+	/// Prefixed names of the options (they have to outlive the options).
+	std::list<std::string> names;
+
+	llvm::cl::opt<std::string> targetHll;
+	llvm::cl::opt<bool> debug;
+	llvm::cl::opt<std::string> semantics;
+	llvm::cl::opt<bool> emitDebugComments;
+	llvm::cl::opt<std::string> enabledOpts;
+	llvm::cl::opt<std::string> disabledOpts;
+	llvm::cl::opt<bool> noOpts;
+	llvm::cl::opt<bool> aggressiveOpts;
+	llvm::cl::opt<bool> noVarRenaming;
+	llvm::cl::opt<bool> noSymbolicNames;
+	llvm::cl::opt<bool> keepAllBrackets;
+	llvm::cl::opt<bool> keepLibraryFunctions;
+	llvm::cl::opt<bool> noTimeVaryingInfo;
+	llvm::cl::opt<bool> noCompoundOperators;
+	llvm::cl::opt<bool> validateModule;
+	llvm::cl::opt<std::string> findPatterns;
+	llvm::cl::opt<std::string> aliasAnalysis;
+	llvm::cl::opt<std::string> varNameGen;
+	llvm::cl::opt<std::string> varNameGenPrefix;
+	llvm::cl::opt<std::string> varRenamer;
+	llvm::cl::opt<bool> emitCFGs;
+	llvm::cl::opt<std::string> cfgWriter;
+	llvm::cl::opt<bool> emitCG;
+	llvm::cl::opt<std::string> cgWriter;
+	llvm::cl::opt<std::string> callInfoObtainer;
+	llvm::cl::opt<std::string> arithmExprEvaluator;
+	llvm::cl::opt<std::string> forcedModuleName;
+	llvm::cl::opt<bool> strictFPUSemantics;
+	llvm::cl::opt<unsigned> optimizerThreads;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
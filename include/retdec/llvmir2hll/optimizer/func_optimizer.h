@@ -45,6 +45,10 @@ class FuncOptimizer: public Optimizer {
 public:
 	virtual ~FuncOptimizer() override;
 
+	void initFuncsOptimization();
+	void optimizeFunc(ShPtr<Function> func);
+	void finishFuncsOptimization();
+
 protected:
 	FuncOptimizer(ShPtr<Module> module);
 
@@ -7,6 +7,10 @@
 #ifndef RETDEC_LLVMIR2HLL_OPTIMIZER_OPTIMIZER_MANAGER_H
 #define RETDEC_LLVMIR2HLL_OPTIMIZER_OPTIMIZER_MANAGER_H
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "retdec/llvmir2hll/optimizer/optimizer.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/support/types.h"
@@ -18,6 +22,7 @@ namespace llvmir2hll {
 
 class ArithmExprEvaluator;
 class CallInfoObtainer;
+class FuncOptimizer;
 class HLLWriter;
 class Module;
 class ValueAnalysis;
@@ -25,6 +30,11 @@ class ValueAnalysis;
 /**
 * @brief A manager managing optimizations.
 *
+* Optimizations that work only with the function they optimize may be run on
+* several functions in parallel (see the @c numThreads parameter of the
+* constructor). The other optimizations, which work with the whole module,
+* are always run alone.
+*
 * Instances of this class have reference object semantics. This class is not
 * meant to be subclassed.
 */
@@ -33,19 +43,44 @@ public:
 	OptimizerManager(const StringSet &enabledOpts, const StringSet &disabledOpts,
 		ShPtr<HLLWriter> hllWriter, ShPtr<ValueAnalysis> va,
 		ShPtr<CallInfoObtainer> cio, ShPtr<ArithmExprEvaluator> arithmExprEvaluator,
-		bool enableAggressiveOpts, bool enableDebug = false);
+		bool enableAggressiveOpts, bool enableDebug = false,
+		unsigned numThreads = 1);
 	~OptimizerManager();
 
 	void optimize(ShPtr<Module> m);
 
+private:
+	/// Analyses with an internal state owned by one optimizing thread.
+	struct ThreadAnalyses {
+		ShPtr<ValueAnalysis> va;
+		ShPtr<ArithmExprEvaluator> arithmExprEvaluator;
+	};
+
+	/// Function optimization waiting to be run on all functions.
+	struct QueuedFuncOptimizer {
+		/// ID of the optimization.
+		std::string id;
+		/// Instance doing the module-wide work before and after the
+		/// functions are optimized.
+		ShPtr<FuncOptimizer> optimizer;
+		/// Creates an instance of the optimizer for one thread.
+		std::function<ShPtr<FuncOptimizer>(const ThreadAnalyses &)> create;
+	};
+
 private:
 	void printOptimization(const std::string &optName) const;
+	void profileOptimization(const std::string &phaseName) const;
+	void printCacheStatistics() const;
 	bool optShouldBeRun(const std::string &optName) const;
 	void runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer);
 	bool shouldSecondCopyPropagationBeRun() const;
 
 	template<typename Optimization, typename... Args>
 	void run(ShPtr<Module> m, Args &&... args);
+	template<typename Optimization, typename... Args>
+	void runOnFuncs(ShPtr<Module> m, Args &&... args);
+	void runQueuedFuncOptimizers(ShPtr<Module> m);
+	ThreadAnalyses createThreadAnalyses() const;
 
 private:
 	/// No other optimization than these will be run.
@@ -77,6 +112,15 @@ private:
 
 	/// List of our optimizations that were run.
 	StringSet backendRunOpts;
+
+	/// Number of threads optimizing functions in parallel.
+	unsigned numThreads;
+
+	/// Function optimizations waiting to be run in parallel.
+	std::vector<QueuedFuncOptimizer> queuedFuncOpts;
+
+	/// Level of the profiled optimizations.
+	unsigned profilerLevel;
 };
 
 } // namespace llvmir2hll
@@ -20,13 +20,14 @@ class ArithmExprEvaluator;
 * @brief Optimizer that optimizes expressions to a simpler form.
 *
 * The optimizer utilizes many sub-optimizers. They are in the @c
-* simplify_arithm_expr sub-directory.
+* simplify_arithm_expr sub-directory. Initializers of global variables are
+* optimized in doInitialization(), functions in runOnFunction().
 *
 * Instances of this class have reference object semantics.
 *
 * This is a concrete optimizer which should not be subclassed.
 */
-class SimplifyArithmExprOptimizer final: public Optimizer {
+class SimplifyArithmExprOptimizer final: public FuncOptimizer {
 public:
 	SimplifyArithmExprOptimizer(ShPtr<Module> module,
 		ShPtr<ArithmExprEvaluator> arithmExprEvaluator);
@@ -36,7 +37,8 @@ public:
 	virtual std::string getId() const override { return "SimplifyArithmExpr"; }
 
 private:
-	virtual void doOptimization() override;
+	virtual void doInitialization() override;
+	virtual void runOnFunction(ShPtr<Function> func) override;
 
 	/// @name Visitor Interface
 	/// @{
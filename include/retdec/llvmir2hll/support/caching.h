@@ -7,6 +7,7 @@
 #ifndef RETDEC_LLVMIR2HLL_SUPPORT_CACHING_H
 #define RETDEC_LLVMIR2HLL_SUPPORT_CACHING_H
 
+#include <cstddef>
 #include <unordered_map>
 
 namespace retdec {
@@ -89,6 +90,16 @@ public:
 		cache.erase(key);
 	}
 
+	/**
+	* @brief Returns @c true if there is a cached result for @a key, @c false
+	*        otherwise.
+	*
+	* Unlike getCachedResult(), it is not counted as a cache hit or miss.
+	*/
+	bool isInCache(const CachedKey &key) const {
+		return cache.find(key) != cache.end();
+	}
+
 	/**
 	* @brief Returns @c true if caching is enabled, @c false otherwise.
 	*/
@@ -96,6 +107,24 @@ public:
 		return cachingEnabled;
 	}
 
+	/**
+	* @brief Returns the number of lookups that found a cached result.
+	*
+	* Only lookups done while caching is enabled are counted.
+	*/
+	std::size_t getNumOfCacheHits() const {
+		return numOfHits;
+	}
+
+	/**
+	* @brief Returns the number of lookups that did not find a cached result.
+	*
+	* Only lookups done while caching is enabled are counted.
+	*/
+	std::size_t getNumOfCacheMisses() const {
+		return numOfMisses;
+	}
+
 protected:
 	/**
 	* @brief If caching is enabled, associates the given @a value with @a key.
@@ -120,8 +149,10 @@ protected:
 			auto it = cache.find(key);
 			if (it != cache.end()) {
 				value = it->second;
+				++numOfHits;
 				return true;
 			}
+			++numOfMisses;
 		}
 		return false;
 	}
@@ -141,6 +172,12 @@ private:
 
 	/// Cache for storing cached results.
 	Cache cache;
+
+	/// Number of lookups that found a cached result.
+	mutable std::size_t numOfHits = 0;
+
+	/// Number of lookups that did not find a cached result.
+	mutable std::size_t numOfMisses = 0;
 };
 
 } // namespace llvmir2hll
@@ -106,7 +106,8 @@ ShPtr<To> ucast(const ShPtr<From> &ptr) noexcept {
 */
 template<typename To, typename From>
 bool isa(const ShPtr<From> &ptr) noexcept {
-	return cast<To>(ptr) != nullptr;
+	// Check the raw pointer so that no reference count is changed.
+	return dynamic_cast<To *>(ptr.get()) != nullptr;
 }
 
 /**
@@ -8,6 +8,7 @@
 #define RETDEC_LLVMIR2HLL_SUPPORT_SUBJECT_H
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 
 #include "retdec/llvmir2hll/support/smart_ptr.h"
@@ -37,6 +38,11 @@ namespace llvmir2hll {
 * };
 * @endcode
 *
+* Adding, removing, and notifying observers is thread-safe because values
+* shared by several functions (e.g. global variables) are observed by
+* expressions from all of them, and functions may be optimized in parallel.
+* Observers themselves are notified without any locking.
+*
 * @see Observer
 */
 template<typename SubjectType, typename ArgType = SubjectType>
@@ -89,6 +95,7 @@ public:
 	* @param[in] observer Observer to be added.
 	*/
 	void addObserver(ObserverPtr observer) {
+		ObserversGuard guard(*this);
 		observers.push_back(observer);
 	}
 
@@ -105,6 +112,7 @@ public:
 	* @brief Removes all observers.
 	*/
 	void removeObservers() {
+		ObserversGuard guard(*this);
 		observers.clear();
 	}
 
@@ -125,7 +133,7 @@ public:
 	void notifyObservers(ShPtr<ArgType> arg = nullptr) {
 		// We have to iterate over a copy of the container because it can be
 		// modified during the iteration (either by us or in an update() call).
-		for (const auto &observer : ObserverContainer(observers)) {
+		for (const auto &observer : getObserversCopy()) {
 			notifyObserverOrRemoveItIfNotExists(observer, arg);
 		}
 	}
@@ -142,6 +150,9 @@ protected:
 protected:
 	/**
 	* @brief Returns a constant iterator to the first observer.
+	*
+	* The iteration is not guarded, so use it only on subjects that are not
+	* shared among functions.
 	*/
 	observer_iterator observer_begin() const {
 		return observers.begin();
@@ -155,6 +166,35 @@ protected:
 	}
 
 private:
+	/**
+	* @brief Locks the observers of a subject for the current scope.
+	*
+	* A spin lock is used because there is one in every subject and it is
+	* held only for a short time.
+	*/
+	class ObserversGuard {
+	public:
+		explicit ObserversGuard(const Subject &subject):
+			lock(subject.observersLock) {
+				while (lock.test_and_set(std::memory_order_acquire)) {}
+			}
+
+		~ObserversGuard() {
+			lock.clear(std::memory_order_release);
+		}
+
+	private:
+		std::atomic_flag &lock;
+	};
+
+private:
+	/**
+	* @brief Returns a copy of the current observers.
+	*/
+	ObserverContainer getObserversCopy() const {
+		ObserversGuard guard(*this);
+		return observers;
+	}
 
 	/**
 	* @brief Notifies the given observer (if it exists) or removes it (if it
@@ -189,16 +229,20 @@ private:
 	* @brief Removes the given observer and all the non-existing observers.
 	*/
 	void removeObserverAndNonExistingObservers(ObserverPtr observer) {
+		ObserversGuard guard(*this);
 		observers.erase(std::remove_if(observers.begin(), observers.end(),
 			[&observer](const auto &other) {
 				return other.expired() || observer.lock() == other.lock();
 			}
-		));
+		), observers.end());
 	}
 
 private:
 	/// Container to store observers.
 	ObserverContainer observers;
+
+	/// Lock of @c observers.
+	mutable std::atomic_flag observersLock = ATOMIC_FLAG_INIT;
 };
 
 } // namespace llvmir2hll
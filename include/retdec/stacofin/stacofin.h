@@ -17,6 +17,7 @@
 #include "retdec/config/config.h"
 #include "retdec/fileformat/fileformat.h"
 #include "retdec/utils/address.h"
+#include "retdec/yara-cache/yara_cache.h"
 
 namespace retdec {
 namespace loader {
@@ -162,6 +163,11 @@ class Finder
 		using ByteData = typename std::pair<const std::uint8_t*, std::size_t>;
 
 	private:
+		void collectDetections(
+				const retdec::fileformat::FileFormat& fileFormat,
+				const std::vector<yara_cache::MatchedRule>& matched,
+				const std::string& yaraFile);
+
 		bool initDisassembler();
 		void solveReferences();
 
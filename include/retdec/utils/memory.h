@@ -16,6 +16,10 @@ std::size_t getTotalSystemMemory();
 bool limitSystemMemory(std::size_t limit);
 bool limitSystemMemoryToHalfOfTotalSystemMemory();
 
+std::size_t getCurrentMemoryUsage();
+std::size_t getPeakMemoryUsage();
+bool resetPeakMemoryUsage();
+
 } // namespace utils
 } // namespace retdec
 
@@ -0,0 +1,145 @@
+/**
+* @file include/retdec/utils/profiler.h
+* @brief Recording of time and memory spent in phases of a program.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_PROFILER_H
+#define RETDEC_UTILS_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Records wall time, CPU time, memory usage, and sizes of the processed
+*        code for phases of a program.
+*
+* Phases form a tree given by their levels (@c 0 is the top level). Starting
+* a phase ends all running phases on the same or a deeper level, so a phase
+* can be recorded at the place where it is announced (e.g. together with
+* @c printPhase()), without a matching end call.
+*
+* Sizes of the processed code (e.g. the number of instructions) are obtained
+* from a getter set by the program at the start and at the end of every phase.
+*
+* Memory usage is the resident set size of the process. When the system allows
+* it, the peak usage is reset at the start of every phase, so the peak of a
+* phase is measured only during the phase (and its sub-phases). Otherwise, only
+* increases of the peak of the whole process are visible. The reset (writing
+* to @c /proc/self/clear_refs on Linux) affects the whole process, so it is
+* done only by enabled profilers.
+*
+* The profiler does nothing until it is enabled, so the recording calls can be
+* left in the code. Callers check isEnabled() before other calls to avoid any
+* work when profiling is off.
+*
+* All methods can be called from several threads. Phases recorded from several
+* threads at once (e.g. when several modules are decompiled in parallel) are
+* interleaved, so their levels are meaningful only when one thread records.
+*/
+class Profiler: private NonCopyable {
+public:
+	/// Named sizes of the processed code.
+	using Sizes = std::vector<std::pair<std::string, std::size_t>>;
+	/// Getter of the sizes of the processed code.
+	using SizesGetter = std::function<Sizes ()>;
+
+	/**
+	* @brief A recorded phase.
+	*
+	* Times are in seconds, memory sizes in bytes.
+	*/
+	struct Phase {
+		std::string name;
+		std::string category;
+		unsigned level = 0;
+		/// Wall-clock time of the start since the profiler was enabled.
+		double start = 0.0;
+		double wallTime = 0.0;
+		double cpuTime = 0.0;
+		std::size_t memoryStart = 0;
+		std::size_t memoryEnd = 0;
+		/// Increase of the peak memory usage during the phase.
+		std::size_t peakMemoryDelta = 0;
+		Sizes sizesStart;
+		Sizes sizesEnd;
+	};
+
+public:
+	Profiler();
+
+	static Profiler &getInstance();
+
+	void enable();
+	bool isEnabled() const;
+
+	void setSizesGetter(SizesGetter getter);
+	SizesGetter getSizesGetter() const;
+
+	void startPhase(const std::string &name, unsigned level = 0,
+		const std::string &category = std::string());
+	void endPhases(unsigned level = 0);
+	unsigned getNumOfRunningPhases() const;
+
+	std::vector<Phase> getPhases() const;
+	void clear();
+
+	void printJson(std::ostream &out) const;
+	void printChromeTrace(std::ostream &out) const;
+
+private:
+	/// A phase that has not ended yet.
+	struct RunningPhase {
+		/// Index of the phase in @c phases.
+		std::size_t index = 0;
+		double cpuStart = 0.0;
+		std::size_t peakStart = 0;
+		std::size_t peak = 0;
+	};
+
+private:
+	double getWallTime() const;
+	Sizes getSizes() const;
+	void samplePeakMemory();
+	void endPhasesUnlocked(unsigned level);
+	void endLastPhase();
+
+private:
+	/// Is the profiler enabled? It can be checked without locking @c mutex.
+	std::atomic<bool> enabled{false};
+
+	/// Guards all the other members.
+	mutable std::mutex mutex;
+
+	/// Can the peak memory usage be reset at the start of phases?
+	bool peakResettable = false;
+
+	/// The moment when the profiler was enabled.
+	std::chrono::steady_clock::time_point epoch;
+
+	/// Getter of the sizes of the processed code.
+	SizesGetter sizesGetter;
+
+	/// Phases that have not ended yet, from the top level.
+	std::vector<RunningPhase> running;
+
+	/// Recorded phases, in the order of their starts.
+	std::vector<Phase> phases;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
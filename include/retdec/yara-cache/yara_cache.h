@@ -0,0 +1,166 @@
+/**
+ * @file include/retdec/yara-cache/yara_cache.h
+ * @brief Cache of compiled YARA rules.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_YARA_CACHE_YARA_CACHE_H
+#define RETDEC_YARA_CACHE_YARA_CACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace yaracpp {
+	class YaraDetector;
+	class YaraRule;
+} // namespace yaracpp
+
+namespace retdec {
+namespace yara_cache {
+
+/**
+ * Mutex guarding initialization and finalization of the YARA library.
+ *
+ * YARA counts its users in an unsynchronized counter, so construction and
+ * destruction of @c yaracpp::YaraDetector, which (de)initializes the library,
+ * must be done under this lock when more threads use YARA.
+ */
+std::mutex& getLibraryMutex();
+
+/**
+ * Get path to compiled (.yarac) version of the given text rule file.
+ *
+ * Compiled rules are stored next to the source file and their name contains
+ * hash of the namespace and of the content of the source file and all files
+ * it includes, so that outdated rules are never used. Outdated rules are
+ * removed when the new ones are stored. Results are also remembered in
+ * process, so the sources are hashed again only if size or modification time
+ * of any of them changes.
+ *
+ * @return Path to compiled rules, or @c ruleFile itself if the file is
+ *         already compiled or it can not be compiled and stored.
+ */
+std::string getCompiledRuleFile(
+		const std::string& ruleFile,
+		const std::string& nameSpace = std::string());
+
+/**
+ * Check if @p path is a compiled rule file created by this cache.
+ *
+ * Directories with rules also contain the cached files, so code listing
+ * rule files in a directory must skip them to not use the rules twice.
+ */
+bool isCachedRuleFile(const std::string& path);
+
+/**
+ * Add rules from @p ruleFile to @p detector, preferring compiled rules
+ * from the cache over compilation of the text rules.
+ */
+bool addRuleFile(
+		yaracpp::YaraDetector& detector,
+		const std::string& ruleFile,
+		const std::string& nameSpace = std::string());
+
+/**
+ * Rule files together with namespaces into which their rules are added.
+ */
+using RuleFiles = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * Scan @p path with rules from @p ruleFiles.
+ *
+ * Every thread creates one detector for each set of rule files on the first
+ * scan and reuses it in all later scans, so the rules are not loaded again
+ * for every scanned file. Detectors are created and destroyed under
+ * getLibraryMutex(). A detector keeps results of all its scans, so it is
+ * created again once it keeps too many of them. Changes of the rule files
+ * are noticed only then.
+ *
+ * @param ruleFiles Rule files and their namespaces.
+ * @param path File to scan.
+ * @param detected Into this parameter are stored rules matched by this scan.
+ * @param undetected If given, rules not matched by this scan are stored into
+ *        it.
+ *
+ * Stored rules are owned by the detector and they are valid until the next
+ * scan with the same @p ruleFiles in the same thread.
+ */
+void scanFile(
+		const RuleFiles& ruleFiles,
+		const std::string& path,
+		std::vector<const yaracpp::YaraRule*>& detected,
+		std::vector<const yaracpp::YaraRule*>* undetected = nullptr);
+
+/**
+ * Rule matched by CompiledRules::scanMemory().
+ */
+struct MatchedRule
+{
+	/**
+	 * Meta of the rule. String metas have no integer value, integer and
+	 * boolean metas have no string value.
+	 */
+	struct Meta
+	{
+		std::string id;
+		std::string stringValue;
+		long long intValue = 0;
+	};
+
+	std::string name;
+	/// Metas in the order in which they are declared.
+	std::vector<Meta> metas;
+	/// Offsets of all matches of all strings of the rule.
+	std::vector<std::uint64_t> offsets;
+};
+
+/**
+ * Rules from one rule file scanned by the YARA library directly.
+ *
+ * Unlike @c yaracpp::YaraDetector, which scans only files and vectors, the
+ * rules scan any buffer in place. Compiled rules from the cache are used if
+ * possible. The YARA library is (de)initialized under getLibraryMutex().
+ * Rules may be loaded in one thread and scanned in another one.
+ */
+class CompiledRules : private utils::NonCopyable
+{
+	public:
+		explicit CompiledRules(
+				const std::string& ruleFile,
+				const std::string& nameSpace = std::string());
+		~CompiledRules();
+
+		/**
+		 * Check if the rules could be loaded or compiled.
+		 */
+		bool isValid() const;
+
+		/**
+		 * Scan @p size bytes at @p data and store the matched rules, in
+		 * the order in which they were matched, into @p matched.
+		 */
+		bool scanMemory(
+				const std::uint8_t* data,
+				std::size_t size,
+				std::vector<MatchedRule>& matched) const;
+
+	private:
+		/// Rules (@c YR_RULES) or @c nullptr if they could not be loaded.
+		void* rules = nullptr;
+		bool initialized = false;
+};
+
+/**
+ * Forget all rule files remembered in process. Files on disk are kept.
+ */
+void clearCache();
+
+} // namespace yara_cache
+} // namespace retdec
+
+#endif
@@ -42,6 +42,10 @@ parameters beginning with -disable-* may be included only once, which is the
 
  - Optimization -phi2seq is needed to be run at the end and not to run two
  times. This is the reason why it is placed at the very end.
+
+ - LLVM passes are run as a group between -fixpoint-begin and -fixpoint-end.
+ The group is run again (at most -fixpoint-max-iterations times, 2 by default)
+ only if its previous run changed the module.
 """
 BIN2LLVMIR_PARAMS_DISABLES = [
     '-disable-inlining',
@@ -142,7 +146,7 @@ BIN2LLVMIR_PARAMS = [
     '-inst-opt',
     '-x86-addr-spaces',
     '-value-protect',
-] + BIN2LLVMIR_LLVM_PASSES_ONLY + BIN2LLVMIR_LLVM_PASSES_ONLY + [
+] + ['-fixpoint-begin'] + BIN2LLVMIR_LLVM_PASSES_ONLY + ['-fixpoint-end'] + [
     '-inst-opt',
     '-simple-types',
     '-stack-ptr-op-remove',
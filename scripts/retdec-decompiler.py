@@ -114,6 +114,12 @@ def parse_args(args):
                         action='store_true',
                         help='Unifies the labels of all nodes in the emitted CFG (this has to be used in tests).')
 
+    parser.add_argument('--backend-in-process',
+                        dest='backend_in_process',
+                        action='store_true',
+                        help='Run the back-end in the bin2llvmir process. LLVM IR is passed to it in memory,'
+                             ' without an intermediate bitcode file.')
+
     parser.add_argument('--backend-disabled-opts',
                         dest='backend_disabled_opts',
                         help='Prevents the optimizations from the given'
@@ -266,6 +272,11 @@ def parse_args(args):
                         action='store_true',
                         help='Decode only selected parts (functions/ranges). Faster decompilation, but worse results.')
 
+    parser.add_argument('--linear-sweep-prepass',
+                        dest='linear_sweep_prepass',
+                        action='store_true',
+                        help='Disassemble code by linear sweep before decoding. Faster decoding of binaries with a lot of data in code.')
+
     parser.add_argument('--select-functions',
                         dest='selected_functions',
                         metavar='FUNCS',
@@ -312,6 +323,15 @@ def parse_args(args):
                         help='Disables the default memory limit (half of system RAM) of fileinfo, '
                              'unpacker, bin2llvmir, and llvmir2hll.')
 
+    parser.add_argument('--profile',
+                        dest='profile',
+                        nargs='?',
+                        const='json',
+                        choices=['json', 'chrome-trace'],
+                        help='Records time, memory, and IR size for every pass of bin2llvmir and every phase '
+                             'of llvmir2hll into OUTPUT.bin2llvmir.profile.json and '
+                             'OUTPUT.llvmir2hll.profile.json (the default format is json).')
+
     return parser.parse_args(args)
 
 
@@ -322,6 +342,7 @@ class Decompiler:
         self.input_file = ''
         self.output_file = ''
         self.config_file = ''
+        self.binary_config = False
         self.selected_ranges = []
         self.selected_functions = []
         self.signatures_to_remove = []
@@ -540,6 +561,8 @@ class Decompiler:
         """
 
         if self.args.stop_after == tool_name:
+            self._convert_config_to_json()
+
             if self.args.generate_log:
                 self._generate_log()
 
@@ -548,9 +571,86 @@ class Decompiler:
             return True
         return False
 
+    def _get_llvmir2hll_params(self):
+        """Returns the options of the back-end given by the script arguments.
+        The input, output, config, and memory limit are not included.
+        """
+
+        llvmir2hll_params = ['-target-hll=' + self.args.hll, '-var-renamer=' + self.args.backend_var_renamer,
+                             '-var-name-gen=fruit', '-var-name-gen-prefix=',
+                             '-call-info-obtainer=' + self.args.backend_call_info_obtainer,
+                             '-arithm-expr-evaluator=' + self.args.backend_arithm_expr_evaluator, '-validate-module']
+
+        if not self.args.backend_no_debug:
+            llvmir2hll_params.append('-enable-debug')
+
+        if not self.args.backend_no_debug_comments:
+            llvmir2hll_params.append('-emit-debug-comments')
+
+        if self.args.backend_semantics:
+            llvmir2hll_params.extend(['-semantics', self.args.backend_semantics])
+
+        if self.args.backend_enabled_opts:
+            llvmir2hll_params.append('-enabled-opts=' + self.args.backend_enabled_opts)
+
+        if self.args.backend_disabled_opts:
+            llvmir2hll_params.append('-disabled-opts=' + self.args.backend_disabled_opts)
+
+        if self.args.backend_no_opts:
+            llvmir2hll_params.append('-no-opts')
+
+        if self.args.backend_aggressive_opts:
+            llvmir2hll_params.append('-aggressive-opts')
+
+        if self.args.backend_no_var_renaming:
+            llvmir2hll_params.append('-no-var-renaming')
+
+        if self.args.backend_no_symbolic_names:
+            llvmir2hll_params.append('-no-symbolic-names')
+
+        if self.args.backend_keep_all_brackets:
+            llvmir2hll_params.append('-keep-all-brackets')
+
+        if self.args.backend_keep_library_funcs:
+            llvmir2hll_params.append('-keep-library-funcs')
+
+        if self.args.backend_no_time_varying_info:
+            llvmir2hll_params.append('-no-time-varying-info')
+
+        if self.args.backend_no_compound_operators:
+            llvmir2hll_params.append('-no-compound-operators')
+
+        if self.args.backend_find_patterns:
+            llvmir2hll_params.extend(['-find-patterns', self.args.backend_find_patterns])
+
+        if self.args.backend_emit_cg:
+            llvmir2hll_params.append('-emit-cg')
+
+        if self.args.backend_force_module_name:
+            llvmir2hll_params.append('-force-module-name=' + self.args.backend_force_module_name)
+
+        if self.args.backend_strict_fpu_semantics:
+            llvmir2hll_params.append('-strict-fpu-semantics')
+
+        if self.args.backend_emit_cfg:
+            llvmir2hll_params.append('-emit-cfgs')
+
+        return llvmir2hll_params
+
+    def _convert_config_to_json(self):
+        """Converts the config file back to JSON if it is passed between the tools
+        in the binary format.
+        """
+
+        if self.binary_config:
+            CmdRunner.run_cmd([config.CONFIGTOOL, self.config_file, '--convert', 'json'])
+            self.binary_config = False
+
     def _cleanup(self):
         """Cleanup working directory"""
 
+        self._convert_config_to_json()
+
         if self.args.cleanup:
             utils.remove_file_forced(self.out_unpacked)
 
@@ -612,6 +712,14 @@ class Decompiler:
             f.write('\n')
 
     def decompile(self):
+        try:
+            return self._decompile()
+        finally:
+            # The config is converted back to JSON also when the decompilation
+            # fails or is stopped.
+            self._convert_config_to_json()
+
+    def _decompile(self):
         # Check arguments and set default values for unset options.
         if not self._check_arguments():
             return 1
@@ -726,6 +834,17 @@ class Decompiler:
 
                 print('Not an archive, going to the next step.')
 
+        # Run the back-end in the bin2llvmir process (if requested and possible).
+        # The log needs separate runtimes and outputs of bin2llvmir and llvmir2hll,
+        # which are not available when they run in a single process.
+        in_process_backend = self.mode in ['bin', 'raw'] and self.args.backend_in_process \
+                             and self.args.stop_after != 'bin2llvmir' and not self.args.backend_cfg_test \
+                             and not self.args.generate_log
+
+        if self.args.backend_in_process and self.args.generate_log:
+            utils.print_warning('Option --backend-in-process cannot be used with --generate-log.'
+                                ' The back-end will run in a separate process.')
+
         if self.mode in ['bin', 'raw']:
             # Assignment of other used variables.
             name = os.path.splitext(self.output_file)[0]
@@ -745,6 +864,11 @@ class Decompiler:
                 with open(self.config_file, 'w') as f:
                     f.write('{}')
 
+            # Pass the config between the tools in the binary format, which is much
+            # faster to read and write. It is converted back to JSON at the end.
+            CmdRunner.run_cmd([config.CONFIGTOOL, self.config_file, '--convert', 'binary'])
+            self.binary_config = True
+
             # Raw data needs architecture, endianess and optionally section's vma and entry point to be specified.
             if self.mode == 'raw':
                 if not self.arch or self.arch == 'unknown' or self.arch == '':
@@ -1049,6 +1173,10 @@ class Decompiler:
             else:
                 CmdRunner.run_cmd([config.CONFIGTOOL, self.config_file, '--write', '--decode-only-selected', 'false'])
 
+            # Store linear sweep pre-pass flag.
+            if self.args.linear_sweep_prepass:
+                CmdRunner.run_cmd([config.CONFIGTOOL, self.config_file, '--write', '--linear-sweep-prepass', 'true'])
+
             # Store selected functions or selected ranges into config.
             if self.selected_functions:
                 for f in self.selected_functions:
@@ -1089,16 +1217,29 @@ class Decompiler:
                 # system RAM to prevent potential black screens on Windows (#270).
                 bin2llvmir_params.append('-max-memory-half-ram')
 
-            print('\n##### Decompiling ' + self.input_file + ' into ' + self.out_bc + '...')
+            if self.args.profile:
+                bin2llvmir_params.extend(['-profile-output', self.output_file + '.bin2llvmir.profile.json',
+                                          '-profile-format', self.args.profile])
+
+            if in_process_backend:
+                # Back-end options are the same as for llvmir2hll, only prefixed with 'backend-'.
+                bin2llvmir_out = ['-backend-output', self.output_file]
+                bin2llvmir_out.extend('-backend-' + p[1:] if p.startswith('-') else p
+                                      for p in self._get_llvmir2hll_params())
+                print('\n##### Decompiling ' + self.input_file + ' into ' + self.output_file + '...')
+            else:
+                bin2llvmir_out = ['-o', self.out_bc]
+                print('\n##### Decompiling ' + self.input_file + ' into ' + self.out_bc + '...')
+
             if self.args.generate_log:
                 self.log_bin2llvmir_memory, self.log_bin2llvmir_time, self.log_bin2llvmir_output, \
-                self.log_bin2llvmir_rc = CmdRunner.run_measured_cmd([config.BIN2LLVMIR] + bin2llvmir_params + ['-o',
-                                                               self.out_bc], timeout=config.LOG_TIMEOUT, print_run_msg=True)
+                self.log_bin2llvmir_rc = CmdRunner.run_measured_cmd([config.BIN2LLVMIR] + bin2llvmir_params + bin2llvmir_out,
+                                                                    timeout=config.LOG_TIMEOUT, print_run_msg=True)
 
                 bin2llvmir_rc = self.log_bin2llvmir_rc
                 print(self.log_bin2llvmir_output)
             else:
-                _, bin2llvmir_rc, _ = CmdRunner.run_cmd([config.BIN2LLVMIR] + bin2llvmir_params + ['-o', self.out_bc], print_run_msg=True)
+                _, bin2llvmir_rc, _ = CmdRunner.run_cmd([config.BIN2LLVMIR] + bin2llvmir_params + bin2llvmir_out, print_run_msg=True)
 
             if bin2llvmir_rc != 0:
                 if self.args.generate_log:
@@ -1116,102 +1257,48 @@ class Decompiler:
             self.out_bc = self.input_file
             self.config_file = self.args.config_db
 
-        # Create parameters for the llvmir2hll call.
-        llvmir2hll_params = ['-target-hll=' + self.args.hll, '-var-renamer=' + self.args.backend_var_renamer,
-                             '-var-name-gen=fruit', '-var-name-gen-prefix=',
-                             '-call-info-obtainer=' + self.args.backend_call_info_obtainer,
-                             '-arithm-expr-evaluator=' + self.args.backend_arithm_expr_evaluator, '-validate-module',
-                             '-o', self.output_file,
-                             self.out_bc]
-
-        if not self.args.backend_no_debug:
-            llvmir2hll_params.append('-enable-debug')
-
-        if not self.args.backend_no_debug_comments:
-            llvmir2hll_params.append('-emit-debug-comments')
-
-        if self.config_file:
-            llvmir2hll_params.append('-config-path=' + self.config_file)
-
-        if self.args.backend_semantics:
-            llvmir2hll_params.extend(['-semantics', self.args.backend_semantics])
-
-        if self.args.backend_enabled_opts:
-            llvmir2hll_params.append('-enabled-opts=' + self.args.backend_enabled_opts)
-
-        if self.args.backend_disabled_opts:
-            llvmir2hll_params.append('-disabled-opts=' + self.args.backend_disabled_opts)
-
-        if self.args.backend_no_opts:
-            llvmir2hll_params.append('-no-opts')
-
-        if self.args.backend_aggressive_opts:
-            llvmir2hll_params.append('-aggressive-opts')
-
-        if self.args.backend_no_var_renaming:
-            llvmir2hll_params.append('-no-var-renaming')
-
-        if self.args.backend_no_symbolic_names:
-            llvmir2hll_params.append('-no-symbolic-names')
-
-        if self.args.backend_keep_all_brackets:
-            llvmir2hll_params.append('-keep-all-brackets')
-
-        if self.args.backend_keep_library_funcs:
-            llvmir2hll_params.append('-keep-library-funcs')
-
-        if self.args.backend_no_time_varying_info:
-            llvmir2hll_params.append('-no-time-varying-info')
+        if not in_process_backend:
+            # Create parameters for the llvmir2hll call.
+            llvmir2hll_params = self._get_llvmir2hll_params() + ['-o', self.output_file, self.out_bc]
 
-        if self.args.backend_no_compound_operators:
-            llvmir2hll_params.append('-no-compound-operators')
+            if self.config_file:
+                llvmir2hll_params.append('-config-path=' + self.config_file)
 
-        if self.args.backend_find_patterns:
-            llvmir2hll_params.extend(['-find-patterns', self.args.backend_find_patterns])
-
-        if self.args.backend_emit_cg:
-            llvmir2hll_params.append('-emit-cg')
-
-        if self.args.backend_force_module_name:
-            llvmir2hll_params.append('-force-module-name=' + self.args.backend_force_module_name)
-
-        if self.args.backend_strict_fpu_semantics:
-            llvmir2hll_params.append('-strict-fpu-semantics')
+            if self.args.backend_cfg_test:
+                llvmir2hll_params.append('--backend-cfg-test')
 
-        if self.args.backend_emit_cfg:
-            llvmir2hll_params.append('-emit-cfgs')
+            if self.args.max_memory:
+                llvmir2hll_params.extend(['-max-memory', self.args.max_memory])
+            elif not self.args.no_memory_limit:
+                # By default, we want to limit the memory of llvmir2hll into half of system
+                # RAM to prevent potential black screens on Windows (#270).
+                llvmir2hll_params.append('-max-memory-half-ram')
 
-        if self.args.backend_cfg_test:
-            llvmir2hll_params.append('--backend-cfg-test')
+            if self.args.profile:
+                llvmir2hll_params.extend(['-profile-output', self.output_file + '.llvmir2hll.profile.json',
+                                          '-profile-format', self.args.profile])
 
-        if self.args.max_memory:
-            llvmir2hll_params.extend(['-max-memory', self.args.max_memory])
-        elif not self.args.no_memory_limit:
-            # By default, we want to limit the memory of llvmir2hll into half of system
-            # RAM to prevent potential black screens on Windows (#270).
-            llvmir2hll_params.append('-max-memory-half-ram')
-
-        # Decompile the optimized IR code.
-        print('\n##### Decompiling ' + self.out_bc + ' into ' + self.output_file + '...')
-        if self.args.generate_log:
-            self.log_llvmir2hll_memory, self.log_llvmir2hll_time, self.log_llvmir2hll_output, self.log_llvmir2hll_rc = CmdRunner.run_measured_cmd(
-                [config.LLVMIR2HLL] + llvmir2hll_params,
-                timeout=config.LOG_TIMEOUT,
-                print_run_msg=True
-            )
-
-            llvmir2hll_rc = self.log_llvmir2hll_rc
-            print(self.log_llvmir2hll_output)
-        else:
-            _, llvmir2hll_rc, _ = CmdRunner.run_cmd([config.LLVMIR2HLL] + llvmir2hll_params, print_run_msg=True)
-
-        if llvmir2hll_rc != 0:
+            # Decompile the optimized IR code.
+            print('\n##### Decompiling ' + self.out_bc + ' into ' + self.output_file + '...')
             if self.args.generate_log:
-                self._generate_log()
+                self.log_llvmir2hll_memory, self.log_llvmir2hll_time, self.log_llvmir2hll_output, self.log_llvmir2hll_rc = CmdRunner.run_measured_cmd(
+                    [config.LLVMIR2HLL] + llvmir2hll_params,
+                    timeout=config.LOG_TIMEOUT,
+                    print_run_msg=True
+                )
+
+                llvmir2hll_rc = self.log_llvmir2hll_rc
+                print(self.log_llvmir2hll_output)
+            else:
+                _, llvmir2hll_rc, _ = CmdRunner.run_cmd([config.LLVMIR2HLL] + llvmir2hll_params, print_run_msg=True)
 
-            self._cleanup()
-            utils.print_error('Decompilation of file %s failed' % self.out_bc)
-            return 1
+            if llvmir2hll_rc != 0:
+                if self.args.generate_log:
+                    self._generate_log()
+
+                self._cleanup()
+                utils.print_error('Decompilation of file %s failed' % self.out_bc)
+                return 1
 
         if self._check_whether_decompilation_should_be_forcefully_stopped('llvmir2hll'):
             return 0
@@ -1247,6 +1334,8 @@ class Decompiler:
         with open(self.output_file, 'w') as fh:
             [fh.write('%s\n' % line) for line in new]
 
+        self._convert_config_to_json()
+
         # Colorize output file.
         if self.args.color_for_ida:
             CmdRunner.run_cmd([sys.executable, config.IDA_COLORIZER, self.output_file, self.config_file])
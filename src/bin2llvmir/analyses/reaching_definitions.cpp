@@ -6,6 +6,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <set>
 #include <sstream>
 #include <string>
@@ -42,57 +43,179 @@ bool ReachingDefinitionsAnalysis::runOnModule(
 		Abi* abi,
 		bool trackFlagRegs)
 {
-	_trackFlagRegs = trackFlagRegs;
-	_abi = abi;
-	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(&M);
+	initialize(&M, abi, trackFlagRegs);
+
+	// Forget functions that are no longer in the module.
+	std::set<const Function*> fncs;
+	for (Function& F : M)
+	{
+		fncs.insert(&F);
+	}
+	for (auto it = bbMap.begin(); it != bbMap.end();)
+	{
+		if (fncs.count(it->first))
+		{
+			++it;
+		}
+		else
+		{
+			_signatures.erase(it->first);
+			it = bbMap.erase(it);
+		}
+	}
 
-	clear();
-	initializeBasicBlocks(M);
-	run();
+	for (Function& F : M)
+	{
+		update(F);
+	}
 
 	_run = true;
 	return false;
 }
 
+/**
+ * Compute RDA only for function @p F. Results for the other functions
+ * are kept.
+ */
 bool ReachingDefinitionsAnalysis::runOnFunction(
 		llvm::Function& F,
 		Abi* abi,
 		bool trackFlagRegs)
 {
-	_trackFlagRegs = trackFlagRegs;
-	_abi = abi;
-	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(F.getParent());
-
-	clear();
-	initializeBasicBlocks(F);
-	run();
+	initialize(F.getParent(), abi, trackFlagRegs);
+	update(F);
 
 	_run = true;
 	return false;
 }
 
-void ReachingDefinitionsAnalysis::run()
+/**
+ * Set parameters of the analysis. Results computed for a different module,
+ * or with different parameters, are thrown away.
+ */
+void ReachingDefinitionsAnalysis::initialize(
+		llvm::Module* M,
+		Abi* abi,
+		bool trackFlagRegs)
 {
-	initializeBasicBlocksPrev();
-	initializeKillGenSets();
-	propagate();
-	initializeDefsAndUses();
+	auto* specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(M);
+	if (M != _module
+			|| abi != _abi
+			|| trackFlagRegs != _trackFlagRegs
+			|| specialGlobal != _specialGlobal)
+	{
+		clear();
+	}
 
-	LOG << *this << "\n";
+	_module = M;
+	_abi = abi;
+	_trackFlagRegs = trackFlagRegs;
+	_specialGlobal = specialGlobal;
+}
 
-	clearInternal();
+/**
+ * Compute RDA for function @p F, unless it was already computed and
+ * the function has not changed since then.
+ */
+void ReachingDefinitionsAnalysis::update(llvm::Function& F)
+{
+	auto sig = getSignature(F);
+	auto sIt = _signatures.find(&F);
+	if (sIt != _signatures.end() && sIt->second == sig)
+	{
+		return;
+	}
+
+	initializeBasicBlocks(F);
+	run(&F, bbMap[&F]);
+	_signatures[&F] = std::move(sig);
 }
 
-void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Module& M)
+/**
+ * Get everything RDA of function @p F depends on -- its basic blocks with
+ * their predecessors, and ordered loads, stores, allocas, and calls with
+ * their relevant operands. RDA of a function whose signature has not changed
+ * does not need to be recomputed.
+ */
+ReachingDefinitionsAnalysis::Signature ReachingDefinitionsAnalysis::getSignature(
+		llvm::Function& F) const
 {
-	for (Function& F : M)
+	Signature sig;
+	auto add = [&sig] (const void* p)
+	{
+		sig.push_back(reinterpret_cast<std::uintptr_t>(p));
+	};
+
+	for (BasicBlock& B : F)
 	{
-		initializeBasicBlocks(F);
+		add(&B);
+		sig.push_back(std::distance(pred_begin(&B), pred_end(&B)));
+		for (auto* pred : predecessors(&B))
+		{
+			add(pred);
+		}
+
+		for (Instruction& I : B)
+		{
+			if (auto* l = dyn_cast<LoadInst>(&I))
+			{
+				add(&I);
+				sig.push_back(I.getOpcode());
+				add(l->getPointerOperand());
+			}
+			else if (auto* s = dyn_cast<StoreInst>(&I))
+			{
+				add(&I);
+				sig.push_back(I.getOpcode());
+				add(s->getPointerOperand());
+			}
+			else if (isa<AllocaInst>(&I))
+			{
+				add(&I);
+				sig.push_back(I.getOpcode());
+			}
+			else if (auto* call = dyn_cast<CallInst>(&I))
+			{
+				add(&I);
+				sig.push_back(I.getOpcode());
+				sig.push_back(call->getNumArgOperands());
+				for (auto& a : call->arg_operands())
+				{
+					add(a.get());
+				}
+			}
+		}
 	}
+
+	return sig;
+}
+
+void ReachingDefinitionsAnalysis::run(
+		const llvm::Function* F,
+		BasicBlockEntryMap& bbs)
+{
+	std::vector<Definition*> defs;
+	SourceDefsMap srcDefs;
+
+	initializeBasicBlocksPrev(bbs);
+	initializeKillGenSets(bbs, defs, srcDefs);
+	propagate(F, bbs);
+	initializeDefsAndUses(bbs, defs, srcDefs);
+
+	for (auto& pair : bbs)
+	{
+		LOG << pair.second;
+	}
+	LOG << "\n";
+
+	clearInternal(bbs);
 }
 
 void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 {
+	auto& bbs = bbMap[&F];
+	bbs.clear();
+
 	for (BasicBlock& B : F)
 	{
 		BasicBlockEntry bbe(&B);
@@ -168,13 +291,25 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 			}
 		}
 
-		bbMap[&F][&B] = bbe;
+		bbs[&B] = bbe;
 	}
 }
 
+/**
+ * Forget RDA of function @p F. It is recomputed by the next run of the
+ * analysis. Use this if the function was modified in a way the analysis
+ * could not detect, e.g. the same instruction got a different operand.
+ */
+void ReachingDefinitionsAnalysis::invalidate(const llvm::Function* F)
+{
+	bbMap.erase(F);
+	_signatures.erase(F);
+}
+
 void ReachingDefinitionsAnalysis::clear()
 {
 	bbMap.clear();
+	_signatures.clear();
 	_run = false;
 }
 
@@ -187,22 +322,21 @@ bool ReachingDefinitionsAnalysis::wasRun() const
  * Clear internal structures used to compute RDA, but not needed to use it once
  * it is computed.
  */
-void ReachingDefinitionsAnalysis::clearInternal()
+void ReachingDefinitionsAnalysis::clearInternal(BasicBlockEntryMap& bbs)
 {
-	for (auto& pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (auto& pair : bbs)
 	{
 		BasicBlockEntry& bb = pair.second;
-		bb.defsOut.clear();
-		bb.genDefs.clear();
-		bb.killDefs.clear();
+		bb.defsOut = BitVector();
+		bb.genDefs = BitVector();
+		bb.killDefs = BitVector();
 	}
 }
 
-void ReachingDefinitionsAnalysis::initializeBasicBlocksPrev()
+void ReachingDefinitionsAnalysis::initializeBasicBlocksPrev(
+		BasicBlockEntryMap& bbs)
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (auto& pair : bbs)
 	{
 		auto B = pair.first;
 		auto &entry = pair.second;
@@ -210,63 +344,91 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocksPrev()
 		for (auto PI = pred_begin(B), E = pred_end(B); PI != E; ++PI)
 		{
 			auto* pred = *PI;
-			auto p = pair1.second.find(pred);
+			auto p = bbs.find(pred);
 
-			assert(p != pair1.second.end() && "we should have all BBs stored in bbMap");
+			assert(p != bbs.end() && "we should have all BBs stored in bbMap");
 
 			entry.prevBBs.insert( &p->second );
 		}
 	}
 }
 
-void ReachingDefinitionsAnalysis::initializeKillGenSets()
+/**
+ * Number all the definitions in the function, and compute kill and gen
+ * sets of its basic blocks.
+ */
+void ReachingDefinitionsAnalysis::initializeKillGenSets(
+		BasicBlockEntryMap& bbs,
+		std::vector<Definition*>& defs,
+		SourceDefsMap& srcDefs)
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (auto& pair : bbs)
+	{
+		for (Definition& d : pair.second.defs)
+		{
+			defs.push_back(&d);
+		}
+	}
+
+	for (unsigned i = 0; i < defs.size(); ++i)
 	{
-		pair.second.initializeKillDefSets();
+		auto& bits = srcDefs[defs[i]->getSource()];
+		bits.resize(defs.size());
+		bits.set(i);
+	}
+
+	unsigned firstDef = 0;
+	for (auto& pair : bbs)
+	{
+		BasicBlockEntry& bb = pair.second;
+		bb.initializeKillGenSets(srcDefs, firstDef, defs.size());
+		firstDef += bb.defs.size();
 	}
 }
 
-void ReachingDefinitionsAnalysis::propagate()
+void ReachingDefinitionsAnalysis::propagate(
+		const llvm::Function* F,
+		BasicBlockEntryMap& bbs)
 {
-	for (auto &pair1 : bbMap)
+	std::vector<BasicBlockEntry*> workList;
+	workList.reserve(bbs.size());
+	ReversePostOrderTraversal<const Function*> RPOT(F); // Expensive to create
+	for (auto I = RPOT.begin(); I != RPOT.end(); ++I)
 	{
-		const Function* fnc = pair1.first;
+		const BasicBlock* bb = *I;
+		auto fIt = bbs.find(bb);
+		assert(fIt != bbs.end());
+		workList.push_back(&(fIt->second));
 
-		std::vector<BasicBlockEntry*> workList;
-		workList.reserve(pair1.second.size());
-		ReversePostOrderTraversal<const Function*> RPOT(fnc); // Expensive to create
-		for (auto I = RPOT.begin(); I != RPOT.end(); ++I)
-		{
-			const BasicBlock* bb = *I;
-			auto fIt = pair1.second.find(bb);
-			assert(fIt != pair1.second.end());
-			workList.push_back(&(fIt->second));
+		fIt->second.changed = true;
+	}
 
-			fIt->second.changed = true;
-		}
+	BitVector tmp;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
 
-		bool changed = true;
-		while (changed)
+		for (auto* bbe : workList)
 		{
-			changed = false;
-
-			for (auto* bbe : workList)
-			{
-				changed |= bbe->initDefsOut();
-			}
+			changed |= bbe->initDefsOut(tmp);
 		}
 	}
 }
 
-void ReachingDefinitionsAnalysis::initializeDefsAndUses()
+void ReachingDefinitionsAnalysis::initializeDefsAndUses(
+		BasicBlockEntryMap& bbs,
+		const std::vector<Definition*>& defs,
+		const SourceDefsMap& srcDefs)
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	BitVector defsIn;
+	BitVector reaching;
+
+	for (auto& pair : bbs)
 	{
 		BasicBlockEntry &bb = pair.second;
 		OrderedBasicBlock obb(bb.bb);
+		bool defsInComputed = false;
 
 		for (Use &u : bb.uses)
 		{
@@ -287,17 +449,32 @@ void ReachingDefinitionsAnalysis::initializeDefsAndUses()
 				}
 			}
 
-			if (u.defs.empty())
+			if (!u.defs.empty())
+			{
+				continue;
+			}
+			auto sIt = srcDefs.find(u.src);
+			if (sIt == srcDefs.end())
+			{
+				continue;
+			}
+
+			if (!defsInComputed)
 			{
-				for (auto p : bb.prevBBs)
-				for (auto d : p->defsOut)
+				defsIn = BitVector(defs.size());
+				for (auto* p : bb.prevBBs)
 				{
-					if (d->getSource() == u.src)
-					{
-						d->uses.insert(&u);
-						u.defs.insert(d);
-					}
+					defsIn |= p->defsOut;
 				}
+				defsInComputed = true;
+			}
+
+			reaching = defsIn;
+			reaching &= sIt->second;
+			for (int i = reaching.find_first(); i != -1; i = reaching.find_next(i))
+			{
+				defs[i]->uses.insert(&u);
+				u.defs.insert(defs[i]);
 			}
 		}
 	}
@@ -347,13 +524,46 @@ std::ostream& operator<<(std::ostream& out, const ReachingDefinitionsAnalysis& r
 	return out;
 }
 
+//
+//=============================================================================
+//  ReachingDefinitionsProvider
+//=============================================================================
+//
+
+std::map<llvm::Module*, ReachingDefinitionsAnalysis> ReachingDefinitionsProvider::_module2rda;
+std::mutex ReachingDefinitionsProvider::_mutex;
+
+/**
+ * @return Analysis shared by all the passes working on module @p m.
+ * It is created if it does not exist yet. It must be run on the module before
+ * its results are used.
+ */
+ReachingDefinitionsAnalysis* ReachingDefinitionsProvider::getReachingDefinitions(
+		llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return &_module2rda[m];
+}
+
+void ReachingDefinitionsProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2rda.erase(m);
+}
+
+void ReachingDefinitionsProvider::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2rda.clear();
+}
+
 //
 //=============================================================================
 //  BasicBlockEntry
 //=============================================================================
 //
 
-int BasicBlockEntry::newUID = 0;
+thread_local int BasicBlockEntry::newUID = 0;
 
 BasicBlockEntry::BasicBlockEntry(const llvm::BasicBlock* b) :
 	bb(b),
@@ -362,19 +572,26 @@ BasicBlockEntry::BasicBlockEntry(const llvm::BasicBlock* b) :
 
 }
 
-void BasicBlockEntry::initializeKillDefSets()
+/**
+ * The last definition of each source in the basic block is generated,
+ * all the definitions of the source in the function are killed.
+ */
+void BasicBlockEntry::initializeKillGenSets(
+		const SourceDefsMap& srcDefs,
+		unsigned firstDef,
+		unsigned defCount)
 {
-	killDefs.clear();
-	genDefs.clear();
+	killDefs = BitVector(defCount);
+	genDefs = BitVector(defCount);
+	defsOut = BitVector(defCount);
 
-	for (auto dIt = defs.rbegin(); dIt != defs.rend(); ++dIt)
+	for (unsigned i = defs.size(); i > 0; --i)
 	{
-		Definition& d = *dIt;
-
-		bool added = (killDefs.insert(d.getSource())).second;
-		if (added)
+		unsigned idx = firstDef + i - 1;
+		if (!killDefs.test(idx))
 		{
-			genDefs.insert(&d);
+			killDefs |= srcDefs.find(defs[i - 1].src)->second;
+			genDefs.set(idx);
 		}
 	}
 }
@@ -382,31 +599,26 @@ void BasicBlockEntry::initializeKillDefSets()
 /**
  * REACH_in[B] = Sum (p in pred[B]) (REACH_out[p])
  * REACH_out[B] = GEN[B] + ( REACH_in[B] - KILL[B] )
+ *
+ * @param tmp Helper bit vector, so that it is not allocated on every call.
  */
-Changed BasicBlockEntry::initDefsOut()
+Changed BasicBlockEntry::initDefsOut(BitVector& tmp)
 {
-	auto oldSz = defsOut.size();
+	auto oldCount = defsOut.count();
 
-	if (defsOut.empty() && !genDefs.empty())
-	{
-		defsOut = std::move(genDefs);
-	}
+	defsOut |= genDefs;
 
 	for (auto* p : prevBBs)
 	{
 		if (p->changed)
 		{
-			for (auto* d : p->defsOut)
-			{
-				if (killDefs.find(d->getSource()) == killDefs.end())
-				{
-					defsOut.insert(d);
-				}
-			}
+			tmp = p->defsOut;
+			tmp.reset(killDefs);
+			defsOut |= tmp;
 		}
 	}
 
-	changed = oldSz != defsOut.size();
+	changed = oldCount != defsOut.count();
 	return changed;
 }
 
@@ -63,7 +63,7 @@ bool CondBranchOpt::run()
 
 	bool changed = false;
 
-	ReachingDefinitionsAnalysis RDA;
+	auto& RDA = *ReachingDefinitionsProvider::getReachingDefinitions(_module);
 	RDA.runOnModule(*_module, _abi, true);
 
 	SymbolicTree::setTrackThroughAllocaLoads(false);
@@ -75,7 +75,7 @@ bool ConstantsAnalysis::runOnModuleCustom(
 
 bool ConstantsAnalysis::run()
 {
-	ReachingDefinitionsAnalysis RDA;
+	auto& RDA = *ReachingDefinitionsProvider::getReachingDefinitions(_module);
 	RDA.runOnModule(*_module, _abi);
 
 	for (Function& f : *_module)
@@ -109,26 +109,25 @@ std::size_t Decoder::decodeJumpTargetDryRun_arm(
 	auto basicMode = _c2l->getBasicMode();
 	if (mode != basicMode) _c2l->modifyBasicMode(mode);
 
-	static csh ce = _c2l->getCapstoneEngine();
-
 	decodedSz = 0;
 	uint64_t addr = jt.getAddress();
 	std::size_t nops = 0;
 	bool first = true;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	LinearSweepTable::Insn insn;
+	while (dryRunDisasm(mode, bytes, addr, insn))
 	{
-		decodedSz += _dryCsInsn->size;
+		decodedSz += insn.size;
 
-		if (strict && first && !looksLikeArmFunctionStart(_dryCsInsn))
+		if (strict && first && !insn.is(LinearSweepTable::ARM_PUSH))
 		{
 			return true;
 		}
 
 		if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& (first || nops > 0)
-				&& _abi->isNopInstruction(_dryCsInsn))
+				&& insn.is(LinearSweepTable::NOP))
 		{
-			nops += _dryCsInsn->size;
+			nops += insn.size;
 		}
 		else if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& nops > 0)
@@ -137,8 +136,8 @@ std::size_t Decoder::decodeJumpTargetDryRun_arm(
 			return nops;
 		}
 
-		if (_c2l->isControlFlowInstruction(*_dryCsInsn)
-				|| insnWrittesPc(ce, _dryCsInsn))
+		if (insn.is(LinearSweepTable::CONTROL_FLOW)
+				|| insn.is(LinearSweepTable::ARM_WRITES_PC))
 		{
 			if (mode != basicMode) _c2l->modifyBasicMode(basicMode);
 			return false;
@@ -165,6 +164,34 @@ std::size_t Decoder::decodeJumpTargetDryRun_arm(
 	return true;
 }
 
+/**
+ * Classify ARM or THUMB instruction @p insn for dry runs.
+ * \return Classification flags from @c LinearSweepTable::eFlag.
+ */
+uint16_t Decoder::classifyDryRunInsn_arm(csh ce, cs_insn* insn)
+{
+	uint16_t flags = 0;
+
+	if (looksLikeArmFunctionStart(insn))
+	{
+		flags |= LinearSweepTable::ARM_PUSH;
+	}
+	if (_abi->isNopInstruction(insn))
+	{
+		flags |= LinearSweepTable::NOP;
+	}
+	if (_c2l->isControlFlowInstruction(*insn))
+	{
+		flags |= LinearSweepTable::CONTROL_FLOW;
+	}
+	if (insnWrittesPc(ce, insn))
+	{
+		flags |= LinearSweepTable::ARM_WRITES_PC;
+	}
+
+	return flags;
+}
+
 /**
  * Recognize some ARM-specific patterns.
  */
@@ -188,9 +215,9 @@ void Decoder::patternsPseudoCall_arm(llvm::CallInst*& call, AsmInstruction& ai)
 		{
 			return;
 		}
-		auto* insn = ai.getCapstoneInsn();
+		auto insn = ai.getCapstoneInsn();
 		auto& arm = insn->detail->arm;
-		auto* pInsn = prev.getCapstoneInsn();
+		auto pInsn = prev.getCapstoneInsn();
 		auto& pArm = pInsn->detail->arm;
 
 		if (pInsn->id == ARM_INS_MOV
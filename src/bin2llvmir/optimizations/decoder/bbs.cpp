@@ -47,8 +47,8 @@ utils::Address Decoder::getBasicBlockEndAddress(llvm::BasicBlock* b)
  */
 utils::Address Decoder::getBasicBlockAddressAfter(utils::Address a)
 {
-	auto it = _addr2bb.upper_bound(a);
-	return it != _addr2bb.end() ? it->first : Address();
+	auto* p = _addr2bb.after(a);
+	return p ? p->first : Address();
 }
 
 /**
@@ -56,8 +56,8 @@ utils::Address Decoder::getBasicBlockAddressAfter(utils::Address a)
  */
 llvm::BasicBlock* Decoder::getBasicBlockAtAddress(utils::Address a)
 {
-	auto fIt = _addr2bb.find(a);
-	return fIt != _addr2bb.end() ? fIt->second : nullptr;
+	auto* p = _addr2bb.at(a);
+	return p ? p->second : nullptr;
 }
 
 /**
@@ -65,30 +65,8 @@ llvm::BasicBlock* Decoder::getBasicBlockAtAddress(utils::Address a)
  */
 llvm::BasicBlock* Decoder::getBasicBlockBeforeAddress(utils::Address a)
 {
-	if (_addr2bb.empty())
-	{
-		return nullptr;
-	}
-
-	// Iterator to the first element whose key goes after a.
-	auto it = _addr2bb.upper_bound(a);
-
-	// The first BB is after a -> no BB before a.
-	if (it == _addr2bb.begin())
-	{
-		return nullptr;
-	}
-	// No BB after a -> the last BB before a.
-	else if (it == _addr2bb.end())
-	{
-		return _addr2bb.rbegin()->second;
-	}
-	// BB after a exists -> the one before it is before a.
-	else
-	{
-		--it;
-		return it->second;
-	}
+	auto* p = _addr2bb.beforeOrAt(a);
+	return p ? p->second : nullptr;
 }
 
 /**
@@ -96,8 +74,8 @@ llvm::BasicBlock* Decoder::getBasicBlockBeforeAddress(utils::Address a)
  */
 llvm::BasicBlock* Decoder::getBasicBlockAfterAddress(utils::Address a)
 {
-	auto it = _addr2bb.upper_bound(a);
-	return it != _addr2bb.end() ? it->second : nullptr;
+	auto* p = _addr2bb.after(a);
+	return p ? p->second : nullptr;
 }
 
 /**
@@ -162,7 +140,7 @@ llvm::BasicBlock* Decoder::createBasicBlock(
 
 void Decoder::addBasicBlock(utils::Address a, llvm::BasicBlock* b)
 {
-	_addr2bb[a] = b;
+	_addr2bb.insert(a, b);
 	_bb2addr[b] = a;
 }
 
@@ -41,9 +41,12 @@ Decoder::Decoder() :
 
 Decoder::~Decoder()
 {
-	if (_dryCsInsn)
+	for (auto* insn : {_dryCsInsn, _translatedCsInsn, _delaySlotCsInsn})
 	{
-		cs_free(_dryCsInsn, 1);
+		if (insn)
+		{
+			cs_free(insn, 1);
+		}
 	}
 }
 
@@ -55,7 +58,7 @@ bool Decoder::runOnModule(Module& m)
 	_debug = DebugFormatProvider::getDebugFormat(_module);
 	_names = NamesProvider::getNames(_module);
 	_abi = AbiProvider::getAbi(_module);
-	_llvm2capstone = &AsmInstruction::getLlvmToCapstoneInsnMap(_module);
+	_insnStore = &AsmInstruction::getCapstoneInsnStore(_module);
 	return runCatcher();
 }
 
@@ -73,7 +76,7 @@ bool Decoder::runOnModuleCustom(
 	_debug = d;
 	_names = n;
 	_abi = a;
-	_llvm2capstone = &AsmInstruction::getLlvmToCapstoneInsnMap(_module);
+	_insnStore = &AsmInstruction::getCapstoneInsnStore(_module);
 	return runCatcher();
 }
 
@@ -105,10 +108,11 @@ bool Decoder::run()
 	}
 
 	initTranslator();
-	initDryRunCsInstruction();
+	initCsInstructions();
 	initEnvironment();
 	initRanges();
 	initJumpTargets();
+	initLinearSweep();
 
 	LOG << _ranges << std::endl;
 	LOG << _jumpTargets << std::endl;
@@ -296,7 +300,7 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 		LOG << "\t\t\t" << "translating = " << addr << std::endl;
 
 		Address oldAddr = addr;
-		auto res = translate(bytes, addr, irb);
+		auto res = translate(bytes, addr, irb, _translatedCsInsn);
 
 		if (res.failed() || res.llvmInsn == nullptr)
 		{
@@ -320,7 +324,7 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 		}
 		_somethingDecoded = true;
 
-		_llvm2capstone->emplace(res.llvmInsn, res.capstoneInsn);
+		storeCapstoneInsn(res.capstoneInsn);
 
 		bbEnd |= getJumpTargetsFromInstruction(oldAddr, res, bytes.second);
 		bbEnd |= instructionBreaksBasicBlock(oldAddr, res);
@@ -336,9 +340,13 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 }
 
 capstone2llvmir::Capstone2LlvmIrTranslator::TranslationResultOne
-Decoder::translate(ByteData& bytes, utils::Address& addr, llvm::IRBuilder<>& irb)
+Decoder::translate(
+		ByteData& bytes,
+		utils::Address& addr,
+		llvm::IRBuilder<>& irb,
+		cs_insn* insn)
 {
-	auto res = _c2l->translateOne(bytes.first, bytes.second, addr, irb);
+	auto res = _c2l->translateOne(bytes.first, bytes.second, addr, irb, insn);
 
 	// MIPS 64-bit mode can decompile more instructions than the 32-bit mode.
 	// When 32-bit mode is used, some 32-bit instructions that IDA handles fail
@@ -352,13 +360,26 @@ Decoder::translate(ByteData& bytes, utils::Address& addr, llvm::IRBuilder<>& irb
 			&& res.failed())
 	{
 		_c2l->modifyBasicMode(CS_MODE_MIPS64);
-		res = _c2l->translateOne(bytes.first, bytes.second, addr, irb);
+		res = _c2l->translateOne(bytes.first, bytes.second, addr, irb, insn);
 		_c2l->modifyBasicMode(CS_MODE_MIPS32);
 	}
 
 	return res;
 }
 
+/**
+ * Keep the compact form of the translated instruction @p insn in the
+ * instruction store. The full instruction can be reused afterwards.
+ */
+void Decoder::storeCapstoneInsn(cs_insn* insn)
+{
+	_insnStore->insert(
+			insn,
+			_c2l->getArchitecture(),
+			static_cast<cs_mode>(_c2l->getBasicMode() + _c2l->getExtraMode()),
+			_abi->isNopInstruction(insn));
+}
+
 /**
  * Check if the given jump targets and bytes can/should be decoded.
  * \return The number of bytes to skip from decoding. If zero, then dry run was
@@ -398,6 +419,92 @@ std::size_t Decoder::decodeJumpTargetDryRun(
 	return false;
 }
 
+/**
+ * Get the next instruction for a dry run. Instruction is taken from the linear
+ * sweep table if the table covers @p addr, otherwise it is disassembled from
+ * @p bytes. Capstone engine must be in the @p mode.
+ * \return @c True if there was a valid instruction. In such a case, @p insn
+ *         is set to it, and @p bytes and @p addr are moved right after it.
+ */
+bool Decoder::dryRunDisasm(
+		cs_mode mode,
+		ByteData& bytes,
+		uint64_t& addr,
+		LinearSweepTable::Insn& insn)
+{
+	if (auto* entry = _sweepTable.get(mode, addr))
+	{
+		if (!entry->isKnown())
+		{
+			*entry = disasmDryRunInsn(
+					mode,
+					_image->getImage()->getRawSegmentData(addr),
+					addr);
+		}
+		insn = *entry;
+	}
+	else
+	{
+		insn = disasmDryRunInsn(mode, bytes, addr);
+	}
+
+	// Instruction may be longer than the bytes the dry run was given.
+	//
+	if (insn.isInvalid() || insn.size > bytes.second)
+	{
+		return false;
+	}
+
+	bytes.first += insn.size;
+	bytes.second -= insn.size;
+	addr += insn.size;
+	return true;
+}
+
+/**
+ * Disassemble an instruction from the start of @p bytes and classify it for
+ * dry runs. Capstone engine must be in the @p mode.
+ */
+LinearSweepTable::Insn Decoder::disasmDryRunInsn(
+		cs_mode mode,
+		ByteData bytes,
+		uint64_t addr)
+{
+	LinearSweepTable::Insn ret;
+	ret.flags = LinearSweepTable::KNOWN;
+
+	auto& arch = _config->getConfig().architecture;
+	csh ce = _c2l->getCapstoneEngine();
+	bool ok = bytes.first != nullptr && (arch.isMipsOrPic32()
+			? disasm_mips(ce, mode, bytes, addr, _dryCsInsn)
+			: cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn));
+	if (!ok)
+	{
+		ret.flags |= LinearSweepTable::INVALID;
+		return ret;
+	}
+
+	ret.size = _dryCsInsn->size;
+	if (arch.isX86())
+	{
+		ret.flags |= classifyDryRunInsn_x86(_dryCsInsn);
+	}
+	else if (arch.isArmOrThumb())
+	{
+		ret.flags |= classifyDryRunInsn_arm(ce, _dryCsInsn);
+	}
+	else if (arch.isMipsOrPic32())
+	{
+		ret.flags |= classifyDryRunInsn_mips(_dryCsInsn);
+	}
+	else if (arch.isPpc())
+	{
+		ret.flags |= classifyDryRunInsn_ppc(_dryCsInsn);
+	}
+
+	return ret;
+}
+
 cs_mode Decoder::determineMode(cs_insn* insn, utils::Address& target)
 {
 	if (_config->getConfig().architecture.isArmOrThumb())
@@ -442,8 +549,9 @@ bool Decoder::instructionBreaksBasicBlock(
 		auto prev = ai.getPrev();
 		if (prev.isValid())
 		{
-			auto& detail = prev.getCapstoneInsn()->detail->x86;
-			if (prev.getCapstoneInsn()->id == X86_INS_MOV
+			auto prevInsn = prev.getCapstoneInsn();
+			auto& detail = prevInsn->detail->x86;
+			if (prevInsn->id == X86_INS_MOV
 					&& detail.op_count == 2
 					&& detail.operands[0].type == X86_OP_REG
 					&& detail.operands[0].reg == X86_REG_EAX
@@ -916,8 +1024,8 @@ utils::Address Decoder::getJumpTarget(
 		AsmInstruction ai4 = ai3.getPrev();
 		if (ai4.isInvalid()
 				&& ai1.isValid() && ai1.getDsm() == "jr $t9"
-				&& ai2.isValid() && ai2.getCapstoneInsn()->id == MIPS_INS_LW
-				&& ai3.isValid() && ai3.getCapstoneInsn()->id == MIPS_INS_LUI)
+				&& ai2.isValid() && ai2.getCapstoneInsnId() == MIPS_INS_LW
+				&& ai3.isValid() && ai3.getCapstoneInsnId() == MIPS_INS_LUI)
 		{
 			return Address::getUndef;
 		}
@@ -1347,12 +1455,12 @@ void Decoder::handleDelaySlotTypical(
 	std::size_t sz = _c2l->getDelaySlot(res.capstoneInsn->id);
 	for (std::size_t i = 0; i < sz; ++i)
 	{
-		auto r = translate(bytes, addr, irb);
+		auto r = translate(bytes, addr, irb, _delaySlotCsInsn);
 		if (r.failed() || r.llvmInsn == nullptr)
 		{
 			break;
 		}
-		_llvm2capstone->emplace(r.llvmInsn, r.capstoneInsn);
+		storeCapstoneInsn(r.capstoneInsn);
 	}
 
 	irb.SetInsertPoint(oldIp);
@@ -1404,12 +1512,12 @@ void Decoder::handleDelaySlotLikely(
 		std::size_t sz = _c2l->getDelaySlot(res.capstoneInsn->id);
 		for (std::size_t i = 0; i < sz; ++i)
 		{
-			auto res = translate(bytes, addr, irb);
+			auto res = translate(bytes, addr, irb, _delaySlotCsInsn);
 			if (res.failed() || res.llvmInsn == nullptr)
 			{
 				break;
 			}
-			_llvm2capstone->emplace(res.llvmInsn, res.capstoneInsn);
+			storeCapstoneInsn(res.capstoneInsn);
 		}
 
 		_likelyBb2Target.emplace(newBb, target);
@@ -4,6 +4,8 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <algorithm>
+
 #include "retdec/bin2llvmir/optimizations/decoder/decoder.h"
 #include "retdec/utils/string.h"
 
@@ -80,12 +82,16 @@ void Decoder::initTranslator()
 }
 
 /**
- * Initialize instruction used in dry run disassembly.
+ * Initialize instructions used in dry run disassembly and in translation.
+ * They are reused for all instructions, translated instructions are kept in
+ * the instruction store.
  */
-void Decoder::initDryRunCsInstruction()
+void Decoder::initCsInstructions()
 {
 	csh ce = _c2l->getCapstoneEngine();
 	_dryCsInsn = cs_malloc(ce);
+	_translatedCsInsn = cs_malloc(ce);
+	_delaySlotCsInsn = cs_malloc(ce);
 }
 
 /**
@@ -537,6 +543,83 @@ void Decoder::initAllowedRangesWithConfig()
 	}
 }
 
+/**
+ * Disassemble primary ranges by linear sweep into the table used by dry runs.
+ * Dry runs of leftover jump targets then do not need to disassemble the same
+ * bytes again and again. It is done only if enabled in config.
+ */
+void Decoder::initLinearSweep()
+{
+	if (!_config->getConfig().parameters.isLinearSweepPrepass())
+	{
+		return;
+	}
+
+	LOG << "\n" << "initLinearSweep():" << std::endl;
+
+	// Mode and instruction alignment.
+	//
+	auto& arch = _config->getConfig().architecture;
+	auto basicMode = _c2l->getBasicMode();
+	std::vector<std::pair<cs_mode, unsigned>> modes;
+	if (arch.isArmOrThumb())
+	{
+		modes = {{CS_MODE_ARM, 4}, {CS_MODE_THUMB, 2}};
+	}
+	else if (arch.isX86())
+	{
+		modes = {{basicMode, 1}};
+	}
+	else
+	{
+		modes = {{basicMode, 4}};
+	}
+
+	for (auto& m : modes)
+	{
+		cs_mode mode = m.first;
+		unsigned alignment = m.second;
+		if (mode != basicMode) _c2l->modifyBasicMode(mode);
+
+		for (auto& r : _ranges.getPrimaryRanges())
+		{
+			_sweepTable.addChunk(mode, r, alignment);
+
+			ByteData bytes = _image->getImage()->getRawSegmentData(r.getStart());
+			if (bytes.first == nullptr)
+			{
+				continue;
+			}
+
+			// Entries exist only for aligned addresses.
+			Address addr = (r.getStart() + alignment - 1) / alignment * alignment;
+			while (addr < r.getEnd() && addr - r.getStart() < bytes.second)
+			{
+				auto* entry = _sweepTable.get(mode, addr);
+				if (entry == nullptr)
+				{
+					addr += alignment;
+					continue;
+				}
+
+				if (!entry->isKnown())
+				{
+					std::size_t off = addr - r.getStart();
+					*entry = disasmDryRunInsn(
+							mode,
+							{bytes.first + off, bytes.second - off},
+							addr);
+				}
+				addr += entry->isInvalid() ? alignment : entry->size;
+			}
+		}
+
+		if (mode != basicMode) _c2l->modifyBasicMode(basicMode);
+	}
+
+	LOG << "\t" << "table entries : " << _sweepTable.size() << std::endl;
+}
+
 /**
  * Find jump targets to decode.
  */
@@ -984,16 +1067,26 @@ void Decoder::initVtables()
 
 void Decoder::initConfigFunctions()
 {
+	// Dense map is not ordered -> process functions ordered by address.
+	//
+	std::vector<std::pair<Address, Function*>> fncs;
+	fncs.reserve(_fnc2addr.size());
 	for (auto& p : _fnc2addr)
 	{
-		Function* f = p.first;
+		fncs.emplace_back(p.second, p.first);
+	}
+	std::sort(fncs.begin(), fncs.end());
+
+	for (auto& p : fncs)
+	{
+		Function* f = p.second;
 
-		if (_config->getConfigFunction(p.second)) // functions from IDA
+		if (_config->getConfigFunction(p.first)) // functions from IDA
 		{
 			continue;
 		}
 
-		Address start = p.second;
+		Address start = p.first;
 		Address end = getFunctionEndAddress(f);
 		end = end > start ? end : Address(start + 1);
 
@@ -1014,7 +1107,9 @@ void Decoder::initConfigFunctions()
 		std::string realName = _names->getPreferredNameForAddress(start);
 		if (cf->getName() != realName)
 		{
-			cf->setRealName(realName);
+			cf = _config->getConfig().functions.setFunctionRealName(
+					cf->getName(),
+					realName);
 		}
 
 		cf->setIsExported(_exports.count(start));
@@ -78,7 +78,7 @@ void RangesToDecode::removeZeroSequences(
 		FileImage* image,
 		utils::AddressRangeContainer& rs)
 {
-	static unsigned minSequence = 0x50; // TODO: Maybe should be smaller.
+	const unsigned minSequence = 0x50; // TODO: Maybe should be smaller.
 	retdec::utils::AddressRangeContainer toRemove;
 
 	for (auto& range : rs)
@@ -192,6 +192,11 @@ const utils::AddressRange* RangesToDecode::get(utils::Address a) const
 	return p ? p : getAlternative(a);
 }
 
+const utils::AddressRangeContainer& RangesToDecode::getPrimaryRanges() const
+{
+	return _primaryRanges;
+}
+
 void RangesToDecode::setArchitectureInstructionAlignment(unsigned a)
 {
 	archInsnAlign = a;
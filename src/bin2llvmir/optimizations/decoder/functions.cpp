@@ -38,8 +38,8 @@ utils::Address Decoder::getFunctionEndAddress(llvm::Function* f)
 
 utils::Address Decoder::getFunctionAddressAfter(utils::Address a)
 {
-	auto it = _addr2fnc.upper_bound(a);
-	return it != _addr2fnc.end() ? it->first : Address();
+	auto* p = _addr2fnc.after(a);
+	return p ? p->first : Address();
 }
 
 /**
@@ -47,8 +47,8 @@ utils::Address Decoder::getFunctionAddressAfter(utils::Address a)
  */
 llvm::Function* Decoder::getFunctionAtAddress(utils::Address a)
 {
-	auto fIt = _addr2fnc.find(a);
-	return fIt != _addr2fnc.end() ? fIt->second : nullptr;
+	auto* p = _addr2fnc.at(a);
+	return p ? p->second : nullptr;
 }
 
 /**
@@ -56,36 +56,14 @@ llvm::Function* Decoder::getFunctionAtAddress(utils::Address a)
  */
 llvm::Function* Decoder::getFunctionBeforeAddress(utils::Address a)
 {
-	if (_addr2fnc.empty())
-	{
-		return nullptr;
-	}
-
-	// Iterator to the first element whose key goes after a.
-	auto it = _addr2fnc.upper_bound(a);
-
-	// The first function is after a -> no function before a.
-	if (it == _addr2fnc.begin())
-	{
-		return nullptr;
-	}
-	// No function after a -> the last function before a.
-	else if (it == _addr2fnc.end())
-	{
-		return _addr2fnc.rbegin()->second;
-	}
-	// Function after a exists -> the one before it is before a.
-	else
-	{
-		--it;
-		return it->second;
-	}
+	auto* p = _addr2fnc.beforeOrAt(a);
+	return p ? p->second : nullptr;
 }
 
 llvm::Function* Decoder::getFunctionAfterAddress(utils::Address a)
 {
-	auto it = _addr2fnc.upper_bound(a);
-	return it != _addr2fnc.end() ? it->second : nullptr;
+	auto* p = _addr2fnc.after(a);
+	return p ? p->second : nullptr;
 }
 
 /**
@@ -108,8 +86,7 @@ llvm::Function* Decoder::getFunctionContainingAddress(utils::Address a)
  */
 llvm::Function* Decoder::createFunction(utils::Address a, bool declaration)
 {
-	auto existing = _addr2fnc.find(a);
-	if (existing != _addr2fnc.end())
+	if (auto* existing = _addr2fnc.at(a))
 	{
 		return existing->second;
 	}
@@ -153,7 +130,7 @@ llvm::Function* Decoder::createFunction(utils::Address a, bool declaration)
 
 void Decoder::addFunction(utils::Address a, llvm::Function* f)
 {
-	_addr2fnc[a] = f;
+	_addr2fnc.insert(a, f);
 	_fnc2addr[f] = a;
 }
 
@@ -165,7 +142,7 @@ void Decoder::addFunctionSize(llvm::Function* f, utils::Maybe<std::size_t> sz)
 {
 	if (_fnc2sz.count(f) == 0 && sz.isDefined())
 	{
-		_fnc2sz.emplace(f, sz);
+		_fnc2sz[f] = sz;
 	}
 }
 
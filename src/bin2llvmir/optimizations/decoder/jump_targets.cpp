@@ -18,7 +18,7 @@ namespace bin2llvmir {
 //==============================================================================
 //
 
-Config* JumpTarget::config = nullptr;
+thread_local Config* JumpTarget::config = nullptr;
 
 JumpTarget::JumpTarget()
 {
@@ -178,7 +178,7 @@ std::ostream& operator<<(std::ostream &out, const JumpTarget& jt)
 //==============================================================================
 //
 
-Config* JumpTargets::config = nullptr;
+thread_local Config* JumpTargets::config = nullptr;
 
 const JumpTarget* JumpTargets::push(
 		retdec::utils::Address a,
@@ -187,7 +187,7 @@ const JumpTarget* JumpTargets::push(
 		retdec::utils::Address f,
 		utils::Maybe<std::size_t> sz)
 {
-	static auto& arch = config->getConfig().architecture;
+	auto& arch = config->getConfig().architecture;
 
 	if (a.isDefined())
 	{
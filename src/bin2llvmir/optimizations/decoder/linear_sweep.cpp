@@ -0,0 +1,132 @@
+/**
+* @file src/bin2llvmir/optimizations/decoder/linear_sweep.cpp
+* @brief Table of instructions found by linear sweep disassembly.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/bin2llvmir/optimizations/decoder/linear_sweep.h"
+
+#include <iterator>
+
+using namespace retdec::utils;
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Add empty chunks for the given @p range disassembled in @p mode.
+ * Parts of @p range already covered by other chunks of the same mode are
+ * not added again, a new chunk is added for each gap between them.
+ * @param mode      Disassembly mode.
+ * @param range     Address range <start, end) of the chunk.
+ * @param alignment Instruction alignment -- entries are created only for
+ *                  addresses aligned to it.
+ */
+void LinearSweepTable::addChunk(
+		cs_mode mode,
+		const utils::AddressRange& range,
+		unsigned alignment)
+{
+	alignment = alignment ? alignment : 1;
+	auto& chunks = _chunks[mode];
+
+	auto alignUp = [alignment](Address a) -> Address
+	{
+		return (a + alignment - 1) / alignment * alignment;
+	};
+	auto chunkEnd = [](const Chunk& c) -> Address
+	{
+		return c.start + c.insns.size() * c.alignment;
+	};
+
+	Address start = alignUp(range.getStart());
+	Address end = range.getEnd();
+
+	// Skip the beginning covered by the previous chunk.
+	auto next = chunks.upper_bound(start);
+	if (next != chunks.begin())
+	{
+		Address prevEnd = chunkEnd(std::prev(next)->second);
+		start = prevEnd > start ? alignUp(prevEnd) : start;
+	}
+
+	// Add the gaps before and between the following chunks.
+	while (start < end)
+	{
+		Address gapEnd = end;
+		if (next != chunks.end() && next->first < end)
+		{
+			gapEnd = next->first;
+		}
+
+		if (start < gapEnd)
+		{
+			Chunk c;
+			c.start = start;
+			c.alignment = alignment;
+			c.insns.resize((gapEnd - start + alignment - 1) / alignment);
+			_size += c.insns.size();
+			chunks.emplace_hint(next, start, std::move(c));
+		}
+
+		if (gapEnd == end)
+		{
+			break;
+		}
+		Address nextEnd = chunkEnd(next->second);
+		start = nextEnd > start ? alignUp(nextEnd) : start;
+		++next;
+	}
+}
+
+/**
+ * @return Entry for the instruction in @p mode on address @p addr, or
+ *         @c nullptr if the address is not in any chunk of @p mode or it is
+ *         not aligned.
+ */
+LinearSweepTable::Insn* LinearSweepTable::get(cs_mode mode, utils::Address addr)
+{
+	auto mIt = _chunks.find(mode);
+	if (mIt == _chunks.end())
+	{
+		return nullptr;
+	}
+
+	auto& chunks = mIt->second;
+	auto it = chunks.upper_bound(addr);
+	if (it == chunks.begin())
+	{
+		return nullptr;
+	}
+	auto& c = std::prev(it)->second;
+
+	std::size_t off = addr - c.start;
+	if (off % c.alignment)
+	{
+		return nullptr;
+	}
+	std::size_t idx = off / c.alignment;
+	return idx < c.insns.size() ? &c.insns[idx] : nullptr;
+}
+
+bool LinearSweepTable::empty() const
+{
+	return _size == 0;
+}
+
+/**
+ * @return Number of entries in all the chunks.
+ */
+std::size_t LinearSweepTable::size() const
+{
+	return _size;
+}
+
+void LinearSweepTable::clear()
+{
+	_chunks.clear();
+	_size = 0;
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
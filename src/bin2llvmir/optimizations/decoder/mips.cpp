@@ -75,22 +75,21 @@ std::size_t Decoder::decodeJumpTargetDryRun_mips(
 		return true;
 	}
 
-	static csh ce = _c2l->getCapstoneEngine();
-
 	uint64_t addr = jt.getAddress();
 	std::size_t nops = 0;
 	bool first = true;
 	unsigned counter = 0;
 	unsigned cfChangePos = 0;
-	while (disasm_mips(ce, _c2l->getBasicMode(), bytes, addr, _dryCsInsn))
+	LinearSweepTable::Insn insn;
+	while (dryRunDisasm(_c2l->getBasicMode(), bytes, addr, insn))
 	{
 		++counter;
 
 		if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& (first || nops > 0)
-				&& _abi->isNopInstruction(_dryCsInsn))
+				&& insn.is(LinearSweepTable::NOP))
 		{
-			nops += _dryCsInsn->size;
+			nops += insn.size;
 		}
 		else if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& nops > 0)
@@ -98,20 +97,20 @@ std::size_t Decoder::decodeJumpTargetDryRun_mips(
 			return nops;
 		}
 
-		if (_c2l->isReturnInstruction(*_dryCsInsn))
+		if (insn.is(LinearSweepTable::RETURN))
 		{
 			return false;
 		}
-		if (_c2l->isBranchInstruction(*_dryCsInsn)
-				&& !isBadBranch(_image, _dryCsInsn))
+		if (insn.is(LinearSweepTable::BRANCH)
+				&& !insn.is(LinearSweepTable::MIPS_BAD_BRANCH))
 		{
 			return false;
 		}
 
-		if (_c2l->isReturnInstruction(*_dryCsInsn)
-				|| _c2l->isBranchInstruction(*_dryCsInsn)
-				|| _c2l->isCondBranchInstruction(*_dryCsInsn)
-				|| _c2l->isCallInstruction(*_dryCsInsn))
+		if (insn.is(LinearSweepTable::RETURN)
+				|| insn.is(LinearSweepTable::BRANCH)
+				|| insn.is(LinearSweepTable::COND_BRANCH)
+				|| insn.is(LinearSweepTable::CALL))
 		{
 			cfChangePos = counter;
 		}
@@ -145,6 +144,42 @@ std::size_t Decoder::decodeJumpTargetDryRun_mips(
 	return true;
 }
 
+/**
+ * Classify MIPS instruction @p insn for dry runs.
+ * \return Classification flags from @c LinearSweepTable::eFlag.
+ */
+uint16_t Decoder::classifyDryRunInsn_mips(cs_insn* insn)
+{
+	uint16_t flags = 0;
+
+	if (_abi->isNopInstruction(insn))
+	{
+		flags |= LinearSweepTable::NOP;
+	}
+	if (_c2l->isReturnInstruction(*insn))
+	{
+		flags |= LinearSweepTable::RETURN;
+	}
+	if (_c2l->isBranchInstruction(*insn))
+	{
+		flags |= LinearSweepTable::BRANCH;
+		if (isBadBranch(_image, insn))
+		{
+			flags |= LinearSweepTable::MIPS_BAD_BRANCH;
+		}
+	}
+	if (_c2l->isCondBranchInstruction(*insn))
+	{
+		flags |= LinearSweepTable::COND_BRANCH;
+	}
+	if (_c2l->isCallInstruction(*insn))
+	{
+		flags |= LinearSweepTable::CALL;
+	}
+
+	return flags;
+}
+
 void Decoder::initializeGpReg_mips()
 {
 	if (!_config->getConfig().architecture.isPic32())
@@ -25,18 +25,17 @@ std::size_t Decoder::decodeJumpTargetDryRun_ppc(
 		return true;
 	}
 
-	static csh ce = _c2l->getCapstoneEngine();
-
 	uint64_t addr = jt.getAddress();
 	std::size_t nops = 0;
 	bool first = true;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	LinearSweepTable::Insn insn;
+	while (dryRunDisasm(_c2l->getBasicMode(), bytes, addr, insn))
 	{
 		if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& (first || nops > 0)
-				&& _abi->isNopInstruction(_dryCsInsn))
+				&& insn.is(LinearSweepTable::NOP))
 		{
-			nops += _dryCsInsn->size;
+			nops += insn.size;
 		}
 		else if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& nops > 0)
@@ -44,7 +43,7 @@ std::size_t Decoder::decodeJumpTargetDryRun_ppc(
 			return nops;
 		}
 
-		if (_c2l->isControlFlowInstruction(*_dryCsInsn))
+		if (insn.is(LinearSweepTable::CONTROL_FLOW))
 		{
 			return false;
 		}
@@ -67,5 +66,25 @@ std::size_t Decoder::decodeJumpTargetDryRun_ppc(
 	return true;
 }
 
+/**
+ * Classify PowerPC instruction @p insn for dry runs.
+ * \return Classification flags from @c LinearSweepTable::eFlag.
+ */
+uint16_t Decoder::classifyDryRunInsn_ppc(cs_insn* insn)
+{
+	uint16_t flags = 0;
+
+	if (_abi->isNopInstruction(insn))
+	{
+		flags |= LinearSweepTable::NOP;
+	}
+	if (_c2l->isControlFlowInstruction(*insn))
+	{
+		flags |= LinearSweepTable::CONTROL_FLOW;
+	}
+
+	return flags;
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -25,24 +25,22 @@ std::size_t Decoder::decodeJumpTargetDryRun_x86(
 		return true;
 	}
 
-	static csh ce = _c2l->getCapstoneEngine();
-
 	uint64_t addr = jt.getAddress();
 	std::size_t nops = 0;
 	bool first = true;
 	bool storeOneToEax = false;
 	bool lastSyscall = false;
 	std::size_t decodedSz = 0;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	LinearSweepTable::Insn insn;
+	while (dryRunDisasm(_c2l->getBasicMode(), bytes, addr, insn))
 	{
-		decodedSz += _dryCsInsn->size;
-		auto& detail = _dryCsInsn->detail->x86;
+		decodedSz += insn.size;
 
 		if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& (first || nops > 0)
-				&& _abi->isNopInstruction(_dryCsInsn))
+				&& insn.is(LinearSweepTable::NOP))
 		{
-			nops += _dryCsInsn->size;
+			nops += insn.size;
 		}
 		else if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& nops > 0)
@@ -50,26 +48,18 @@ std::size_t Decoder::decodeJumpTargetDryRun_x86(
 			return nops;
 		}
 
-		if (_c2l->isReturnInstruction(*_dryCsInsn)
-				|| _c2l->isBranchInstruction(*_dryCsInsn))
+		if (insn.is(LinearSweepTable::RETURN)
+				|| insn.is(LinearSweepTable::BRANCH))
 		{
 			return false;
 		}
 
 		// TODO: not very strict - not checking that eax is not overwritten.
-		if (_dryCsInsn->id == X86_INS_MOV
-				&& detail.op_count == 2
-				&& detail.operands[0].type == X86_OP_REG
-				&& detail.operands[0].reg == X86_REG_EAX
-				&& detail.operands[1].type == X86_OP_IMM
-				&& detail.operands[1].imm == 1)
+		if (insn.is(LinearSweepTable::X86_STORE_ONE_TO_EAX))
 		{
 			storeOneToEax = true;
 		}
-		if (_dryCsInsn->id == X86_INS_INT
-				&& detail.op_count == 1
-				&& detail.operands[0].type == X86_OP_IMM
-				&& detail.operands[0].imm == 0x80)
+		if (insn.is(LinearSweepTable::X86_INT_80))
 		{
 			if (storeOneToEax)
 			{
@@ -77,7 +67,7 @@ std::size_t Decoder::decodeJumpTargetDryRun_x86(
 			}
 			lastSyscall = true;
 		}
-		else if (_dryCsInsn->id == X86_INS_SYSCALL)
+		else if (insn.is(LinearSweepTable::X86_SYSCALL))
 		{
 			lastSyscall = true;
 		}
@@ -109,5 +99,51 @@ std::size_t Decoder::decodeJumpTargetDryRun_x86(
 	return true;
 }
 
+/**
+ * Classify x86 instruction @p insn for dry runs.
+ * \return Classification flags from @c LinearSweepTable::eFlag.
+ */
+uint16_t Decoder::classifyDryRunInsn_x86(cs_insn* insn)
+{
+	uint16_t flags = 0;
+	auto& detail = insn->detail->x86;
+
+	if (_abi->isNopInstruction(insn))
+	{
+		flags |= LinearSweepTable::NOP;
+	}
+	if (_c2l->isReturnInstruction(*insn))
+	{
+		flags |= LinearSweepTable::RETURN;
+	}
+	if (_c2l->isBranchInstruction(*insn))
+	{
+		flags |= LinearSweepTable::BRANCH;
+	}
+
+	if (insn->id == X86_INS_MOV
+			&& detail.op_count == 2
+			&& detail.operands[0].type == X86_OP_REG
+			&& detail.operands[0].reg == X86_REG_EAX
+			&& detail.operands[1].type == X86_OP_IMM
+			&& detail.operands[1].imm == 1)
+	{
+		flags |= LinearSweepTable::X86_STORE_ONE_TO_EAX;
+	}
+	if (insn->id == X86_INS_INT
+			&& detail.op_count == 1
+			&& detail.operands[0].type == X86_OP_IMM
+			&& detail.operands[0].imm == 0x80)
+	{
+		flags |= LinearSweepTable::X86_INT_80;
+	}
+	else if (insn->id == X86_INS_SYSCALL)
+	{
+		flags |= LinearSweepTable::X86_SYSCALL;
+	}
+
+	return flags;
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -260,7 +260,7 @@ void DsmGenerator::generateFunction(
 
 void DsmGenerator::getAsmInstructionHex(AsmInstruction& ai, std::ostream& ret)
 {
-	static std::size_t longestHexa = _longestInst * 3 - 1;
+	const std::size_t longestHexa = _longestInst * 3 - 1;
 	const std::size_t aiHexa = ai.getByteSize() * 3 - 1;
 
 	std::vector<std::uint64_t> bytes;
@@ -366,7 +366,7 @@ std::string DsmGenerator::processInstructionDsm(AsmInstruction& ai)
 	std::string comment;
 	if (_config->getConfig().architecture.isX86())
 	{
-		auto* capstoneI = ai.getCapstoneInsn();
+		auto capstoneI = ai.getCapstoneInsn();
 		auto& xi = capstoneI->detail->x86;
 		for (unsigned j = 0; j < xi.op_count; ++j)
 		{
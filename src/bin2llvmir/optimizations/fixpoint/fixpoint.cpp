@@ -0,0 +1,143 @@
+/**
+* @file src/bin2llvmir/optimizations/fixpoint/fixpoint.cpp
+* @brief Run a group of passes until they stop changing the module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+
+#include <llvm/ADT/Hashing.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/IR/InstrTypes.h>
+
+#include "retdec/bin2llvmir/optimizations/fixpoint/fixpoint.h"
+
+using namespace llvm;
+
+namespace retdec {
+namespace bin2llvmir {
+
+char FixpointPassGroup::ID = 0;
+
+/**
+ * @param tlii Target library info for the passes in the group. It should be
+ *             the same as in the outer pass manager, otherwise the passes
+ *             would use the default one.
+ * @param maxIterations Maximal number of runs of the group.
+ */
+FixpointPassGroup::FixpointPassGroup(
+		const llvm::TargetLibraryInfoImpl& tlii,
+		unsigned maxIterations)
+		:
+		ModulePass(ID),
+		_maxIterations(std::max(maxIterations, 1u))
+{
+	_passes.add(new TargetLibraryInfoWrapperPass(tlii));
+	_passes.add(createTargetTransformInfoWrapperPass(TargetIRAnalysis()));
+}
+
+llvm::StringRef FixpointPassGroup::getPassName() const
+{
+	return "Fixpoint Pass Group";
+}
+
+/**
+ * Pass manager to add the passes of the group into.
+ */
+llvm::legacy::PassManager& FixpointPassGroup::getPassManager()
+{
+	return _passes;
+}
+
+/**
+ * \return Number of runs of the group done by the last runOnModule().
+ */
+unsigned FixpointPassGroup::getNumOfIterations() const
+{
+	return _iterations;
+}
+
+bool FixpointPassGroup::runOnModule(llvm::Module& M)
+{
+	bool changed = false;
+	std::size_t fingerprint = getFingerprint(M);
+
+	for (_iterations = 1; ; ++_iterations)
+	{
+		if (!_passes.run(M))
+		{
+			break;
+		}
+		changed = true;
+
+		if (_iterations >= _maxIterations)
+		{
+			break;
+		}
+
+		std::size_t newFingerprint = getFingerprint(M);
+		if (newFingerprint == fingerprint)
+		{
+			break;
+		}
+		fingerprint = newFingerprint;
+	}
+
+	return changed;
+}
+
+/**
+ * Cheap fingerprint of module @p M. It changes when a global variable,
+ * function, basic block, or instruction is added or removed, when
+ * an operand of an instruction or an initializer of a global variable is
+ * replaced, or when a type, a comparison predicate, or optional flags
+ * (e.g. nsw, exact, inbounds, fast-math) of an instruction are changed.
+ * Names, attributes, and metadata are not considered.
+ *
+ * Objects are hashed by their addresses, so a change may be missed in the
+ * unlikely case that an object is replaced by an equal one allocated at
+ * the same address. It only means that the group is not run again.
+ */
+std::size_t FixpointPassGroup::getFingerprint(llvm::Module& M)
+{
+	hash_code h = hash_value(M.size());
+
+	for (GlobalVariable& gv : M.globals())
+	{
+		h = hash_combine(
+				h,
+				&gv,
+				gv.hasInitializer() ? gv.getInitializer() : nullptr);
+	}
+
+	for (Function& f : M)
+	{
+		h = hash_combine(h, &f, f.isDeclaration());
+		for (BasicBlock& bb : f)
+		{
+			h = hash_combine(h, &bb);
+			for (Instruction& i : bb)
+			{
+				h = hash_combine(
+						h,
+						&i,
+						i.getOpcode(),
+						i.getType(),
+						i.getRawSubclassOptionalData());
+				if (auto* cmp = dyn_cast<CmpInst>(&i))
+				{
+					h = hash_combine(h, cmp->getPredicate());
+				}
+				for (Value* op : i.operand_values())
+				{
+					h = hash_combine(h, op);
+				}
+			}
+		}
+	}
+
+	return h;
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
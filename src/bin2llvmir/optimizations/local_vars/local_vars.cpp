@@ -67,7 +67,7 @@ bool LocalVars::runOnModule(Module& M)
 		return false;
 	}
 
-	ReachingDefinitionsAnalysis RDA;
+	auto& RDA = *ReachingDefinitionsProvider::getReachingDefinitions(&M);
 	RDA.runOnModule(M, abi);
 
 	std::set<llvm::Instruction*> uses;
@@ -551,13 +551,16 @@ bool Collector::storesString(StoreInst* si, std::string& str) const
 	return true;
 }
 
-llvm::Value* Collector::getRoot(llvm::Value* i, bool first) const
+llvm::Value* Collector::getRoot(llvm::Value* i) const
+{
+	std::set<llvm::Value*> seen;
+	return getRoot(i, seen);
+}
+
+llvm::Value* Collector::getRoot(
+		llvm::Value* i,
+		std::set<llvm::Value*>& seen) const
 {
-	static std::set<llvm::Value*> seen;
-	if (first)
-	{
-		seen.clear();
-	}
 	if (seen.count(i))
 	{
 		return i;
@@ -574,7 +577,7 @@ llvm::Value* Collector::getRoot(llvm::Value* i, bool first) const
 				auto* d = (*u->defs.begin())->def;
 				if (auto* s = dyn_cast<StoreInst>(d))
 				{
-					return getRoot(s->getValueOperand(), false);
+					return getRoot(s->getValueOperand(), seen);
 				}
 				else
 				{
@@ -583,7 +586,7 @@ llvm::Value* Collector::getRoot(llvm::Value* i, bool first) const
 			}
 			else if (auto* l = dyn_cast<LoadInst>(ii))
 			{
-				return getRoot(l->getPointerOperand(), false);
+				return getRoot(l->getPointerOperand(), seen);
 			}
 			else
 			{
@@ -592,7 +595,7 @@ llvm::Value* Collector::getRoot(llvm::Value* i, bool first) const
 		}
 		else if (auto* l = dyn_cast<LoadInst>(ii))
 		{
-			return getRoot(l->getPointerOperand(), false);
+			return getRoot(l->getPointerOperand(), seen);
 		}
 		else
 		{
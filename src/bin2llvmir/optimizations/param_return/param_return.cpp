@@ -59,7 +59,8 @@ bool ParamReturn::runOnModule(Module& m)
 	_image = FileImageProvider::getFileImage(_module);
 	_dbgf = DebugFormatProvider::getDebugFormat(_module);
 	_lti = LtiProvider::getLti(_module);
-	_collector = CollectorProvider::createCollector(_abi, _module, &_RDA);
+	_RDA = ReachingDefinitionsProvider::getReachingDefinitions(_module);
+	_collector = CollectorProvider::createCollector(_abi, _module, _RDA);
 
 	return run();
 }
@@ -78,7 +79,8 @@ bool ParamReturn::runOnModuleCustom(
 	_image = img;
 	_dbgf = dbgf;
 	_lti = lti;
-	_collector = CollectorProvider::createCollector(_abi, _module, &_RDA);
+	_RDA = ReachingDefinitionsProvider::getReachingDefinitions(_module);
+	_collector = CollectorProvider::createCollector(_abi, _module, _RDA);
 
 	return run();
 }
@@ -91,7 +93,7 @@ bool ParamReturn::run()
 		return false;
 	}
 
-	_RDA.runOnModule(*_module, _abi);
+	_RDA->runOnModule(*_module, _abi);
 
 	collectAllCalls();
 //	dumpInfo();
@@ -99,8 +101,6 @@ bool ParamReturn::run()
 //	dumpInfo();
 	applyToIr();
 
-	_RDA.clear();
-
 	return false;
 }
 
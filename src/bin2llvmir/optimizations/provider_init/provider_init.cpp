@@ -9,6 +9,7 @@
 #include <llvm/Support/CommandLine.h>
 
 #include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
+#include "retdec/bin2llvmir/analyses/reaching_definitions.h"
 #include "retdec/bin2llvmir/analyses/symbolic_tree.h"
 #include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
@@ -39,8 +40,13 @@ cl::opt<std::string> ConfigPath(
 		cl::init("")
 );
 
-ProviderInitialization::ProviderInitialization() :
-		ModulePass(ID)
+/**
+ * @param c In-memory config to use instead of the file in @c -config-path.
+ *          It is updated with the config state at finalization.
+ */
+ProviderInitialization::ProviderInitialization(retdec::config::Config* c) :
+		ModulePass(ID),
+		_config(c)
 {
 
 }
@@ -50,14 +56,17 @@ ProviderInitialization::ProviderInitialization() :
  */
 bool ProviderInitialization::runOnModule(Module& m)
 {
-	static bool firstRun = true;
+	// Providers are initialized only once for each module.
 	std::string confPath = ConfigPath;
-	if (!firstRun || confPath.empty())
+	if (ConfigProvider::getConfig(&m)
+			|| (confPath.empty() && _config == nullptr))
 	{
 		return false;
 	}
 
-	auto* c = ConfigProvider::addConfigFile(&m, confPath);
+	auto* c = _config
+			? ConfigProvider::addConfig(&m, *_config)
+			: ConfigProvider::addConfigFile(&m, confPath);
 	if (c == nullptr)
 	{
 		return false;
@@ -93,9 +102,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 
 	NamesProvider::addNames(&m, c, debug, f, d, lti);
 
-	AsmInstruction::clear();
-
-	firstRun = false;
+	AsmInstruction::clear(&m);
 
 	return false;
 }
@@ -106,8 +113,38 @@ bool ProviderInitialization::runOnModule(Module& m)
 bool ProviderInitialization::doFinalization(Module& m)
 {
 	ConfigProvider::doFinalization(&m);
+
+	auto* c = ConfigProvider::getConfig(&m);
+	if (_config && c)
+	{
+		*_config = c->getConfig();
+	}
+
 	return false;
 }
 
+/**
+ * Remove all provider data associated with the module @a m.
+ * Providers are shared by all the modules processed in parallel. Once
+ * @a m is not needed anymore, its data should be removed, so that they do not
+ * pile up in a long-running process.
+ * The ABI and config that @c SymbolicTree uses in the calling thread are
+ * reset too -- a thread processes one module at a time, so they belong to
+ * @a m.
+ */
+void clearProviders(llvm::Module* m)
+{
+	SymbolicTree::clear();
+	ReachingDefinitionsProvider::clear(m);
+	NamesProvider::clear(m);
+	LtiProvider::clear(m);
+	DebugFormatProvider::clear(m);
+	FileImageProvider::clear(m);
+	DemanglerProvider::clear(m);
+	AbiProvider::clear(m);
+	AsmInstruction::clear(m);
+	ConfigProvider::clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
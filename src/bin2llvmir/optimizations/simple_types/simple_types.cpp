@@ -83,19 +83,22 @@ bool SimpleTypesAnalysis::runOnModule(Module& M)
 	module = &M;
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(module);
 
-	static bool first = true;
-
-	if (first)
+	// Only the first run on the module does the full analysis. The state is
+	// kept in the module's config, so it goes away with the module.
+	if (!config->isSimpleTypesAnalysed())
 	{
-		RDA.runOnModule(M, AbiProvider::getAbi(&M));
+		RDA = ReachingDefinitionsProvider::getReachingDefinitions(&M);
+		RDA->runOnModule(M, AbiProvider::getAbi(&M));
 		buildEqSets(M);
 		buildEquations();
 		eqSets.propagate(module);
 		eqSets.apply(module, config, objf, instToErase);
 		eraseObsoleteInstructions();
 		setGlobalConstants();
-		first = false;
-		RDA.clear();
+		config->setSimpleTypesAnalysed();
+		// No other pass in the default pipeline uses RDA after this one.
+		ReachingDefinitionsProvider::clear(&M);
+		RDA = nullptr;
 	}
 	else
 	{
@@ -401,7 +404,7 @@ void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<
 					}
 					else
 					{
-						auto uses = RDA.usesFromDef(store);
+						auto uses = RDA->usesFromDef(store);
 						for (auto* u : uses)
 						{
 							toProcess.push(u->use);
@@ -527,7 +530,7 @@ void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<
 			}
 			else
 			{
-				auto uses = RDA.usesFromDef(user);
+				auto uses = RDA->usesFromDef(user);
 				for (auto* u : uses)
 				{
 					toProcess.push(u->use);
@@ -762,7 +765,7 @@ std::ostream& operator<<(std::ostream& out, const EqSetContainer& eqs)
 //=============================================================================
 //
 
-unsigned EqSet::newUID = 0;
+thread_local unsigned EqSet::newUID = 0;
 
 EqSet::EqSet() :
 		id(newUID++)
@@ -1228,7 +1231,7 @@ void EqSet::apply(
 
 	LOG << "\napply BEGIN " << id << " =============================\n";
 
-	static auto &conf = config->getConfig();
+	auto& conf = config->getConfig();
 
 	IrModifier irModif(module, config);
 	for (auto& vs : valSet)
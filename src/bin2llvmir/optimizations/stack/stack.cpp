@@ -69,7 +69,7 @@ bool StackAnalysis::run()
 		return false;
 	}
 
-	ReachingDefinitionsAnalysis RDA;
+	auto& RDA = *ReachingDefinitionsProvider::getReachingDefinitions(_module);
 	RDA.runOnModule(*_module, _abi);
 
 	for (auto& f : *_module)
@@ -432,8 +432,12 @@ bool SyscallFixer::runArm_linux_32()
  */
 bool SyscallFixer::runArm_linux_32(AsmInstruction ai)
 {
-	auto* armAsm = ai.getCapstoneInsn();
-	if (armAsm == nullptr || armAsm->id != ARM_INS_SVC)
+	if (ai.getCapstoneInsnId() != ARM_INS_SVC)
+	{
+		return false;
+	}
+	auto armAsm = ai.getCapstoneInsn();
+	if (armAsm == nullptr)
 	{
 		return false;
 	}
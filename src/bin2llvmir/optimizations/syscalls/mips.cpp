@@ -266,8 +266,7 @@ bool SyscallFixer::runMips_linux()
 
 bool SyscallFixer::runMips_linux(AsmInstruction ai)
 {
-	auto* mipsAsm = ai.getCapstoneInsn();
-	if (mipsAsm == nullptr || mipsAsm->id != MIPS_INS_SYSCALL)
+	if (ai.getCapstoneInsnId() != MIPS_INS_SYSCALL)
 	{
 		return false;
 	}
@@ -460,8 +460,12 @@ bool SyscallFixer::runX86_linux_32()
  */
 bool SyscallFixer::runX86_linux_32(AsmInstruction ai)
 {
-	auto* x86Asm = ai.getCapstoneInsn();
-	if (x86Asm == nullptr || x86Asm->id != X86_INS_INT)
+	if (ai.getCapstoneInsnId() != X86_INS_INT)
+	{
+		return false;
+	}
+	auto x86Asm = ai.getCapstoneInsn();
+	if (x86Asm == nullptr)
 	{
 		return false;
 	}
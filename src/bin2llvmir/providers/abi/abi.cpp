@@ -148,9 +148,13 @@ bool Abi::isStackVariable(const Value* val) const
 	return _config->isStackVariable(val);
 }
 
+/**
+ * The decoder decides whether instructions are NOPs when it translates them
+ * and keeps the result with the instruction, so it is not disassembled again.
+ */
 bool Abi::isNopInstruction(AsmInstruction ai)
 {
-	return isNopInstruction(ai.getCapstoneInsn());
+	return ai.isNop();
 }
 
 std::size_t Abi::getTypeByteSize(llvm::Type* t) const
@@ -292,6 +296,7 @@ Config* Abi::getConfig() const
 //
 
 std::map<llvm::Module*, std::unique_ptr<Abi>> AbiProvider::_module2abi;
+std::mutex AbiProvider::_mutex;
 
 Abi* AbiProvider::addAbi(
 		llvm::Module* m,
@@ -302,25 +307,22 @@ Abi* AbiProvider::addAbi(
 		return nullptr;
 	}
 
+	std::unique_ptr<Abi> abi;
 	if (c->getConfig().architecture.isArmOrThumb())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiArm>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiArm>(m, c);
 	}
 	else if (c->getConfig().architecture.isMips())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiMips>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiMips>(m, c);
 	}
 	else if (c->getConfig().architecture.isPic32())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiPic32>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiPic32>(m, c);
 	}
 	else if (c->getConfig().architecture.isPpc())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiPowerpc>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiPowerpc>(m, c);
 	}
 	else if (c->getConfig().architecture.isX86_64())
 	{
@@ -329,25 +331,31 @@ Abi* AbiProvider::addAbi(
 
 		if (isMinGW || c->getConfig().tools.isMsvc())
 		{
-			auto p = _module2abi.emplace(m, std::make_unique<AbiMS_X64>(m, c));
-			return p.first->second.get();
+			abi = std::make_unique<AbiMS_X64>(m, c);
+		}
+		else
+		{
+			abi = std::make_unique<AbiX64>(m, c);
 		}
-
-		auto p = _module2abi.emplace(m, std::make_unique<AbiX64>(m, c));
-		return p.first->second.get();
 	}
 	else if (c->getConfig().architecture.isX86())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiX86>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiX86>(m, c);
 	}
 	// ...
+	else
+	{
+		return nullptr;
+	}
 
-	return nullptr;
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2abi.emplace(m, std::move(abi));
+	return p.first->second.get();
 }
 
 Abi* AbiProvider::getAbi(llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2abi.find(m);
 	return f != _module2abi.end() ? f->second.get() : nullptr;
 }
@@ -360,8 +368,15 @@ bool AbiProvider::getAbi(llvm::Module* m, Abi*& abi)
 
 void AbiProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2abi.clear();
 }
 
+void AbiProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2abi.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -4,6 +4,10 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/InstIterator.h>
 
@@ -19,8 +23,337 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
-std::vector<AsmInstruction::ModuleGlobalPair> AsmInstruction::_module2global;
-std::vector<AsmInstruction::ModuleInstructionMap> AsmInstruction::_module2instMap;
+//
+//==============================================================================
+// CapstoneInsnStore
+//==============================================================================
+//
+
+namespace {
+
+/// Size of memory blocks allocated by CapstoneInsnStore.
+const std::size_t insnStoreBlockSize = 64 * 1024;
+
+} // anonymous namespace
+
+CapstoneInsnStore::CapstoneInsnStore()
+{
+
+}
+
+CapstoneInsnStore::~CapstoneInsnStore()
+{
+	closeHandle();
+}
+
+/**
+ * Keep the compact form of @p insn. The instruction itself is not needed
+ * after this call and can be freed by the caller.
+ * An instruction at the same address and in the same mode is replaced,
+ * instructions at the same address in other modes are kept.
+ * @param insn Decoded instruction, it must contain bytes of the instruction.
+ * @param arch Architecture used to decode @p insn.
+ * @param mode Mode (basic and extra) used to decode @p insn.
+ * @param nop  Is @p insn a NOP instruction?
+ */
+void CapstoneInsnStore::insert(
+		const cs_insn* insn,
+		cs_arch arch,
+		cs_mode mode,
+		bool nop)
+{
+	if (_arch != arch)
+	{
+		closeHandle();
+		_arch = arch;
+	}
+
+	auto mnemonicSize = std::min(std::strlen(insn->mnemonic), std::size_t(255));
+	auto opStrSize = std::min(std::strlen(insn->op_str), std::size_t(255));
+
+	Entry e;
+	e.id = insn->id;
+	e.mode = getModeIndex(mode);
+	e.size = insn->size;
+	e.mnemonicSize = mnemonicSize;
+	e.opStrSize = opStrSize;
+	e.nop = nop;
+
+	char* data = allocate(e.size + mnemonicSize + opStrSize);
+	std::memcpy(data, insn->bytes, e.size);
+	std::memcpy(data + e.size, insn->mnemonic, mnemonicSize);
+	std::memcpy(data + e.size + mnemonicSize, insn->op_str, opStrSize);
+	e.data = data;
+
+	auto it = _entries.find(insn->address);
+	if (it == _entries.end())
+	{
+		_entries.emplace(insn->address, e);
+		++_count;
+		return;
+	}
+
+	// The last inserted instruction is kept in the map, the others are
+	// chained from it. Rebuild the chain without the replaced instruction.
+	//
+	std::vector<const Entry*> others;
+	std::size_t oldCount = 0;
+	for (const Entry* o = &it->second; o; o = o->other)
+	{
+		++oldCount;
+		if (o->mode != e.mode)
+		{
+			others.push_back(o);
+		}
+	}
+	for (auto o = others.rbegin(); o != others.rend(); ++o)
+	{
+		e.other = allocateEntry(**o, e.other);
+	}
+	it->second = e;
+	_count = _count - oldCount + others.size() + 1;
+}
+
+bool CapstoneInsnStore::contains(retdec::utils::Address addr) const
+{
+	return getEntry(addr) != nullptr;
+}
+
+bool CapstoneInsnStore::contains(
+		retdec::utils::Address addr,
+		cs_mode mode) const
+{
+	return getEntry(addr, mode) != nullptr;
+}
+
+/**
+ * @return Capstone ID of the instruction at @p addr, or @c 0 (invalid
+ *         instruction in all architectures) if there is no such instruction.
+ */
+unsigned CapstoneInsnStore::getId(retdec::utils::Address addr) const
+{
+	auto* e = getEntry(addr);
+	return e ? e->id : 0;
+}
+
+std::size_t CapstoneInsnStore::getByteSize(retdec::utils::Address addr) const
+{
+	auto* e = getEntry(addr);
+	return e ? e->size : 0;
+}
+
+/**
+ * @return @c True if the instruction at @p addr was inserted as a NOP
+ *         instruction, @c false otherwise.
+ */
+bool CapstoneInsnStore::isNop(retdec::utils::Address addr) const
+{
+	auto* e = getEntry(addr);
+	return e && e->nop;
+}
+
+std::string CapstoneInsnStore::getDsm(retdec::utils::Address addr) const
+{
+	auto* e = getEntry(addr);
+	if (e == nullptr)
+	{
+		return std::string();
+	}
+
+	const char* mnemonic = e->data + e->size;
+	return std::string(mnemonic, e->mnemonicSize)
+			+ " "
+			+ std::string(mnemonic + e->mnemonicSize, e->opStrSize);
+}
+
+/**
+ * Get a full Capstone instruction (including detail) at @p addr.
+ * It is disassembled again from the kept bytes.
+ * @return Instruction owned by the caller, or @c nullptr if there is no such
+ *         instruction. It stays valid even if the store is changed or
+ *         destroyed.
+ */
+CapstoneInsnPtr CapstoneInsnStore::getCapstoneInsn(
+		retdec::utils::Address addr)
+{
+	return disassemble(getEntry(addr), addr);
+}
+
+/**
+ * Same as @c getCapstoneInsn(), but only the instruction decoded in @p mode
+ * is returned.
+ */
+CapstoneInsnPtr CapstoneInsnStore::getCapstoneInsn(
+		retdec::utils::Address addr,
+		cs_mode mode)
+{
+	return disassemble(getEntry(addr, mode), addr);
+}
+
+/**
+ * @return Number of kept instructions (in all modes).
+ */
+std::size_t CapstoneInsnStore::size() const
+{
+	return _count;
+}
+
+void CapstoneInsnStore::clear()
+{
+	closeHandle();
+	_entries.clear();
+	_count = 0;
+	_blocks.clear();
+	_blockUsed = 0;
+	_blockSize = 0;
+	_modes.clear();
+}
+
+const CapstoneInsnStore::Entry* CapstoneInsnStore::getEntry(
+		retdec::utils::Address addr) const
+{
+	if (addr.isUndefined())
+	{
+		return nullptr;
+	}
+	auto f = _entries.find(addr);
+	return f != _entries.end() ? &f->second : nullptr;
+}
+
+const CapstoneInsnStore::Entry* CapstoneInsnStore::getEntry(
+		retdec::utils::Address addr,
+		cs_mode mode) const
+{
+	auto m = std::find(_modes.begin(), _modes.end(), mode);
+	if (m == _modes.end())
+	{
+		return nullptr;
+	}
+
+	auto idx = static_cast<uint8_t>(m - _modes.begin());
+	for (auto* e = getEntry(addr); e; e = e->other)
+	{
+		if (e->mode == idx)
+		{
+			return e;
+		}
+	}
+	return nullptr;
+}
+
+char* CapstoneInsnStore::allocate(std::size_t size, std::size_t align)
+{
+	std::size_t used = (_blockUsed + align - 1) / align * align;
+	if (_blocks.empty() || used + size > _blockSize)
+	{
+		_blockSize = std::max(insnStoreBlockSize, size);
+		_blocks.emplace_back(new char[_blockSize]);
+		used = 0;
+	}
+
+	char* ret = _blocks.back().get() + used;
+	_blockUsed = used + size;
+	return ret;
+}
+
+/**
+ * Copy @p e into the memory blocks and chain @p other from the copy.
+ */
+const CapstoneInsnStore::Entry* CapstoneInsnStore::allocateEntry(
+		const Entry& e,
+		const Entry* other)
+{
+	auto* mem = allocate(sizeof(Entry), alignof(Entry));
+	auto* ret = new (mem) Entry(e);
+	ret->other = other;
+	return ret;
+}
+
+uint8_t CapstoneInsnStore::getModeIndex(cs_mode mode)
+{
+	auto it = std::find(_modes.begin(), _modes.end(), mode);
+	if (it == _modes.end())
+	{
+		it = _modes.insert(_modes.end(), mode);
+	}
+	return static_cast<uint8_t>(it - _modes.begin());
+}
+
+/**
+ * Disassemble the instruction @p e located at @p addr again.
+ */
+CapstoneInsnPtr CapstoneInsnStore::disassemble(const Entry* e, uint64_t addr)
+{
+	if (e == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto mode = _modes[e->mode];
+	if (_handle == 0)
+	{
+		if (cs_open(_arch, mode, &_handle) != CS_ERR_OK)
+		{
+			_handle = 0;
+			return nullptr;
+		}
+		cs_option(_handle, CS_OPT_DETAIL, CS_OPT_ON);
+		_handleMode = mode;
+	}
+	else if (mode != _handleMode
+			&& cs_option(_handle, CS_OPT_MODE, mode) == CS_ERR_OK)
+	{
+		_handleMode = mode;
+	}
+
+	CapstoneInsnPtr insn(cs_malloc(_handle));
+	auto* bytes = reinterpret_cast<const uint8_t*>(e->data);
+	std::size_t size = e->size;
+	uint64_t address = addr;
+	if (cs_disasm_iter(_handle, &bytes, &size, &address, insn.get()))
+	{
+		return insn;
+	}
+
+	// Decoder uses MIPS64 mode for instructions MIPS32 mode fails on.
+	if (_arch == CS_ARCH_MIPS && (mode & CS_MODE_MIPS32))
+	{
+		auto mode64 = static_cast<cs_mode>(
+				(mode & ~CS_MODE_MIPS32) | CS_MODE_MIPS64);
+		if (cs_option(_handle, CS_OPT_MODE, mode64) == CS_ERR_OK)
+		{
+			_handleMode = mode64;
+			bytes = reinterpret_cast<const uint8_t*>(e->data);
+			size = e->size;
+			address = addr;
+			if (cs_disasm_iter(_handle, &bytes, &size, &address, insn.get()))
+			{
+				return insn;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void CapstoneInsnStore::closeHandle()
+{
+	if (_handle != 0)
+	{
+		cs_close(&_handle);
+		_handle = 0;
+	}
+}
+
+//
+//==============================================================================
+// AsmInstruction
+//==============================================================================
+//
+
+std::map<const llvm::Module*, llvm::GlobalVariable*> AsmInstruction::_module2global;
+std::map<const llvm::Module*, CapstoneInsnStore> AsmInstruction::_module2insnStore;
+std::mutex AsmInstruction::_mutex;
 
 AsmInstruction::AsmInstruction()
 {
@@ -182,41 +515,27 @@ const llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariablePrivate(
 	}
 }
 
-Llvm2CapstoneInsnMap& AsmInstruction::getLlvmToCapstoneInsnMap(
+CapstoneInsnStore& AsmInstruction::getCapstoneInsnStore(
 		const llvm::Module* m)
 {
-	for (auto& p : _module2instMap)
-	{
-		if (p.first == m)
-		{
-			return p.second;
-		}
-	}
-
-	auto it = _module2instMap.emplace(_module2instMap.end(), std::make_pair(
-			m,
-			std::map<llvm::StoreInst*, cs_insn*>()));
-	return it->second;
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _module2insnStore[m];
 }
 
 llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariable(
 		const llvm::Module* m)
 {
-	for (auto& p : _module2global)
-	{
-		if (p.first == m)
-		{
-			return p.second;
-		}
-	}
-	return nullptr;
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto f = _module2global.find(m);
+	return f != _module2global.end() ? f->second : nullptr;
 }
 
 void AsmInstruction::setLlvmToAsmGlobalVariable(
 		const llvm::Module* m,
 		llvm::GlobalVariable* gv)
 {
-	_module2global.emplace_back(m, gv);
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2global[m] = gv;
 }
 
 retdec::utils::Address AsmInstruction::getInstructionAddress(
@@ -271,8 +590,16 @@ bool AsmInstruction::isLlvmToAsmInstruction(const llvm::Value* inst)
 
 void AsmInstruction::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2global.clear();
-	_module2instMap.clear();
+	_module2insnStore.clear();
+}
+
+void AsmInstruction::clear(const llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2global.erase(m);
+	_module2insnStore.erase(m);
 }
 
 bool AsmInstruction::isValid() const
@@ -285,29 +612,50 @@ bool AsmInstruction::isInvalid() const
 	return !isValid();
 }
 
-cs_insn* AsmInstruction::getCapstoneInsn() const
+CapstoneInsnStore* AsmInstruction::getCapstoneInsnStorePrivate() const
 {
-	for (auto& p : _module2instMap)
-	{
-		if (p.first == _llvmToAsmInstr->getModule())
-		{
-			auto it =  p.second.find(_llvmToAsmInstr);
-			return it != p.second.end() ? it->second : nullptr;
-		}
-	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto f = _module2insnStore.find(_llvmToAsmInstr->getModule());
+	return f != _module2insnStore.end() ? &f->second : nullptr;
+}
 
-	return nullptr;
+/**
+ * Get the full Capstone instruction. It is disassembled again, so prefer
+ * getCapstoneInsnId(), getDsm(), getByteSize() and isNop() if they are
+ * sufficient. The returned instruction is owned by the caller.
+ */
+CapstoneInsnPtr AsmInstruction::getCapstoneInsn() const
+{
+	auto* store = getCapstoneInsnStorePrivate();
+	return store ? store->getCapstoneInsn(getAddress()) : nullptr;
+}
+
+/**
+ * @return @c True if this instruction was decoded as a NOP instruction.
+ */
+bool AsmInstruction::isNop() const
+{
+	auto* store = getCapstoneInsnStorePrivate();
+	return store && store->isNop(getAddress());
+}
+
+/**
+ * @return Capstone ID of this instruction, or @c 0 if it is not known.
+ */
+unsigned AsmInstruction::getCapstoneInsnId() const
+{
+	auto* store = getCapstoneInsnStorePrivate();
+	return store ? store->getId(getAddress()) : 0;
 }
 
 std::string AsmInstruction::getDsm() const
 {
-	auto* i = getCapstoneInsn();
-	return std::string(i->mnemonic) + " " + std::string(i->op_str);
+	return getCapstoneInsnStorePrivate()->getDsm(getAddress());
 }
 
 std::size_t AsmInstruction::getByteSize() const
 {
-	return getCapstoneInsn()->size;
+	return getCapstoneInsnStorePrivate()->getByteSize(getAddress());
 }
 
 retdec::utils::Address AsmInstruction::getAddress() const
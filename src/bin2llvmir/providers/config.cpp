@@ -42,7 +42,7 @@ Config Config::fromFile(llvm::Module* m, const std::string& path)
 	if (!config._configPath.empty())
 	{
 		// Can throw an exception, but it is catched by bin2llvmirl.
-		config._configDB.readJsonFile(config._configPath);
+		config._configDB.readFile(config._configPath);
 	}
 
 	for (auto& s : config.getConfig().structures)
@@ -79,6 +79,26 @@ Config Config::fromJsonString(llvm::Module* m, const std::string& json)
 	return config;
 }
 
+Config Config::fromConfig(llvm::Module* m, const retdec::config::Config& c)
+{
+	Config config;
+	config._module = m;
+	config._configDB = c;
+
+	for (auto& s : config.getConfig().structures)
+	{
+		llvm_utils::stringToLlvmType(m->getContext(), s.getLlvmIr());
+	}
+
+	// TODO: needed?
+	if (config.getConfig().tools.isPic32())
+	{
+		config.getConfig().architecture.setIsPic32();
+	}
+
+	return config;
+}
+
 /**
  * Save the config to reflect changes that have been done to it in
  * the bin2llvmirl.
@@ -89,7 +109,7 @@ void Config::doFinalization()
 
 	if (!_configPath.empty())
 	{
-		_configDB.generateJsonFile(_configPath);
+		_configDB.generateFile(_configPath);
 	}
 }
 
@@ -420,6 +440,29 @@ llvm::GlobalVariable* Config::getLlvmRegister(
 	return cr ? _module->getNamedGlobal(cr->getName()) : nullptr;
 }
 
+/**
+ * @return @c True if the full simple types analysis has already run on the
+ *         module, @c false otherwise. Later runs in the pipeline do only its
+ *         light version.
+ */
+bool Config::isSimpleTypesAnalysed() const
+{
+	return _simpleTypesAnalysed;
+}
+
+void Config::setSimpleTypesAnalysed()
+{
+	_simpleTypesAnalysed = true;
+}
+
+/**
+ * @return Number of the next dump of the module (see @c dumpModuleToFile()).
+ */
+unsigned Config::getNextDumpNumber()
+{
+	return _dumpNumber++;
+}
+
 /**
  * @return Always returns the same dummy global variable.
  */
@@ -744,10 +787,13 @@ void Config::tagFunctionsWithUsedCryptoGlobals()
 //
 
 std::map<llvm::Module*, Config> ConfigProvider::_module2config;
+std::mutex ConfigProvider::_mutex;
 
 Config* ConfigProvider::addConfigFile(llvm::Module* m, const std::string& path)
 {
-	auto p = _module2config.emplace(m, Config::fromFile(m, path));
+	auto c = Config::fromFile(m, path);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2config.emplace(m, std::move(c));
 	return &p.first->second;
 }
 
@@ -755,12 +801,29 @@ Config* ConfigProvider::addConfigJsonString(
 		llvm::Module* m,
 		const std::string& json)
 {
-	auto p = _module2config.emplace(m, Config::fromJsonString(m, json));
+	auto c = Config::fromJsonString(m, json);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2config.emplace(m, std::move(c));
+	return &p.first->second;
+}
+
+/**
+ * Add a copy of the given in-memory config. No config file is associated
+ * with it, so it is not written anywhere at finalization.
+ */
+Config* ConfigProvider::addConfig(
+		llvm::Module* m,
+		const retdec::config::Config& c)
+{
+	auto config = Config::fromConfig(m, c);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2config.emplace(m, std::move(config));
 	return &p.first->second;
 }
 
 Config* ConfigProvider::getConfig(llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2config.find(m);
 	return f != _module2config.end() ? &f->second : nullptr;
 }
@@ -785,8 +848,18 @@ void ConfigProvider::doFinalization(llvm::Module* m)
  */
 void ConfigProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2config.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void ConfigProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2config.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
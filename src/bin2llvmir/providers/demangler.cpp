@@ -12,6 +12,7 @@ namespace retdec {
 namespace bin2llvmir {
 
 std::map<Module*, DemanglerProvider::Demangler> DemanglerProvider::_module2demangler;
+std::mutex DemanglerProvider::_mutex;
 
 /**
  * Create and add to provider a demangler for the given module @a m
@@ -42,6 +43,7 @@ retdec::demangler::CDemangler* DemanglerProvider::addDemangler(
 		d = retdec::demangler::CDemangler::createGcc();
 	}
 
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto p = _module2demangler.insert(std::make_pair(m, std::move(d)));
 
 	return p.first->second.get();
@@ -53,6 +55,7 @@ retdec::demangler::CDemangler* DemanglerProvider::addDemangler(
  */
 retdec::demangler::CDemangler* DemanglerProvider::getDemangler(llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2demangler.find(m);
 	return f != _module2demangler.end() ? f->second.get() : nullptr;
 }
@@ -78,8 +81,18 @@ bool DemanglerProvider::getDemangler(
  */
 void DemanglerProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2demangler.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void DemanglerProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2demangler.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -504,7 +504,7 @@ llvm::Constant* FileImage::getConstant(
 			refGvs.push_back(newGv);
 			addr += Abi::getTypeByteSize(_module, Abi::getDefaultType(_module));
 
-			static auto& conf = config->getConfig();
+			auto& conf = config->getConfig();
 			if (conf.globals.getObjectByAddress(addr))
 			{
 				break;
@@ -623,6 +623,7 @@ bool FileImage::isImportTerminating(
 //
 
 std::map<llvm::Module*, FileImage> FileImageProvider::_module2image;
+std::mutex FileImageProvider::_mutex;
 
 /**
  * Create and add to provider a file image created from file at @a path for
@@ -656,6 +657,7 @@ FileImage* FileImageProvider::addFileImage(
 		llvm::Module* m,
 		FileImage img)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto p = _module2image.emplace(m, std::move(img));
 	return &p.first->second;
 }
@@ -667,6 +669,7 @@ FileImage* FileImageProvider::addFileImage(
 FileImage* FileImageProvider::getFileImage(
 		llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2image.find(m);
 	return f != _module2image.end() ? &f->second : nullptr;
 }
@@ -692,8 +695,18 @@ bool FileImageProvider::getFileImage(
  */
 void FileImageProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2image.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void FileImageProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2image.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
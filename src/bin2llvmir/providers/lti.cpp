@@ -7,6 +7,9 @@
 #include <fstream>
 #include <iostream>
 
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/FileSystem.h>
+
 #include "retdec/ctypes/floating_point_type.h"
 #include "retdec/ctypes/function_type.h"
 #include "retdec/ctypes/integral_type.h"
@@ -307,18 +310,99 @@ void Lti::loadLtiFile(const std::string& filePath)
 		{"unsigned __int3264", 32} // this has the same size as arch size
 	};
 
+	std::string cc = "cdecl";
+	if (retdec::utils::containsCaseInsensitive(filePath, "win"))
+	{
+		cc = "stdcall";
+	}
+
+	if (loadLtiIndex(filePath, typeWidths, cc))
+	{
+		return;
+	}
+
 	std::ifstream file(filePath);
 	if (file)
 	{
-		std::string cc = "cdecl";
-		if (retdec::utils::containsCaseInsensitive(filePath, "win"))
-		{
-			cc = "stdcall";
-		}
-		_ltiParser.parseInto(file, _ltiModule, typeWidths, cc);
+		// Every file has its own context, so that a function is always
+		// taken from the first file that has it (see getLtiFunction()).
+		LtiFile ltiFile;
+		ltiFile.module = std::make_unique<retdec::ctypes::Module>(
+				std::make_shared<retdec::ctypes::Context>());
+		_ltiParser.parseInto(file, ltiFile.module, typeWidths, cc);
+		_ltiFiles.push_back(std::move(ltiFile));
 	}
 }
 
+/**
+ * Use the index of JSON types file @c filePath if there is an up-to-date one.
+ * The index has the same name as the JSON file, but the @c .lti suffix. It is
+ * memory-mapped and functions from it are parsed only when they are asked
+ * for in getLtiFunction(). The index is up to date if it was created from the
+ * JSON file of the current size and modification time. The JSON file itself
+ * is not read.
+ * @return @c True if the index is used, @c false otherwise.
+ */
+bool Lti::loadLtiIndex(
+		const std::string& filePath,
+		const ctypesparser::CTypesParser::TypeWidths& typeWidths,
+		const std::string& callConv)
+{
+	std::string indexPath = filePath;
+	if (retdec::utils::endsWith(indexPath, ".json"))
+	{
+		indexPath.erase(indexPath.size() - 5);
+	}
+	indexPath += ".lti";
+
+	llvm::sys::fs::file_status jsonStatus;
+	if (!llvm::sys::fs::exists(indexPath)
+			|| llvm::sys::fs::status(filePath, jsonStatus))
+	{
+		return false;
+	}
+
+	auto buffer = MemoryBuffer::getFile(
+			indexPath,
+			-1,
+			/*RequiresNullTerminator=*/false);
+	if (!buffer)
+	{
+		return false;
+	}
+
+	auto index = std::make_unique<ctypesparser::IndexedCTypesParser>(
+			static_cast<unsigned>(
+					_config->getConfig().architecture.getBitSize()));
+	try
+	{
+		index->open(
+				(*buffer)->getBufferStart(),
+				(*buffer)->getBufferSize(),
+				std::make_shared<retdec::ctypes::Context>(),
+				typeWidths,
+				callConv);
+	}
+	catch (const ctypesparser::CTypesParseError&)
+	{
+		return false;
+	}
+
+	// The JSON file has changed since the index was created.
+	if (!index->isCreatedFrom(
+			jsonStatus.getSize(),
+			llvm::sys::toTimeT(jsonStatus.getLastModificationTime())))
+	{
+		return false;
+	}
+
+	LtiFile ltiFile;
+	ltiFile.index = std::move(index);
+	ltiFile.indexBuffer = std::move(*buffer);
+	_ltiFiles.push_back(std::move(ltiFile));
+	return true;
+}
+
 bool Lti::hasLtiFunction(const std::string& name)
 {
 	return getLtiFunction(name) != nullptr;
@@ -327,7 +411,24 @@ bool Lti::hasLtiFunction(const std::string& name)
 std::shared_ptr<retdec::ctypes::Function> Lti::getLtiFunction(
 		const std::string& name)
 {
-	return _ltiModule->getFunctionWithName(name);
+	if (auto f = _ltiModule->getFunctionWithName(name))
+	{
+		return f;
+	}
+
+	for (auto& ltiFile : _ltiFiles)
+	{
+		auto f = ltiFile.index
+				? ltiFile.index->getFunction(name)
+				: ltiFile.module->getFunctionWithName(name);
+		if (f)
+		{
+			_ltiModule->addFunction(f);
+			return f;
+		}
+	}
+
+	return nullptr;
 }
 
 /**
@@ -446,6 +547,7 @@ llvm::Type* Lti::getLlvmType(std::shared_ptr<retdec::ctypes::Type> type)
 //
 
 std::map<llvm::Module*, Lti> LtiProvider::_module2lti;
+std::mutex LtiProvider::_mutex;
 
 Lti* LtiProvider::addLti(
 		llvm::Module* m,
@@ -457,12 +559,15 @@ Lti* LtiProvider::addLti(
 		return nullptr;
 	}
 
-	auto p = _module2lti.emplace(m, Lti(m, c, objf));
+	Lti lti(m, c, objf);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2lti.emplace(m, std::move(lti));
 	return &p.first->second;
 }
 
 Lti* LtiProvider::getLti(llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2lti.find(m);
 	return f != _module2lti.end() ? &f->second : nullptr;
 }
@@ -475,8 +580,15 @@ bool LtiProvider::getLti(llvm::Module* m, Lti*& lti)
 
 void LtiProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2lti.clear();
 }
 
+void LtiProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2lti.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -548,6 +548,7 @@ bool NameContainer::loadImportOrds(const std::string& libName)
 //
 
 std::map<llvm::Module*, NameContainer> NamesProvider::_module2names;
+std::mutex NamesProvider::_mutex;
 
 NameContainer* NamesProvider::addNames(
 		llvm::Module* m,
@@ -566,12 +567,15 @@ NameContainer* NamesProvider::addNames(
 		return nullptr;
 	}
 
-	auto p = _module2names.emplace(m, NameContainer(m, c, d, i, dm, lti));
+	NameContainer names(m, c, d, i, dm, lti);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2names.emplace(m, std::move(names));
 	return &p.first->second;
 }
 
 NameContainer* NamesProvider::getNames(llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2names.find(m);
 	return f != _module2names.end() ? &f->second : nullptr;
 }
@@ -584,8 +588,15 @@ bool NamesProvider::getNames(llvm::Module* m, NameContainer*& names)
 
 void NamesProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2names.clear();
 }
 
+void NamesProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2names.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -13,6 +13,7 @@
 #include <llvm/Support/Casting.h>
 
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
+#include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/names.h"
 #include "retdec/bin2llvmir/utils/debug.h"
 #include "retdec/utils/address.h"
@@ -56,10 +57,15 @@ void dumpModuleToFile(
 		utils::FilesystemPath dirName,
 		const std::string& fileName)
 {
-	static unsigned cntr = 0;
-	std::string n = fileName.empty()
-			? "dump_" + std::to_string(cntr++) + ".ll"
-			: fileName;
+	std::string n = fileName;
+	if (n.empty())
+	{
+		// Dumps are numbered per module.
+		auto* config = ConfigProvider::getConfig(const_cast<llvm::Module*>(m));
+		n = "dump_"
+				+ std::to_string(config ? config->getNextDumpNumber() : 0)
+				+ ".ll";
+	}
 
 	dirName.append(n);
 
@@ -176,7 +182,7 @@ void dumpControFlowToJsonBasicBlock(
 		llvm::BasicBlock& bbEnd,
 		std::ostream &out)
 {
-	static auto* config = ConfigProvider::getConfig(bb.getModule());
+	auto* config = ConfigProvider::getConfig(bb.getModule());
 
 	auto start = getBasicBlockAddress(&bb);
 	auto end = getBasicBlockEndAddress(&bbEnd);
@@ -291,7 +297,7 @@ void dumpControFlowToJsonFunction(
 		llvm::Function& f,
 		std::ostream &out)
 {
-	static auto* config = ConfigProvider::getConfig(f.getParent());
+	auto* config = ConfigProvider::getConfig(f.getParent());
 
 	auto start = getFunctionAddress(&f);
 	auto end = getFunctionEndAddress(&f);
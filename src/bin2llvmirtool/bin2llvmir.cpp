@@ -6,20 +6,34 @@
  * Optimizations may be specified an arbitrary number of times on the command
  * line, They are run in the order specified.
  *
+ * If @c -backend-output is given, the resulting module is also converted into
+ * the target high-level language by llvmir2hll in this process. The module is
+ * not written into bitcode and parsed again in such a case. Bitcode is written
+ * only if @c -o is given as well.
+ *
+ * If @c -profile-output is given, time, memory, and module size are recorded
+ * for every pass (and every back-end phase) and written into the given file.
+ *
  * Created by taking LLVM's tool opt, removing all unneeded code, and adding
  * some code specific to our purpose.
  */
 
 #include <algorithm>
+#include <climits>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/CallGraph.h>
 #include <llvm/Analysis/CallGraphSCCPass.h>
+#include <llvm/Analysis/LoopInfo.h>
 #include <llvm/Analysis/LoopPass.h>
 #include <llvm/Analysis/RegionPass.h>
+#include <llvm/Analysis/ScalarEvolution.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeWriterPass.h>
@@ -52,9 +66,15 @@
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 
+#include "retdec/bin2llvmir/optimizations/fixpoint/fixpoint.h"
+#include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
+#include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/llvm-support/diagnostics.h"
+#include "retdec/llvmir2hll/decompiler.h"
+#include "retdec/llvmir2hll/decompiler_command_line.h"
 #include "retdec/utils/memory.h"
 #include "retdec/utils/conversion.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 
 using namespace llvm;
@@ -112,6 +132,62 @@ static cl::opt<bool>
 DisableSimplifyLibCalls("disable-simplify-libcalls",
 		cl::desc("Disable simplify-libcalls"));
 
+// Passes between -fixpoint-begin and -fixpoint-end are run as a group, which is
+// run again only if its previous run changed the module. It replaces listing
+// the same passes several times in a row.
+//
+static cl::list<bool>
+FixpointBegin("fixpoint-begin",
+		cl::desc("Start a group of passes that is run repeatedly until "
+				"it stops changing the module."));
+
+static cl::list<bool>
+FixpointEnd("fixpoint-end",
+		cl::desc("End the group of passes started by -fixpoint-begin."));
+
+static cl::opt<unsigned>
+FixpointMaxIterations("fixpoint-max-iterations",
+		cl::desc("Maximal number of runs of a -fixpoint-begin group."),
+		cl::init(FixpointPassGroup::DEFAULT_MAX_ITERATIONS));
+
+enum class ProfileFormat
+{
+	JSON,
+	CHROME_TRACE
+};
+
+static cl::opt<std::string>
+ProfileOutputFilename("profile-output",
+		cl::desc("Record time, memory, and module size for every pass "
+				"and write them into the given file."),
+		cl::value_desc("filename"));
+
+static cl::opt<ProfileFormat>
+ProfileOutputFormat("profile-format",
+		cl::desc("Format of the -profile-output file."),
+		cl::values(
+				clEnumValN(ProfileFormat::JSON, "json",
+						"JSON with one object per pass (default)"),
+				clEnumValN(ProfileFormat::CHROME_TRACE, "chrome-trace",
+						"Chrome trace event format")),
+		cl::init(ProfileFormat::JSON));
+
+// Back-end (llvmir2hll) options. They are the same as the options of
+// retdec-llvmir2hll, only prefixed with "backend-".
+//
+static cl::OptionCategory
+BackendCategory("Back-end options (used only with -backend-output)");
+
+static cl::opt<std::string>
+BackendOutputFilename("backend-output",
+		cl::desc("Convert the module into the target HLL in this process "
+				"and write the generated code into the given file."),
+		cl::value_desc("filename"),
+		cl::cat(BackendCategory));
+
+static retdec::llvmir2hll::DecompilerCommandLine
+BackendOptions("backend-", BackendCategory);
+
 /**
  * These passes are considered to be from LLVM, not from RetDec.
  * We do not want to write phase information for each of them.
@@ -227,6 +303,13 @@ class ModulePassPrinter : public ModulePass
 				retdec::llvm_support::printPhase(PhaseName);
 			}
 
+			// LLVM passes are profiled one by one, even if they are printed
+			// as a single phase.
+			retdec::utils::Profiler::getInstance().startPhase(
+					PhaseName,
+					0,
+					"bin2llvmir");
+
 			// LastPhase gets updated every time.
 			LastPhase = PhaseName;
 
@@ -306,6 +389,78 @@ void limitMaximalMemoryIfRequested()
 	}
 }
 
+/**
+ * Enable profiling of passes if requested on the command line.
+ * The sizes of module @p M are recorded for every pass.
+ */
+void enableProfilingIfRequested(Module* M)
+{
+	if (ProfileOutputFilename.empty())
+	{
+		return;
+	}
+
+	auto& profiler = retdec::utils::Profiler::getInstance();
+	profiler.enable();
+	profiler.setSizesGetter([M]()
+	{
+		std::size_t fncs = 0;
+		std::size_t bbs = 0;
+		std::size_t insns = 0;
+		for (Function& F : *M)
+		{
+			if (F.isDeclaration())
+			{
+				continue;
+			}
+			++fncs;
+			for (BasicBlock& BB : F)
+			{
+				++bbs;
+				insns += BB.size();
+			}
+		}
+
+		return retdec::utils::Profiler::Sizes{
+				{"functions", fncs},
+				{"basicBlocks", bbs},
+				{"instructions", insns},
+				{"globalVariables", M->global_size()}};
+	});
+}
+
+/**
+ * Write the recorded profile if requested on the command line.
+ */
+void writeProfileIfRequested()
+{
+	if (ProfileOutputFilename.empty())
+	{
+		return;
+	}
+
+	auto& profiler = retdec::utils::Profiler::getInstance();
+	profiler.endPhases();
+	profiler.setSizesGetter(nullptr);
+
+	std::ofstream out(ProfileOutputFilename);
+	if (!out)
+	{
+		throw std::runtime_error(
+			"failed to open profile output file: " + ProfileOutputFilename
+		);
+	}
+
+	if (ProfileOutputFormat == ProfileFormat::CHROME_TRACE)
+	{
+		profiler.printChromeTrace(out);
+	}
+	else
+	{
+		profiler.printJson(out);
+	}
+}
+
 /**
  * Call a bunch of LLVM initialization functions, same as the original opt.
  */
@@ -408,6 +563,80 @@ std::unique_ptr<ToolOutputFile> createAssemblyOutputFile()
 	return Out;
 }
 
+/**
+ * Create back-end output file object.
+ */
+std::unique_ptr<ToolOutputFile> createBackendOutputFile()
+{
+	std::error_code EC;
+	auto Out = std::make_unique<ToolOutputFile>(
+			BackendOutputFilename,
+			EC,
+			sys::fs::F_None);
+	if (EC)
+	{
+		throw std::runtime_error(
+			"failed to create llvm::ToolOutputFile for back-end: " + EC.message()
+		);
+	}
+
+	return Out;
+}
+
+/**
+ * Get the back-end options given on the command line.
+ */
+retdec::llvmir2hll::DecompilerOptions getBackendOptions()
+{
+	auto options = BackendOptions.getOptions();
+	options.outputFile = BackendOutputFilename;
+	return options;
+}
+
+/**
+ * Convert the lifted module @p M into the target HLL by llvmir2hll.
+ * The module and the config are passed to llvmir2hll in memory.
+ */
+void runBackend(Module& M)
+{
+	auto* c = retdec::bin2llvmir::ConfigProvider::getConfig(&M);
+	if (c == nullptr)
+	{
+		throw std::runtime_error("back-end needs a config (-config-path)");
+	}
+
+	// Providers are not needed anymore. Keep only the config state.
+	retdec::config::Config config = c->getConfig();
+	retdec::bin2llvmir::clearProviders(&M);
+
+	std::unique_ptr<ToolOutputFile> Out = createBackendOutputFile();
+	auto* decompiler = new retdec::llvmir2hll::Decompiler(
+			Out->os(),
+			getBackendOptions(),
+			&config);
+
+	legacy::PassManager Passes;
+	Passes.add(new TargetLibraryInfoWrapperPass(
+			TargetLibraryInfoImpl(Triple(M.getTargetTriple()))));
+	Passes.add(new LoopInfoWrapperPass());
+	Passes.add(new ScalarEvolutionWrapperPass());
+	Passes.add(decompiler);
+	Passes.run(M);
+
+	if (!decompiler->wasSuccessful())
+	{
+		throw std::runtime_error("decompilation of LLVM IR failed");
+	}
+
+	// Save changes done by the back-end, same as retdec-llvmir2hll does.
+	if (!config.getConfigFileName().empty())
+	{
+		config.generateFile(config.getConfigFileName());
+	}
+
+	Out->keep();
+}
+
 /**
  * Real main -- it does all the work.
  */
@@ -433,6 +662,13 @@ int _main(int argc, char **argv)
 	LLVMContext Context;
 	std::unique_ptr<Module> M = createLlvmModule(Context);
 
+	// Initialization is profiled since the options are known.
+	enableProfilingIfRequested(M.get());
+	retdec::utils::Profiler::getInstance().startPhase(
+			"Initialization",
+			0,
+			"bin2llvmir");
+
 	// Add an appropriate TargetLibraryInfo pass for the module's triple.
 	Triple ModuleTriple(M->getTargetTriple());
 	TargetLibraryInfoImpl TLII(ModuleTriple);
@@ -453,9 +689,52 @@ int _main(int argc, char **argv)
 			Passes,
 			createTargetTransformInfoWrapperPass(TargetIRAnalysis()));
 
+	// Positions of -fixpoint-begin (true) and -fixpoint-end (false) markers.
+	std::vector<std::pair<unsigned, bool>> fixpointMarkers;
+	for (unsigned i = 0; i < FixpointBegin.size(); ++i)
+	{
+		fixpointMarkers.emplace_back(FixpointBegin.getPosition(i), true);
+	}
+	for (unsigned i = 0; i < FixpointEnd.size(); ++i)
+	{
+		fixpointMarkers.emplace_back(FixpointEnd.getPosition(i), false);
+	}
+	std::sort(fixpointMarkers.begin(), fixpointMarkers.end());
+
+	// Open and close fixpoint groups whose markers precede the given position.
+	FixpointPassGroup* fixpoint = nullptr;
+	auto nextMarker = fixpointMarkers.begin();
+	auto processFixpointMarkers = [&](unsigned position)
+	{
+		for (; nextMarker != fixpointMarkers.end()
+				&& nextMarker->first < position; ++nextMarker)
+		{
+			if (nextMarker->second)
+			{
+				if (fixpoint)
+				{
+					throw std::runtime_error("nested -fixpoint-begin");
+				}
+				fixpoint = new FixpointPassGroup(TLII, FixpointMaxIterations);
+				Passes.add(fixpoint);
+			}
+			else
+			{
+				if (fixpoint == nullptr)
+				{
+					throw std::runtime_error(
+							"-fixpoint-end without -fixpoint-begin");
+				}
+				fixpoint = nullptr;
+			}
+		}
+	};
+
 	// Create a new optimization pass for each one specified on the command line
 	for (unsigned i = 0; i < PassList.size(); ++i)
 	{
+		processFixpointMarkers(PassList.getPosition(i));
+
 		const PassInfo *PassInf = PassList[i];
 		Pass *P = nullptr;
 		if (PassInf->getNormalCtor())
@@ -474,32 +753,46 @@ int _main(int argc, char **argv)
 
 		if (P)
 		{
-			addPassWithPossibleVerification(Passes, P);
+			addPassWithPossibleVerification(
+					fixpoint ? fixpoint->getPassManager() : Passes,
+					P);
 		}
 	}
 
+	processFixpointMarkers(UINT_MAX);
+	if (fixpoint)
+	{
+		throw std::runtime_error("-fixpoint-begin without -fixpoint-end");
+	}
+
 	// Check that the module is well formed on completion of optimization
 	if (!NoVerify && !VerifyEach)
 	{
 		addPassWithoutVerification(Passes, createVerifierPass());
 	}
 
-	// Write bitcode to the output as the last step.
-	std::unique_ptr<ToolOutputFile> bcOut = createBitcodeOutputFile();
-	raw_ostream *bcOs = &bcOut->os();
-	bool PreserveBitcodeUseListOrder = false;
-	addPassWithoutVerification(
-			Passes,
-			createBitcodeWriterPass(*bcOs, PreserveBitcodeUseListOrder));
-
-	// Write assembly to the output as the last step.
-	std::unique_ptr<ToolOutputFile> llOut = createAssemblyOutputFile();
-	raw_ostream *llOs = &llOut->os();
-	bool PreserveAssemblyUseListOrder = false;
-	addPassWithoutVerification(
-			Passes,
-			createPrintModulePass(*llOs, "", PreserveAssemblyUseListOrder),
-			"Assembly Writer"); // original name = "Print module to stderr"
+	// Bitcode and assembly are optional if the back-end runs in this process.
+	std::unique_ptr<ToolOutputFile> bcOut;
+	std::unique_ptr<ToolOutputFile> llOut;
+	if (BackendOutputFilename.empty() || !OutputFilename.empty())
+	{
+		// Write bitcode to the output as the last step.
+		bcOut = createBitcodeOutputFile();
+		raw_ostream *bcOs = &bcOut->os();
+		bool PreserveBitcodeUseListOrder = false;
+		addPassWithoutVerification(
+				Passes,
+				createBitcodeWriterPass(*bcOs, PreserveBitcodeUseListOrder));
+
+		// Write assembly to the output as the last step.
+		llOut = createAssemblyOutputFile();
+		raw_ostream *llOs = &llOut->os();
+		bool PreserveAssemblyUseListOrder = false;
+		addPassWithoutVerification(
+				Passes,
+				createPrintModulePass(*llOs, "", PreserveAssemblyUseListOrder),
+				"Assembly Writer"); // original name = "Print module to stderr"
+	}
 
 	// Before executing passes, print the final values of the LLVM options.
 	cl::PrintOptionValues();
@@ -507,10 +800,32 @@ int _main(int argc, char **argv)
 	// Now that we have all of the passes ready, run them.
 	Passes.run(*M);
 
+	if (!BackendOutputFilename.empty())
+	{
+		// Phases of the back-end are profiled as sub-phases of this one.
+		retdec::llvm_support::printPhase("Back-end");
+		retdec::utils::Profiler::getInstance().startPhase(
+				"Back-end",
+				0,
+				"bin2llvmir");
+		runBackend(*M);
+	}
+
 	// Declare success.
 	retdec::llvm_support::printPhase("Cleanup");
-	bcOut->keep();
-	llOut->keep();
+	retdec::utils::Profiler::getInstance().startPhase(
+			"Cleanup",
+			0,
+			"bin2llvmir");
+	if (bcOut)
+	{
+		bcOut->keep();
+	}
+	if (llOut)
+	{
+		llOut->keep();
+	}
+	writeProfileIfRequested();
 	return EXIT_SUCCESS;
 }
 
@@ -235,12 +235,17 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 		const uint8_t*& bytes,
 		std::size_t& size,
 		retdec::utils::Address& a,
-		llvm::IRBuilder<>& irb)
+		llvm::IRBuilder<>& irb,
+		cs_insn* insn)
 {
 	TranslationResultOne res;
 
-	// We want to keep all Capstone instructions -> alloc a new one each time.
-	cs_insn* insn = cs_malloc(_handle);
+	// Unless the caller reuses its own instruction, alloc a new one each time.
+	bool ownInsn = insn == nullptr;
+	if (ownInsn)
+	{
+		insn = cs_malloc(_handle);
+	}
 
 	uint64_t address = a;
 	_branchGenerated = nullptr;
@@ -268,7 +273,7 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 
 		a = address;
 	}
-	else
+	else if (ownInsn)
 	{
 		cs_free(insn, 1);
 	}
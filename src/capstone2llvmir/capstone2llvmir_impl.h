@@ -76,7 +76,8 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 				const uint8_t*& bytes,
 				std::size_t& size,
 				retdec::utils::Address& a,
-				llvm::IRBuilder<>& irb) override;
+				llvm::IRBuilder<>& irb,
+				cs_insn* insn = nullptr) override;
 //
 //==============================================================================
 // Capstone related getters - from Capstone2LlvmIrTranslator.
@@ -270,32 +270,161 @@ const Function* FunctionContainer::getFunctionByName(const std::string& name) co
 
 /**
  * @return Pointer to function or @c nullptr if not found.
+ * If there are more functions starting at @a addr, the one with the lowest
+ * name is returned.
  */
-Function* FunctionContainer::getFunctionByStartAddress(const retdec::utils::Address& addr)
+Function* FunctionContainer::getFunctionByStartAddress(
+		const retdec::utils::Address& addr)
 {
-	for (auto& elem : _data)
+	return likeConstVersion(
+			this, &FunctionContainer::getFunctionByStartAddress, addr);
+}
+
+/// const version of getFunctionByStartAddress().
+const Function* FunctionContainer::getFunctionByStartAddress(
+		const retdec::utils::Address& addr) const
+{
+	for (auto it = _addr2name.lower_bound({addr, std::string()});
+			it != _addr2name.end() && it->first == addr;
+			++it)
 	{
-		if (addr == elem.second.getStart())
+		// Skip entries of functions modified in place.
+		auto* f = getElementById(it->second);
+		if (f && f->getStart() == addr)
 		{
-			return &elem.second;
+			return f;
 		}
 	}
 
 	return nullptr;
 }
 
+/**
+ * @return Pointer to function or @c nullptr if not found.
+ * If there are more functions with real name @a name, the one with the
+ * lowest name is returned.
+ */
 Function* FunctionContainer::getFunctionByRealName(const std::string& name)
 {
-	for (auto& elem : _data)
+	return likeConstVersion(
+			this, &FunctionContainer::getFunctionByRealName, name);
+}
+
+/// const version of getFunctionByRealName().
+const Function* FunctionContainer::getFunctionByRealName(
+		const std::string& name) const
+{
+	for (auto it = _realName2name.lower_bound({name, std::string()});
+			it != _realName2name.end() && it->first == name;
+			++it)
 	{
-		if (name == elem.second.getRealName())
+		// Skip entries of functions modified in place.
+		auto* f = getElementById(it->second);
+		if (f && f->getRealName() == name)
 		{
-			return &elem.second;
+			return f;
 		}
 	}
 
 	return nullptr;
 }
 
+/**
+ * Set start and end addresses of function @a name and update the start
+ * address index.
+ * @return Pointer to the modified function or @c nullptr if not found.
+ */
+Function* FunctionContainer::setFunctionStartEnd(
+		const std::string& name,
+		const retdec::utils::Address& start,
+		const retdec::utils::Address& end)
+{
+	auto* f = getElementById(name);
+	if (f == nullptr)
+	{
+		return nullptr;
+	}
+
+	_addr2name.erase({f->getStart(), f->getName()});
+	f->setStartEnd(start, end);
+	_addr2name.emplace(f->getStart(), f->getName());
+	return f;
+}
+
+/**
+ * Set real name of function @a name and update the real name index.
+ * @return Pointer to the modified function or @c nullptr if not found.
+ */
+Function* FunctionContainer::setFunctionRealName(
+		const std::string& name,
+		const std::string& realName)
+{
+	auto* f = getElementById(name);
+	if (f == nullptr)
+	{
+		return nullptr;
+	}
+
+	_realName2name.erase({f->getRealName(), f->getName()});
+	f->setRealName(realName);
+	_realName2name.emplace(f->getRealName(), f->getName());
+	return f;
+}
+
+/**
+ * See @c BaseAssociativeContainer::insert().
+ * Indexes are updated to reflect the inserted function.
+ */
+std::pair<FunctionContainer::iterator,bool> FunctionContainer::insert(
+		const Function& e)
+{
+	auto* existing = getElementById(e.getId());
+	if (existing)
+	{
+		removeFromIndexes(*existing);
+	}
+
+	auto retPair = BaseAssociativeContainer::insert(e);
+	addToIndexes(retPair.first->second);
+	return retPair;
+}
+
+/**
+ * Erase from both underlying container and indexes.
+ */
+size_t FunctionContainer::erase(const std::string& name)
+{
+	auto* existing = getElementById(name);
+	if (existing == nullptr)
+	{
+		return 0;
+	}
+
+	removeFromIndexes(*existing);
+	return _data.erase(name);
+}
+
+/**
+ * Clear both underlying container and indexes.
+ */
+void FunctionContainer::clear()
+{
+	_data.clear();
+	_addr2name.clear();
+	_realName2name.clear();
+}
+
+void FunctionContainer::addToIndexes(const Function& f)
+{
+	_addr2name.emplace(f.getStart(), f.getName());
+	_realName2name.emplace(f.getRealName(), f.getName());
+}
+
+void FunctionContainer::removeFromIndexes(const Function& f)
+{
+	_addr2name.erase({f.getStart(), f.getName()});
+	_realName2name.erase({f.getRealName(), f.getName()});
+}
+
 } // namespace config
 } // namespace retdec
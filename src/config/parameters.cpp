@@ -11,6 +11,7 @@ namespace {
 const std::string JSON_verboseOut               = "verboseOut";
 const std::string JSON_keepAllFuncs             = "keepAllFuncs";
 const std::string JSON_selectedDecodeOnly       = "selectedDecodeOnly";
+const std::string JSON_linearSweepPrepass       = "linearSweepPrepass";
 const std::string JSON_outputFile               = "outputFile";
 const std::string JSON_ordinalNumDir            = "ordinalNumDirectory";
 const std::string JSON_userStaticSigPaths       = "userStaticSignPaths";
@@ -52,6 +53,14 @@ bool Parameters::isKeepAllFunctions() const
  */
 bool Parameters::isSelectedDecodeOnly() const { return _selectedDecodeOnly; }
 
+/**
+ * @return Disassemble ranges to decode by linear sweep before decoding.
+ */
+bool Parameters::isLinearSweepPrepass() const
+{
+	return _linearSweepPrepass;
+}
+
 /**
  * Find out if some functions or ranges were selected in selective decompilation.
  * @return @c True if @c selectedFunctions or @c selectedRanges not empty,
@@ -92,6 +101,11 @@ void Parameters::setIsSelectedDecodeOnly(bool b)
 	_selectedDecodeOnly = b;
 }
 
+void Parameters::setIsLinearSweepPrepass(bool b)
+{
+	_linearSweepPrepass = b;
+}
+
 void Parameters::setOutputFile(const std::string& n)
 {
 	_outputFile = n;
@@ -123,6 +137,7 @@ Json::Value Parameters::getJsonValue() const
 	params[JSON_verboseOut]         = isVerboseOutput();
 	params[JSON_keepAllFuncs]       = isKeepAllFunctions();
 	params[JSON_selectedDecodeOnly] = isSelectedDecodeOnly();
+	params[JSON_linearSweepPrepass] = isLinearSweepPrepass();
 	params[JSON_outputFile]         = getOutputFile();
 
 	if (!getOrdinalNumbersDirectory().empty()) params[JSON_ordinalNumDir] = getOrdinalNumbersDirectory();
@@ -154,6 +169,7 @@ void Parameters::readJsonValue(const Json::Value& val)
 	setIsVerboseOutput( safeGetBool(val, JSON_verboseOut, false) );
 	setIsKeepAllFunctions( safeGetBool(val, JSON_keepAllFuncs) );
 	setIsSelectedDecodeOnly( safeGetBool(val, JSON_selectedDecodeOnly) );
+	setIsLinearSweepPrepass( safeGetBool(val, JSON_linearSweepPrepass) );
 	setOrdinalNumbersDirectory( safeGetString(val, JSON_ordinalNumDir) );
 	setOutputFile( safeGetString(val, JSON_outputFile) );
 
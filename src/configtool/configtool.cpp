@@ -14,6 +14,7 @@
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/filesystem_path.h"
 #include "retdec/utils/string.h"
+#include "retdec/yara-cache/yara_cache.h"
 
 enum errcode_t
 {
@@ -38,6 +39,7 @@ void printHelp()
 	std::cout << "retdec-configtool <config_file> --read  [R_OPTION...]  prints comma-separated list of values for options" << std::endl;
 	std::cout << "retdec-configtool <config_file> --write [W_OPTION...]  sets options to proviede values" << std::endl;
 	std::cout << "retdec-configtool <config_file> --preprocess           allows only whitelisted values to remain in the config file" << std::endl;
+	std::cout << "retdec-configtool <config_file> --convert {json,binary} converts the config file into the given format" << std::endl;
 	std::cout << std::endl;
 	std::cout << "R_OPTION:" << std::endl;
 	std::cout << "\t--compiler" << std::endl;
@@ -70,6 +72,7 @@ void printHelp()
 	std::cout << "\t--unpacked-in-file path" << std::endl;
 	std::cout << "\t--output-file path" << std::endl;
 	std::cout << "\t--decode-only-selected true/false" << std::endl;
+	std::cout << "\t--linear-sweep-prepass true/false" << std::endl;
 	std::cout << "\t--selected-func name" << std::endl;
 	std::cout << "\t--selected-range range" << std::endl;
 	std::cout << "\t--set-fnc-fixed fncName" << std::endl;
@@ -91,7 +94,8 @@ void getDirFiles(const std::string &dirPath, std::vector<std::string> &ret, cons
 			getDirFiles(f->getPath(), ret, suffixes);
 		}
 		else if (f->isFile()
-				&& hasEnding(f->getPath(), suffixes))
+				&& hasEnding(f->getPath(), suffixes)
+				&& !retdec::yara_cache::isCachedRuleFile(f->getPath()))
 		{
 			auto p = fsp.separator() == '\\'
 					? retdec::utils::replaceAll(f->getPath(), "\\", "/")
@@ -126,7 +130,7 @@ int handleArguments(std::vector<std::string> &args)
 
 	try
 	{
-		config.readJsonFile(configName);
+		config.readFile(configName);
 	}
 	catch (const retdec::config::Exception& e)
 	{
@@ -341,6 +345,10 @@ int handleArguments(std::vector<std::string> &args)
 			{
 				config.parameters.setIsSelectedDecodeOnly( (val == "true") ? (true) : (false) );
 			}
+			else if (opt == "--linear-sweep-prepass")
+			{
+				config.parameters.setIsLinearSweepPrepass( (val == "true") ? (true) : (false) );
+			}
 			else if (opt == "--selected-func")
 			{
 				config.parameters.selectedFunctions.insert(val);
@@ -371,6 +379,7 @@ int handleArguments(std::vector<std::string> &args)
 		newConfig.setEntryPoint(config.getEntryPoint());
 		newConfig.setImageBase(config.getImageBase());
 		newConfig.setIsIda(config.isIda());
+		newConfig.setIsBinary(config.isBinary());
 
 		newConfig.functions = config.functions;
 		newConfig.globals = config.globals;
@@ -380,16 +389,21 @@ int handleArguments(std::vector<std::string> &args)
 		newConfig.vtables = config.vtables;
 		newConfig.classes = config.classes;
 
-		newConfig.generateJsonFile(configName);
+		newConfig.generateFile(configName);
 		return ERROR_OK;
 	}
+	else if (args[1] == "--convert" && args.size() == 3
+			&& (args[2] == "json" || args[2] == "binary"))
+	{
+		config.setIsBinary(args[2] == "binary");
+	}
 	else
 	{
 		printHelp();
 		return ERROR_PARAMETER;
 	}
 
-	config.generateJsonFile(configName);
+	config.generateFile(configName);
 	return ERROR_OK;
 }
 
@@ -12,6 +12,7 @@
 #include "retdec/cpdetect/compiler_detector/compiler_detector.h"
 #include "retdec/cpdetect/settings.h"
 #include "retdec/cpdetect/utils/version_solver.h"
+#include "retdec/yara-cache/yara_cache.h"
 #include "yaracpp/yara_detector/yara_detector.h"
 
 using namespace retdec::fileformat;
@@ -203,7 +204,7 @@ bool CompilerDetector::getExternalDatabases()
 			{
 				return endsWith(subpath->getPath(), suffix);
 			}
-		))
+		) && !yara_cache::isCachedRuleFile(subpath->getPath()))
 		{
 			result = true;
 			externalDatabase.push_back(subpath->getPath());
@@ -311,7 +312,7 @@ void CompilerDetector::populateInternalPaths(
 			{
 				return endsWith(subpath->getPath(), suffix);
 			}
-		))
+		) && !yara_cache::isCachedRuleFile(subpath->getPath()))
 		{
 			internalPaths.push_back(subpath->getPath());
 		}
@@ -339,14 +340,13 @@ void CompilerDetector::getAllHeuristics()
  */
 ReturnCode CompilerDetector::getAllSignatures()
 {
-	YaraDetector yara;
+	yara_cache::RuleFiles ruleFiles;
 
 	// Add internal paths.
 	unsigned iCntr = 0;
 	for (const auto &ruleFile : internalPaths)
 	{
-		std::string nameSpace = "internal_" + std::to_string(iCntr++);
-		yara.addRuleFile(ruleFile, nameSpace);
+		ruleFiles.emplace_back(ruleFile, "internal_" + std::to_string(iCntr++));
 	}
 
 	unsigned eCntr = 0;
@@ -354,23 +354,22 @@ ReturnCode CompilerDetector::getAllSignatures()
 	{
 		for (const auto &item : externalDatabase)
 		{
-			std::string nameSpace = "external_" + std::to_string(eCntr++);
-			yara.addRuleFile(item, nameSpace);
+			ruleFiles.emplace_back(item, "external_" + std::to_string(eCntr++));
 		}
 	}
 
-	yara.analyze(fileParser.getPathToFile(), cpParams.searchType != SearchType::EXACT_MATCH);
-	const auto &detected = yara.getDetectedRules();
-	const auto &undetected = yara.getUndetectedRules();
+	std::vector<const YaraRule*> detected, undetected;
+	yara_cache::scanFile(ruleFiles, fileParser.getPathToFile(), detected,
+		cpParams.searchType != SearchType::EXACT_MATCH ? &undetected : nullptr);
 	auto result = false;
 	if (cpParams.searchType == SearchType::EXACT_MATCH
 			|| (cpParams.searchType == SearchType::MOST_SIMILAR && !detected.empty()))
 	{
-		for (const auto &rule : detected)
+		for (const auto *rule : detected)
 		{
-			const auto *match = rule.getFirstMatch();
-			const auto *nameMeta = rule.getMeta("name");
-			const auto *patternMeta = rule.getMeta("pattern");
+			const auto *match = rule->getFirstMatch();
+			const auto *nameMeta = rule->getMeta("name");
+			const auto *patternMeta = rule->getMeta("pattern");
 			if (!match || !nameMeta || !patternMeta)
 			{
 				continue;
@@ -379,12 +378,12 @@ ReturnCode CompilerDetector::getAllSignatures()
 			if (nibbles)
 			{
 				result = true;
-				const auto *toolMeta = rule.getMeta("tool");
-				const auto *versionMeta = rule.getMeta("version");
-				const auto *commentMeta = rule.getMeta("comment");
-				const auto *languageMeta = rule.getMeta("language");
-				const auto *bytecodeMeta = rule.getMeta("bytecode");
-				commentMeta = commentMeta ? commentMeta : rule.getMeta("extra");
+				const auto *toolMeta = rule->getMeta("tool");
+				const auto *versionMeta = rule->getMeta("version");
+				const auto *commentMeta = rule->getMeta("comment");
+				const auto *languageMeta = rule->getMeta("language");
+				const auto *bytecodeMeta = rule->getMeta("bytecode");
+				commentMeta = commentMeta ? commentMeta : rule->getMeta("extra");
 				toolInfo.addTool(nibbles, nibbles, toolMeta ? metaToTool(toolMeta->getStringValue()) : ToolType::UNKNOWN,
 					nameMeta->getStringValue(), versionMeta ? versionMeta->getStringValue() : "", commentMeta ? commentMeta->getStringValue() : "");
 				if (languageMeta)
@@ -400,12 +399,12 @@ ReturnCode CompilerDetector::getAllSignatures()
 	Similarity sim;
 	double maxRatio = 0.0;
 
-	for (const auto &rules : {detected, undetected})
+	for (const auto *rules : {&detected, &undetected})
 	{
-		for (const auto &rule : rules)
+		for (const auto *rule : *rules)
 		{
-			const auto *nameMeta = rule.getMeta("name");
-			auto *patternMeta = rule.getMeta("pattern");
+			const auto *nameMeta = rule->getMeta("name");
+			auto *patternMeta = rule->getMeta("pattern");
 			if (!nameMeta || !patternMeta)
 			{
 				continue;
@@ -415,11 +414,11 @@ ReturnCode CompilerDetector::getAllSignatures()
 			{
 				pattern.pop_back();
 			}
-			const auto *match = rule.getFirstMatch();
-			const auto *toolMeta = rule.getMeta("tool");
-			const auto *versionMeta = rule.getMeta("version");
-			const auto *commentMeta = rule.getMeta("comment");
-			commentMeta = commentMeta ? commentMeta : rule.getMeta("extra");
+			const auto *match = rule->getFirstMatch();
+			const auto *toolMeta = rule->getMeta("tool");
+			const auto *versionMeta = rule->getMeta("version");
+			const auto *commentMeta = rule->getMeta("comment");
+			commentMeta = commentMeta ? commentMeta : rule->getMeta("extra");
 			if (match)
 			{
 				const auto nibbles = search->countImpNibbles(pattern);
@@ -434,7 +433,7 @@ ReturnCode CompilerDetector::getAllSignatures()
 			}
 
 			std::size_t base = 0;
-			const auto *absoluteStartMeta = rule.getMeta("absoluteStart");
+			const auto *absoluteStartMeta = rule->getMeta("absoluteStart");
 			if (absoluteStartMeta)
 			{
 				if (!strToNum(absoluteStartMeta->getStringValue(), base))
@@ -452,8 +451,8 @@ ReturnCode CompilerDetector::getAllSignatures()
 			}
 
 			std::size_t startShift = 0, endShift = 0;
-			const auto *startMeta = rule.getMeta("start");
-			const auto *endMeta = rule.getMeta("end");
+			const auto *startMeta = rule->getMeta("start");
+			const auto *endMeta = rule->getMeta("end");
 			if (startMeta)
 			{
 				startShift = startMeta->getIntValue();
@@ -29,6 +29,8 @@ const std::map<std::string, std::set<std::string>> dynamicLanguagesMap =
 	{"libgfortran.so", {"Fortran"}}
 };
 
+const std::string upxMagic = "UPX!";
+
 } // anonymous namespace
 
 namespace retdec {
@@ -64,8 +66,8 @@ void ElfHeuristics::getUpxHeuristics()
 	auto strength = DetectionStrength::MEDIUM;
 
 	const auto fileLen = fileParser.getLoadedFileLength();
-	if (search.hasString("UPX!", 0, 0xFF)
-			|| search.hasString("UPX!", fileLen - 0x40, fileLen - 1))
+	if (search.hasString(upxMagic, 0, 0xFF)
+			|| search.hasString(upxMagic, fileLen - 0x40, fileLen - 1))
 	{
 		addPacker(source, strength, "UPX", getUpxVersion());
 	}
@@ -170,6 +172,11 @@ void ElfHeuristics::getDynamicEntriesHeuristics()
 	} // dynamic tables loop
 }
 
+void ElfHeuristics::registerFormatSpecificPatterns()
+{
+	search.registerString(upxMagic);
+}
+
 void ElfHeuristics::getFormatSpecificCompilerHeuristics()
 {
 	getUpxHeuristics();
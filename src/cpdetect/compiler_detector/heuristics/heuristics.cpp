@@ -30,6 +30,8 @@ const std::size_t MINIMUM_RUST_FUNCTIONS = 5;
 const std::size_t MINIMUM_GHC_SYMBOLS = 15;
 const std::size_t MINIMUM_GHC_RECORD_SIZE = 9; // "GHC X.X.X"
 
+const std::string upxIdPrefix = "$Id: UPX ";
+
 /**
  * Delphi version names
  *
@@ -941,19 +943,38 @@ std::string Heuristics::getUpxVersion()
 	if (fileParser.isElf() || fileParser.isMacho())
 	{
 		// format: $Id: UPX x.xx
-		const std::string pattern = "$Id: UPX ";
-		const auto &content = search.getPlainString();
-		const auto pos = content.find(pattern);
+		const auto content = search.getPlainString();
+		const auto pos = search.findString(upxIdPrefix);
 		const std::size_t versionLen = 4;
-		if (pos <= content.length() - pattern.length() - versionLen)
+		if (pos <= content.size() - upxIdPrefix.length() - versionLen)
 		{
-			return content.substr(pos + pattern.length(), versionLen);
+			return content.substr(pos + upxIdPrefix.length(), versionLen).str();
 		}
 	}
 
 	return "";
 }
 
+/**
+ * Register patterns searched by common heuristics
+ */
+void Heuristics::registerCommonPatterns()
+{
+	if (fileParser.isElf() || fileParser.isMacho())
+	{
+		search.registerString(upxIdPrefix);
+	}
+}
+
+/**
+ * Register patterns searched by heuristics which are specific for one file format
+ *
+ * All registered patterns are found in one pass over the file.
+ */
+void Heuristics::registerFormatSpecificPatterns()
+{
+}
+
 /**
  * Get all compiler heuristics which are specific for one file format
  */
@@ -973,6 +994,10 @@ void Heuristics::getFormatSpecificLanguageHeuristics()
  */
 void Heuristics::getAllHeuristics()
 {
+	// Declare searched patterns up front so that they are found in one pass
+	registerCommonPatterns();
+	registerFormatSpecificPatterns();
+
 	// Detect languages
 	getCommonLanguageHeuristics();
 	getFormatSpecificLanguageHeuristics();
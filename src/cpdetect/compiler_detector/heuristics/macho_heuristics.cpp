@@ -11,6 +11,13 @@ using namespace retdec::fileformat;
 namespace retdec {
 namespace cpdetect {
 
+namespace
+{
+
+const std::string upxMagic = "UPX!";
+
+} // anonymous namespace
+
 /**
  * Constructor
  * @param parser Parser of input file
@@ -40,7 +47,7 @@ void MachOHeuristics::getUpxHeuristic()
 	auto source = DetectionMethod::STRING_SEARCH_H;
 	auto strength = DetectionStrength::MEDIUM;
 
-	if (search.hasString("UPX!", 0, 0x400))
+	if (search.hasString(upxMagic, 0, 0x400))
 	{
 		addPacker(source, strength, "UPX", getUpxVersion());
 	}
@@ -127,6 +134,11 @@ void MachOHeuristics::getImportTableHeuristic()
 	}
 }
 
+void MachOHeuristics::registerFormatSpecificPatterns()
+{
+	search.registerString(upxMagic);
+}
+
 void MachOHeuristics::getFormatSpecificCompilerHeuristics()
 {
 	getUpxHeuristic();
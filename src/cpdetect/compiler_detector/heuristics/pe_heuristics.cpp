@@ -92,6 +92,35 @@ const std::vector<std::string> dotNetShrinkPatterns =
 	"20E6EA19BE28--------13--2039EA19BE28--------13--11--11--161F4028--------26;"
 };
 
+const std::vector<std::string> reactorSignatures =
+{
+	"558BECB90F0000006A006A004975F951535657B8--------E8;",
+	"5266686E204D182276B5331112330C6D0A204D18229EA129611C76B505190158;"
+};
+
+const std::string phoenixSignature =
+	"0000010B160C----------0208----------0D0906085961D21304091E630861D21305070811051E62110460D19D081758;";
+const std::string assemblyInvokeSignature = "282D00000A6F2E00000A14146F2F00000A;";
+const std::string cliSecureSignature = "436C69005300650063007500720065;";
+
+const std::string goBuildId = "\xFF Go build ID: ";
+const std::string upxOldVersionPrefix = "UPX 1.0";
+const std::string upxMagic = "UPX!";
+const std::string fsgMagic = "FSG!";
+const std::string peCompactPrefix = "PEC2";
+const std::string peCompactString = "PECompact2";
+const std::string enigmaMagic = "\0\0\0ENIGMA"s;
+const std::string enigmaVersionPrefix = "Enigma protector v";
+const std::string adeptProtectorString = "ByAdeptProtector";
+const std::string staThreadString = "STAThreadAttribute";
+const std::string netSpiderString = "Protected_By_Attribute\0NETSpider.Attribute"s;
+const std::string reNetPackString = "Protected/Packed with ReNET-Pack by stx";
+const std::string netzString = "\0NetzStarter\0netz\0"s;
+const std::string phoenixResourcesString = "?.resources";
+const std::string excelsiorString = "ExcelsiorII1";
+const std::string borlandDelphiString = "SOFTWARE\\Borland\\Delphi\\RTL\0FPUMaskValue"s;
+const std::string beRoString = "Compiled by: BeRoTinyPascal - (C) Copyright 2006, Benjamin";
+
 const std::string msvcRuntimeString = "Microsoft Visual C++ Runtime Library";
 
 const std::vector<std::string> msvcRuntimeStrings =
@@ -177,14 +206,12 @@ std::string PeHeuristics::getEnigmaVersion()
 		}
 	}
 
-	const std::string pattern = "\0\0\0ENIGMA"s;
-	const auto &content = search.getPlainString();
-	const auto pos = content.find(pattern, sec->getOffset());
+	const auto pos = search.findString(enigmaMagic, sec->getOffset());
 	if (pos < sec->getOffset() + sec->getLoadedSize())
 	{
 		std::uint64_t result1, result2;
-		if (fileParser.get1ByteOffset(pos + pattern.length(), result1)
-				&& fileParser.get1ByteOffset(pos + pattern.length() + 1, result2))
+		if (fileParser.get1ByteOffset(pos + enigmaMagic.length(), result1)
+				&& fileParser.get1ByteOffset(pos + enigmaMagic.length() + 1, result2))
 		{
 			return numToStr(result1) + "." + numToStr(result2);
 		}
@@ -201,10 +228,10 @@ std::string PeHeuristics::getEnigmaVersion()
  */
 std::string PeHeuristics::getUpxAdditionalInfo(std::size_t metadataPos)
 {
-	const auto& content = search.getPlainString();
+	const auto content = search.getPlainString();
 
 	std::string info;
-	if (content.length() > metadataPos + 6)
+	if (content.size() > metadataPos + 6)
 	{
 		switch (content[metadataPos + 6])
 		{
@@ -234,7 +261,7 @@ std::string PeHeuristics::getUpxAdditionalInfo(std::size_t metadataPos)
 				break;
 		}
 
-		if (content.length() > metadataPos + 29)
+		if (content.size() > metadataPos + 29)
 		{
 			info += info.empty() ? "" : " ";
 
@@ -261,13 +288,12 @@ void PeHeuristics::getGoHeuristics()
 		return;
 	}
 
-	const auto goString = "\xFF Go build ID: ";
-	if (section->getBytes(0, 15) == goString)
+	if (section->getBytes(0, goBuildId.length()) == goBuildId)
 	{
 		addCompiler(source, DetectionStrength::MEDIUM, "gc");
 		addLanguage("Go");
 	}
-	else if (search.hasStringInSection(goString, section))
+	else if (search.hasStringInSection(goBuildId, section))
 	{
 		// Go build ID not on start of section
 		addCompiler(source, DetectionStrength::LOW, "gc");
@@ -290,10 +316,10 @@ void PeHeuristics::getAutoItHeuristics()
 		addPriorityLanguage("AutoIt", "", true);
 	}
 
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 	const auto *rsrc = fileParser.getSection(".rsrc");
-	if (rsrc && rsrc->getOffset() < content.length()
-			&& findAutoIt(content.substr(rsrc->getOffset())))
+	if (rsrc && rsrc->getOffset() < content.size()
+			&& findAutoIt(content.substr(rsrc->getOffset()).str()))
 	{
 		addCompiler(source, strength, "Aut2Exe");
 		addPriorityLanguage("AutoIt", "", true);
@@ -436,14 +462,14 @@ void PeHeuristics::getEzirizReactorHeuristics()
 		const auto *sec0 = peParser.getPeSection(0);
 		const auto *sec1 = peParser.getPeSection(1);
 
-		if (sec0 && search.findUnslashedSignature("558BECB90F0000006A006A004975F951535657B8--------E8;",
+		if (sec0 && search.findUnslashedSignature(reactorSignatures[0],
 			sec0->getOffset(), sec0->getOffset() + sec0->getLoadedSize() - 1))
 		{
 			version = "3.X";
 		}
 		else if (sec1
 				&& sec1->getPeCoffFlags() == 0xC0000040
-				&& search.findUnslashedSignature("5266686E204D182276B5331112330C6D0A204D18229EA129611C76B505190158;",
+				&& search.findUnslashedSignature(reactorSignatures[1],
 					sec1->getOffset(), sec1->getOffset() + sec1->getLoadedSize() - 1))
 		{
 			version = "4.8 - 5.0";
@@ -492,10 +518,9 @@ void PeHeuristics::getUpxHeuristics()
 
 	// UPX 1.00 - UPX 1.07
 	// format: UPX 1.0x
-	const std::string upxVer = "UPX 1.0";
-	const auto &content = search.getPlainString();
-	auto pos = content.find(upxVer);
-	if (pos < 0x500 && pos < content.length() - upxVer.length())
+	const auto content = search.getPlainString();
+	auto pos = search.findString(upxOldVersionPrefix);
+	if (pos < 0x500 && pos < content.size() - upxOldVersionPrefix.length())
 	{
 		// we must decide between UPX and UPX$HiT
 		source = DetectionMethod::COMBINED;
@@ -509,7 +534,7 @@ void PeHeuristics::getUpxHeuristics()
 		else
 		{
 			const std::string versionPrefix = "1.0";
-			addPacker(source, strength, "UPX", versionPrefix + content[pos + upxVer.length()]);
+			addPacker(source, strength, "UPX", versionPrefix + content[pos + upxOldVersionPrefix.length()]);
 		}
 
 		return;
@@ -518,15 +543,15 @@ void PeHeuristics::getUpxHeuristics()
 	// UPX 1.08 and later
 	// format: x.xx'\0'UPX!
 	const std::size_t minPos = 5, verLen = 4;
-	pos = content.find("UPX!");
+	pos = search.findString(upxMagic);
 	if (pos >= minPos && pos < 0x500)
 	{
 		std::string version;
 		std::size_t num;
-		if (strToNum(content.substr(pos - minPos, 1), num)
-				&& strToNum(content.substr(pos - minPos + 2, 2), num))
+		if (strToNum(content.substr(pos - minPos, 1).str(), num)
+				&& strToNum(content.substr(pos - minPos + 2, 2).str(), num))
 		{
-			version = content.substr(pos - minPos, verLen);
+			version = content.substr(pos - minPos, verLen).str();
 		}
 		std::string additionalInfo = getUpxAdditionalInfo(pos);
 		if (!additionalInfo.empty())
@@ -549,7 +574,7 @@ void PeHeuristics::getFsgHeuristics()
 	auto source = DetectionMethod::STRING_SEARCH_H;
 	auto strength = DetectionStrength::MEDIUM;
 
-	if (search.hasString("FSG!", peParser.getPeHeaderOffset(), peParser.getMzHeaderSize()))
+	if (search.hasString(fsgMagic, peParser.getPeHeaderOffset(), peParser.getMzHeaderSize()))
 	{
 		addPacker(source, strength, "FSG");
 	}
@@ -564,14 +589,13 @@ void PeHeuristics::getPeCompactHeuristics()
 	auto strength = DetectionStrength::MEDIUM;
 
 	// format: PEC2[any character]O
-	const std::string pattern = "PEC2";
-	const auto patLen = pattern.length();
+	const auto patLen = peCompactPrefix.length();
 
-	const auto &content = search.getPlainString();
-	const auto pos = content.find(pattern);
+	const auto content = search.getPlainString();
+	const auto pos = search.findString(peCompactPrefix);
 
 	if (pos < 0x500
-			&& pos + patLen + 2 <= content.length()
+			&& pos + patLen + 2 <= content.size()
 			&& content[pos + patLen + 1] == 'O')
 	{
 		for (const auto &item : peCompactMap)
@@ -586,7 +610,7 @@ void PeHeuristics::getPeCompactHeuristics()
 		addPacker(source, strength, "PECompact");
 	}
 
-	if (search.hasString("PECompact2", 0, 0x4FF))
+	if (search.hasString(peCompactString, 0, 0x4FF))
 	{
 		addPacker(source, strength, "PECompact", "2.xx - 3.xx");
 	}
@@ -624,12 +648,11 @@ void PeHeuristics::getEnigmaHeuristics()
 		const auto *sec = fileParser.getSection(".data");
 		if (sec)
 		{
-			const std::string pattern = "Enigma protector v";
-			const auto &content = search.getPlainString();
-			const auto pos = content.find(pattern, sec->getOffset());
-			if (pos < sec->getOffset() + sec->getSizeInFile() && pos <= content.length() - 4)
+			const auto content = search.getPlainString();
+			const auto pos = search.findString(enigmaVersionPrefix, sec->getOffset());
+			if (pos < sec->getOffset() + sec->getSizeInFile() && pos <= content.size() - 4)
 			{
-				addPacker(source, strength, "Enigma", content.substr(pos + pattern.length(), 4));
+				addPacker(source, strength, "Enigma", content.substr(pos + enigmaVersionPrefix.length(), 4).str());
 				return;
 			}
 		}
@@ -660,7 +683,7 @@ void PeHeuristics::getEnigmaHeuristics()
 		}
 	}
 
-	if (peParser.isDotNet() && search.hasStringInSection("\0\0\0ENIGMA"s, std::size_t(0)))
+	if (peParser.isDotNet() && search.hasStringInSection(enigmaMagic, std::size_t(0)))
 	{
 		addPacker(DetectionMethod::SIGNATURE, strength, "Enigma");
 		return;
@@ -720,10 +743,10 @@ void PeHeuristics::getAdeptProtectorHeuristics()
 	auto strength = DetectionStrength::MEDIUM;
 
 	if (peParser.isDotNet()
-			&& search.hasStringInSection("ByAdeptProtector", std::size_t(0)))
+			&& search.hasStringInSection(adeptProtectorString, std::size_t(0)))
 	{
 		std::string version;
-		if (search.hasStringInSection("STAThreadAttribute", std::size_t(0)))
+		if (search.hasStringInSection(staThreadString, std::size_t(0)))
 		{
 			version = "2.1";
 		}
@@ -761,15 +784,15 @@ void PeHeuristics::getNetHeuristic()
 
 	// normal string search
 	std::size_t idx = 0;
-	if (search.hasStringInSection("Protected_By_Attribute\0NETSpider.Attribute"s, idx))
+	if (search.hasStringInSection(netSpiderString, idx))
 	{
 		addPacker(source, strength, ".NET Spider", "0.5 - 1.3");
 	}
-	if (search.hasStringInSection("Protected/Packed with ReNET-Pack by stx", idx))
+	if (search.hasStringInSection(reNetPackString, idx))
 	{
 		addPacker(source, strength, "ReNET-pack");
 	}
-	if (search.hasStringInSection("\0NetzStarter\0netz\0"s, idx))
+	if (search.hasStringInSection(netzString, idx))
 	{
 		addPacker(source, strength, ".NETZ");
 	}
@@ -782,13 +805,11 @@ void PeHeuristics::getNetHeuristic()
 		const auto start = sec->getOffset();
 		const auto end = start + sec->getLoadedSize() - 1;
 
-		const std::string sig =
-			"0000010B160C----------0208----------0D0906085961D21304091E630861D21305070811051E62110460D19D081758;";
-		if (search.findUnslashedSignature(sig, start, end))
+		if (search.findUnslashedSignature(phoenixSignature, start, end))
 		{
 			version = "1.7 - 1.8";
 		}
-		else if (search.hasStringInSection("?.resources", sec))
+		else if (search.hasStringInSection(phoenixResourcesString, sec))
 		{
 			version = "1.x";
 		}
@@ -797,12 +818,12 @@ void PeHeuristics::getNetHeuristic()
 			addPacker(source, strength, "Phoenix", version);
 		}
 
-		if (search.findUnslashedSignature("282D00000A6F2E00000A14146F2F00000A;", start, end))
+		if (search.findUnslashedSignature(assemblyInvokeSignature, start, end))
 		{
 			addPacker(source, strength, "AssemblyInvoke");
 		}
 
-		if (search.findUnslashedSignature("436C69005300650063007500720065;", start, end))
+		if (search.findUnslashedSignature(cliSecureSignature, start, end))
 		{
 			addPacker(source, strength, "CliSecure");
 		}
@@ -832,7 +853,7 @@ void PeHeuristics::getExcelsiorHeuristics()
 		"83EC--53555657E8--------6A--5B391D--------8BF37E--8B3D--------A1--------8B----8A08;";
 	if (canSearch && toolInfo.entryPointOffset
 			&& search.exactComparison(sig, toolInfo.epOffset)
-			&& search.hasString("ExcelsiorII1", declaredLength, loadedLength - 1))
+			&& search.hasString(excelsiorString, declaredLength, loadedLength - 1))
 	{
 		addInstaller(source, strength, "Excelsior Installer");
 	}
@@ -906,8 +927,7 @@ void PeHeuristics::getBorlandDelphiHeuristics()
 		return;
 	}
 
-	const std::string str = "SOFTWARE\\Borland\\Delphi\\RTL\0FPUMaskValue"s;
-	if (search.hasStringInSection(str, sections[0])
+	if (search.hasStringInSection(borlandDelphiString, sections[0])
 			|| peParser.getTimeStamp() == 0x2A425E19) // 1992-06-19
 	{
 		addCompiler(source, strength, "Borland Delphi");
@@ -922,9 +942,8 @@ void PeHeuristics::getBeRoHeuristics()
 	auto source = DetectionMethod::STRING_SEARCH_H;
 	auto strength = DetectionStrength::MEDIUM;
 
-	const std::string &str = "Compiled by: BeRoTinyPascal - (C) Copyright 2006, Benjamin";
 	if (toolInfo.entryPointSection
-			&& search.hasStringInSection(str, toolInfo.epSection.getIndex()))
+			&& search.hasStringInSection(beRoString, toolInfo.epSection.getIndex()))
 	{
 		addCompiler(source, strength, "BeRo Tiny Pascal");
 		addLanguage("Pascal");
@@ -1660,6 +1679,51 @@ void PeHeuristics::getPeSectionHeuristics()
 	getNsPackSectionHeuristics();
 }
 
+void PeHeuristics::registerFormatSpecificPatterns()
+{
+	for (const auto &str : {goBuildId, upxOldVersionPrefix, upxMagic, fsgMagic,
+			peCompactPrefix, peCompactString, enigmaMagic, enigmaVersionPrefix,
+			excelsiorString, borlandDelphiString, beRoString})
+	{
+		search.registerString(str);
+	}
+
+	for (const auto &str : msvcRuntimeStrings)
+	{
+		search.registerString(str);
+	}
+
+	if (peParser.isDotNet())
+	{
+		for (const auto &str : {adeptProtectorString, staThreadString, netSpiderString,
+				reNetPackString, netzString, phoenixResourcesString})
+		{
+			search.registerString(str);
+		}
+	}
+
+	if (canSearch)
+	{
+		for (const auto &sig : reactorSignatures)
+		{
+			search.registerSignature(sig);
+		}
+
+		if (peParser.isDotNet())
+		{
+			for (const auto &sig : {phoenixSignature, assemblyInvokeSignature, cliSecureSignature})
+			{
+				search.registerSignature(sig);
+			}
+
+			for (const auto &sig : dotNetShrinkPatterns)
+			{
+				search.registerSignature(sig);
+			}
+		}
+	}
+}
+
 void PeHeuristics::getFormatSpecificLanguageHeuristics()
 {
 	getGoHeuristics();
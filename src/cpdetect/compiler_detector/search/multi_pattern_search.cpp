@@ -0,0 +1,305 @@
+/**
+ * @file src/cpdetect/compiler_detector/search/multi_pattern_search.cpp
+ * @brief Class for simultaneous search of many patterns in one pass.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+#include "retdec/cpdetect/compiler_detector/search/multi_pattern_search.h"
+
+namespace retdec {
+namespace cpdetect {
+
+namespace
+{
+
+const std::uint32_t NoState = static_cast<std::uint32_t>(-1);
+
+} // anonymous namespace
+
+const std::size_t MultiPatternSearch::npos;
+
+/**
+ * Constructor
+ */
+MultiPatternSearch::MultiPatternSearch() : scanned(false), numberOfClasses(0)
+{
+	std::memset(byteClasses, 0, sizeof(byteClasses));
+}
+
+/**
+ * Register plain string
+ * @param str Plain string (must not be empty)
+ * @return Index of registered string
+ *
+ * Registration of new pattern invalidates hit table.
+ */
+std::size_t MultiPatternSearch::addString(const std::string &str)
+{
+	strings.push_back(str);
+	scanned = false;
+	return strings.size() - 1;
+}
+
+/**
+ * Register unslashed signature
+ * @param signPattern Signature pattern (relative jumps are not supported)
+ * @return Index of registered signature
+ *
+ * Registration of new pattern invalidates hit table. Signature without any
+ * significant byte cannot be searched by automaton (see @c isSignatureIndexed()).
+ */
+std::size_t MultiPatternSearch::addSignature(const std::string &signPattern)
+{
+	signatures.emplace_back(signPattern);
+	const auto &part = signatures.back().getUnslashed();
+
+	auto indexed = part.isValid() && part.getNibbleLength();
+	for(std::size_t alignment = 0; indexed && alignment < 2; ++alignment)
+	{
+		std::size_t offset = 0;
+		indexed = !part.getLongestLiteral(alignment, offset).empty();
+	}
+
+	indexedSignatures.push_back(indexed);
+	scanned = false;
+	return signatures.size() - 1;
+}
+
+/**
+ * Build automaton from all registered patterns
+ */
+void MultiPatternSearch::buildAutomaton()
+{
+	keys.clear();
+	for(std::size_t i = 0, e = strings.size(); i < e; ++i)
+	{
+		if(!strings[i].empty())
+		{
+			const auto *data = reinterpret_cast<const std::uint8_t*>(strings[i].data());
+			keys.push_back({false, i, 0, 0, llvm::ArrayRef<std::uint8_t>(data, strings[i].length())});
+		}
+	}
+	for(std::size_t i = 0, e = signatures.size(); i < e; ++i)
+	{
+		if(!indexedSignatures[i])
+		{
+			continue;
+		}
+
+		for(std::size_t alignment = 0; alignment < 2; ++alignment)
+		{
+			std::size_t offset = 0;
+			const auto literal = signatures[i].getUnslashed().getLongestLiteral(alignment, offset);
+			keys.push_back({true, i, alignment, offset, literal});
+		}
+	}
+
+	// Bytes which are not present in any key share one input class.
+	std::memset(byteClasses, 0, sizeof(byteClasses));
+	numberOfClasses = 1;
+	for(const auto &key : keys)
+	{
+		for(const auto byte : key.literal)
+		{
+			auto &byteClass = byteClasses[byte];
+			if(!byteClass)
+			{
+				byteClass = numberOfClasses++;
+			}
+		}
+	}
+
+	// Trie of all keys
+	transitions.assign(numberOfClasses, NoState);
+	outputs.assign(1, {});
+	for(std::size_t k = 0, e = keys.size(); k < e; ++k)
+	{
+		std::uint32_t state = 0;
+		for(const auto byte : keys[k].literal)
+		{
+			const auto next = state * numberOfClasses + byteClasses[byte];
+			if(transitions[next] == NoState)
+			{
+				transitions[next] = outputs.size();
+				transitions.resize(transitions.size() + numberOfClasses, NoState);
+				outputs.emplace_back();
+			}
+			state = transitions[next];
+		}
+
+		outputs[state].push_back(k);
+	}
+
+	// Failure links are folded into transition table in breadth-first order.
+	std::vector<std::uint32_t> failures(outputs.size(), 0);
+	std::queue<std::uint32_t> queue;
+	for(std::size_t c = 0; c < numberOfClasses; ++c)
+	{
+		auto &next = transitions[c];
+		if(next == NoState)
+		{
+			next = 0;
+		}
+		else
+		{
+			queue.push(next);
+		}
+	}
+
+	while(!queue.empty())
+	{
+		const auto state = queue.front();
+		queue.pop();
+
+		for(std::size_t c = 0; c < numberOfClasses; ++c)
+		{
+			auto &next = transitions[state * numberOfClasses + c];
+			const auto fallback = transitions[failures[state] * numberOfClasses + c];
+			if(next == NoState)
+			{
+				next = fallback;
+				continue;
+			}
+
+			failures[next] = fallback;
+			const auto &inherited = outputs[fallback];
+			outputs[next].insert(outputs[next].end(), inherited.begin(), inherited.end());
+			queue.push(next);
+		}
+	}
+}
+
+/**
+ * Run automaton over data and store found patterns into hit table
+ * @param data Searched data
+ * @param searchStrings @c true if hits of strings should be stored
+ * @param searchSignatures @c true if hits of signatures should be stored
+ */
+void MultiPatternSearch::runAutomaton(llvm::ArrayRef<std::uint8_t> data, bool searchStrings, bool searchSignatures)
+{
+	std::uint32_t state = 0;
+
+	for(std::size_t i = 0, e = data.size(); i < e; ++i)
+	{
+		state = transitions[state * numberOfClasses + byteClasses[data[i]]];
+
+		for(const auto k : outputs[state])
+		{
+			const auto &key = keys[k];
+			const auto keyStart = i + 1 - key.literal.size();
+			if(!key.signature)
+			{
+				if(searchStrings)
+				{
+					stringHits[key.index].push_back(keyStart);
+				}
+			}
+			else if(searchSignatures && keyStart >= key.offset)
+			{
+				const auto nibbleOffset = 2 * (keyStart - key.offset) + key.alignment;
+				if(signatures[key.index].getUnslashed().matches(data, nibbleOffset))
+				{
+					signatureHits[key.index].push_back(nibbleOffset);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Find all registered patterns in one pass
+ * @param plainData Data in which strings are searched
+ * @param signatureData Data in which signatures are searched
+ *
+ * If @a plainData and @a signatureData are the same (e.g. content of little
+ * endian file), data are scanned only once.
+ */
+void MultiPatternSearch::scan(llvm::ArrayRef<std::uint8_t> plainData, llvm::ArrayRef<std::uint8_t> signatureData)
+{
+	buildAutomaton();
+	stringHits.assign(strings.size(), {});
+	signatureHits.assign(signatures.size(), {});
+
+	if(plainData.data() == signatureData.data() && plainData.size() == signatureData.size())
+	{
+		runAutomaton(plainData, true, true);
+	}
+	else
+	{
+		runAutomaton(plainData, true, false);
+		runAutomaton(signatureData, false, true);
+	}
+
+	// Hits of both alignments of signature are interleaved.
+	for(auto &hits : signatureHits)
+	{
+		std::sort(hits.begin(), hits.end());
+		hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+	}
+
+	scanned = true;
+}
+
+/**
+ * Check if hit table contains results of all registered patterns
+ * @return @c true if hit table is up to date, @c false otherwise
+ */
+bool MultiPatternSearch::isScanned() const
+{
+	return scanned;
+}
+
+/**
+ * Check if signature is searched by automaton
+ * @param index Index of signature
+ * @return @c true if hits of signature are stored in hit table, @c false otherwise
+ */
+bool MultiPatternSearch::isSignatureIndexed(std::size_t index) const
+{
+	return index < indexedSignatures.size() && indexedSignatures[index];
+}
+
+/**
+ * Find first hit on or after specified offset
+ * @param hits Sorted offsets of hits
+ * @param offset Minimal offset
+ * @return Offset of first hit or @c npos if there is no such hit
+ */
+std::size_t MultiPatternSearch::findHit(const std::vector<std::size_t> &hits, std::size_t offset) const
+{
+	const auto it = std::lower_bound(hits.begin(), hits.end(), offset);
+	return it == hits.end() ? npos : *it;
+}
+
+/**
+ * Find first occurrence of registered string
+ * @param index Index of string
+ * @param startOffset Minimal byte offset of occurrence
+ * @return Byte offset of occurrence or @c npos if string is not found
+ *
+ * Hit table must be up to date.
+ */
+std::size_t MultiPatternSearch::findString(std::size_t index, std::size_t startOffset) const
+{
+	return index < stringHits.size() ? findHit(stringHits[index], startOffset) : npos;
+}
+
+/**
+ * Find first occurrence of registered signature
+ * @param index Index of signature
+ * @param startNibble Minimal nibble offset of occurrence
+ * @return Nibble offset of occurrence or @c npos if signature is not found
+ *
+ * Hit table must be up to date and signature must be indexed.
+ */
+std::size_t MultiPatternSearch::findSignature(std::size_t index, std::size_t startNibble) const
+{
+	return index < signatureHits.size() ? findHit(signatureHits[index], startNibble) : npos;
+}
+
+} // namespace cpdetect
+} // namespace retdec
@@ -39,11 +39,30 @@ const std::map<Architecture, std::vector<Search::RelativeJump>> jumpMap =
  */
 Search::Search(retdec::fileformat::FileFormat &fileParser) : parser(fileParser), averageSlashLen(0)
 {
-	const auto &bytes = parser.getLoadedBytes();
-	bytesToHexString(bytes, nibbles);
-	bytesToString(bytes, plain);
+	const auto bytes = parser.getLoadedBytes();
+	plain = llvm::StringRef(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	content = bytes;
 	fileLoaded = !bytes.empty();
-	fileSupported = parser.hexToLittle(nibbles) && parser.getNumberOfNibblesInByte();
+	fileSupported = !parser.isUnknownEndian() && parser.getNumberOfNibblesInByte();
+
+	// Signatures are always searched in little endian representation of file.
+	if(fileSupported && parser.isBigEndian())
+	{
+		const auto wordSize = parser.getBytesPerWord();
+		if(!wordSize || bytes.size() < wordSize)
+		{
+			fileSupported = false;
+		}
+		else
+		{
+			swappedBytes.assign(bytes.begin(), bytes.end() - bytes.size() % wordSize);
+			for(auto it = swappedBytes.begin(), e = swappedBytes.end(); it != e; it += wordSize)
+			{
+				std::reverse(it, it + wordSize);
+			}
+			content = swappedBytes;
+		}
+	}
 	jumps = mapGetValueOrDefault(jumpMap, parser.getTargetArchitecture(), std::vector<RelativeJump>());
 
 	for(std::size_t i = 0, e = jumps.size(); i < e; ++i)
@@ -144,6 +163,86 @@ std::size_t Search::bytesFromNibbles(std::size_t nNibbles) const
 	return parser.bytesFromNibbles(nNibbles);
 }
 
+/**
+ * Get number of nibbles in searched content of file
+ * @return Number of nibbles
+ */
+std::size_t Search::getNumberOfNibbles() const
+{
+	return nibblesFromBytes(content.size());
+}
+
+/**
+ * Get nibble of searched content of file
+ * @param nibbleOffset Offset of nibble (must be lower than number of nibbles)
+ * @return Nibble in hexadecimal representation (upper case)
+ */
+char Search::getNibble(std::size_t nibbleOffset) const
+{
+	const auto byte = content[nibbleOffset / 2];
+	return "0123456789ABCDEF"[nibbleOffset % 2 ? byte & 0x0F : byte >> 4];
+}
+
+/**
+ * Check if searched content of file has nibbles @a hexString on specified offset
+ * @param hexString Nibbles in hexadecimal representation
+ * @param nibbleOffset Offset of first nibble
+ * @return @c true if nibbles are present on offset, @c false otherwise
+ */
+bool Search::hasNibblesOnPosition(const std::string &hexString, std::size_t nibbleOffset) const
+{
+	const auto nibblesLen = getNumberOfNibbles();
+	if(nibbleOffset >= nibblesLen || nibblesLen - nibbleOffset < hexString.length())
+	{
+		return false;
+	}
+
+	for(std::size_t i = 0, e = hexString.length(); i < e; ++i)
+	{
+		if(getNibble(nibbleOffset + i) != hexString[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Get compiled form of signature pattern
+ * @param signPattern Signature pattern
+ * @return Compiled signature pattern
+ *
+ * Each pattern is compiled only once, the result is cached for the lifetime of the instance.
+ */
+const SignaturePattern& Search::getPattern(const std::string &signPattern) const
+{
+	auto it = patterns.find(signPattern);
+	if(it == patterns.end())
+	{
+		it = patterns.emplace(signPattern, SignaturePattern(signPattern)).first;
+	}
+
+	return it->second;
+}
+
+/**
+ * Get hit table of registered patterns
+ * @return Registered patterns with up to date hit table
+ *
+ * All registered patterns are searched in one pass when hit table is requested
+ * for the first time after registration of new pattern.
+ */
+const MultiPatternSearch& Search::getRegistered() const
+{
+	if(!registered.isScanned())
+	{
+		registered.scan(llvm::ArrayRef<std::uint8_t>(plain.bytes_begin(), plain.bytes_end()), content);
+	}
+
+	return registered;
+}
+
 /**
  * Check if input file was successfully loaded
  * @return @c true if file was successfully loaded, @c false otherwise
@@ -163,21 +262,42 @@ bool Search::isFileSupported() const
 }
 
 /**
- * Get content of file in hexadecimal string representation
- * @return Content of file in hexadecimal string representation
+ * Get content of file as plain string
+ * @return View of content of file as plain string
  */
-const std::string& Search::getNibbles() const
+llvm::StringRef Search::getPlainString() const
 {
-	return nibbles;
+	return plain;
 }
 
 /**
- * Get content of file as plain string
- * @return Content of file as plain string
+ * Register plain string for search in one pass with other registered patterns
+ * @param str Plain string
+ *
+ * All patterns should be registered before the first query, because registration
+ * of new pattern invalidates results of previous pass.
  */
-const std::string& Search::getPlainString() const
+void Search::registerString(const std::string &str)
 {
-	return plain;
+	if(!str.empty() && !registeredStrings.count(str))
+	{
+		registeredStrings.emplace(str, registered.addString(str));
+	}
+}
+
+/**
+ * Register unslashed signature for search in one pass with other registered patterns
+ * @param signPattern Signature pattern
+ *
+ * All patterns should be registered before the first query, because registration
+ * of new pattern invalidates results of previous pass.
+ */
+void Search::registerSignature(const std::string &signPattern)
+{
+	if(!registeredSignatures.count(signPattern))
+	{
+		registeredSignatures.emplace(signPattern, registered.addSignature(signPattern));
+	}
 }
 
 /**
@@ -196,8 +316,8 @@ const Search::RelativeJump* Search::getRelativeJump(std::size_t fileOffset, std:
 	for(const auto &jump : jumps)
 	{
 		const auto nibblesAfter = nibblesFromBytes(jump.getBytesAfter());
-		if(!hasSubstringOnPosition(nibbles, jump.getSlash(), nibbleOffset) ||
-			(nibbleOffset + jump.getSlashNibbleSize() + nibblesAfter - 1 >= nibbles.length()))
+		if(!hasNibblesOnPosition(jump.getSlash(), nibbleOffset) ||
+			(nibbleOffset + jump.getSlashNibbleSize() + nibblesAfter - 1 >= getNumberOfNibbles()))
 		{
 			continue;
 		}
@@ -258,6 +378,16 @@ unsigned long long Search::countImpNibbles(const std::string &signPattern) const
 	return count;
 }
 
+/**
+ * Count number of significant nibbles in compiled signature pattern
+ * @param pattern Compiled signature pattern
+ * @return Number of significant nibbles in signature pattern
+ */
+unsigned long long Search::countImpNibbles(const SignaturePattern &pattern) const
+{
+	return pattern.getNumberOfSignificantNibbles() + pattern.getNumberOfJumps() * averageSlashLen;
+}
+
 /**
  * Method tells if there is the pattern in selected area of file. Unable for slashed signatures
  * @param signPattern Signature pattern
@@ -272,17 +402,20 @@ unsigned long long Search::findUnslashedSignature(const std::string &signPattern
 		return 0;
 	}
 
-	const auto startIterator = nibbles.begin() + nibblesFromBytes(startOffset);
-	const auto stopIndex = nibblesFromBytes(stopOffset) + 1;
-	const auto stopIterator = stopIndex < nibbles.size() ? nibbles.begin() + stopIndex : nibbles.end();
-	const auto it = std::search(startIterator, stopIterator, signPattern.begin(), signPattern.end(),
-		[] (const char fileNibble, const char signatureNibble)
-		{
-			return fileNibble == signatureNibble || signatureNibble == '-' || signatureNibble == '?' || signatureNibble == ';';
-		}
-	);
+	const auto &pattern = getPattern(signPattern);
+	const auto startNibble = nibblesFromBytes(startOffset);
+	const auto stopNibble = nibblesFromBytes(stopOffset) + 1;
+
+	const auto it = registeredSignatures.find(signPattern);
+	if(it != registeredSignatures.end() && registered.isSignatureIndexed(it->second))
+	{
+		const auto pos = getRegistered().findSignature(it->second, startNibble);
+		const auto found = pos != MultiPatternSearch::npos && pos + pattern.getUnslashed().getNibbleLength() <= stopNibble;
+		return found ? countImpNibbles(pattern) : 0;
+	}
 
-	return (it != stopIterator) ? countImpNibbles(signPattern) : 0;
+	const auto found = pattern.getUnslashed().find(content, startNibble, stopNibble);
+	return found ? countImpNibbles(pattern) : 0;
 }
 
 /**
@@ -306,10 +439,11 @@ unsigned long long Search::findSlashedSignature(const std::string &signPattern,
 		return false;
 	}
 	const auto iters = (startOffset == stopOffset) ? 1 : areaSize - signSize + 1;
+	const auto &pattern = getPattern(signPattern);
 
 	for(std::size_t i = 0; i < iters; ++i)
 	{
-		const auto result = exactComparison(signPattern, startOffset, i);
+		const auto result = exactComparison(pattern, startOffset, i);
 		if(result)
 		{
 			return result;
@@ -328,36 +462,56 @@ unsigned long long Search::findSlashedSignature(const std::string &signPattern,
  */
 unsigned long long Search::exactComparison(const std::string &signPattern, std::size_t fileOffset, std::size_t shift) const
 {
-	for(std::size_t sigIndex = 0, fileIndex = nibblesFromBytes(fileOffset) + shift, fileLen = nibbles.length();
-		fileIndex < fileLen; ++sigIndex, ++fileIndex)
+	return exactComparison(getPattern(signPattern), fileOffset, shift);
+}
+
+/**
+ * Try find compiled signature @a pattern at specified offset
+ * @param pattern Compiled signature pattern
+ * @param fileOffset Offset in file
+ * @param shift Relative shift in nibbles from @a fileOffset
+ * @return Number of significant nibbles of signature or 0 if content of file and signature are different
+ */
+unsigned long long Search::exactComparison(const SignaturePattern &pattern, std::size_t fileOffset, std::size_t shift) const
+{
+	const auto &parts = pattern.getParts();
+	const auto fileLen = getNumberOfNibbles();
+	auto fileIndex = nibblesFromBytes(fileOffset) + shift;
+
+	for(std::size_t i = 0, e = parts.size(); i < e; ++i)
 	{
-		if(sigIndex == signPattern.length() || signPattern[sigIndex] == ';')
+		const auto &part = parts[i];
+		if(fileIndex >= fileLen || !part.matches(content, fileIndex))
 		{
-			return countImpNibbles(signPattern);
+			return 0;
 		}
-		else if(signPattern[sigIndex] == '/')
+
+		// at least one nibble must follow the matched part
+		fileIndex += part.getNibbleLength();
+		if(fileIndex >= fileLen)
 		{
-			std::int64_t moveSize = 0;
-			const auto actShift = (parser.getNumberOfNibblesInByte() ? fileIndex % parser.getNumberOfNibblesInByte() : 0);
-			const auto *jump = getRelativeJump(bytesFromNibbles(fileIndex), actShift, moveSize);
-			if(!jump)
-			{
-				if(!haveSlashes())
-				{
-					--fileIndex;
-					continue;
-				}
+			return 0;
+		}
+		else if(i + 1 == e)
+		{
+			return countImpNibbles(pattern);
+		}
 
-				return 0;
+		// part is followed by relative jump
+		std::int64_t moveSize = 0;
+		const auto actShift = (parser.getNumberOfNibblesInByte() ? fileIndex % parser.getNumberOfNibblesInByte() : 0);
+		const auto *jump = getRelativeJump(bytesFromNibbles(fileIndex), actShift, moveSize);
+		if(!jump)
+		{
+			if(!haveSlashes())
+			{
+				continue;
 			}
 
-			// move after one nibble is in header of cycle
-			fileIndex += jump->getSlashNibbleSize() + nibblesFromBytes(jump->getBytesAfter()) + moveSize - 1;
-		}
-		else if(signPattern[sigIndex] != nibbles[fileIndex] && signPattern[sigIndex] != '-' && signPattern[sigIndex] != '?')
-		{
 			return 0;
 		}
+
+		fileIndex += jump->getSlashNibbleSize() + nibblesFromBytes(jump->getBytesAfter()) + moveSize;
 	}
 
 	return 0;
@@ -377,7 +531,7 @@ bool Search::countSimilarity(const std::string &signPattern, Similarity &sim, st
 {
 	Similarity result;
 
-	for(std::size_t sigIndex = 0, fileIndex = nibblesFromBytes(fileOffset) + shift, fileLen = nibbles.length(); fileIndex < fileLen; ++sigIndex, ++fileIndex)
+	for(std::size_t sigIndex = 0, fileIndex = nibblesFromBytes(fileOffset) + shift, fileLen = getNumberOfNibbles(); fileIndex < fileLen; ++sigIndex, ++fileIndex)
 	{
 		if(sigIndex == signPattern.length() || signPattern[sigIndex] == ';')
 		{
@@ -413,7 +567,7 @@ bool Search::countSimilarity(const std::string &signPattern, Similarity &sim, st
 			}
 			continue;
 		}
-		else if(signPattern[sigIndex] == nibbles[fileIndex])
+		else if(signPattern[sigIndex] == getNibble(fileIndex))
 		{
 			++result.same;
 		}
@@ -473,6 +627,25 @@ bool Search::areaSimilarity(const std::string &signPattern, Similarity &sim, std
 	return result;
 }
 
+/**
+ * Find first occurrence of substring in file
+ * @param str Coveted substring
+ * @param startOffset Minimal offset of occurrence
+ * @return Offset of the first occurrence of @a str on or after @a startOffset
+ *    or @c llvm::StringRef::npos if there is no such occurrence
+ */
+std::size_t Search::findString(const std::string &str, std::size_t startOffset) const
+{
+	const auto it = registeredStrings.find(str);
+	if(it == registeredStrings.end())
+	{
+		return plain.find(str, startOffset);
+	}
+
+	const auto pos = getRegistered().findString(it->second, startOffset);
+	return pos == MultiPatternSearch::npos ? llvm::StringRef::npos : pos;
+}
+
 /**
  * Check if file contains specified substring
  * @param str Coveted substring
@@ -480,7 +653,7 @@ bool Search::areaSimilarity(const std::string &signPattern, Similarity &sim, std
  */
 bool Search::hasString(const std::string &str) const
 {
-	return contains(plain, str);
+	return findString(str) != llvm::StringRef::npos;
 }
 
 /**
@@ -491,7 +664,7 @@ bool Search::hasString(const std::string &str) const
  */
 bool Search::hasString(const std::string &str, std::size_t fileOffset) const
 {
-	return hasSubstringOnPosition(plain, str, fileOffset);
+	return fileOffset < plain.size() && plain.substr(fileOffset).startswith(str);
 }
 
 /**
@@ -503,7 +676,19 @@ bool Search::hasString(const std::string &str, std::size_t fileOffset) const
  */
 bool Search::hasString(const std::string &str, std::size_t startOffset, std::size_t stopOffset) const
 {
-	return hasSubstringInArea(plain, str, startOffset, stopOffset);
+	if(startOffset > stopOffset)
+	{
+		return false;
+	}
+
+	if(registeredStrings.count(str))
+	{
+		const auto pos = findString(str, startOffset);
+		return pos != llvm::StringRef::npos && pos + str.length() <= stopOffset + 1;
+	}
+
+	const auto area = plain.slice(startOffset, stopOffset + 1);
+	return !area.empty() && area.find(str) != llvm::StringRef::npos;
 }
 
 /**
@@ -551,7 +736,7 @@ bool Search::createSignature(std::string &pattern, std::size_t fileOffset, std::
 {
 	pattern.clear();
 
-	for(std::size_t i = 0, fileIndex = nibblesFromBytes(fileOffset), fileLen = nibbles.length(), nibbleSize = nibblesFromBytes(size);
+	for(std::size_t i = 0, fileIndex = nibblesFromBytes(fileOffset), fileLen = getNumberOfNibbles(), nibbleSize = nibblesFromBytes(size);
 		fileIndex < fileLen && i < nibbleSize; ++i, ++fileIndex)
 	{
 		std::int64_t moveSize = 0;
@@ -564,7 +749,7 @@ bool Search::createSignature(std::string &pattern, std::size_t fileOffset, std::
 		}
 		else
 		{
-			pattern += nibbles[fileIndex];
+			pattern += getNibble(fileIndex);
 		}
 	}
 
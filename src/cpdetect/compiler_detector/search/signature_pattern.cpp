@@ -0,0 +1,399 @@
+/**
+ * @file src/cpdetect/compiler_detector/search/signature_pattern.cpp
+ * @brief Class for signature pattern compiled into byte values and masks.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "retdec/cpdetect/compiler_detector/search/signature_pattern.h"
+
+namespace retdec {
+namespace cpdetect {
+
+namespace
+{
+
+const std::size_t NoAnchor = static_cast<std::size_t>(-1);
+
+/**
+ * Convert hexadecimal digit into its value
+ * @param c Hexadecimal digit (only upper case letters are accepted)
+ * @param value Into this parameter is stored value of @a c
+ * @return @c true if @a c is valid hexadecimal digit, @c false otherwise
+ */
+bool hexDigitToValue(char c, std::uint8_t &value)
+{
+	if(c >= '0' && c <= '9')
+	{
+		value = c - '0';
+		return true;
+	}
+	else if(c >= 'A' && c <= 'F')
+	{
+		value = c - 'A' + 10;
+		return true;
+	}
+
+	return false;
+}
+
+} // anonymous namespace
+
+/**
+ * Constructor of Part
+ */
+SignaturePattern::Part::Part() : nibbleLength(0), anchors{NoAnchor, NoAnchor}, valid(true)
+{
+
+}
+
+/**
+ * Check if part matches data on specified byte offset
+ * @param data Searched data
+ * @param alignment @c 0 if part starts on high nibble of byte, @c 1 otherwise
+ * @param byteOffset Offset of first byte of part in @a data
+ * @return @c true if part matches, @c false otherwise
+ */
+bool SignaturePattern::Part::matchesBytes(llvm::ArrayRef<std::uint8_t> data, std::size_t alignment, std::size_t byteOffset) const
+{
+	const auto &actValues = values[alignment];
+	const auto &actMasks = masks[alignment];
+	if(byteOffset > data.size() || data.size() - byteOffset < actValues.size())
+	{
+		return false;
+	}
+
+	const auto *bytes = data.data() + byteOffset;
+	for(std::size_t i = 0, e = actValues.size(); i < e; ++i)
+	{
+		if((bytes[i] & actMasks[i]) != actValues[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Append one nibble to the end of part
+ * @param value Value of nibble
+ * @param mask Mask of nibble (@c 0xF for significant nibble, @c 0 for wildcard)
+ */
+void SignaturePattern::Part::addNibble(std::uint8_t value, std::uint8_t mask)
+{
+	value &= mask;
+
+	for(std::size_t alignment = 0; alignment < 2; ++alignment)
+	{
+		const auto absIndex = alignment + nibbleLength;
+		if(absIndex % 2 == 0)
+		{
+			values[alignment].push_back(value << 4);
+			masks[alignment].push_back(mask << 4);
+		}
+		else
+		{
+			if(values[alignment].empty())
+			{
+				values[alignment].push_back(0);
+				masks[alignment].push_back(0);
+			}
+
+			values[alignment].back() |= value;
+			masks[alignment].back() |= mask;
+		}
+	}
+
+	++nibbleLength;
+}
+
+/**
+ * Mark part as never matching (e.g. it contains invalid character)
+ */
+void SignaturePattern::Part::invalidate()
+{
+	valid = false;
+}
+
+/**
+ * Finish construction of part
+ */
+void SignaturePattern::Part::finalize()
+{
+	for(std::size_t alignment = 0; alignment < 2; ++alignment)
+	{
+		anchors[alignment] = NoAnchor;
+		for(std::size_t i = 0, e = masks[alignment].size(); i < e; ++i)
+		{
+			if(masks[alignment][i] == 0xFF)
+			{
+				anchors[alignment] = i;
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * Get length of part in nibbles
+ * @return Length of part in nibbles
+ */
+std::size_t SignaturePattern::Part::getNibbleLength() const
+{
+	return nibbleLength;
+}
+
+/**
+ * Check if part can be matched
+ * @return @c false if part contains invalid character, @c true otherwise
+ */
+bool SignaturePattern::Part::isValid() const
+{
+	return valid;
+}
+
+/**
+ * Get the longest sequence of bytes without wildcards
+ * @param alignment @c 0 if part starts on high nibble of byte, @c 1 otherwise
+ * @param byteOffset Into this parameter is stored offset of sequence from the first byte of part
+ * @return The longest sequence of significant bytes (empty if part has no such byte)
+ */
+llvm::ArrayRef<std::uint8_t> SignaturePattern::Part::getLongestLiteral(std::size_t alignment, std::size_t &byteOffset) const
+{
+	const auto &actMasks = masks[alignment];
+	std::size_t bestOffset = 0, bestLength = 0;
+
+	for(std::size_t i = 0, e = actMasks.size(); i < e; )
+	{
+		if(actMasks[i] != 0xFF)
+		{
+			++i;
+			continue;
+		}
+
+		auto j = i;
+		while(j < e && actMasks[j] == 0xFF)
+		{
+			++j;
+		}
+
+		if(j - i > bestLength)
+		{
+			bestOffset = i;
+			bestLength = j - i;
+		}
+		i = j;
+	}
+
+	byteOffset = bestOffset;
+	return llvm::ArrayRef<std::uint8_t>(values[alignment]).slice(bestOffset, bestLength);
+}
+
+/**
+ * Check if part matches data on specified nibble offset
+ * @param data Searched data
+ * @param nibbleOffset Offset of first nibble of part in @a data
+ * @return @c true if part matches, @c false otherwise
+ */
+bool SignaturePattern::Part::matches(llvm::ArrayRef<std::uint8_t> data, std::size_t nibbleOffset) const
+{
+	if(!valid)
+	{
+		return false;
+	}
+	else if(!nibbleLength)
+	{
+		return true;
+	}
+
+	return matchesBytes(data, nibbleOffset % 2, nibbleOffset / 2);
+}
+
+/**
+ * Check if part is present in selected area of data
+ * @param data Searched data
+ * @param startNibble First nibble of area
+ * @param stopNibble First nibble after area
+ * @return @c true if whole part lies in area and matches data, @c false otherwise
+ */
+bool SignaturePattern::Part::find(llvm::ArrayRef<std::uint8_t> data, std::size_t startNibble, std::size_t stopNibble) const
+{
+	stopNibble = std::min(stopNibble, data.size() * 2);
+	if(!valid || startNibble > stopNibble || stopNibble - startNibble < nibbleLength)
+	{
+		return false;
+	}
+	else if(!nibbleLength)
+	{
+		return true;
+	}
+
+	const auto lastNibble = stopNibble - nibbleLength;
+	for(std::size_t alignment = 0; alignment < 2; ++alignment)
+	{
+		const auto firstNibble = startNibble + (startNibble % 2 != alignment);
+		if(firstNibble > lastNibble)
+		{
+			continue;
+		}
+
+		const auto firstByte = firstNibble / 2;
+		const auto lastByte = lastNibble / 2 - (lastNibble % 2 < alignment);
+		if(firstByte > lastByte)
+		{
+			continue;
+		}
+
+		const auto anchor = anchors[alignment];
+		if(anchor == NoAnchor)
+		{
+			for(auto i = firstByte; i <= lastByte; ++i)
+			{
+				if(matchesBytes(data, alignment, i))
+				{
+					return true;
+				}
+			}
+
+			continue;
+		}
+
+		// Use significant byte of part for fast skipping of non-matching offsets.
+		const auto anchorValue = values[alignment][anchor];
+		const auto *begin = data.data();
+		const auto *act = begin + firstByte + anchor;
+		const auto *end = begin + lastByte + anchor + 1;
+		while(act < end)
+		{
+			act = static_cast<const std::uint8_t*>(std::memchr(act, anchorValue, end - act));
+			if(!act)
+			{
+				break;
+			}
+
+			if(matchesBytes(data, alignment, act - begin - anchor))
+			{
+				return true;
+			}
+			++act;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Constructor
+ * @param pattern Signature pattern in nibble representation
+ *
+ * Characters @c '-' and @c '?' are wildcards, @c '/' is relative jump and
+ * @c ';' terminates the pattern.
+ */
+SignaturePattern::SignaturePattern(const std::string &pattern) : parts(1), significantNibbles(0), numberOfJumps(0)
+{
+	bool terminated = false;
+
+	for(const auto c : pattern)
+	{
+		std::uint8_t value = 0;
+		const auto isHex = hexDigitToValue(c, value);
+
+		if(c == '/')
+		{
+			++numberOfJumps;
+		}
+		else if(c != '-' && c != '?' && c != ';')
+		{
+			++significantNibbles;
+		}
+
+		if(isHex)
+		{
+			unslashed.addNibble(value, 0xF);
+		}
+		else if(c == '-' || c == '?' || c == ';')
+		{
+			unslashed.addNibble(0, 0);
+		}
+		else
+		{
+			unslashed.addNibble(0, 0);
+			unslashed.invalidate();
+		}
+
+		if(terminated || c == ';')
+		{
+			terminated = true;
+			continue;
+		}
+
+		auto &part = parts.back();
+		if(isHex)
+		{
+			part.addNibble(value, 0xF);
+		}
+		else if(c == '-' || c == '?')
+		{
+			part.addNibble(0, 0);
+		}
+		else if(c == '/')
+		{
+			parts.emplace_back();
+		}
+		else
+		{
+			part.addNibble(0, 0);
+			part.invalidate();
+		}
+	}
+
+	unslashed.finalize();
+	for(auto &part : parts)
+	{
+		part.finalize();
+	}
+}
+
+/**
+ * Get parts of pattern separated by relative jumps
+ * @return Parts of pattern up to the first terminator
+ *
+ * Number of parts is always number of jumps before the first terminator plus one.
+ */
+const std::vector<SignaturePattern::Part>& SignaturePattern::getParts() const
+{
+	return parts;
+}
+
+/**
+ * Get whole pattern as one part (terminators are considered to be wildcards)
+ * @return Whole pattern as one part
+ */
+const SignaturePattern::Part& SignaturePattern::getUnslashed() const
+{
+	return unslashed;
+}
+
+/**
+ * Get number of significant nibbles in pattern (relative jumps are not counted)
+ * @return Number of significant nibbles
+ */
+std::size_t SignaturePattern::getNumberOfSignificantNibbles() const
+{
+	return significantNibbles;
+}
+
+/**
+ * Get number of relative jumps in pattern
+ * @return Number of relative jumps
+ */
+std::size_t SignaturePattern::getNumberOfJumps() const
+{
+	return numberOfJumps;
+}
+
+} // namespace cpdetect
+} // namespace retdec
@@ -0,0 +1,177 @@
+/**
+* @file src/crypto/multi_hash.cpp
+* @brief Implementation of class MultiHash.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "retdec/crypto/multi_hash.h"
+#include "retdec/utils/string.h"
+
+namespace retdec {
+namespace crypto {
+
+namespace {
+
+/// Size of a chunk fed to all algorithms at once. It fits into the L1 or L2
+/// cache of common processors.
+constexpr std::size_t CHUNK_SIZE = 32 * 1024;
+
+/// Ranges whose total size is smaller are hashed by a single thread because
+/// starting of threads would take longer than the hashing itself.
+constexpr std::size_t MIN_PARALLEL_SIZE = 1024 * 1024;
+
+} // anonymous namespace
+
+/**
+ * Constructor.
+ *
+ * @param algorithms Algorithms to compute (combination of Algorithms).
+ */
+MultiHash::MultiHash(unsigned algorithms) : _algorithms(algorithms)
+{
+	if (isRequested(MD5))
+		_md5.init(HashAlgorithm::Md5);
+	if (isRequested(SHA1))
+		_sha1.init(HashAlgorithm::Sha1);
+	if (isRequested(SHA256))
+		_sha256.init(HashAlgorithm::Sha256);
+}
+
+/**
+ * Adds the new data to all requested hashes.
+ *
+ * @param data Pointer to the start of data.
+ * @param size Size of data.
+ */
+void MultiHash::addData(const std::uint8_t* data, std::size_t size)
+{
+	if (!data)
+		return;
+
+	for (std::size_t offset = 0; offset < size; offset += CHUNK_SIZE)
+	{
+		const auto* chunk = data + offset;
+		const auto chunkSize = std::min(CHUNK_SIZE, size - offset);
+
+		if (isRequested(CRC32))
+			_crc32.add(chunk, chunkSize);
+		if (isRequested(MD5))
+			_md5.addData(chunk, chunkSize);
+		if (isRequested(SHA1))
+			_sha1.addData(chunk, chunkSize);
+		if (isRequested(SHA256))
+			_sha256.addData(chunk, chunkSize);
+	}
+}
+
+/**
+ * Gets the final hashes of all added data.
+ *
+ * It can be called only once.
+ */
+Hashes MultiHash::getHashes()
+{
+	Hashes hashes;
+	if (isRequested(CRC32))
+		hashes.crc32 = _crc32.getHash();
+	if (isRequested(MD5))
+		hashes.md5 = retdec::utils::toLower(_md5.getHash());
+	if (isRequested(SHA1))
+		hashes.sha1 = retdec::utils::toLower(_sha1.getHash());
+	if (isRequested(SHA256))
+		hashes.sha256 = retdec::utils::toLower(_sha256.getHash());
+	return hashes;
+}
+
+/**
+ * Computes hashes of @a data.
+ *
+ * @param data Input data.
+ * @param size Size of input data.
+ * @param algorithms Algorithms to compute (combination of Algorithms).
+ */
+Hashes MultiHash::compute(
+		const std::uint8_t* data,
+		std::size_t size,
+		unsigned algorithms)
+{
+	MultiHash multiHash(algorithms);
+	multiHash.addData(data, size);
+	return multiHash.getHashes();
+}
+
+/**
+ * Computes hashes of every range in @a ranges separately.
+ *
+ * The ranges are hashed in parallel when they are large enough. Callers
+ * which already run in several threads (e.g. workers processing different
+ * files) should limit the number of threads, usually to one, so the threads
+ * are not oversubscribed.
+ *
+ * @param ranges Ranges of input data.
+ * @param algorithms Algorithms to compute (combination of Algorithms).
+ * @param maxThreads Maximal number of threads including the calling one
+ *                   (0 means the number of CPUs).
+ *
+ * @return Hashes of the ranges, in the same order as @a ranges.
+ */
+std::vector<Hashes> MultiHash::compute(
+		const std::vector<Range>& ranges,
+		unsigned algorithms,
+		unsigned maxThreads)
+{
+	std::vector<Hashes> result(ranges.size());
+
+	std::atomic<std::size_t> next(0);
+	auto hash = [&]()
+	{
+		for (std::size_t i = next++; i < ranges.size(); i = next++)
+		{
+			result[i] = compute(ranges[i].first, ranges[i].second, algorithms);
+		}
+	};
+
+	std::size_t totalSize = 0;
+	for (const auto& range : ranges)
+	{
+		totalSize += range.second;
+	}
+
+	std::size_t threadCount = 1;
+	if (totalSize >= MIN_PARALLEL_SIZE)
+	{
+		if (maxThreads == 0)
+		{
+			maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+		threadCount = std::min<std::size_t>(maxThreads, ranges.size());
+	}
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < threadCount; ++i)
+	{
+		threads.emplace_back(hash);
+	}
+	hash();
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	return result;
+}
+
+/**
+ * Is the given algorithm requested?
+ */
+bool MultiHash::isRequested(Algorithms algorithm) const
+{
+	return _algorithms & algorithm;
+}
+
+} // namespace crypto
+} // namespace retdec
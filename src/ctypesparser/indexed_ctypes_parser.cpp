@@ -0,0 +1,520 @@
+/**
+* @file src/ctypesparser/indexed_ctypes_parser.cpp
+* @brief Parser for C-types from indexed binary files.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "retdec/ctypes/context.h"
+#include "retdec/ctypes/module.h"
+#include "retdec/ctypesparser/indexed_ctypes_parser.h"
+
+namespace {
+
+// The last character of the magic is the version of the format.
+const char INDEX_MAGIC[] = {'R', 'D', 'C', 'T', 'I', 'D', 'X', '3'};
+const std::uint32_t INDEX_VERSION = 3;
+
+// Offsets of the items in the header.
+const std::size_t HEADER_version         = sizeof(INDEX_MAGIC);
+const std::size_t HEADER_sourceSize      = HEADER_version + 4;
+const std::size_t HEADER_sourceMTime     = HEADER_sourceSize + 4;
+const std::size_t HEADER_functionTable   = HEADER_sourceMTime + 8;
+const std::size_t HEADER_typeTable       = HEADER_functionTable + 8;
+const std::size_t HEADER_size            = HEADER_typeTable + 8;
+
+const char JSON_functions[] = "functions";
+const char JSON_types[]     = "types";
+
+/**
+* @brief FNV-1a hash of @a name used in the hash tables of the index.
+*/
+std::uint32_t hashName(const char *name, std::size_t length)
+{
+	std::uint32_t hash = 2166136261u;
+	for (std::size_t i = 0; i < length; ++i)
+	{
+		hash ^= static_cast<unsigned char>(name[i]);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+* @brief Returns the smallest power of two that leaves the table for @a count
+*        items at most half full.
+*/
+std::uint32_t getBucketCount(std::size_t count)
+{
+	std::uint32_t buckets = 1;
+	while (buckets < 2 * count)
+	{
+		buckets *= 2;
+	}
+	return buckets;
+}
+
+void writeUint32(std::string &out, std::size_t offset, std::size_t value)
+{
+	if (value > UINT32_MAX)
+	{
+		throw retdec::ctypesparser::CTypesParseError(
+			"C-types index would be larger than 4 GB.");
+	}
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		out[offset + i] = static_cast<char>((value >> (8 * i)) & 0xff);
+	}
+}
+
+void appendUint32(std::string &out, std::size_t value)
+{
+	out.append(4, '\0');
+	writeUint32(out, out.size() - 4, value);
+}
+
+/**
+* @brief Appends records for all members of @a items to @a out and returns
+*        their hash table.
+*/
+std::vector<std::uint32_t> appendRecords(
+	std::string &out,
+	const rapidjson::Value &items)
+{
+	std::vector<std::uint32_t> table(getBucketCount(items.MemberCount()), 0);
+	auto mask = table.size() - 1;
+	for (auto i = items.MemberBegin(), e = items.MemberEnd(); i != e; ++i)
+	{
+		const char *name = i->name.GetString();
+		std::size_t nameLength = i->name.GetStringLength();
+		auto bucket = hashName(name, nameLength) & mask;
+		while (table[bucket] != 0)
+		{
+			bucket = (bucket + 1) & mask;
+		}
+		table[bucket] = static_cast<std::uint32_t>(out.size());
+
+		rapidjson::StringBuffer json;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(json);
+		i->value.Accept(writer);
+
+		appendUint32(out, nameLength);
+		out.append(name, nameLength);
+		appendUint32(out, json.GetSize());
+		out.append(json.GetString(), json.GetSize());
+	}
+	return table;
+}
+
+} // anonymous namespace
+
+namespace retdec {
+namespace ctypesparser {
+
+/**
+* @brief Constructs a new parser.
+*/
+IndexedCTypesParser::IndexedCTypesParser() = default;
+
+/**
+* @brief Constructs a new parser.
+*
+* @param defaultBitWidth BitWidth used for types that are not in typeWidths.
+*/
+IndexedCTypesParser::IndexedCTypesParser(unsigned defaultBitWidth):
+	JSONCTypesParser(defaultBitWidth) {}
+
+/**
+* @brief Parses all C-types from an index.
+*
+* @param[in] stream Input stream containing the index.
+* @param[in] typeWidths C-types' bit widths.
+* @param[in] callConvention Function call convention.
+*
+* @return Module filled with C-types information.
+*
+* @throw CTypesParseError when the input index is invalid.
+*/
+std::unique_ptr<retdec::ctypes::Module> IndexedCTypesParser::parse(
+	std::istream &stream,
+	const CTypesParser::TypeWidths &typeWidths,
+	const retdec::ctypes::CallConvention &callConvention)
+{
+	auto module = std::make_unique<retdec::ctypes::Module>(context);
+	parseInto(stream, module, typeWidths, callConvention);
+	return module;
+}
+
+/**
+* @brief Parses all C-types from an index to user's module.
+*
+* @param[in] stream Input stream containing the index.
+* @param[in] module User's module.
+* @param[in] typeWidths C-types' bit widths.
+* @param[in] callConvention Function call convention.
+*
+* @throw CTypesParseError when the input index is invalid.
+*
+* All functions are materialized. Use open() and getFunction() to
+* materialize only the needed ones.
+*/
+void IndexedCTypesParser::parseInto(
+	std::istream &stream,
+	std::unique_ptr<retdec::ctypes::Module> &module,
+	const CTypesParser::TypeWidths &typeWidths,
+	const retdec::ctypes::CallConvention &callConvention)
+{
+	assert(module && "violated precondition - module cannot be null");
+
+	ownedData = loadJson(stream);
+	open(ownedData.data(), ownedData.size(), module->getContext(),
+		typeWidths, callConvention);
+
+	for (std::uint32_t i = 0; i < functions.bucketCount; ++i)
+	{
+		auto offset = readUint32(functions.offset + 4 * i);
+		if (offset == 0)
+		{
+			continue;
+		}
+
+		auto nameLength = readUint32(offset);
+		if (offset + 4 + std::size_t(nameLength) > size)
+		{
+			throw CTypesParseError("Corrupted C-types index.");
+		}
+		auto function = getFunction(std::string(data + offset + 4, nameLength));
+		if (function)
+		{
+			module->addFunction(function);
+		}
+	}
+}
+
+/**
+* @brief Opens an index for lazy access to its functions.
+*
+* @param[in] data Data of the index. They have to outlive the parser.
+* @param[in] size Size of @a data.
+* @param[in] context Context the materialized C-types are stored into.
+* @param[in] typeWidths C-types' bit widths.
+* @param[in] callConvention Function call convention.
+*
+* @throw CTypesParseError when @a data is not a valid index.
+*/
+void IndexedCTypesParser::open(
+	const char *data,
+	std::size_t size,
+	const std::shared_ptr<retdec::ctypes::Context> &context,
+	const CTypesParser::TypeWidths &typeWidths,
+	const retdec::ctypes::CallConvention &callConvention)
+{
+	assert(context && "violated precondition - context cannot be null");
+
+	this->context = context;
+	this->typeWidths = typeWidths;
+	defaultCallConv = callConvention;
+
+	// Type keys are unique only in a single file.
+	parserContext.clear();
+	typeRecords.clear();
+
+	openIndex(data, size);
+}
+
+/**
+* @brief Checks whether the opened index contains function @a name.
+*/
+bool IndexedCTypesParser::hasFunction(const std::string &name) const
+{
+	Record record;
+	return findRecord(functions, name, record);
+}
+
+/**
+* @brief Returns function @a name from the opened index.
+*
+* The function and all types it uses are parsed on the first request and
+* stored into the context given to open().
+*
+* @return The function or @c nullptr when the index does not contain it.
+*
+* @throw CTypesParseError when the index is corrupted.
+*/
+std::shared_ptr<retdec::ctypes::Function> IndexedCTypesParser::getFunction(
+	const std::string &name)
+{
+	Record record;
+	if (!findRecord(functions, name, record))
+	{
+		return nullptr;
+	}
+
+	auto jsonFunction = parseRecord(record);
+	auto function = getOrParseFunction(name, *jsonFunction);
+
+	// All the needed types are in the parser context now.
+	typeRecords.clear();
+	return function;
+}
+
+/**
+* @brief Checks whether the opened index was created from a JSON file of size
+*        @a jsonSize, last modified at @a jsonModificationTime.
+*
+* The content of the JSON file is not compared, so the check does not need to
+* read the file. An edit that keeps both the size and the modification time of
+* the file is not detected.
+*/
+bool IndexedCTypesParser::isCreatedFrom(
+	std::uint64_t jsonSize,
+	std::uint64_t jsonModificationTime) const
+{
+	return jsonSize == sourceSize
+		&& jsonModificationTime == sourceModificationTime;
+}
+
+/**
+* @brief Checks whether @a data start with the header of an index.
+*/
+bool IndexedCTypesParser::isIndex(const char *data, std::size_t size)
+{
+	return size >= HEADER_size
+		&& std::memcmp(data, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0;
+}
+
+/**
+* @brief Returns JSON representation of the type with the given key.
+*
+* The type record is parsed from the index and kept until the currently
+* parsed function is finished.
+*
+* @throw CTypesParseError when there is no such type.
+*/
+const rapidjson::Value &IndexedCTypesParser::getJsonType(
+	const std::string &typeKey)
+{
+	auto it = typeRecords.find(typeKey);
+	if (it != typeRecords.end())
+	{
+		return *it->second;
+	}
+
+	Record record;
+	if (!findRecord(types, typeKey, record))
+	{
+		throw CTypesParseError("unknown type " + typeKey);
+	}
+	auto &jsonType = typeRecords[typeKey] = parseRecord(record);
+	return *jsonType;
+}
+
+/**
+* @brief Checks the header and hash tables of the index in @a data.
+*
+* @throw CTypesParseError when @a data is not a valid index.
+*/
+void IndexedCTypesParser::openIndex(const char *data, std::size_t size)
+{
+	this->data = data;
+	this->size = size;
+
+	if (!isIndex(data, size))
+	{
+		throw CTypesParseError("Input is not a C-types index.");
+	}
+	if (readUint32(HEADER_version) != INDEX_VERSION)
+	{
+		throw CTypesParseError("Unsupported version of C-types index.");
+	}
+
+	sourceSize = readUint32(HEADER_sourceSize);
+	sourceModificationTime = std::uint64_t(readUint32(HEADER_sourceMTime))
+		| std::uint64_t(readUint32(HEADER_sourceMTime + 4)) << 32;
+	functions = readTable(HEADER_functionTable);
+	types = readTable(HEADER_typeTable);
+}
+
+/**
+* @brief Reads the hash table described in the header at @a headerOffset.
+*
+* @throw CTypesParseError when the table does not fit into the index.
+*/
+IndexedCTypesParser::Table IndexedCTypesParser::readTable(
+	std::size_t headerOffset) const
+{
+	Table table;
+	table.bucketCount = readUint32(headerOffset);
+	table.offset = readUint32(headerOffset + 4);
+	if (table.bucketCount == 0
+			|| (table.bucketCount & (table.bucketCount - 1)) != 0
+			|| table.offset + 4 * std::size_t(table.bucketCount) > size)
+	{
+		throw CTypesParseError("Corrupted C-types index.");
+	}
+	return table;
+}
+
+/**
+* @brief Finds record @a name in hash @a table.
+*
+* @return @c true if the record was found, @c false otherwise.
+*
+* @throw CTypesParseError when the index is corrupted.
+*/
+bool IndexedCTypesParser::findRecord(
+	const Table &table,
+	const std::string &name,
+	Record &record) const
+{
+	if (data == nullptr)
+	{
+		return false;
+	}
+
+	auto mask = table.bucketCount - 1;
+	auto bucket = hashName(name.data(), name.size()) & mask;
+	for (std::uint32_t probes = 0; probes < table.bucketCount; ++probes)
+	{
+		auto offset = readUint32(table.offset + 4 * std::size_t(bucket));
+		if (offset == 0)
+		{
+			return false;
+		}
+
+		std::size_t nameLength = readUint32(offset);
+		std::size_t jsonOffset = offset + 4 + nameLength;
+		std::size_t jsonSize = readUint32(jsonOffset);
+		if (jsonOffset + 4 + jsonSize > size)
+		{
+			throw CTypesParseError("Corrupted C-types index.");
+		}
+
+		if (nameLength == name.size()
+				&& std::memcmp(data + offset + 4, name.data(), nameLength) == 0)
+		{
+			record.json = data + jsonOffset + 4;
+			record.jsonSize = jsonSize;
+			return true;
+		}
+		bucket = (bucket + 1) & mask;
+	}
+	return false;
+}
+
+/**
+* @brief Parses JSON stored in @a record.
+*
+* @throw CTypesParseError when the JSON is invalid.
+*/
+std::unique_ptr<rapidjson::Document> IndexedCTypesParser::parseRecord(
+	const Record &record) const
+{
+	auto root = std::make_unique<rapidjson::Document>();
+	rapidjson::ParseResult res = root->Parse(record.json, record.jsonSize);
+	if (!res)
+	{
+		handleParsingFailure(res);
+	}
+	return root;
+}
+
+/**
+* @brief Reads a little-endian 32-bit integer at @a offset of the index.
+*
+* @throw CTypesParseError when @a offset is out of the index.
+*/
+std::uint32_t IndexedCTypesParser::readUint32(std::size_t offset) const
+{
+	if (offset + 4 > size)
+	{
+		throw CTypesParseError("Corrupted C-types index.");
+	}
+
+	auto *bytes = reinterpret_cast<const unsigned char *>(data + offset);
+	return std::uint32_t(bytes[0])
+		| std::uint32_t(bytes[1]) << 8
+		| std::uint32_t(bytes[2]) << 16
+		| std::uint32_t(bytes[3]) << 24;
+}
+
+/**
+* @brief Creates an index of C-types in JSON.
+*
+* @param[in] jsonStream Input stream containing C-types in JSON.
+* @param[out] indexStream Output stream the index is written into.
+* @param[in] jsonModificationTime Time of the last modification of the JSON
+*                                 file (in seconds since the epoch).
+*
+* The size and the modification time of the JSON file are stored in the index,
+* so a reader can tell whether the index is out of date without reading the
+* JSON file (see IndexedCTypesParser::isCreatedFrom()).
+*
+* @throw CTypesParseError when the input JSON is invalid or the index cannot
+*                         be written.
+*
+* See IndexedCTypesParser for the description of the index.
+*/
+void createCTypesIndex(std::istream &jsonStream, std::ostream &indexStream,
+	std::uint64_t jsonModificationTime)
+{
+	std::ostringstream sstr;
+	sstr << jsonStream.rdbuf();
+	if (!jsonStream.good())
+	{
+		throw CTypesParseError("Failed to read from the input stream.");
+	}
+	std::string buffer = sstr.str();
+	auto sourceSize = buffer.size();
+
+	rapidjson::Document root;
+	rapidjson::ParseResult res = root.Parse(buffer.data(), buffer.size());
+	if (!res)
+	{
+		throw CTypesParseError("Failed to parse JSON.");
+	}
+	if (!root.IsObject()
+			|| !root.HasMember(JSON_functions) || !root[JSON_functions].IsObject()
+			|| !root.HasMember(JSON_types) || !root[JSON_types].IsObject())
+	{
+		throw CTypesParseError("JSON must contain functions and types objects.");
+	}
+
+	std::string index(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+	appendUint32(index, INDEX_VERSION);
+	appendUint32(index, sourceSize);
+	appendUint32(index, jsonModificationTime & 0xffffffff);
+	appendUint32(index, jsonModificationTime >> 32);
+	index.append(HEADER_size - index.size(), '\0');
+
+	auto funcTable = appendRecords(index, root[JSON_functions]);
+	auto typeTable = appendRecords(index, root[JSON_types]);
+
+	writeUint32(index, HEADER_functionTable, funcTable.size());
+	writeUint32(index, HEADER_functionTable + 4, index.size());
+	for (auto offset : funcTable)
+	{
+		appendUint32(index, offset);
+	}
+	writeUint32(index, HEADER_typeTable, typeTable.size());
+	writeUint32(index, HEADER_typeTable + 4, index.size());
+	for (auto offset : typeTable)
+	{
+		appendUint32(index, offset);
+	}
+
+	if (!indexStream.write(index.data(), index.size()))
+	{
+		throw CTypesParseError("Failed to write the C-types index.");
+	}
+}
+
+} // namespace ctypesparser
+} // namespace retdec
@@ -321,6 +321,21 @@ void JSONCTypesParser::addTypesToMap(const rapidjson::Value &types)
 	}
 }
 
+/**
+* @brief Returns JSON representation of the type with the given key.
+*
+* @throw CTypesParseError when there is no such type.
+*/
+const rapidjson::Value &JSONCTypesParser::getJsonType(const std::string &typeKey)
+{
+	auto it = typesMap.find(typeKey);
+	if (it == typesMap.end())
+	{
+		throw CTypesParseError("unknown type " + typeKey);
+	}
+	return it->second->value;
+}
+
 /**
 * @brief Returns function from context, if already stored, otherwise parse new one.
 *
@@ -523,7 +538,7 @@ std::shared_ptr<retdec::ctypes::Type> JSONCTypesParser::getOrParseType(
 std::shared_ptr<retdec::ctypes::Type> JSONCTypesParser::parseType(
 	const std::string &typeKey)
 {
-	const rapidjson::Value &jsonType = retdec::utils::mapGetValueOrDefault(typesMap, typeKey)->value;
+	const rapidjson::Value &jsonType = getJsonType(typeKey);
 	std::string typeOfType = safeGetString(jsonType, JSON_type);
 	std::shared_ptr<retdec::ctypes::Type> parsedType;
 
@@ -0,0 +1,106 @@
+/**
+ * @file src/ctypesparsertool/ctypesparser.cpp
+ * @brief Creates indexes of C-types in JSON.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "retdec/ctypesparser/indexed_ctypes_parser.h"
+
+/**
+ * Print usage.
+ */
+void printUsage()
+{
+	std::cout << "\nCreates an index of C-types for fast lookup of functions.\n"
+		<< "Usage: retdec-ctypesparser INPUT_JSON_FILE OUTPUT_INDEX_FILE\n\n";
+}
+
+/**
+ * Print error message and return non-zero value.
+ *
+ * @param errorMessage message to print
+ * @return non-zero value
+ */
+int printError(
+	const std::string &errorMessage)
+{
+	std::cerr << "Error: " << errorMessage << "\n";
+	return 1;
+}
+
+/**
+ * Get the time of the last modification of @a file in seconds since the epoch.
+ *
+ * @param file path to the file
+ * @param[out] time modification time
+ * @return @c true on success, @c false otherwise
+ */
+bool getModificationTime(const std::string &file, std::uint64_t &time)
+{
+	struct stat st;
+	if (stat(file.c_str(), &st) != 0)
+	{
+		return false;
+	}
+	time = static_cast<std::uint64_t>(st.st_mtime);
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		printUsage();
+		return 1;
+	}
+
+	std::ifstream input(argv[1], std::ios::in | std::ios::binary);
+	if (!input)
+	{
+		return printError("cannot open input file " + std::string(argv[1]));
+	}
+	std::uint64_t inputModificationTime = 0;
+	if (!getModificationTime(argv[1], inputModificationTime))
+	{
+		return printError("cannot get status of input file "
+			+ std::string(argv[1]));
+	}
+
+	// The index is written under a temporary name first, so a reader never
+	// sees a partial index.
+	std::string outputFile = argv[2];
+	std::string tmpFile = outputFile + ".tmp";
+	try
+	{
+		std::ofstream output(tmpFile, std::ios::out | std::ios::binary);
+		if (!output)
+		{
+			return printError("cannot open output file " + tmpFile);
+		}
+		retdec::ctypesparser::createCTypesIndex(input, output,
+			inputModificationTime);
+	}
+	catch (const retdec::ctypesparser::CTypesParseError &e)
+	{
+		std::remove(tmpFile.c_str());
+		return printError(std::string(argv[1]) + ": " + e.what());
+	}
+
+	std::remove(outputFile.c_str());
+	if (std::rename(tmpFile.c_str(), outputFile.c_str()) != 0)
+	{
+		std::remove(tmpFile.c_str());
+		return printError("cannot create output file " + outputFile);
+	}
+
+	return 0;
+}
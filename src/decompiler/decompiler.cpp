@@ -0,0 +1,404 @@
+/**
+ * @file src/decompiler/decompiler.cpp
+ * @brief In-process decompilation of a binary file into a high-level language.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <llvm/ADT/Triple.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Analysis/ScalarEvolution.h>
+#include <llvm/Analysis/TargetLibraryInfo.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/InitializePasses.h>
+#include <llvm/PassRegistry.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/ToolOutputFile.h>
+
+#include "retdec/bin2llvmir/optimizations/fixpoint/fixpoint.h"
+#include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
+#include "retdec/cpdetect/errors.h"
+#include "retdec/decompiler/decompiler.h"
+#include "retdec/utils/filesystem_path.h"
+#include "retdec/utils/string.h"
+#include "retdec/yara-cache/yara_cache.h"
+#include "bin2llvmir_passes.h"
+#include "fileinfo/file_detector/detector_factory.h"
+#include "fileinfo/file_presentation/config_presentation.h"
+
+using namespace llvm;
+
+namespace retdec {
+namespace decompiler {
+
+namespace {
+
+const std::set<std::string> SIGNATURE_SUFFIXES = {".yar", ".yara", ".yarac"};
+const std::string TYPES_SUFFIX = ".json";
+
+/**
+ * Markers of a group of passes run by @c FixpointPassGroup.
+ * Same as @c -fixpoint-begin and @c -fixpoint-end of bin2llvmir.
+ */
+const std::string FIXPOINT_BEGIN = "fixpoint-begin";
+const std::string FIXPOINT_END = "fixpoint-end";
+
+/**
+ * Get the bin2llvmir pipeline.
+ * @c BIN2LLVMIR_PASSES are generated from @c BIN2LLVMIR_PARAMS in
+ * @c retdec-config.py, without @c provider-init, which is created with
+ * the in-memory config.
+ */
+std::vector<std::string> getBin2llvmirPasses(bool keepUnreachableFuncs)
+{
+	auto passes = BIN2LLVMIR_PASSES;
+	if (keepUnreachableFuncs)
+	{
+		passes.erase(
+				std::remove(passes.begin(), passes.end(), "unreachable-funcs"),
+				passes.end());
+	}
+
+	return passes;
+}
+
+/**
+ * Get all files with one of the @p suffixes in the @p dirPath directory
+ * and its subdirectories. Compiled rules from the YARA cache are skipped.
+ */
+void getDirFiles(
+		const std::string& dirPath,
+		std::set<std::string>& ret,
+		const std::set<std::string>& suffixes)
+{
+	retdec::utils::FilesystemPath fsp(dirPath);
+	if (!fsp.isDirectory())
+	{
+		return;
+	}
+
+	for (auto f : fsp)
+	{
+		if (f->isDirectory())
+		{
+			getDirFiles(f->getPath(), ret, suffixes);
+		}
+		else if (f->isFile()
+				&& std::any_of(suffixes.begin(), suffixes.end(),
+						[&] (const auto& s) { return retdec::utils::endsWith(f->getPath(), s); })
+				&& !retdec::yara_cache::isCachedRuleFile(f->getPath()))
+		{
+			auto p = fsp.separator() == '\\'
+					? retdec::utils::replaceAll(f->getPath(), "\\", "/")
+					: f->getPath();
+			ret.insert(p);
+		}
+	}
+}
+
+std::string joinPath(const std::string& base, const std::string& sub)
+{
+	retdec::utils::FilesystemPath p(base);
+	p.append(sub);
+	return p.getPath();
+}
+
+/**
+ * Detect information about the input file and store it into @p config.
+ * This is what @c retdec-fileinfo does with the @c -c option.
+ */
+void runFileinfo(
+		const DecompilationParams& params,
+		retdec::config::Config& config)
+{
+	using namespace retdec::cpdetect;
+	using namespace retdec::fileformat;
+
+	DetectParams searchPar(SearchType::MOST_SIMILAR, true, false);
+	auto loadFlags = static_cast<LoadFlags>(LoadFlags::NO_FILE_HASHES
+			| LoadFlags::NO_VERBOSE_HASHES);
+	const fileinfo::YaraPatternPaths yaraPaths = {
+		{"crypto", params.cryptoPatternPaths}
+	};
+
+	fileinfo::FileInformation finfo;
+	std::unique_ptr<fileinfo::FileDetector> fileDetector(
+			fileinfo::detectFileInformation(
+					params.inputFile,
+					finfo,
+					searchPar,
+					loadFlags,
+					&config,
+					yaraPaths));
+
+	auto res = finfo.getStatus();
+	if (isFatalError(res))
+	{
+		throw DecompilationError(
+				getErrorMessage(res, finfo.getFileFormatEnum()));
+	}
+
+	fileinfo::ConfigPresentation presentation(finfo, config);
+	if (!presentation.present())
+	{
+		throw DecompilationError(
+				"loading of config failed: " + presentation.getErrorMessage());
+	}
+}
+
+/**
+ * Check that the detected file can be decompiled and fill in the decompiler
+ * parameters into @p config. This is what @c retdec-decompiler.py does by
+ * the @c retdec-config calls.
+ */
+void prepareConfig(
+		const DecompilationParams& params,
+		retdec::config::Config& config)
+{
+	auto& arch = config.architecture;
+	auto& format = config.fileFormat;
+
+	std::string ordsDir;
+	std::string sigArch;
+	if (arch.isArmOrThumb())
+	{
+		ordsDir = joinPath(params.supportDir, "arm/ords");
+		sigArch = arch.isThumb() ? "thumb" : "arm";
+	}
+	else if (arch.isX86())
+	{
+		ordsDir = joinPath(params.supportDir, "x86/ords");
+		sigArch = "x86";
+	}
+	else if (arch.isMipsOrPic32())
+	{
+		sigArch = "mips";
+	}
+	else if (arch.isPpc())
+	{
+		sigArch = "powerpc";
+	}
+	else
+	{
+		throw DecompilationError("unsupported target architecture '"
+				+ arch.getName() + "'");
+	}
+
+	auto fileClass = format.getFileClassBits();
+	if (fileClass != 16 && fileClass != 32 && fileClass != 64)
+	{
+		throw DecompilationError("unsupported target format '"
+				+ format.getName() + std::to_string(fileClass) + "'");
+	}
+	if (fileClass == 64 && arch.getBitSize() != 64)
+	{
+		throw DecompilationError("unsupported target format and architecture"
+				" combination: '" + format.getName() + std::to_string(fileClass)
+				+ "' + '" + arch.getName() + "'");
+	}
+
+	if (arch.isEndianUnknown())
+	{
+		throw DecompilationError("cannot determine endianness");
+	}
+
+	if (params.keepUnreachableFuncs)
+	{
+		config.parameters.setIsKeepAllFunctions(true);
+	}
+
+	if (!params.noDefaultStaticSignatures)
+	{
+		auto sigFormat = format.isIntelHex() || format.isRaw()
+				? std::string("elf")
+				: format.getName();
+		auto sigDir = joinPath(params.supportDir, "generic/yara_patterns/static-code");
+		sigDir = joinPath(sigDir, sigFormat);
+		sigDir = joinPath(sigDir, std::to_string(fileClass));
+		sigDir = joinPath(sigDir, arch.isEndianLittle() ? "le" : "be");
+		sigDir = joinPath(sigDir, sigArch);
+		getDirFiles(sigDir, config.parameters.staticSignaturePaths, SIGNATURE_SUFFIXES);
+	}
+	config.parameters.userStaticSignaturePaths.insert(
+			params.userSignaturePaths.begin(),
+			params.userSignaturePaths.end());
+
+	getDirFiles(
+			joinPath(params.supportDir, "generic/types"),
+			config.parameters.libraryTypeInfoPaths,
+			{TYPES_SUFFIX});
+
+	if (!ordsDir.empty() && retdec::utils::FilesystemPath(ordsDir).isDirectory())
+	{
+		config.parameters.setOrdinalNumbersDirectory(ordsDir + "/");
+	}
+
+	config.setInputFile(params.inputFile);
+	config.parameters.setOutputFile(params.outputFile);
+	config.parameters.setIsSelectedDecodeOnly(false);
+}
+
+/**
+ * Call a bunch of LLVM initialization functions, same as the original opt.
+ */
+void initializeLlvmPasses()
+{
+	PassRegistry& registry = *PassRegistry::getPassRegistry();
+	initializeCore(registry);
+	initializeScalarOpts(registry);
+	initializeIPO(registry);
+	initializeAnalysis(registry);
+	initializeTransformUtils(registry);
+	initializeInstCombine(registry);
+	initializeTarget(registry);
+}
+
+/**
+ * Create an empty module for bin2llvmir.
+ */
+std::unique_ptr<Module> createLlvmModule(LLVMContext& context)
+{
+	SMDiagnostic err;
+
+	std::string c = "; ModuleID = 'test'\nsource_filename = \"test\"\n";
+	auto mb = MemoryBuffer::getMemBuffer(c);
+	auto m = parseIR(mb->getMemBufferRef(), err, context);
+	if (m == nullptr)
+	{
+		throw DecompilationError("failed to create llvm::Module");
+	}
+
+	return m;
+}
+
+/**
+ * Lift the input binary into @p module. @p config is used instead of a
+ * config file and it is updated when the passes finish.
+ */
+void runBin2llvmir(
+		const DecompilationParams& params,
+		Module& module,
+		retdec::config::Config& config)
+{
+	legacy::PassManager pm;
+
+	// Same as -disable-simplify-libcalls.
+	TargetLibraryInfoImpl tlii(Triple(module.getTargetTriple()));
+	tlii.disableAllFunctions();
+	pm.add(new TargetLibraryInfoWrapperPass(tlii));
+	pm.add(createTargetTransformInfoWrapperPass(TargetIRAnalysis()));
+
+	pm.add(new retdec::bin2llvmir::ProviderInitialization(&config));
+	retdec::bin2llvmir::FixpointPassGroup* fixpoint = nullptr;
+	for (auto& name : getBin2llvmirPasses(params.keepUnreachableFuncs))
+	{
+		if (name == FIXPOINT_BEGIN)
+		{
+			fixpoint = new retdec::bin2llvmir::FixpointPassGroup(
+					tlii,
+					retdec::bin2llvmir::FixpointPassGroup::DEFAULT_MAX_ITERATIONS);
+			pm.add(fixpoint);
+			continue;
+		}
+		else if (name == FIXPOINT_END)
+		{
+			fixpoint = nullptr;
+			continue;
+		}
+
+		auto* passInfo = PassRegistry::getPassRegistry()->getPassInfo(name);
+		if (passInfo == nullptr || passInfo->getNormalCtor() == nullptr)
+		{
+			throw DecompilationError("cannot create pass: " + name);
+		}
+		auto* pass = passInfo->getNormalCtor()();
+		if (fixpoint)
+		{
+			fixpoint->getPassManager().add(pass);
+		}
+		else
+		{
+			pm.add(pass);
+		}
+	}
+	pm.add(createVerifierPass());
+
+	pm.run(module);
+}
+
+/**
+ * Convert the lifted @p module into the target HLL.
+ */
+void runLlvmir2hll(
+		const DecompilationParams& params,
+		Module& module,
+		retdec::config::Config& config)
+{
+	std::error_code ec;
+	ToolOutputFile out(params.outputFile, ec, sys::fs::F_None);
+	if (ec)
+	{
+		throw DecompilationError("cannot open output file '"
+				+ params.outputFile + "': " + ec.message());
+	}
+
+	auto options = params.backendOptions;
+	if (options.outputFile.empty())
+	{
+		options.outputFile = params.outputFile;
+	}
+	auto* decompiler = new retdec::llvmir2hll::Decompiler(
+			out.os(),
+			options,
+			&config);
+
+	legacy::PassManager pm;
+	pm.add(new TargetLibraryInfoWrapperPass(
+			TargetLibraryInfoImpl(Triple(module.getTargetTriple()))));
+	pm.add(new LoopInfoWrapperPass());
+	pm.add(new ScalarEvolutionWrapperPass());
+	pm.add(decompiler);
+	pm.run(module);
+
+	if (!decompiler->wasSuccessful())
+	{
+		throw DecompilationError("decompilation of LLVM IR failed");
+	}
+	out.keep();
+}
+
+} // anonymous namespace
+
+void decompile(
+		const DecompilationParams& params,
+		retdec::config::Config& config)
+{
+	runFileinfo(params, config);
+	prepareConfig(params, config);
+
+	initializeLlvmPasses();
+	LLVMContext context;
+	auto module = createLlvmModule(context);
+
+	runBin2llvmir(params, *module, config);
+	retdec::bin2llvmir::clearProviders(module.get());
+	runLlvmir2hll(params, *module, config);
+
+	if (!params.outputConfigFile.empty())
+	{
+		config.generateJsonFile(params.outputConfigFile);
+	}
+}
+
+} // namespace decompiler
+} // namespace retdec
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+
+"""Generates the list of bin2llvmir passes used by the in-process decompiler.
+
+The passes are taken from BIN2LLVMIR_PARAMS in retdec-config.py, so that
+retdec-decompiler.py and retdec-decompiler always run the same pipeline.
+
+Usage: generate_passes.py path/to/retdec-config.py output.h
+"""
+
+import os
+import runpy
+import sys
+
+# Options that are not passes. -provider-init is created with the in-memory
+# config and library calls are disabled directly in the pass manager.
+SKIPPED_PARAMS = {
+    '-provider-init',
+    '-disable-inlining',
+    '-disable-simplify-libcalls',
+}
+
+
+def load_config(path):
+    return runpy.run_path(path)
+
+
+def generate(params):
+    passes = []
+    for param in params:
+        if param in SKIPPED_PARAMS:
+            continue
+        if not param.startswith('-') or param.startswith('-disable-'):
+            sys.exit('unsupported bin2llvmir parameter: ' + param)
+        passes.append(param[1:])
+
+    lines = [
+        '/**',
+        ' * @file bin2llvmir_passes.h',
+        ' * @brief bin2llvmir pipeline generated from retdec-config.py.',
+        ' *',
+        ' * Generated by src/decompiler/generate_passes.py. Do not edit.',
+        ' */',
+        '',
+        '#ifndef RETDEC_DECOMPILER_BIN2LLVMIR_PASSES_H',
+        '#define RETDEC_DECOMPILER_BIN2LLVMIR_PASSES_H',
+        '',
+        '#include <string>',
+        '#include <vector>',
+        '',
+        'namespace retdec {',
+        'namespace decompiler {',
+        '',
+        'const std::vector<std::string> BIN2LLVMIR_PASSES =',
+        '{',
+    ]
+    lines += ['\t"{}",'.format(p) for p in passes]
+    lines += [
+        '};',
+        '',
+        '} // namespace decompiler',
+        '} // namespace retdec',
+        '',
+        '#endif',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+
+    content = generate(load_config(sys.argv[1])['BIN2LLVMIR_PARAMS'])
+
+    # Keep the old file when nothing changed to avoid needless rebuilds.
+    if os.path.isfile(sys.argv[2]):
+        with open(sys.argv[2], 'r') as f:
+            if f.read() == content:
+                return
+    with open(sys.argv[2], 'w') as f:
+        f.write(content)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,260 @@
+/**
+ * @file src/decompilertool/decompiler.cpp
+ * @brief Decompiler of a binary file into a high-level language.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ *
+ * Unlike @c retdec-decompiler.py, all the decompilation stages run in this
+ * process. Unpacking, archives and raw input are not supported -- use the
+ * script for them.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/PrettyStackTrace.h>
+#include <llvm/Support/Signals.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "retdec/decompiler/decompiler.h"
+#include "retdec/llvmir2hll/decompiler_command_line.h"
+#include "retdec/utils/filesystem_path.h"
+
+namespace {
+
+llvm::cl::OptionCategory BackendCategory("Back-end options");
+
+retdec::llvmir2hll::DecompilerCommandLine BackendOptions(
+		"backend-",
+		BackendCategory);
+
+void printHelp()
+{
+	std::cout << "retdec-decompiler - decompiler of executable files\n\n"
+			<< "Usage: retdec-decompiler [options] file\n\n"
+			<< "Options list:\n"
+			<< "    -h, --help                Display this help.\n"
+			<< "    -o, --output FILE         Output file (default: file.c or file.py).\n"
+			<< "    -l, --target-language L   Target high-level language: c or py (default: c).\n"
+			<< "    -k, --keep-unreachable-funcs\n"
+			<< "                              Decompile also unreachable functions.\n"
+			<< "    --config FILE             Store the final config into FILE.\n"
+			<< "    --static-code-sigfile FILE\n"
+			<< "                              Additional signatures of statically linked code.\n"
+			<< "    --no-default-static-signatures\n"
+			<< "                              Do not use the default signatures of statically\n"
+			<< "                              linked code.\n"
+			<< "    --support-dir DIR         Path to the RetDec support directory.\n"
+			<< "    --backend-no-debug        Disable emission of debug messages.\n"
+			<< "    --backend-no-debug-comments\n"
+			<< "                              Disable emission of debug comments.\n"
+			<< "    --backend-OPTION[=VALUE]  Back-end option, the same as -backend-OPTION\n"
+			<< "                              of retdec-bin2llvmir (e.g. --backend-no-opts,\n"
+			<< "                              --backend-optimizer-threads=1).\n";
+}
+
+/**
+ * Parse the back-end options collected in @p args into @p options.
+ */
+bool parseBackendOptions(
+		const char* argv0,
+		const std::vector<std::string>& args,
+		retdec::llvmir2hll::DecompilerOptions& options)
+{
+	std::vector<const char*> argv = {argv0};
+	for (auto& a : args)
+	{
+		argv.push_back(a.c_str());
+	}
+	if (!llvm::cl::ParseCommandLineOptions(
+			argv.size(),
+			argv.data(),
+			"",
+			&llvm::errs()))
+	{
+		return false;
+	}
+
+	options = BackendOptions.getOptions();
+	return true;
+}
+
+/**
+ * Get the default support directory, which is installed next to the binary:
+ * <prefix>/bin/retdec-decompiler, <prefix>/share/retdec/support
+ */
+std::string getDefaultSupportDir(const char* argv0)
+{
+	static int anchor = 0;
+	std::string exe = llvm::sys::fs::getMainExecutable(argv0, &anchor);
+	llvm::SmallString<256> dir(llvm::sys::path::parent_path(exe));
+	llvm::sys::path::append(dir, "..", "share", "retdec", "support");
+	return dir.str();
+}
+
+/**
+ * Add the first existing of @p paths into @p ret.
+ */
+void addFirstExisting(
+		const std::vector<std::string>& paths,
+		std::set<std::string>& ret)
+{
+	for (auto& p : paths)
+	{
+		if (retdec::utils::FilesystemPath(p).isFile())
+		{
+			ret.insert(p);
+			return;
+		}
+	}
+}
+
+bool doParams(
+		int argc,
+		char** argv,
+		retdec::decompiler::DecompilationParams& params)
+{
+	std::string targetHll = "c";
+	bool debug = true;
+	bool emitDebugComments = true;
+	std::vector<std::string> backendArgs;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string c = argv[i];
+		auto getParam = [&] (std::string& out)
+		{
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+			out = argv[++i];
+			return true;
+		};
+
+		std::string val;
+		if (c == "-o" || c == "--output")
+		{
+			if (!getParam(params.outputFile)) return false;
+		}
+		else if (c == "-l" || c == "--target-language")
+		{
+			if (!getParam(targetHll)) return false;
+		}
+		else if (c == "-k" || c == "--keep-unreachable-funcs")
+		{
+			params.keepUnreachableFuncs = true;
+		}
+		else if (c == "--config")
+		{
+			if (!getParam(params.outputConfigFile)) return false;
+		}
+		else if (c == "--static-code-sigfile")
+		{
+			if (!getParam(val)) return false;
+			params.userSignaturePaths.insert(val);
+		}
+		else if (c == "--no-default-static-signatures")
+		{
+			params.noDefaultStaticSignatures = true;
+		}
+		else if (c == "--support-dir")
+		{
+			if (!getParam(params.supportDir)) return false;
+		}
+		else if (c == "--backend-no-debug")
+		{
+			debug = false;
+		}
+		else if (c == "--backend-no-debug-comments")
+		{
+			emitDebugComments = false;
+		}
+		else if (c.compare(0, 10, "--backend-") == 0)
+		{
+			backendArgs.push_back(c);
+		}
+		else if (params.inputFile.empty() && !c.empty() && c[0] != '-')
+		{
+			params.inputFile = c;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	if (params.inputFile.empty()
+			|| (targetHll != "c" && targetHll != "py"))
+	{
+		return false;
+	}
+
+	auto& backend = params.backendOptions;
+	if (!parseBackendOptions(argv[0], backendArgs, backend))
+	{
+		return false;
+	}
+	backend.targetHll = targetHll;
+	backend.debug = debug;
+	backend.emitDebugComments = emitDebugComments;
+	backend.validateModule = true;
+
+	if (params.outputFile.empty())
+	{
+		params.outputFile = params.inputFile + "." + targetHll;
+	}
+	if (params.supportDir.empty())
+	{
+		params.supportDir = getDefaultSupportDir(argv[0]);
+	}
+
+	retdec::utils::FilesystemPath signsrch(params.supportDir);
+	signsrch.append("generic/yara_patterns/signsrch/signsrch");
+	addFirstExisting(
+			{signsrch.getPath() + ".yarac", signsrch.getPath() + ".yara"},
+			params.cryptoPatternPaths);
+
+	return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+	llvm::sys::PrintStackTraceOnErrorSignal(argv[0]);
+	llvm::PrettyStackTraceProgram X(argc, argv);
+	llvm::llvm_shutdown_obj Y;
+
+	if (argc == 2
+			&& (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))
+	{
+		printHelp();
+		return 0;
+	}
+
+	retdec::decompiler::DecompilationParams params;
+	if (!doParams(argc, argv, params))
+	{
+		std::cerr << "Error: invalid parameters\n\n";
+		printHelp();
+		return 1;
+	}
+
+	try
+	{
+		retdec::config::Config config;
+		retdec::decompiler::decompile(params, config);
+	}
+	catch (const std::runtime_error& e)
+	{
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
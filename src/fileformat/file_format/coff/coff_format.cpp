@@ -217,7 +217,12 @@ Symbol::UsageType getSymbolUsageType(std::uint8_t storageClass, std::uint8_t com
  */
 CoffFormat::CoffFormat(std::string pathToFile, LoadFlags loadFlags) :
 		FileFormat(pathToFile, loadFlags),
-		fileBuffer(MemoryBuffer::getFile(Twine(pathToFile)))
+		fileBuffer(MemoryBuffer::getMemBuffer(
+				StringRef(
+						reinterpret_cast<const char*>(getBytesData()),
+						getFileLength()),
+				"",
+				false))
 {
 	initStructures();
 }
@@ -231,8 +236,8 @@ CoffFormat::CoffFormat(std::istream &inputStream, LoadFlags loadFlags) :
 		FileFormat(inputStream, loadFlags),
 		fileBuffer(MemoryBuffer::getMemBuffer(
 				StringRef(
-						reinterpret_cast<const char*>(bytes.data()),
-						bytes.size()),
+						reinterpret_cast<const char*>(getBytesData()),
+						getFileLength()),
 				"",
 				false))
 {
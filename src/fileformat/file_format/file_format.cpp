@@ -14,7 +14,7 @@
 
 #include <pelib/PeLibInc.h>
 
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/file_io.h"
 #include "retdec/utils/string.h"
@@ -24,7 +24,7 @@
 #include "retdec/fileformat/utils/byte_array_buffer.h"
 #include "retdec/fileformat/file_format/intel_hex/intel_hex_format.h"
 #include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
-#include "retdec/fileformat/types/strings/character_iterator.h"
+#include "retdec/fileformat/types/strings/string_scanner.h"
 #include "retdec/fileformat/utils/conversions.h"
 #include "retdec/fileformat/utils/file_io.h"
 #include "retdec/fileformat/utils/other.h"
@@ -121,10 +121,11 @@ bool isAddressFromRegion(const SecSeg *actualRegion, const SecSeg *newRegion, st
 FileFormat::FileFormat(std::string pathToFile, LoadFlags loadFlags) :
 		auxBuff(nullptr, nullptr),
 		auxIStream(&auxBuff),
+		inputStream(auxFStream),
 		loadedBytes(&bytes),
 		loadFlags(loadFlags),
 		filePath(pathToFile),
-		fileStream(auxFStream),
+		fileStream(nullptr),
 		_ldrErrInfo()
 {
 	auxFStream.open(filePath, std::ifstream::binary);
@@ -140,9 +141,10 @@ FileFormat::FileFormat(std::string pathToFile, LoadFlags loadFlags) :
 FileFormat::FileFormat(std::istream &inputStream, LoadFlags loadFlags) :
 		auxBuff(nullptr, nullptr),
 		auxIStream(&auxBuff),
+		inputStream(inputStream),
 		loadedBytes(&bytes),
 		loadFlags(loadFlags),
-		fileStream(inputStream),
+		fileStream(nullptr),
 		_ldrErrInfo()
 {
 	stateIsValid = !inputStream.fail();
@@ -158,9 +160,10 @@ FileFormat::FileFormat(std::istream &inputStream, LoadFlags loadFlags) :
 FileFormat::FileFormat(const std::uint8_t *data, std::size_t size, LoadFlags loadFlags) :
 		auxBuff(data, size),
 		auxIStream(&auxBuff),
+		inputStream(auxIStream),
 		loadedBytes(&bytes),
 		loadFlags(loadFlags),
-		fileStream(auxIStream),
+		fileStream(nullptr),
 		_ldrErrInfo()
 {
 	stateIsValid = true;
@@ -190,7 +193,14 @@ void FileFormat::init()
 	tlsInfo = nullptr;
 	elfCoreInfo = nullptr;
 	fileFormat = Format::UNDETECTABLE;
-	stateIsValid = readFile(fileStream, bytes) && stateIsValid;
+	if (!initMappedFile())
+	{
+		stateIsValid = readFile(inputStream, bytes) && stateIsValid;
+	}
+	if (auxFStream.is_open())
+	{
+		auxFStream.close();
+	}
 	if (getLoadFlags() & LoadFlags::NO_FILE_HASHES)
 	{
 		crc32.clear();
@@ -199,20 +209,54 @@ void FileFormat::init()
 	}
 	else
 	{
-		crc32 = retdec::crypto::getCrc32(bytes.data(), bytes.size());
-		md5 = retdec::crypto::getMd5(bytes.data(), bytes.size());
-		sha256 = retdec::crypto::getSha256(bytes.data(), bytes.size());
+		const auto fileBytes = getBytes();
+		const auto hashes = retdec::crypto::MultiHash::compute(fileBytes.data(), fileBytes.size());
+		crc32 = hashes.crc32;
+		md5 = hashes.md5;
+		sha256 = hashes.sha256;
 	}
 	initStream();
 }
 
 /**
- * Initialize internal state of member @c fileStream
+ * Map input file into memory if it was requested by load flags
+ * @return @c true if input file is mapped, @c false otherwise
+ *
+ * Mapping is possible only if instance was created from path to input file.
+ * If mapping fails, content of input file is read into @c bytes as usual.
+ */
+bool FileFormat::initMappedFile()
+{
+	if (!(getLoadFlags() & LoadFlags::MEMORY_MAP_INPUT) || filePath.empty())
+	{
+		return false;
+	}
+
+	auto buffer = llvm::MemoryBuffer::getFile(
+			filePath,
+			-1,
+			/*RequiresNullTerminator=*/false);
+	if (!buffer)
+	{
+		return false;
+	}
+
+	mappedFile = std::move(buffer.get());
+	return true;
+}
+
+/**
+ * Initialize member @c fileStream
+ *
+ * The stream reads the content of input file that has already been loaded
+ * (or mapped) by init(). Parsers of file formats (e.g. PeLib, ELFIO) thus
+ * do not do any further I/O on input file.
  */
 void FileFormat::initStream()
 {
-	fileStream.clear();
-	fileStream.seekg(0);
+	const auto fileBytes = getBytes();
+	bytesBuff.reset(new byte_array_buffer(fileBytes.data(), fileBytes.size()));
+	fileStream.rdbuf(bytesBuff.get());
 }
 
 /**
@@ -221,11 +265,58 @@ void FileFormat::initStream()
  * @return Number of offsets in offsets vector after initialization
  */
 
+/**
+ * Load the given component now, or on its first access if lazy loading of
+ * components is enabled (see LoadFlags::LAZY_COMPONENTS)
+ * @param component Loaded component
+ * @param loader Function which loads the component
+ */
+void FileFormat::loadComponent(LazyComponent component, std::function<void()> loader)
+{
+	if (getLoadFlags() & LoadFlags::LAZY_COMPONENTS)
+	{
+		std::lock_guard<std::recursive_mutex> lock(lazyLoadersMutex);
+		lazyLoaders[component] = std::move(loader);
+	}
+	else
+	{
+		loader();
+	}
+}
+
+/**
+ * Load the given component if it has not been loaded yet
+ * @param component Component to load
+ *
+ * Getters of lazily loaded components have to call this method before they
+ * access the component.
+ */
+void FileFormat::loadLazyComponent(LazyComponent component) const
+{
+	std::lock_guard<std::recursive_mutex> lock(lazyLoadersMutex);
+	auto it = lazyLoaders.find(component);
+	if (it == lazyLoaders.end())
+	{
+		return;
+	}
+
+	// Remove the loader before calling it so it is called only once, even if
+	// it accesses the component itself.
+	auto loader = std::move(it->second);
+	lazyLoaders.erase(it);
+	loader();
+}
+
 /**
  * Clear all internal structures
  */
 void FileFormat::clear()
 {
+	{
+		std::lock_guard<std::recursive_mutex> lock(lazyLoadersMutex);
+		lazyLoaders.clear();
+	}
+
 	delete importTable;
 	delete exportTable;
 	delete resourceTable;
@@ -269,8 +360,40 @@ void FileFormat::clear()
 }
 
 /**
- * Compute hashes of section table. This method must be called after
- * sections are loaded.
+ * Compute hashes of content of all loaded sections and segments
+ *
+ * Sections and segments are independent of each other, so they are hashed
+ * in parallel, unless LoadFlags::SINGLE_THREADED is set.
+ */
+void FileFormat::computeSecSegHashes()
+{
+	std::vector<SecSeg*> secSegs;
+	std::vector<retdec::crypto::MultiHash::Range> ranges;
+	auto addSecSeg = [&](SecSeg *secSeg)
+	{
+		const auto data = secSeg ? secSeg->getBytes() : llvm::StringRef();
+		if(!data.empty())
+		{
+			secSegs.push_back(secSeg);
+			ranges.emplace_back(reinterpret_cast<const std::uint8_t*>(data.data()), data.size());
+		}
+	};
+	std::for_each(sections.begin(), sections.end(), addSecSeg);
+	std::for_each(segments.begin(), segments.end(), addSecSeg);
+
+	const auto hashes = retdec::crypto::MultiHash::compute(
+			ranges,
+			retdec::crypto::MultiHash::DEFAULT,
+			(getLoadFlags() & LoadFlags::SINGLE_THREADED) ? 1 : 0);
+	for(std::size_t i = 0, e = secSegs.size(); i < e; ++i)
+	{
+		secSegs[i]->setHashes(hashes[i]);
+	}
+}
+
+/**
+ * Compute hashes of content of sections and segments and hashes of section
+ * table. This method must be called after sections and segments are loaded.
  */
 void FileFormat::computeSectionTableHashes()
 {
@@ -279,6 +402,8 @@ void FileFormat::computeSectionTableHashes()
 		return;
 	}
 
+	computeSecSegHashes();
+
 	if(!initSectionTableHashOffsets() || secHashInfo.empty())
 	{
 		return;
@@ -316,9 +441,10 @@ void FileFormat::computeSectionTableHashes()
 
 	if(!data.empty())
 	{
-		sectionCrc32 = retdec::crypto::getCrc32(data.data(), data.size());
-		sectionMd5 = retdec::crypto::getMd5(data.data(), data.size());
-		sectionSha256 = retdec::crypto::getSha256(data.data(), data.size());
+		const auto hashes = retdec::crypto::MultiHash::compute(data.data(), data.size());
+		sectionCrc32 = hashes.crc32;
+		sectionMd5 = hashes.md5;
+		sectionSha256 = hashes.sha256;
 	}
 }
 
@@ -377,22 +503,6 @@ void FileFormat::loadStrings()
 	if (!(getLoadFlags() & LoadFlags::DETECT_STRINGS))
 		return;
 
-	loadStrings(StringType::Ascii, 1);
-	loadStrings(StringType::Wide, 2);
-
-	// Sort and remove duplicates
-	std::sort(strings.begin(), strings.end());
-	auto endItr = std::unique(strings.begin(), strings.end());
-	strings.erase(endItr, strings.end());
-}
-
-/**
- * Load strings of specified type and with specified character size.
- * @param type Type of the strings.
- * @param charSize Character size.
- */
-void FileFormat::loadStrings(StringType type, std::size_t charSize)
-{
 	if (!sections.empty())
 	{
 		for (const auto* sec : sections)
@@ -400,7 +510,7 @@ void FileFormat::loadStrings(StringType type, std::size_t charSize)
 			if (!sec->isSomeData() && !sec->isDebug())
 				continue;
 
-			loadStrings(type, charSize, sec);
+			loadStrings(sec);
 		}
 	}
 	else
@@ -410,33 +520,37 @@ void FileFormat::loadStrings(StringType type, std::size_t charSize)
 			if (!seg->isSomeData() && !seg->isDebug())
 				continue;
 
-			loadStrings(type, charSize, seg);
+			loadStrings(seg);
 		}
 	}
+
+	// Sort and remove duplicates
+	std::sort(strings.begin(), strings.end());
+	auto endItr = std::unique(strings.begin(), strings.end());
+	strings.erase(endItr, strings.end());
 }
 
-void FileFormat::loadStrings(StringType type, std::size_t charSize, const SecSeg* secSeg)
+/**
+ * Load ASCII and wide strings from the given section or segment.
+ * @param secSeg Section or segment.
+ *
+ * Strings refer to content of input file, their characters are copied only
+ * when they are requested.
+ */
+void FileFormat::loadStrings(const SecSeg* secSeg)
 {
-	CharacterEndianness endian = isLittleEndian() ? CharacterEndianness::Little : CharacterEndianness::Big;
+	const auto bytes = secSeg->getBytes();
+	const auto sectionName = secSeg->getName();
+	StringScanner scanner(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size());
 
-	for (auto begin = secSeg->getBytes().begin(), end = secSeg->getBytes().end(), itr = begin; itr != end;)
-	{
-		if (makeCharacterIterator(itr, begin, end, charSize).pointsToValidCharacter(endian))
-		{
-			auto stringBeginItr = makeCharacterIterator(itr, begin, end, charSize);
-			auto stringDataEndItr = makeCharacterIterator(end, begin, end, charSize);
-			auto stringEndItr = stringBeginItr + 1;
-			while (stringEndItr != stringDataEndItr && stringEndItr.pointsToValidCharacter(endian))
-				++stringEndItr;
-
-			if (static_cast<std::size_t>(stringEndItr - stringBeginItr) >= DefaultMinStringLength)
-				strings.emplace_back(type, secSeg->getOffset() + (itr - begin), secSeg->getName(), std::string{stringBeginItr, stringEndItr});
+	for (const auto& run : scanner.findAsciiRuns(DefaultMinStringLength))
+		strings.emplace_back(StringType::Ascii, secSeg->getOffset() + run.offset, sectionName, bytes.data() + run.offset, run.length, 1);
 
-			itr = stringEndItr.getUnderlyingIterator();
-		}
-		else
-			++itr;
-	}
+	// The printable byte of a big endian wide character is the second one.
+	CharacterEndianness endian = isLittleEndian() ? CharacterEndianness::Little : CharacterEndianness::Big;
+	const std::size_t charOffset = endian == CharacterEndianness::Little ? 0 : 1;
+	for (const auto& run : scanner.findWideRuns(DefaultMinStringLength, endian))
+		strings.emplace_back(StringType::Wide, secSeg->getOffset() + run.offset, sectionName, bytes.data() + run.offset + charOffset, run.length, 2);
 }
 
 /**
@@ -487,6 +601,20 @@ bool FileFormat::isInValidState() const
 	return stateIsValid;
 }
 
+/**
+ * Find out whether input file is mapped into memory
+ * @return @c true if content of input file is held by a read-only mapping
+ *    of the file, @c false otherwise
+ *
+ * Even if @c LoadFlags::MEMORY_MAP_INPUT is set, very small files are read
+ * into a heap-allocated buffer instead of being mapped.
+ */
+bool FileFormat::isMemoryMapped() const
+{
+	return mappedFile
+			&& mappedFile->getBufferKind() == llvm::MemoryBuffer::MemoryBuffer_MMap;
+}
+
 /**
  * Getter for load flags.
  * @return Load flags.
@@ -1051,7 +1179,7 @@ std::size_t FileFormat::getNumberOfDynamicTables() const
  */
 std::size_t FileFormat::getFileLength() const
 {
-	return bytes.size();
+	return getBytes().size();
 }
 
 /**
@@ -1060,7 +1188,7 @@ std::size_t FileFormat::getFileLength() const
  */
 std::size_t FileFormat::getLoadedFileLength() const
 {
-	return loadedBytes->size();
+	return getLoadedBytes().size();
 }
 
 /**
@@ -1192,9 +1320,8 @@ bool FileFormat::getBytes(std::vector<std::uint8_t> &result, unsigned long long
 	}
 
 	numberOfBytes = offset + numberOfBytes > getLoadedFileLength() ? getLoadedFileLength() - offset : numberOfBytes;
-	result.clear();
-	result.reserve(numberOfBytes);
-	std::copy(loadedBytes->begin() + offset, loadedBytes->begin() + offset + numberOfBytes, std::back_inserter(result));
+	const auto loaded = getLoadedBytes();
+	result.assign(loaded.begin() + offset, loaded.begin() + offset + numberOfBytes);
 	return true;
 }
 
@@ -1230,7 +1357,8 @@ bool FileFormat::getEpBytes(std::vector<std::uint8_t> &result, unsigned long lon
  */
 bool FileFormat::getHexBytes(std::string &result, unsigned long long offset, unsigned long long numberOfBytes) const
 {
-	bytesToHexString(*loadedBytes, result, offset, numberOfBytes);
+	const auto loaded = getLoadedBytes();
+	bytesToHexString(loaded.data(), loaded.size(), result, offset, numberOfBytes);
 	return offset < getLoadedFileLength();
 }
 
@@ -1281,7 +1409,8 @@ bool FileFormat::getHexBytesFromEnd(std::string &result, unsigned long long numb
  */
 bool FileFormat::getString(std::string &result, unsigned long long offset, unsigned long long numberOfBytes) const
 {
-	bytesToString(*loadedBytes, result, offset, numberOfBytes);
+	const auto loaded = getLoadedBytes();
+	bytesToString(loaded.data(), loaded.size(), result, offset, numberOfBytes);
 	return offset < getLoadedFileLength();
 }
 
@@ -1521,6 +1650,7 @@ const ExportTable* FileFormat::getExportTable() const
  */
 const ResourceTable* FileFormat::getResourceTable() const
 {
+	loadLazyComponent(LazyComponent::RESOURCES);
 	return resourceTable;
 }
 
@@ -1530,6 +1660,7 @@ const ResourceTable* FileFormat::getResourceTable() const
  */
 const ResourceTree* FileFormat::getResourceTree() const
 {
+	loadLazyComponent(LazyComponent::RESOURCES);
 	return resourceTree;
 }
 
@@ -1557,6 +1688,7 @@ const PdbInfo* FileFormat::getPdbInfo() const
  */
 const CertificateTable* FileFormat::getCertificateTable() const
 {
+	loadLazyComponent(LazyComponent::CERTIFICATES);
 	return certificateTable;
 }
 
@@ -1713,6 +1845,7 @@ const Export* FileFormat::getExport(unsigned long long address) const
  */
 const Resource* FileFormat::getManifestResource() const
 {
+	loadLazyComponent(LazyComponent::RESOURCES);
 	return resourceTable ? resourceTable->getResourceWithType(PELIB_RT_MANIFEST) : nullptr;
 }
 
@@ -1722,6 +1855,7 @@ const Resource* FileFormat::getManifestResource() const
  */
 const Resource* FileFormat::getVersionResource() const
 {
+	loadLazyComponent(LazyComponent::RESOURCES);
 	return resourceTable ? resourceTable->getResourceWithType(PELIB_RT_VERSION) : nullptr;
 }
 
@@ -1731,6 +1865,7 @@ const Resource* FileFormat::getVersionResource() const
  */
 bool FileFormat::isSignaturePresent() const
 {
+	loadLazyComponent(LazyComponent::CERTIFICATES);
 	return signatureVerified.isDefined();
 }
 
@@ -1740,6 +1875,7 @@ bool FileFormat::isSignaturePresent() const
  */
 bool FileFormat::isSignatureVerified() const
 {
+	loadLazyComponent(LazyComponent::CERTIFICATES);
 	return signatureVerified.isDefined() && signatureVerified.getValue();
 }
 
@@ -1749,6 +1885,8 @@ bool FileFormat::isSignatureVerified() const
  */
 const retdec::utils::RangeContainer<std::uint64_t>& FileFormat::getNonDecodableAddressRanges() const
 {
+	// Resources are not decodable.
+	loadLazyComponent(LazyComponent::RESOURCES);
 	return nonDecodableRanges;
 }
 
@@ -1849,20 +1987,30 @@ const std::vector<DynamicTable*>& FileFormat::getDynamicTables() const
 
 /**
  * Get content of input file as bytes
- * @return Content of input file as bytes
+ * @return View of content of input file as bytes
+ *
+ * Returned view is valid as long as this instance exists. If input file
+ * is mapped into memory, view points directly into the mapping.
  */
-const std::vector<unsigned char>& FileFormat::getBytes() const
+llvm::ArrayRef<unsigned char> FileFormat::getBytes() const
 {
+	if (mappedFile)
+	{
+		return llvm::ArrayRef<unsigned char>(
+				reinterpret_cast<const unsigned char*>(mappedFile->getBufferStart()),
+				mappedFile->getBufferSize());
+	}
+
 	return bytes;
 }
 
 /**
  * Get serialized loaded content of input file as bytes
- * @return Serialized content of input file as bytes
+ * @return View of serialized content of input file as bytes
  */
-const std::vector<unsigned char>& FileFormat::getLoadedBytes() const
+llvm::ArrayRef<unsigned char> FileFormat::getLoadedBytes() const
 {
-	return *loadedBytes;
+	return loadedBytes == &bytes ? getBytes() : llvm::ArrayRef<unsigned char>(*loadedBytes);
 }
 
 /**
@@ -1871,7 +2019,7 @@ const std::vector<unsigned char>& FileFormat::getLoadedBytes() const
  */
 const unsigned char* FileFormat::getBytesData() const
 {
-	return bytes.data();
+	return getBytes().data();
 }
 
 /**
@@ -1880,12 +2028,15 @@ const unsigned char* FileFormat::getBytesData() const
  */
 const unsigned char* FileFormat::getLoadedBytesData() const
 {
-	return loadedBytes->data();
+	return getLoadedBytes().data();
 }
 
 /**
  * Get all detected strings
  * @return Reference to strings
+ *
+ * The reference is valid as long as this instance. Every string owns a copy
+ * of its content, so strings copied out of the vector may outlive it.
  */
 const std::vector<String>& FileFormat::getStrings() const
 {
@@ -1930,7 +2081,7 @@ bool FileFormat::getXByte(std::uint64_t address, std::uint64_t x, std::uint64_t
 	const auto secOffset = address - secSeg->getAddress();
 	const auto offset = secSeg->getOffset() + secOffset;
 	return (secOffset + x > secSeg->getLoadedSize() || offset + x > getLoadedFileLength()) ?
-		false : createValueFromBytes(*loadedBytes, res, e, offset, x);
+		false : createValueFromBytes(getLoadedBytesData(), getLoadedFileLength(), res, e, offset, x);
 }
 
 /**
@@ -2070,7 +2221,7 @@ bool FileFormat::getXByteOffset(std::uint64_t offset, std::uint64_t x, std::uint
 		return true;
 	}
 
-	return createValueFromBytes(*loadedBytes, res, e, offset, x);
+	return createValueFromBytes(getLoadedBytesData(), getLoadedFileLength(), res, e, offset, x);
 }
 
 /**
@@ -2085,7 +2236,8 @@ bool FileFormat::getXBytesOffset(std::uint64_t offset, std::uint64_t x, std::vec
 	res.clear();
 	if(offset + x <= getLoadedFileLength())
 	{
-		res.assign(loadedBytes->begin() + offset, loadedBytes->begin() + offset + x);
+		const auto loaded = getLoadedBytes();
+		res.assign(loaded.begin() + offset, loaded.begin() + offset + x);
 		return res.size() == x;
 	}
 
@@ -2575,6 +2727,7 @@ void FileFormat::dumpResourceTree()
 
 void FileFormat::dumpResourceTree(std::string &dumpStr)
 {
+	loadLazyComponent(LazyComponent::RESOURCES);
 	if(!resourceTree)
 	{
 		dumpStr.clear();
@@ -68,7 +68,12 @@ std::string getVersionFromDWord(const std::uint32_t version)
  */
 MachOFormat::MachOFormat(std::string pathToFile, LoadFlags loadFlags) :
 		FileFormat(pathToFile, loadFlags),
-		fileBuffer(MemoryBuffer::getFile(Twine(filePath))),
+		fileBuffer(MemoryBuffer::getMemBuffer(
+				StringRef(
+						reinterpret_cast<const char*>(getBytesData()),
+						getFileLength()),
+				"",
+				false)),
 		file(nullptr),
 		fatFile(nullptr)
 {
@@ -83,8 +88,8 @@ MachOFormat::MachOFormat(std::string pathToFile, LoadFlags loadFlags) :
 MachOFormat::MachOFormat(std::istream &inputStream, LoadFlags loadFlags) :
 		FileFormat(inputStream, loadFlags),
 		fileBuffer(MemoryBuffer::getMemBuffer(StringRef(
-				reinterpret_cast<const char*>(bytes.data()),
-				bytes.size()))),
+				reinterpret_cast<const char*>(getBytesData()),
+				getFileLength()))),
 		file(nullptr),
 		fatFile(nullptr)
 {
@@ -280,6 +285,7 @@ void MachOFormat::initStructures()
 		}
 		fileFormat = Format::MACHO;
 		loadCommands();
+		computeSectionTableHashes();
 		loadStrings();
 		loadImpHash();
 		loadExpHash();
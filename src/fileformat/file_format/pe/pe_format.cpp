@@ -28,7 +28,7 @@
 #include "retdec/fileformat/utils/asn1.h"
 #include "retdec/fileformat/utils/conversions.h"
 #include "retdec/fileformat/utils/file_io.h"
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 
 
 using namespace retdec::utils;
@@ -370,8 +370,13 @@ void PeFormat::initStructures()
 			file->readExportDirectory();
 			file->readDebugDirectory();
 			file->readTlsDirectory();
-			file->readResourceDirectory();
-			file->readSecurityDirectory();
+			if(!(getLoadFlags() & LoadFlags::LAZY_COMPONENTS))
+			{
+				// Otherwise, they are read on the first access to resources
+				// or certificates.
+				file->readResourceDirectory();
+				file->readSecurityDirectory();
+			}
 			file->readComHeaderDirectory();
 
 			// Fill-in the loader error info from PE file
@@ -426,16 +431,57 @@ void PeFormat::initStructures()
 		loadImports();
 		loadExports();
 		loadPdbInfo();
-		loadResources();
-		loadCertificates();
+		loadComponent(LazyComponent::RESOURCES, [this]() {
+			if(readLazyDirectory([this]() { file->readResourceDirectory(); }))
+			{
+				loadResources();
+			}
+		});
+		loadComponent(LazyComponent::CERTIFICATES, [this]() {
+			if(readLazyDirectory([this]() { file->readSecurityDirectory(); }))
+			{
+				loadCertificates();
+			}
+		});
 		loadTlsInformation();
-		loadDotnetHeaders();
-		loadVisualBasicHeader();
+		loadComponent(LazyComponent::DOTNET_HEADERS, [this]() {
+			loadDotnetHeaders();
+		});
+		loadComponent(LazyComponent::VISUAL_BASIC_HEADER, [this]() {
+			loadVisualBasicHeader();
+		});
 		computeSectionTableHashes();
 		loadStrings();
 	}
 }
 
+/**
+ * Read PeLib directory needed by a lazily loaded component
+ * @param read Function which reads the directory
+ * @return @c true if the directory can be used, @c false otherwise
+ *
+ * If lazy loading of components is disabled, the directory has already been
+ * read in initStructures().
+ */
+bool PeFormat::readLazyDirectory(const std::function<void()> &read)
+{
+	if(!(getLoadFlags() & LoadFlags::LAZY_COMPONENTS))
+	{
+		return true;
+	}
+
+	// The state of the instance cannot be changed after its initialization,
+	// so the component is just left empty if the directory is broken.
+	try
+	{
+		read();
+		return true;
+	} catch(...)
+	{
+		return false;
+	}
+}
+
 std::size_t PeFormat::initSectionTableHashOffsets()
 {
 	secHashInfo.emplace_back(20, 4);
@@ -543,7 +589,7 @@ void PeFormat::loadRichHeader()
 	}
 
 	std::string plainText;
-	bytesToString(bytes, plainText, getMzHeaderSize(), getPeHeaderOffset() - getMzHeaderSize());
+	bytesToString(getBytesData(), getFileLength(), plainText, getMzHeaderSize(), getPeHeaderOffset() - getMzHeaderSize());
 	auto offset = getRichHeaderOffset(plainText);
 	auto standardOffset = (offset == STANDARD_RICH_HEADER_OFFSET);
 	if(offset >= getPeHeaderOffset())
@@ -1755,15 +1801,12 @@ void PeFormat::loadTlsInformation()
 	auto callBacksAddr = formatParser->getTlsAddressOfCallBacks();
 	tlsInfo->setCallBacksAddr(callBacksAddr);
 
-	const auto &allBytes = getBytes();
-	DynamicBuffer structContent(allBytes);
-
 	unsigned long long callBacksOffset;
 	if (getOffsetFromAddress(callBacksOffset, callBacksAddr))
 	{
-		while (allBytes.size() >= callBacksOffset + sizeof(std::uint32_t))
+		std::uint64_t cbAddr = 0;
+		while (get4ByteOffset(callBacksOffset, cbAddr, retdec::utils::Endianness::LITTLE))
 		{
-			auto cbAddr = structContent.read<std::uint32_t>(callBacksOffset);
 			callBacksOffset += sizeof(std::uint32_t);
 
 			if (cbAddr == 0)
@@ -1978,12 +2021,12 @@ std::vector<std::tuple<const std::uint8_t*, std::size_t>> PeFormat::getDigestRan
 	for (auto& offsetSize : offsets)
 	{
 		// If the length of the range is bigger than the amount of data we have available, then sanitize the length
-		if (offsetSize.second > bytes.size())
-			offsetSize.second = bytes.size();
+		if (offsetSize.second > getFileLength())
+			offsetSize.second = getFileLength();
 
 		// If the range overlaps the end of the file, then sanitize the length
-		if (offsetSize.first + offsetSize.second > bytes.size())
-			offsetSize.second = bytes.size() - offsetSize.first;
+		if (offsetSize.first + offsetSize.second > getFileLength())
+			offsetSize.second = getFileLength() - offsetSize.first;
 
 		// This offsetSize is completely covered by the last offset so ignore it
 		if (offsetSize.first + offsetSize.second <= lastOffset)
@@ -1997,13 +2040,13 @@ std::vector<std::tuple<const std::uint8_t*, std::size_t>> PeFormat::getDigestRan
 			offsetSize.first = lastOffset;
 		}
 
-		result.emplace_back(bytes.data() + lastOffset, offsetSize.first - lastOffset);
+		result.emplace_back(getBytesData() + lastOffset, offsetSize.first - lastOffset);
 		lastOffset = offsetSize.first + offsetSize.second;
 	}
 
 	// Finish off the data if the last offset didn't end at the end of all data
-	if (lastOffset != bytes.size())
-		result.emplace_back(bytes.data() + lastOffset, bytes.size() - lastOffset);
+	if (lastOffset != getFileLength())
+		result.emplace_back(getBytesData() + lastOffset, getFileLength() - lastOffset);
 
 	return result;
 }
@@ -2709,9 +2752,10 @@ void PeFormat::computeTypeRefHashes()
 		}
 	}
 
-	typeRefHashCrc32 = retdec::crypto::getCrc32(typeRefHashBytes.data(), typeRefHashBytes.size());
-	typeRefHashMd5 = retdec::crypto::getMd5(typeRefHashBytes.data(), typeRefHashBytes.size());
-	typeRefHashSha256 = retdec::crypto::getSha256(typeRefHashBytes.data(), typeRefHashBytes.size());
+	const auto hashes = retdec::crypto::MultiHash::compute(typeRefHashBytes.data(), typeRefHashBytes.size());
+	typeRefHashCrc32 = hashes.crc32;
+	typeRefHashMd5 = hashes.md5;
+	typeRefHashSha256 = hashes.sha256;
 }
 
 retdec::utils::Endianness PeFormat::getEndianness() const
@@ -3130,6 +3174,7 @@ int PeFormat::getPeClass() const
  */
 bool PeFormat::isDotNet() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return clrHeader != nullptr || metadataHeader != nullptr;
 }
 
@@ -3277,76 +3322,91 @@ const PeCoffSection* PeFormat::getPeSection(unsigned long long secIndex) const
 
 const CLRHeader* PeFormat::getCLRHeader() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return clrHeader.get();
 }
 
 const MetadataHeader* PeFormat::getMetadataHeader() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return metadataHeader.get();
 }
 
 const MetadataStream* PeFormat::getMetadataStream() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return metadataStream.get();
 }
 
 const StringStream* PeFormat::getStringStream() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return stringStream.get();
 }
 
 const BlobStream* PeFormat::getBlobStream() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return blobStream.get();
 }
 
 const GuidStream* PeFormat::getGuidStream() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return guidStream.get();
 }
 
 const UserStringStream* PeFormat::getUserStringStream() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return userStringStream.get();
 }
 
 const std::string& PeFormat::getModuleVersionId() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return moduleVersionId;
 }
 
 const std::string& PeFormat::getTypeLibId() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return typeLibId;
 }
 
 const std::vector<std::shared_ptr<DotnetClass>>& PeFormat::getDefinedDotnetClasses() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return definedClasses;
 }
 
 const std::vector<std::shared_ptr<DotnetClass>>& PeFormat::getImportedDotnetClasses() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return importedClasses;
 }
 
 const std::string& PeFormat::getTypeRefhashCrc32() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return typeRefHashCrc32;
 }
 
 const std::string& PeFormat::getTypeRefhashMd5() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return typeRefHashMd5;
 }
 
 const std::string& PeFormat::getTypeRefhashSha256() const
 {
+	loadLazyComponent(LazyComponent::DOTNET_HEADERS);
 	return typeRefHashSha256;
 }
 
 const VisualBasicInfo* PeFormat::getVisualBasicInfo() const
 {
+	loadLazyComponent(LazyComponent::VISUAL_BASIC_HEADER);
 	return &visualBasicInfo;
 }
 
@@ -4,7 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/fileformat/types/export_table/export_table.h"
@@ -179,9 +179,10 @@ void ExportTable::computeHashes()
 		}
 	}
 
-	expHashCrc32 = retdec::crypto::getCrc32(expHashBytes.data(), expHashBytes.size());
-	expHashMd5 = retdec::crypto::getMd5(expHashBytes.data(), expHashBytes.size());
-	expHashSha256 = retdec::crypto::getSha256(expHashBytes.data(), expHashBytes.size());
+	const auto hashes = retdec::crypto::MultiHash::compute(expHashBytes.data(), expHashBytes.size());
+	expHashCrc32 = hashes.crc32;
+	expHashMd5 = hashes.md5;
+	expHashSha256 = hashes.sha256;
 }
 
 /**
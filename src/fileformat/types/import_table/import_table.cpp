@@ -4,7 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/string.h"
@@ -815,9 +815,10 @@ void ImportTable::computeHashes()
 		}
 	}
 
-	impHashCrc32 = retdec::crypto::getCrc32(impHashBytes.data(), impHashBytes.size());
-	impHashMd5 = retdec::crypto::getMd5(impHashBytes.data(), impHashBytes.size());
-	impHashSha256 = retdec::crypto::getSha256(impHashBytes.data(), impHashBytes.size());
+	const auto hashes = retdec::crypto::MultiHash::compute(impHashBytes.data(), impHashBytes.size());
+	impHashCrc32 = hashes.crc32;
+	impHashMd5 = hashes.md5;
+	impHashSha256 = hashes.sha256;
 }
 
 /**
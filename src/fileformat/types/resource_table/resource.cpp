@@ -6,7 +6,7 @@
 
 #include <algorithm>
 
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/fileformat/file_format/file_format.h"
 #include "retdec/fileformat/types/resource_table/resource.h"
@@ -446,9 +446,10 @@ void Resource::load(const FileFormat *rOwner)
 
 	if (!(rOwner->getLoadFlags() & LoadFlags::NO_VERBOSE_HASHES))
 	{
-		crc32 = retdec::crypto::getCrc32(origBytes, bytes.size());
-		md5 = retdec::crypto::getMd5(origBytes, bytes.size());
-		sha256 = retdec::crypto::getSha256(origBytes, bytes.size());
+		const auto hashes = retdec::crypto::MultiHash::compute(origBytes, bytes.size());
+		crc32 = hashes.crc32;
+		md5 = hashes.md5;
+		sha256 = hashes.sha256;
 	}
 }
 
@@ -7,7 +7,7 @@
 #include <sstream>
 #include <iostream>
 
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/dynamic_buffer.h"
 #include "retdec/utils/string.h"
@@ -430,9 +430,10 @@ void ResourceTable::computeIconHashes()
 		return;
 	}
 
-	iconHashCrc32 = retdec::crypto::getCrc32(iconHashBytes.data(), iconHashBytes.size());
-	iconHashMd5 = retdec::crypto::getMd5(iconHashBytes.data(), iconHashBytes.size());
-	iconHashSha256 = retdec::crypto::getSha256(iconHashBytes.data(), iconHashBytes.size());
+	const auto hashes = retdec::crypto::MultiHash::compute(iconHashBytes.data(), iconHashBytes.size());
+	iconHashCrc32 = hashes.crc32;
+	iconHashMd5 = hashes.md5;
+	iconHashSha256 = hashes.sha256;
 	iconPerceptualAvgHash = computePerceptualAvgHash(*priorIcon);
 }
 
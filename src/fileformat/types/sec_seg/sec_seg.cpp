@@ -6,7 +6,7 @@
 
 #include <sstream>
 
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/string.h"
 #include "retdec/fileformat/file_format/file_format.h"
@@ -39,17 +39,6 @@ SecSeg::~SecSeg()
 
 }
 
-/**
- * Compute all supported hashes
- */
-void SecSeg::computeHashes()
-{
-	const auto *hashData = reinterpret_cast<const unsigned char*>(bytes.data());
-	crc32 = retdec::crypto::getCrc32(hashData, bytes.size());
-	md5 = retdec::crypto::getMd5(hashData, bytes.size());
-	sha256 = retdec::crypto::getSha256(hashData, bytes.size());
-}
-
 /**
  * Check if section type is undefined
  * @return @c true if section type is undefined, @c false otherwise
@@ -536,6 +525,17 @@ void SecSeg::setMemory(bool sMemory)
 	isInMemory = sMemory;
 }
 
+/**
+ * Set hashes of section or segment data
+ * @param sHashes Hashes of data (CRC32, MD5 and SHA256 are used)
+ */
+void SecSeg::setHashes(const retdec::crypto::Hashes &sHashes)
+{
+	crc32 = sHashes.crc32;
+	md5 = sHashes.md5;
+	sha256 = sHashes.sha256;
+}
+
 /**
  * Compute entropy of section data in <0,1>
  */
@@ -585,7 +585,9 @@ void SecSeg::invalidateEntrySize()
  * Load content of section or segment from input file
  * @param sOwner Pointer to input file
  *
- * This method must be called before getters of section or segment content
+ * This method must be called before getters of section or segment content.
+ * Hashes of content are computed later by FileFormat, see
+ * FileFormat::computeSectionTableHashes().
  */
 void SecSeg::load(const FileFormat *sOwner)
 {
@@ -598,11 +600,6 @@ void SecSeg::load(const FileFormat *sOwner)
 
 	bytes = StringRef(reinterpret_cast<const char*>(sOwner->getLoadedBytesData() + offset), std::min(fileSize, sOwner->getLoadedFileLength() - offset));
 	loaded = true;
-
-	if (!(sOwner->getLoadFlags() & LoadFlags::NO_VERBOSE_HASHES))
-	{
-		computeHashes();
-	}
 }
 
 /**
@@ -9,6 +9,21 @@
 namespace retdec {
 namespace fileformat {
 
+/**
+ * Extract content of a string from the referenced data
+ * @param data Referenced data
+ * @param length Number of characters of the string
+ * @param charStep Distance between characters in @a data
+ * @return Extracted content
+ */
+std::string String::extractContent(const char* data, std::size_t length, std::size_t charStep)
+{
+	std::string result(length, '\0');
+	for (std::size_t i = 0; i < length; ++i)
+		result[i] = data[i * charStep];
+	return result;
+}
+
 StringType String::getType() const
 {
 	return type;
@@ -73,12 +88,12 @@ bool String::operator<(const String& rhs) const
 {
 	return (fileOffset < rhs.fileOffset)
 		|| (fileOffset == rhs.fileOffset && type < rhs.getType())
-		|| (fileOffset == rhs.fileOffset && type == rhs.type && content < rhs.content);
+		|| (fileOffset == rhs.fileOffset && type == rhs.type && getContent() < rhs.getContent());
 }
 
 bool String::operator==(const String& rhs) const
 {
-	return (fileOffset == rhs.fileOffset) && (type == rhs.type) && (content == rhs.content);
+	return (fileOffset == rhs.fileOffset) && (type == rhs.type) && (getContent() == rhs.getContent());
 }
 
 bool String::operator!=(const String& rhs) const
@@ -0,0 +1,287 @@
+/**
+ * @file src/fileformat/types/strings/string_scanner.cpp
+ * @brief Class for finding of strings in data.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define RETDEC_STRING_SCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+// Support of AVX2 is detected at runtime, which is done only for GCC and Clang.
+#if defined(RETDEC_STRING_SCANNER_SSE2) && defined(__GNUC__)
+#define RETDEC_STRING_SCANNER_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "retdec/fileformat/types/strings/string_scanner.h"
+
+namespace retdec {
+namespace fileformat {
+
+namespace
+{
+
+/// Number of bytes classified into one word of bits.
+constexpr std::size_t BLOCK_SIZE = 64;
+
+/// All bits of a word.
+constexpr std::uint64_t ALL_BITS = ~std::uint64_t(0);
+
+/// Bits of even bytes in a word.
+constexpr std::uint64_t EVEN_BITS = 0x5555555555555555ULL;
+
+/**
+ * Function which classifies @a blocks blocks of @c BLOCK_SIZE bytes from
+ * @a data. It sets bits of printable bytes in @a printable and bits of zero
+ * bytes in @a zero (one word per block).
+ */
+using ClassifyFunction = void (*)(const std::uint8_t *data, std::size_t blocks, std::uint64_t *printable, std::uint64_t *zero);
+
+/**
+ * Index of the lowest set bit in non-zero @a word
+ */
+std::size_t countTrailingZeros(std::uint64_t word)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return index;
+#else
+	std::size_t index = 0;
+	for (; !(word & 1); word >>= 1)
+		++index;
+	return index;
+#endif
+}
+
+/**
+ * Printable characters are the same as for @c std::isprint() in the "C"
+ * locale.
+ */
+bool isPrintable(std::uint8_t byte)
+{
+	return byte >= 0x20 && byte <= 0x7E;
+}
+
+void classifyScalar(const std::uint8_t *data, std::size_t blocks, std::uint64_t *printable, std::uint64_t *zero)
+{
+	for (std::size_t block = 0; block < blocks; ++block, data += BLOCK_SIZE)
+	{
+		std::uint64_t p = 0, z = 0;
+		for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+		{
+			p |= static_cast<std::uint64_t>(isPrintable(data[i])) << i;
+			z |= static_cast<std::uint64_t>(data[i] == 0) << i;
+		}
+		printable[block] = p;
+		zero[block] = z;
+	}
+}
+
+#ifdef RETDEC_STRING_SCANNER_SSE2
+// Bytes are moved by 0x60 so that the printable ones, [0x20, 0x7E], become
+// [-128, -34] as signed bytes, and all the others are greater. A single
+// signed comparison then decides whether a byte is printable.
+void classifySse2(const std::uint8_t *data, std::size_t blocks, std::uint64_t *printable, std::uint64_t *zero)
+{
+	const auto bias = _mm_set1_epi8(0x60);
+	const auto limit = _mm_set1_epi8(static_cast<char>(0xDF));
+	const auto zeroBytes = _mm_setzero_si128();
+
+	for (std::size_t block = 0; block < blocks; ++block, data += BLOCK_SIZE)
+	{
+		std::uint64_t p = 0, z = 0;
+		for (std::size_t i = 0; i < BLOCK_SIZE; i += 16)
+		{
+			const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			const auto printableMask = _mm_movemask_epi8(_mm_cmplt_epi8(_mm_add_epi8(bytes, bias), limit));
+			const auto zeroMask = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zeroBytes));
+			p |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(printableMask)) << i;
+			z |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(zeroMask)) << i;
+		}
+		printable[block] = p;
+		zero[block] = z;
+	}
+}
+#endif
+
+#ifdef RETDEC_STRING_SCANNER_AVX2
+// The same as classifySse2(), only with twice as wide vectors.
+__attribute__((target("avx2")))
+void classifyAvx2(const std::uint8_t *data, std::size_t blocks, std::uint64_t *printable, std::uint64_t *zero)
+{
+	const auto bias = _mm256_set1_epi8(0x60);
+	const auto limit = _mm256_set1_epi8(static_cast<char>(0xDF));
+	const auto zeroBytes = _mm256_setzero_si256();
+
+	for (std::size_t block = 0; block < blocks; ++block, data += BLOCK_SIZE)
+	{
+		std::uint64_t p = 0, z = 0;
+		for (std::size_t i = 0; i < BLOCK_SIZE; i += 32)
+		{
+			const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+			const auto printableMask = _mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, _mm256_add_epi8(bytes, bias)));
+			const auto zeroMask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, zeroBytes));
+			p |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(printableMask)) << i;
+			z |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(zeroMask)) << i;
+		}
+		printable[block] = p;
+		zero[block] = z;
+	}
+}
+#endif
+
+/**
+ * Select the fastest classification supported by the processor
+ */
+ClassifyFunction selectClassifyFunction()
+{
+#ifdef RETDEC_STRING_SCANNER_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		return classifyAvx2;
+#endif
+#ifdef RETDEC_STRING_SCANNER_SSE2
+	return classifySse2;
+#else
+	return classifyScalar;
+#endif
+}
+
+} // anonymous namespace
+
+/**
+ * Constructor
+ * @param data Data to scan
+ * @param size Size of @a data
+ *
+ * @a data are not needed after construction.
+ */
+StringScanner::StringScanner(const std::uint8_t *data, std::size_t size) : size(size),
+	printable((size + BLOCK_SIZE - 1) / BLOCK_SIZE), zero((size + BLOCK_SIZE - 1) / BLOCK_SIZE)
+{
+	static const auto classify = selectClassifyFunction();
+
+	const auto fullBlocks = size / BLOCK_SIZE;
+	classify(data, fullBlocks, printable.data(), zero.data());
+
+	const auto rest = size % BLOCK_SIZE;
+	if (rest)
+	{
+		std::uint8_t lastBlock[BLOCK_SIZE] = {};
+		std::memcpy(lastBlock, data + fullBlocks * BLOCK_SIZE, rest);
+		classifyScalar(lastBlock, 1, &printable[fullBlocks], &zero[fullBlocks]);
+		// Bytes after the end of data are not zero bytes.
+		zero[fullBlocks] &= ~(ALL_BITS << rest);
+	}
+}
+
+/**
+ * Find the first set bit at or after @a start
+ * @param bits Searched bits
+ * @param start Index of the first searched bit
+ * @param mask Bits of every word which are searched
+ * @return Index of the bit or size of data if there is no such bit
+ */
+std::size_t StringScanner::findSet(const std::vector<std::uint64_t> &bits, std::size_t start, std::uint64_t mask) const
+{
+	for (std::size_t i = start / BLOCK_SIZE, e = bits.size(); i < e; ++i)
+	{
+		auto word = bits[i] & mask;
+		if (i == start / BLOCK_SIZE)
+			word &= ALL_BITS << (start % BLOCK_SIZE);
+		if (word)
+			return std::min(i * BLOCK_SIZE + countTrailingZeros(word), size);
+	}
+
+	return size;
+}
+
+/**
+ * Find the first clear bit at or after @a start
+ * @param bits Searched bits
+ * @param start Index of the first searched bit
+ * @param mask Bits of every word which are searched
+ * @return Index of the bit or size of data if there is no such bit
+ */
+std::size_t StringScanner::findClear(const std::vector<std::uint64_t> &bits, std::size_t start, std::uint64_t mask) const
+{
+	for (std::size_t i = start / BLOCK_SIZE, e = bits.size(); i < e; ++i)
+	{
+		auto word = ~bits[i] & mask;
+		if (i == start / BLOCK_SIZE)
+			word &= ALL_BITS << (start % BLOCK_SIZE);
+		if (word)
+			return std::min(i * BLOCK_SIZE + countTrailingZeros(word), size);
+	}
+
+	return size;
+}
+
+/**
+ * Find runs of printable single-byte characters
+ * @param minLength Minimal number of characters in a run
+ * @return Found runs ordered by their offsets
+ */
+std::vector<StringRun> StringScanner::findAsciiRuns(std::size_t minLength) const
+{
+	std::vector<StringRun> runs;
+	for (auto start = findSet(printable, 0, ALL_BITS); start < size; )
+	{
+		const auto end = findClear(printable, start, ALL_BITS);
+		if (end - start >= minLength)
+			runs.push_back({start, end - start});
+		start = findSet(printable, end, ALL_BITS);
+	}
+
+	return runs;
+}
+
+/**
+ * Find runs of printable two-byte characters (one byte is printable and the
+ * other one is zero)
+ * @param minLength Minimal number of characters in a run
+ * @param endian Endianness of characters
+ * @return Found runs ordered by their offsets
+ *
+ * Runs may start at any offset, not only at even ones.
+ */
+std::vector<StringRun> StringScanner::findWideRuns(std::size_t minLength, CharacterEndianness endian) const
+{
+	// Bit i of 'valid' is set if a character starts at byte i, i.e. byte i
+	// is printable and byte i + 1 is zero (or vice versa for big endian).
+	const auto &first = endian == CharacterEndianness::Little ? printable : zero;
+	const auto &second = endian == CharacterEndianness::Little ? zero : printable;
+	std::vector<std::uint64_t> valid(first.size());
+	for (std::size_t i = 0, e = valid.size(); i < e; ++i)
+	{
+		const std::uint64_t nextSecond = i + 1 < e ? second[i + 1] & 1 : 0;
+		valid[i] = first[i] & ((second[i] >> 1) | (nextSecond << (BLOCK_SIZE - 1)));
+	}
+
+	std::vector<StringRun> runs;
+	for (auto start = findSet(valid, 0, ALL_BITS); start < size; )
+	{
+		// Characters of the run start at bytes of the same parity.
+		const auto parityBits = EVEN_BITS << (start % 2);
+		const auto end = findClear(valid, start, parityBits);
+		if ((end - start) / 2 >= minLength)
+			runs.push_back({start, (end - start) / 2});
+		start = findSet(valid, end, ALL_BITS);
+	}
+
+	return runs;
+}
+
+} // namespace fileformat
+} // namespace retdec
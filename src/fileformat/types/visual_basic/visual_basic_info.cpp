@@ -4,7 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
-#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/system.h"
 #include "retdec/utils/conversion.h"
@@ -705,9 +705,10 @@ void VisualBasicInfo::computeExternTableHashes()
 		}
 	}
 
-	externTableHashCrc32 = retdec::crypto::getCrc32(hashBytes.data(), hashBytes.size());
-	externTableHashMd5 = retdec::crypto::getMd5(hashBytes.data(), hashBytes.size());
-	externTableHashSha256 = retdec::crypto::getSha256(hashBytes.data(), hashBytes.size());
+	const auto hashes = retdec::crypto::MultiHash::compute(hashBytes.data(), hashBytes.size());
+	externTableHashCrc32 = hashes.crc32;
+	externTableHashMd5 = hashes.md5;
+	externTableHashSha256 = hashes.sha256;
 }
 
 /**
@@ -747,9 +748,10 @@ void VisualBasicInfo::computeObjectTableHashes()
 		}
 	}
 
-	objectTableHashCrc32 = retdec::crypto::getCrc32(hashBytes.data(), hashBytes.size());
-	objectTableHashMd5 = retdec::crypto::getMd5(hashBytes.data(), hashBytes.size());
-	objectTableHashSha256 = retdec::crypto::getSha256(hashBytes.data(), hashBytes.size());
+	const auto hashes = retdec::crypto::MultiHash::compute(hashBytes.data(), hashBytes.size());
+	objectTableHashCrc32 = hashes.crc32;
+	objectTableHashMd5 = hashes.md5;
+	objectTableHashSha256 = hashes.sha256;
 }
 
 /**
@@ -4,26 +4,32 @@
  * @copyright (c) 2019 Avast Software, licensed under the MIT license
  */
 
-#include <iostream>
-
 #include <functional>
 #include <cassert>
-#include <cstring>
 
 #include "retdec/fileformat/utils/byte_array_buffer.h"
 
 namespace retdec {
 namespace fileformat {
 
+namespace
+{
+
+char* toChars(const std::uint8_t* bytes)
+{
+	// The get area is never written to, std::streambuf just does not have
+	// a read-only variant.
+	return reinterpret_cast<char*>(const_cast<std::uint8_t*>(bytes));
+}
+
+} // anonymous namespace
+
 byte_array_buffer::byte_array_buffer(
 		const std::uint8_t*begin,
 		const std::uint8_t*end)
-		:
-		begin_(begin),
-		end_(end),
-		current_(begin_)
 {
-	assert(std::less_equal<const std::uint8_t *>()(begin_, end_));
+	assert(std::less_equal<const std::uint8_t *>()(begin, end));
+	setg(toChars(begin), toChars(begin), toChars(end));
 }
 
 byte_array_buffer::byte_array_buffer(const std::uint8_t* data, const std::size_t size) :
@@ -34,38 +40,24 @@ byte_array_buffer::byte_array_buffer(const std::uint8_t* data, const std::size_t
 
 byte_array_buffer::int_type byte_array_buffer::underflow()
 {
-	if (current_ == end_)
-	{
-		return traits_type::eof();
-	}
-
-	return traits_type::to_int_type(*current_);
-}
-
-byte_array_buffer::int_type byte_array_buffer::uflow()
-{
-	if (current_ == end_)
-	{
-		return traits_type::eof();
-	}
-
-	return traits_type::to_int_type(*current_++);
+	// Called only if the get area is exhausted.
+	return gptr() == egptr() ? traits_type::eof() : traits_type::to_int_type(*gptr());
 }
 
 byte_array_buffer::int_type byte_array_buffer::pbackfail(int_type ch)
 {
-	if (current_ == begin_ || (ch != traits_type::eof() && ch != current_[-1]))
+	if (gptr() == eback() || (ch != traits_type::eof() && ch != traits_type::to_int_type(gptr()[-1])))
 	{
 		return traits_type::eof();
 	}
 
-	return traits_type::to_int_type(*--current_);
+	gbump(-1);
+	return traits_type::to_int_type(*gptr());
 }
 
 std::streamsize byte_array_buffer::showmanyc()
 {
-	assert(std::less_equal<const std::uint8_t *>()(current_, end_));
-	return end_ - current_;
+	return egptr() - gptr();
 }
 
 std::streampos byte_array_buffer::seekoff(
@@ -73,39 +65,31 @@ std::streampos byte_array_buffer::seekoff(
 		std::ios_base::seekdir way,
 		std::ios_base::openmode which)
 {
-	if (way == std::ios_base::beg)
+	std::streamoff base = 0;
+	if (way == std::ios_base::cur)
 	{
-		current_ = begin_ + off;
-	}
-	else if (way == std::ios_base::cur)
-	{
-		current_ += off;
+		base = gptr() - eback();
 	}
 	else if (way == std::ios_base::end)
 	{
-		current_ = end_;
-	}
-
-	if (current_ < begin_ || current_ > end_)
-	{
-		return -1;
+		base = egptr() - eback();
 	}
 
-	return current_ - begin_;
+	return seekpos(base + off, which);
 }
 
 std::streampos byte_array_buffer::seekpos(
 		std::streampos sp,
 		std::ios_base::openmode which)
 {
-	current_ = begin_ + sp;
-
-	if (current_ < begin_ || current_ > end_)
+	const std::streamoff pos = sp;
+	if (!(which & std::ios_base::in) || pos < 0 || pos > egptr() - eback())
 	{
-		return -1;
+		return std::streampos(std::streamoff(-1));
 	}
 
-	return current_ - begin_;
+	setg(eback(), eback() + pos, egptr());
+	return pos;
 }
 
 } // namespace fileformat
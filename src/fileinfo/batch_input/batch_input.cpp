@@ -0,0 +1,113 @@
+/**
+ * @file src/fileinfo/batch_input/batch_input.cpp
+ * @brief Methods of BatchInput class.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <iostream>
+
+#include "fileinfo/batch_input/batch_input.h"
+
+using namespace retdec::utils;
+
+namespace fileinfo {
+
+/**
+ * Add file or all files in directory (recursively) to input files
+ * @param path Path to file or directory
+ */
+void BatchInput::addFiles(const FilesystemPath &path)
+{
+	if(!path.isDirectory())
+	{
+		// Files which do not exist are reported in the output.
+		files.push_back(path.getPath());
+		return;
+	}
+
+	for(const auto *subpath : path)
+	{
+		addFiles(*subpath);
+	}
+}
+
+/**
+ * Initialize input files
+ * @param inputPaths Input files and directories
+ * @param fileList Path to file with list of input files ("-" means standard input)
+ * @return @c true if the list of input files could be opened, @c false otherwise
+ *
+ * If neither files nor list of files are given, paths are read from standard input.
+ */
+bool BatchInput::init(const std::vector<std::string> &inputPaths, const std::string &fileList)
+{
+	if(fileList == "-" || (fileList.empty() && inputPaths.empty()))
+	{
+		init(inputPaths, &std::cin);
+	}
+	else if(!fileList.empty())
+	{
+		listFile.open(fileList);
+		if(!listFile)
+		{
+			return false;
+		}
+		init(inputPaths, &listFile);
+	}
+	else
+	{
+		init(inputPaths, nullptr);
+	}
+
+	return true;
+}
+
+/**
+ * Initialize input files
+ * @param inputPaths Input files and directories
+ * @param fileList List of input files (one path per line) or @c nullptr if none
+ *
+ * Stream @a fileList must outlive this object.
+ */
+void BatchInput::init(const std::vector<std::string> &inputPaths, std::istream *fileList)
+{
+	for(const auto &item : inputPaths)
+	{
+		addFiles(FilesystemPath(item));
+	}
+	list = fileList;
+}
+
+/**
+ * Get next input file
+ * @param path Into this parameter is stored path to the next input file
+ * @return @c true if there is a next input file, @c false otherwise
+ *
+ * Method may be called from more threads at once.
+ */
+bool BatchInput::next(std::string &path)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if(nextFile < files.size())
+	{
+		path = files[nextFile++];
+		return true;
+	}
+
+	while(list && std::getline(*list, path))
+	{
+		if(!path.empty() && path.back() == '\r')
+		{
+			path.pop_back();
+		}
+		if(!path.empty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} // namespace fileinfo
@@ -0,0 +1,49 @@
+/**
+ * @file src/fileinfo/batch_input/batch_input.h
+ * @brief Definition of BatchInput class.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#ifndef FILEINFO_BATCH_INPUT_BATCH_INPUT_H
+#define FILEINFO_BATCH_INPUT_BATCH_INPUT_H
+
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "retdec/utils/filesystem_path.h"
+
+namespace fileinfo {
+
+/**
+ * Source of input files in batch mode
+ *
+ * Files given on the command line come first, then files from the list.
+ * The list is read only when its paths are needed, so paths may be sent
+ * to a running process through standard input.
+ */
+class BatchInput
+{
+	private:
+		std::mutex mutex;               ///< guards reading of input files
+		std::vector<std::string> files; ///< files from the command line
+		std::size_t nextFile = 0;       ///< index of the next file from the command line
+		std::ifstream listFile;         ///< opened file with list of input files
+		std::istream *list = nullptr;   ///< list of input files or @c nullptr if none
+
+		void addFiles(const retdec::utils::FilesystemPath &path);
+	public:
+		/// @name Initialization
+		/// @{
+		bool init(const std::vector<std::string> &inputPaths, const std::string &fileList);
+		void init(const std::vector<std::string> &inputPaths, std::istream *fileList);
+		/// @}
+
+		bool next(std::string &path);
+};
+
+} // namespace fileinfo
+
+#endif
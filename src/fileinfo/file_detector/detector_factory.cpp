@@ -4,13 +4,18 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include "retdec/ar-extractor/detection.h"
+#include "retdec/fileformat/utils/format_detection.h"
 #include "fileinfo/file_detector/coff_detector.h"
+#include "fileinfo/file_detector/detector_factory.h"
 #include "fileinfo/file_detector/elf_detector.h"
 #include "fileinfo/file_detector/intel_hex_detector.h"
 #include "fileinfo/file_detector/macho_detector.h"
 #include "fileinfo/file_detector/pe_detector.h"
 #include "fileinfo/file_detector/raw_data_detector.h"
+#include "fileinfo/pattern_detector/pattern_detector.h"
 
+using namespace retdec::ar_extractor;
 using namespace retdec::cpdetect;
 using namespace retdec::fileformat;
 
@@ -55,4 +60,81 @@ FileDetector* createFileDetector(
 	}
 }
 
+/**
+ * Detect format of input file and gather all information about it
+ * @param pathToInputFile Path to input file
+ * @param finfo Instance of class for storing information about input file
+ * @param searchPar Parameters for detection of used compiler or packer
+ * @param loadFlags Load flags
+ * @param config Config with previously known information or @c nullptr
+ * @param yaraPaths Paths to YARA rules used for detection of patterns
+ * @return Pointer to instance of used detector or @c nullptr if no detector
+ *    was created
+ *
+ * Result of detection is stored in @a finfo, including its status. Pointer
+ * to detector is dynamically allocated and must be released, but only after
+ * all information from @a finfo has been presented.
+ */
+FileDetector* detectFileInformation(
+		const std::string &pathToInputFile,
+		FileInformation &finfo,
+		retdec::cpdetect::DetectParams &searchPar,
+		retdec::fileformat::LoadFlags loadFlags,
+		retdec::config::Config *config,
+		const YaraPatternPaths &yaraPaths)
+{
+	const auto fileFormat = detectFileFormat(pathToInputFile, config && config->fileFormat.isRaw());
+	finfo.setPathToFile(pathToInputFile);
+	finfo.setFileFormatEnum(fileFormat);
+	if(fileFormat == Format::UNDETECTABLE)
+	{
+		finfo.setStatus(ReturnCode::FILE_NOT_EXIST);
+		return nullptr;
+	}
+
+	auto *fileDetector = createFileDetector(pathToInputFile, fileFormat, finfo, searchPar, loadFlags);
+	if(fileDetector)
+	{
+		if(!fileDetector->getFileParser()->isInValidState())
+		{
+			// Check if Mach-O is archive.
+			if(fileFormat == Format::MACHO
+					&& static_cast<MachODetector*>(fileDetector)->isMachoUniversalArchive())
+			{
+				finfo.setStatus(ReturnCode::MACHO_AR_DETECTED);
+				return fileDetector;
+			}
+
+			finfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+			return fileDetector;
+		}
+
+		if(config)
+		{
+			fileDetector->setConfigFile(*config);
+		}
+		fileDetector->getAllInformation();
+	}
+	else
+	{
+		if(isArchive(pathToInputFile))
+		{
+			finfo.setStatus(ReturnCode::ARCHIVE_DETECTED);
+		}
+		else
+		{
+			finfo.setStatus(ReturnCode::UNKNOWN_FORMAT);
+		}
+	}
+
+	PatternDetector patternDetector(fileDetector ? fileDetector->getFileParser() : nullptr, finfo);
+	for(const auto &category : yaraPaths)
+	{
+		patternDetector.addFilePaths(category.first, category.second);
+	}
+	patternDetector.analyze();
+
+	return fileDetector;
+}
+
 } // namespace fileinfo
@@ -7,11 +7,23 @@
 #ifndef FILEINFO_FILE_DETECTOR_DETECTOR_FACTORY_H
 #define FILEINFO_FILE_DETECTOR_DETECTOR_FACTORY_H
 
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "retdec/config/config.h"
 #include "fileinfo/file_detector/file_detector.h"
 
 namespace fileinfo {
 
+/**
+ * Paths to YARA rules for each pattern category (e.g. "crypto")
+ */
+using YaraPatternPaths = std::vector<std::pair<std::string, std::set<std::string>>>;
+
 FileDetector* createFileDetector(std::string pathToInputFile, retdec::fileformat::Format fileFormat, FileInformation &finfo, retdec::cpdetect::DetectParams &searchPar, retdec::fileformat::LoadFlags loadFlags);
+FileDetector* detectFileInformation(const std::string &pathToInputFile, FileInformation &finfo, retdec::cpdetect::DetectParams &searchPar, retdec::fileformat::LoadFlags loadFlags, retdec::config::Config *config, const YaraPatternPaths &yaraPaths);
 
 } // namespace fileinfo
 
@@ -22,11 +22,11 @@ namespace fileinfo {
  * @param file_ Name of configuration file
  */
 ConfigPresentation::ConfigPresentation(FileInformation &fileinfo_, std::string file_) :
-	FilePresentation(fileinfo_), configFile(file_), stateIsValid(true)
+	FilePresentation(fileinfo_), configFile(file_), outDoc(fileDoc), stateIsValid(true)
 {
 	try
 	{
-		outDoc.readJsonFile(configFile);
+		outDoc.readFile(configFile);
 	}
 	catch (const FileNotFoundException&)
 	{
@@ -39,12 +39,28 @@ ConfigPresentation::ConfigPresentation(FileInformation &fileinfo_, std::string f
 	}
 }
 
+/**
+ * Constructor
+ * @param fileinfo_ Information about file
+ * @param config_ Config into which information is presented
+ *
+ * Presented information is not written into any file.
+ */
+ConfigPresentation::ConfigPresentation(FileInformation &fileinfo_, retdec::config::Config &config_) :
+	FilePresentation(fileinfo_), outDoc(config_), stateIsValid(true)
+{
+
+}
+
 /**
  * Destructor
  */
 ConfigPresentation::~ConfigPresentation()
 {
-	outDoc.generateJsonFile(configFile);
+	if(!configFile.empty())
+	{
+		outDoc.generateFile(configFile);
+	}
 }
 
 /**
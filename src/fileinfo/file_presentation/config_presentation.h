@@ -16,7 +16,8 @@ class ConfigPresentation : public FilePresentation
 {
 	private:
 		std::string configFile;         ///< name of output file
-		retdec::config::Config outDoc; ///< representation of output file
+		retdec::config::Config fileDoc; ///< representation of output file
+		retdec::config::Config &outDoc; ///< config the information is presented into
 		bool stateIsValid;              ///< internal state of instance
 		std::string errorMessage;       ///< error message
 
@@ -28,6 +29,8 @@ class ConfigPresentation : public FilePresentation
 		/// @}
 	public:
 		ConfigPresentation(FileInformation &fileinfo_, std::string file_);
+		ConfigPresentation(FileInformation &fileinfo_, retdec::config::Config &config_);
+		ConfigPresentation(const ConfigPresentation&) = delete;
 		virtual ~ConfigPresentation() override;
 
 		virtual bool present() override;
@@ -833,9 +833,13 @@ void JsonPresentation::presentIterativeSubtitle(Json::Value &root, const Iterati
 	}
 }
 
-bool JsonPresentation::present()
+/**
+ * Present all information about the input file
+ * @param root Output document
+ */
+void JsonPresentation::presentRoot(Json::Value &root) const
 {
-	Value root, jEp;
+	Value jEp;
 	root["inputFile"] = fileinfo.getPathToFile();
 	presentErrors(root);
 	presentLoaderError(root);
@@ -898,10 +902,34 @@ bool JsonPresentation::present()
 	}
 
 	presentIterativeSubtitle(root, StringsJsonGetter(fileinfo));
+}
+
+bool JsonPresentation::present()
+{
+	Value root;
+	presentRoot(root);
 
 	StreamWriterBuilder builder;
 	std::cout << writeString(builder, root) << std::endl;
 	return true;
 }
 
+/**
+ * Get all information about the input file as a single line of JSON
+ * @return Compact JSON document without the terminating newline
+ *
+ * Unlike present(), nothing is printed, so the caller may serialize output
+ * of documents created in several threads. Documents of more files printed
+ * line by line form newline-delimited JSON.
+ */
+std::string JsonPresentation::getJsonLine() const
+{
+	Value root;
+	presentRoot(root);
+
+	StreamWriterBuilder builder;
+	builder["indentation"] = "";
+	return writeString(builder, root);
+}
+
 } // namespace fileinfo
@@ -40,12 +40,14 @@ class JsonPresentation : public FilePresentation
 		void presentFlags(Json::Value &root, const std::string &title, const std::string &flags, const std::vector<std::string> &desc) const;
 		void presentIterativeSubtitleStructure(Json::Value &root, const IterativeSubtitleGetter &getter, std::size_t structIndex) const;
 		void presentIterativeSubtitle(Json::Value &root, const IterativeSubtitleGetter &getter) const;
+		void presentRoot(Json::Value &root) const;
 		/// @}
 	public:
 		JsonPresentation(FileInformation &fileinfo_, bool verbose_);
 		virtual ~JsonPresentation() override;
 
 		virtual bool present() override;
+		std::string getJsonLine() const;
 };
 
 } // namespace fileinfo
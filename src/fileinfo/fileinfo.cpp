@@ -4,28 +4,34 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <thread>
 
 #include <llvm/Support/ErrorHandling.h>
+#include <yara.h>
 
 #include "retdec/utils/conversion.h"
+#include "retdec/utils/filesystem_path.h"
 #include "retdec/utils/memory.h"
 #include "retdec/utils/string.h"
-#include "retdec/ar-extractor/detection.h"
+#include "retdec/yara-cache/yara_cache.h"
 #include "retdec/cpdetect/errors.h"
 #include "retdec/cpdetect/settings.h"
-#include "retdec/fileformat/utils/format_detection.h"
 #include "retdec/fileformat/utils/other.h"
+#include "fileinfo/batch_input/batch_input.h"
 #include "fileinfo/file_detector/detector_factory.h"
-#include "fileinfo/file_detector/macho_detector.h"
 #include "fileinfo/file_presentation/config_presentation.h"
 #include "fileinfo/file_presentation/json_presentation.h"
 #include "fileinfo/file_presentation/plain_presentation.h"
 #include "fileinfo/pattern_detector/pattern_detector.h"
 
 using namespace retdec::utils;
-using namespace retdec::ar_extractor;
 using namespace retdec::cpdetect;
 using namespace retdec::fileformat;
 using namespace fileinfo;
@@ -39,6 +45,10 @@ namespace
 struct ProgParams
 {
 	std::string filePath;                   ///< name of input file
+	std::vector<std::string> inputPaths;    ///< input files and directories in batch mode
+	bool batch;                             ///< analyze more files in one process
+	std::string fileList;                   ///< file with list of input files in batch mode
+	std::size_t jobs;                       ///< number of files analyzed in parallel (0 means auto)
 	SearchType searchMode;                  ///< type of search
 	bool internalDatabase;                  ///< use of internal signature database
 	bool externalDatabase;                  ///< use of external signature database
@@ -55,7 +65,9 @@ struct ProgParams
 	std::size_t epBytesCount;               ///< number of bytes to load from entry point
 	LoadFlags loadFlags;                    ///< load flags for `fileformat`
 
-	ProgParams() : searchMode(SearchType::EXACT_MATCH),
+	ProgParams() : batch(false),
+					jobs(0),
+					searchMode(SearchType::EXACT_MATCH),
 					internalDatabase(true),
 					externalDatabase(false),
 					plainText(true),
@@ -102,6 +114,173 @@ void fatalErrorHandler(void *user_data, const std::string& /*reason*/, bool /*ge
 	exit(static_cast<int>(ReturnCode::FORMAT_PARSER_PROBLEM));
 }
 
+/**
+ * Guards standard output in batch mode
+ */
+std::mutex outputMutex;
+
+/**
+ * Information about file analyzed by the current thread in batch mode
+ */
+thread_local FileInformation *batchFileinfo = nullptr;
+
+/**
+ * Print one line of newline-delimited JSON in batch mode
+ * @param line Compact JSON document
+ *
+ * Output is flushed after every line, so results of a long-running batch
+ * may be consumed while it is still running.
+ */
+void printJsonLine(const std::string &line)
+{
+	std::lock_guard<std::mutex> lock(outputMutex);
+	std::cout << line << std::endl;
+}
+
+/**
+ * LLVM fatal error handler in batch mode
+ * @param user_data Program parameters
+ * @param reason Unused
+ * @param gen_crash_diag Unused
+ *
+ * LLVM can not recover from a fatal error, so the whole batch ends. Results
+ * of all files analyzed so far have already been printed. Other workers are
+ * still running, so the output stays locked and the process ends without
+ * destruction of objects they may use.
+ */
+void batchFatalErrorHandler(void *user_data, const std::string& /*reason*/, bool /*gen_crash_diag*/)
+{
+	ProgParams* params = static_cast<ProgParams*>(user_data);
+
+	outputMutex.lock();
+	if(batchFileinfo)
+	{
+		batchFileinfo->setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+		std::cout << JsonPresentation(*batchFileinfo, params->verbose).getJsonLine() << "\n";
+	}
+	std::cout.flush();
+
+	std::_Exit(static_cast<int>(ReturnCode::FORMAT_PARSER_PROBLEM));
+}
+
+/**
+ * Analyze one file in batch mode and print the result
+ * @param path Path to input file
+ * @param params Program parameters
+ * @param yaraPaths Files with YARA rules used for detection of patterns
+ * @return Status of analysis of the file
+ */
+ReturnCode analyzeInBatch(const std::string &path, const ProgParams &params, const YaraPatternPaths &yaraPaths)
+{
+	DetectParams searchPar(params.searchMode, params.internalDatabase, params.externalDatabase, params.epBytesCount);
+	FileInformation fileinfo;
+	batchFileinfo = &fileinfo;
+
+	std::unique_ptr<FileDetector> fileDetector;
+	try
+	{
+		fileDetector.reset(detectFileInformation(
+				path,
+				fileinfo,
+				searchPar,
+				params.loadFlags,
+				nullptr,
+				yaraPaths));
+	}
+	catch(const std::exception&)
+	{
+		// One broken file must not end analysis of the other files.
+		fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+	}
+
+	printJsonLine(JsonPresentation(fileinfo, params.verbose).getJsonLine());
+	batchFileinfo = nullptr;
+	return fileinfo.getStatus();
+}
+
+/**
+ * Analyze all input files in batch mode
+ * @param params Program parameters
+ * @return Program status (status of the first file whose analysis failed, if any)
+ *
+ * Files are analyzed concurrently and the result of each file is printed as
+ * a single line of JSON as soon as it is available, so lines are not in the
+ * order of input files. YARA rules are listed and compiled only once, before
+ * any file is analyzed, and the YARA library stays initialized for the whole
+ * batch.
+ */
+int runBatch(ProgParams &params)
+{
+	BatchInput input;
+	if(!input.init(params.inputPaths, params.fileList))
+	{
+		std::cerr << "Error: could not open list of input files " << params.fileList << "\n";
+		return static_cast<int>(ReturnCode::FILE_NOT_EXIST);
+	}
+
+	const YaraPatternPaths yaraPaths = {
+		{"malware", PatternDetector::getRuleFiles(params.yaraMalwarePaths)},
+		{"crypto", PatternDetector::getRuleFiles(params.yaraCryptoPaths)},
+		{"other", PatternDetector::getRuleFiles(params.yaraOtherPaths)}
+	};
+	for(const auto &category : yaraPaths)
+	{
+		for(const auto &ruleFile : category.second)
+		{
+			retdec::yara_cache::getCompiledRuleFile(ruleFile);
+		}
+	}
+
+	// Files are already analyzed in parallel, so analysis of a single file
+	// must not start more threads.
+	params.loadFlags = static_cast<LoadFlags>(params.loadFlags
+			| LoadFlags::SINGLE_THREADED);
+
+	bool yaraInitialized;
+	{
+		std::lock_guard<std::mutex> lock(retdec::yara_cache::getLibraryMutex());
+		yaraInitialized = yr_initialize() == ERROR_SUCCESS;
+	}
+	llvm::install_fatal_error_handler(batchFatalErrorHandler, &params);
+
+	std::atomic<int> result(static_cast<int>(ReturnCode::OK));
+	auto analyze = [&]()
+	{
+		std::string path;
+		while(input.next(path))
+		{
+			const auto res = analyzeInBatch(path, params, yaraPaths);
+			if(isFatalError(res))
+			{
+				auto ok = static_cast<int>(ReturnCode::OK);
+				result.compare_exchange_strong(ok, static_cast<int>(res));
+			}
+		}
+	};
+
+	const std::size_t threadCount = params.jobs
+			? params.jobs
+			: std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<std::thread> threads;
+	for(std::size_t i = 1; i < threadCount; ++i)
+	{
+		threads.emplace_back(analyze);
+	}
+	analyze();
+	for(auto &t : threads)
+	{
+		t.join();
+	}
+
+	if(yaraInitialized)
+	{
+		std::lock_guard<std::mutex> lock(retdec::yara_cache::getLibraryMutex());
+		yr_finalize();
+	}
+
+	return result;
+}
+
 /**
  * Print help text on standard output
  */
@@ -111,7 +290,8 @@ void printHelp()
 				<< "For compiler detection, program looks in the input file for YARA patterns.\n"
 				<< "According to them, it determines compiler or packer used for file creation.\n"
 				<< "Supported file formats are: " + joinStrings(getSupportedFileFormats()) + ".\n\n"
-				<< "Usage: fileinfo [options] file\n\n"
+				<< "Usage: fileinfo [options] file\n"
+				<< "       fileinfo --batch [options] [fileOrDir ...]\n\n"
 				<< "Options list:\n"
 				<< "    --help, -h            Display this help.\n"
 				<< "\n"
@@ -157,6 +337,8 @@ void printHelp()
 				<< "                          Either all hashes or only file/verbose hashes.\n"
 				<< "                          All assumed if no argument specified.\n"
 				<< "    --ep-bytes=N          Number of bytes to load from entry point. (Default: " << EP_BYTES_SIZE << ")\n"
+				<< "    --mmap                Map the input file into memory instead of reading\n"
+				<< "                          it into an internal buffer.\n"
 				<< "\n"
 				<< "Other options for specifying output:\n"
 				<< "    --verbose, -v         Print more information about input file.\n"
@@ -172,7 +354,19 @@ void printHelp()
 				<< "    --max-memory=N\n"
 				<< "                          Limit maximal memory to N bytes (0 means no limit).\n"
 				<< "    --max-memory-half-ram\n"
-				<< "                          Limit maximal memory to half of system RAM.\n";
+				<< "                          Limit maximal memory to half of system RAM.\n"
+				<< "\n"
+				<< "Options for analysis of more files in one process:\n"
+				<< "  Result of each file is printed in JSON format on a single line as soon as\n"
+				<< "  the file is analyzed. Option \"--config\" can not be used. Exit status is\n"
+				<< "  the error of the first file whose analysis failed, if any.\n"
+				<< "    --batch               Analyze all given files and all files in given\n"
+				<< "                          directories (recursively). If no file is given,\n"
+				<< "                          paths are read from standard input, one per line.\n"
+				<< "    --file-list=file      Analyze files listed in the given file, one per line\n"
+				<< "                          (\"-\" means standard input). Implies \"--batch\".\n"
+				<< "    --jobs=N              Number of files analyzed in parallel\n"
+				<< "                          (default: number of processors).\n";
 }
 
 std::string getParamOrDie(std::vector<std::string> &argv, std::size_t &i)
@@ -211,7 +405,8 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 	std::vector<std::string> argv;
 
 	std::set<std::string> withArgs = {"malware", "m", "crypto", "C", "other",
-			"o", "config", "c", "no-hashes", "max-memory", "ep-bytes"};
+			"o", "config", "c", "no-hashes", "max-memory", "ep-bytes",
+			"file-list", "jobs"};
 	for (int i = 1; i < argc; ++i)
 	{
 		std::string a = _argv[i];
@@ -286,6 +481,11 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 			params.loadFlags = static_cast<LoadFlags>(params.loadFlags
 					| LoadFlags::DETECT_STRINGS);
 		}
+		else if (c == "--mmap")
+		{
+			params.loadFlags = static_cast<LoadFlags>(params.loadFlags
+					| LoadFlags::MEMORY_MAP_INPUT);
+		}
 		else if (c == "-m" || c == "--malware")
 		{
 			params.yaraMalwarePaths.insert(getParamOrDie(argv, i));
@@ -353,20 +553,38 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 			if (!strToNum(epBytesCountString, params.epBytesCount))
 				return false;
 		}
-		else if (params.filePath.empty())
+		else if (c == "--batch")
 		{
-			params.filePath = argv[i];
+			params.batch = true;
+		}
+		else if (c == "--file-list")
+		{
+			params.fileList = getParamOrDie(argv, i);
+			params.batch = true;
+		}
+		else if (c == "--jobs")
+		{
+			auto jobsString = getParamOrDie(argv, i);
+			if (!strToNum(jobsString, params.jobs))
+				return false;
 		}
 		else
 		{
-			return false;
+			params.inputPaths.push_back(argv[i]);
 		}
 	}
 
-	if(params.filePath.empty())
+	if(params.batch)
+	{
+		params.plainText = false;
+		return !params.generateConfigFile;
+	}
+
+	if(params.inputPaths.size() != 1)
 	{
 		return false;
 	}
+	params.filePath = params.inputPaths.front();
 
 	return true;
 }
@@ -409,13 +627,18 @@ int main(int argc, char* argv[])
 
 	limitMaximalMemoryIfRequested(params);
 
+	if(params.batch)
+	{
+		return runBatch(params);
+	}
+
 	bool useConfig = true;
 	retdec::config::Config config;
 	if(params.generateConfigFile && !params.configFile.empty())
 	{
 		try
 		{
-			config.readJsonFile(params.configFile);
+			config.readFile(params.configFile);
 		}
 		catch (const retdec::config::FileNotFoundException&)
 		{
@@ -428,66 +651,21 @@ int main(int argc, char* argv[])
 	}
 
 	DetectParams searchPar(params.searchMode, params.internalDatabase, params.externalDatabase, params.epBytesCount);
-	const auto fileFormat = detectFileFormat(params.filePath, useConfig && config.fileFormat.isRaw());
 	FileInformation fileinfo;
-	FileDetector *fileDetector = nullptr;
-	fileinfo.setPathToFile(params.filePath);
-	fileinfo.setFileFormatEnum(fileFormat);
 	ErrorHandlerInfo hInfo { &params, &fileinfo };
 	llvm::install_fatal_error_handler(fatalErrorHandler, &hInfo);
-	switch(fileFormat)
-	{
-		case Format::UNDETECTABLE:
-		{
-			fileinfo.setStatus(ReturnCode::FILE_NOT_EXIST);
-			break;
-		}
-		default:
-		{
-			fileDetector = createFileDetector(params.filePath, fileFormat, fileinfo, searchPar, params.loadFlags);
-			if(fileDetector)
-			{
-				if(!fileDetector->getFileParser()->isInValidState())
-				{
-					// Check if Mach-O is archive.
-					if (fileFormat == Format::MACHO)
-					{
-						auto machoDetecor = static_cast<MachODetector*>(fileDetector);
-						if (machoDetecor->isMachoUniversalArchive())
-						{
-							fileinfo.setStatus(ReturnCode::MACHO_AR_DETECTED);
-							break;
-						}
-					}
-
-					fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
-					break;
-				}
-
-				if(useConfig)
-				{
-					fileDetector->setConfigFile(config);
-				}
-				fileDetector->getAllInformation();
-			}
-			else
-			{
-				if(isArchive(params.filePath))
-				{
-					fileinfo.setStatus(ReturnCode::ARCHIVE_DETECTED);
-				}
-				else
-				{
-					fileinfo.setStatus(ReturnCode::UNKNOWN_FORMAT);
-				}
-			}
-			PatternDetector patternDetector(fileDetector ? fileDetector->getFileParser() : nullptr, fileinfo);
-			patternDetector.addFilePaths("malware", params.yaraMalwarePaths);
-			patternDetector.addFilePaths("crypto", params.yaraCryptoPaths);
-			patternDetector.addFilePaths("other", params.yaraOtherPaths);
-			patternDetector.analyze();
-		}
-	}
+	const YaraPatternPaths yaraPaths = {
+		{"malware", params.yaraMalwarePaths},
+		{"crypto", params.yaraCryptoPaths},
+		{"other", params.yaraOtherPaths}
+	};
+	FileDetector *fileDetector = detectFileInformation(
+			params.filePath,
+			fileinfo,
+			searchPar,
+			params.loadFlags,
+			useConfig ? &config : nullptr,
+			yaraPaths);
 
 	// print results on standard output
 	if(params.plainText)
@@ -503,10 +681,10 @@ int main(int argc, char* argv[])
 	auto res = fileinfo.getStatus();
 	if(params.generateConfigFile)
 	{
-		auto config = ConfigPresentation(fileinfo, params.configFile);
-		if(!config.present())
+		ConfigPresentation configPresentation(fileinfo, params.configFile);
+		if(!configPresentation.present())
 		{
-			std::cerr << "Error: loading of config failed: " << config.getErrorMessage() << "\n";
+			std::cerr << "Error: loading of config failed: " << configPresentation.getErrorMessage() << "\n";
 			res = ReturnCode::FILE_PROBLEM;
 		}
 	}
@@ -9,6 +9,7 @@
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/filesystem_path.h"
 #include "retdec/utils/string.h"
+#include "retdec/yara-cache/yara_cache.h"
 #include "fileinfo/pattern_detector/pattern_detector.h"
 #include "yaracpp/yara_detector/yara_detector.h"
 
@@ -316,12 +317,29 @@ void PatternDetector::addFilePaths(const std::string &category, const std::set<s
 		actCategory = &categories[categories.size() - 1];
 	}
 
+	const auto ruleFiles = getRuleFiles(paths);
+	actCategory->second.insert(ruleFiles.begin(), ruleFiles.end());
+}
+
+/**
+ * Get files with YARA patterns
+ * @param paths Set of paths to files and/or directories with YARA pattern files.
+ *    From directory is taken every file with .yar or .yara extension.
+ * @return Set of paths to files with YARA patterns
+ *
+ * Result may be passed to addFilePaths() instead of the original paths, so
+ * directories are listed only once when many input files are analyzed.
+ */
+std::set<std::string> PatternDetector::getRuleFiles(const std::set<std::string> &paths)
+{
+	std::set<std::string> result;
+
 	for(const auto &item : paths)
 	{
 		FilesystemPath actDir(item);
 		if(actDir.isFile())
 		{
-			actCategory->second.insert(item);
+			result.insert(item);
 			continue;
 		}
 
@@ -330,10 +348,12 @@ void PatternDetector::addFilePaths(const std::string &category, const std::set<s
 			const auto path = file->getPath();
 			if(file->isFile() && (endsWith(path, ".yar") || endsWith(path, ".yara")))
 			{
-				actCategory->second.insert(path);
+				result.insert(path);
 			}
 		}
 	}
+
+	return result;
 }
 
 /**
@@ -343,28 +363,28 @@ void PatternDetector::analyze()
 {
 	for(const auto &category : categories)
 	{
-		YaraDetector yara;
-
+		retdec::yara_cache::RuleFiles ruleFiles;
 		for(const auto &item : category.second)
 		{
-			yara.addRuleFile(item);
+			ruleFiles.emplace_back(item, std::string());
 		}
 
-		yara.analyze(fileinfo.getPathToFile());
+		std::vector<const YaraRule*> detected;
+		retdec::yara_cache::scanFile(ruleFiles, fileinfo.getPathToFile(), detected);
 
-		for(const auto &rule : yara.getDetectedRules())
+		for(const auto *rule : detected)
 		{
 			if(category.first == "crypto")
 			{
-				saveCryptoRule(rule);
+				saveCryptoRule(*rule);
 			}
 			else if(category.first == "malware")
 			{
-				saveMalwareRule(rule);
+				saveMalwareRule(*rule);
 			}
 			else
 			{
-				saveOtherRule(rule);
+				saveOtherRule(*rule);
 			}
 		}
 	}
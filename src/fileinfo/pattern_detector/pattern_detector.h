@@ -52,6 +52,8 @@ class PatternDetector
 		void addFilePaths(const std::string &category, const std::set<std::string> &paths);
 		void analyze();
 		/// @}
+
+		static std::set<std::string> getRuleFiles(const std::set<std::string> &paths);
 };
 
 } // namespace fileinfo
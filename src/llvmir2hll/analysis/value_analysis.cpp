@@ -650,6 +650,31 @@ void ValueAnalysis::removeFromCache(ShPtr<Value> value, bool recursive) {
 	}
 }
 
+/**
+* @brief Removes all values in the given function from the cache.
+*
+* This includes the function itself, its parameters, and all statements and
+* expressions in its body. Cached results for values in other functions are
+* kept, so after changing a function, it is enough to call this function
+* instead of clearCache().
+*
+* @par Preconditions
+*  - @a func is non-null
+*/
+void ValueAnalysis::removeFuncFromCache(ShPtr<Function> func) {
+	PRECONDITION_NON_NULL(func);
+
+	if (!isCachingEnabled()) {
+		return;
+	}
+
+	// Visit the whole body, including nested statements and successors.
+	restart(true, true);
+	removingFromCache = true;
+	func->accept(this);
+	removingFromCache = false;
+}
+
 /**
 * @brief Re-initializes the underlying alias analysis.
 *
@@ -660,6 +685,13 @@ void ValueAnalysis::initAliasAnalysis(ShPtr<Module> module) {
 	aliasAnalysis->init(module);
 }
 
+/**
+* @brief Returns the underlying alias analysis.
+*/
+ShPtr<AliasAnalysis> ValueAnalysis::getAliasAnalysis() const {
+	return aliasAnalysis;
+}
+
 /**
 * @brief Returns the set of variables to which @a var may point to.
 *
@@ -119,6 +119,8 @@ JSONConfig::~JSONConfig() = default;
 /**
 * @brief Parses and returns a config from the given file.
 *
+* The file can be either in JSON or in the binary config format.
+*
 * @throw JSONConfigFileNotFoundError when the file does not exist.
 * @throw JSONConfigParsingError when there is a parsing error.
 */
@@ -127,7 +129,7 @@ UPtr<JSONConfig> JSONConfig::fromFile(const std::string &path) {
 	auto config = UPtr<JSONConfig>(new JSONConfig());
 	config->impl->path = path;
 	try {
-		config->impl->config.readJsonFile(path);
+		config->impl->config.readFile(path);
 	} catch (const retdec::config::FileNotFoundException &ex) {
 		throw JSONConfigFileNotFoundError(ex.what());
 	} catch (const retdec::config::Exception &ex) {
@@ -152,6 +154,19 @@ UPtr<JSONConfig> JSONConfig::fromString(const std::string &str) {
 	return config;
 }
 
+/**
+* @brief Returns a config with a copy of the given underlying config.
+*
+* This allows to use a config that is already loaded in memory (e.g. passed
+* from bin2llvmir in the same process) without a JSON round-trip.
+*/
+UPtr<JSONConfig> JSONConfig::fromConfig(const retdec::config::Config &config) {
+	// We cannot use std::make_unique() because JSONConfig() is private.
+	auto result = UPtr<JSONConfig>(new JSONConfig());
+	result->impl->config = config;
+	return result;
+}
+
 /**
 * @brief Returns an empty config.
 */
@@ -164,6 +179,13 @@ void JSONConfig::saveTo(const std::string &path) {
 	impl->config.generateJsonFile(path);
 }
 
+/**
+* @brief Returns the underlying config.
+*/
+const retdec::config::Config &JSONConfig::getConfig() const {
+	return impl->config;
+}
+
 void JSONConfig::dump() {
 	// The string returned from generateJsonString() is already ended with a
 	// new line, so do not emit an additional '\n'.
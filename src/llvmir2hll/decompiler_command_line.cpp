@@ -0,0 +1,227 @@
+/**
+* @file src/llvmir2hll/decompiler_command_line.cpp
+* @brief Command-line options of the conversion into the target high-level
+*        language.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/llvmir2hll/decompiler_command_line.h"
+
+using namespace llvm;
+
+namespace retdec {
+namespace llvmir2hll {
+
+namespace {
+
+/**
+* @brief Returns the default options.
+*
+* Defaults of the command-line options are taken from them, so they are the
+* same as when DecompilerOptions are created directly.
+*/
+const DecompilerOptions &getDefaults() {
+	static const DecompilerOptions defaults;
+	return defaults;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Registers the options.
+*
+* @param[in] prefix Prefix of the names of all the options (may be empty).
+* @param[in] category Category of the options in the help.
+* @param[in] targetHllRequired If @c true, the target HLL has to be given on
+*                              the command line. Otherwise, it defaults to the
+*                              one from DecompilerOptions.
+*/
+DecompilerCommandLine::DecompilerCommandLine(const std::string &prefix,
+		cl::OptionCategory &category, bool targetHllRequired):
+	prefix(prefix),
+	names(),
+	targetHll(name("target-hll"),
+		cl::desc("Name of the target HLL (set to 'help' to list all the supported HLLs)."),
+		cl::init(getDefaults().targetHll),
+		cl::cat(category)),
+	// We cannot use just -debug because it has been already registered :(.
+	debug(name("enable-debug"),
+		cl::desc("Enables the emission of debugging messages, like information about the current phase."),
+		cl::init(getDefaults().debug),
+		cl::cat(category)),
+	semantics(name("semantics"),
+		cl::desc("The used semantics in the form 'sem1,sem2,...'."
+			" When not given, the semantics is created based on the data in the input LLVM IR."
+			" If you want to use no semantics, set this to 'none'."),
+		cl::init(getDefaults().semantics),
+		cl::cat(category)),
+	emitDebugComments(name("emit-debug-comments"),
+		cl::desc("Emits debugging comments in the generated code."),
+		cl::init(getDefaults().emitDebugComments),
+		cl::cat(category)),
+	enabledOpts(name("enabled-opts"),
+		cl::desc("A comma separated list of optimizations to be enabled, i.e. only they will run."),
+		cl::init(getDefaults().enabledOpts),
+		cl::cat(category)),
+	disabledOpts(name("disabled-opts"),
+		cl::desc("A comma separated list of optimizations to be disabled, i.e. they will not run."),
+		cl::init(getDefaults().disabledOpts),
+		cl::cat(category)),
+	noOpts(name("no-opts"),
+		cl::desc("Disables all optimizations."),
+		cl::init(getDefaults().noOpts),
+		cl::cat(category)),
+	aggressiveOpts(name("aggressive-opts"),
+		cl::desc("Enables aggressive optimizations."),
+		cl::init(getDefaults().aggressiveOpts),
+		cl::cat(category)),
+	noVarRenaming(name("no-var-renaming"),
+		cl::desc("Disables renaming of variables."),
+		cl::init(getDefaults().noVarRenaming),
+		cl::cat(category)),
+	noSymbolicNames(name("no-symbolic-names"),
+		cl::desc("Disables conversion of constants into symbolic names."),
+		cl::init(getDefaults().noSymbolicNames),
+		cl::cat(category)),
+	keepAllBrackets(name("keep-all-brackets"),
+		cl::desc("All brackets in the generated code will be kept."),
+		cl::init(getDefaults().keepAllBrackets),
+		cl::cat(category)),
+	keepLibraryFunctions(name("keep-library-funcs"),
+		cl::desc("Functions from standard libraries will be kept, not turned into declarations."),
+		cl::init(getDefaults().keepLibraryFunctions),
+		cl::cat(category)),
+	noTimeVaryingInfo(name("no-time-varying-info"),
+		cl::desc("Do not emit time-varying information, like dates."),
+		cl::init(getDefaults().noTimeVaryingInfo),
+		cl::cat(category)),
+	noCompoundOperators(name("no-compound-operators"),
+		cl::desc("Do not emit compound operators (like +=) instead of assignments."),
+		cl::init(getDefaults().noCompoundOperators),
+		cl::cat(category)),
+	validateModule(name("validate-module"),
+		cl::desc("Validates the resulting module before generating the target code."),
+		cl::init(getDefaults().validateModule),
+		cl::cat(category)),
+	findPatterns(name("find-patterns"),
+		cl::desc("If set, runs the selected comma-separated pattern finders "
+			"(set to 'all' to run all of them)."),
+		cl::init(getDefaults().findPatterns),
+		cl::cat(category)),
+	aliasAnalysis(name("alias-analysis"),
+		cl::desc("Name of the used alias analysis "
+			"(the default is 'simple'; set to 'help' to list all the supported analyses)."),
+		cl::init(getDefaults().aliasAnalysis),
+		cl::cat(category)),
+	varNameGen(name("var-name-gen"),
+		cl::desc("Name of the used generator of variable names "
+			"(the default is 'fruit'; set to 'help' to list all the supported generators)."),
+		cl::init(getDefaults().varNameGen),
+		cl::cat(category)),
+	varNameGenPrefix(name("var-name-gen-prefix"),
+		cl::desc("Prefix for all variable names returned by the used generator of variable names "
+			"(the default is '')."),
+		cl::init(getDefaults().varNameGenPrefix),
+		cl::cat(category)),
+	varRenamer(name("var-renamer"),
+		cl::desc("Name of the used renamer of variable names "
+			"(the default is 'readable'; set to 'help' to list all the supported renamers)."),
+		cl::init(getDefaults().varRenamer),
+		cl::cat(category)),
+	emitCFGs(name("emit-cfgs"),
+		cl::desc("Enables the emission of control-flow graphs (CFGs) for each "
+			"function (creates a separate file for each function in the resulting module)."),
+		cl::init(getDefaults().emitCFGs),
+		cl::cat(category)),
+	cfgWriter(name("cfg-writer"),
+		cl::desc("Name of the used CFG writer (set to 'help' to list all "
+			"the supported writers, the default is 'dot')."),
+		cl::init(getDefaults().cfgWriter),
+		cl::cat(category)),
+	emitCG(name("emit-cg"),
+		cl::desc("Emits a call graph (CG) for the decompiled module."),
+		cl::init(getDefaults().emitCG),
+		cl::cat(category)),
+	cgWriter(name("cg-writer"),
+		cl::desc("Name of the used CG writer (set to 'help' to list all "
+			"the supported writers, the default is 'dot')."),
+		cl::init(getDefaults().cgWriter),
+		cl::cat(category)),
+	callInfoObtainer(name("call-info-obtainer"),
+		cl::desc("Name of the used obtainer of information about function calls (set to "
+			"'help' to list all the supported obtainers, the default is 'optim')."),
+		cl::init(getDefaults().callInfoObtainer),
+		cl::cat(category)),
+	arithmExprEvaluator(name("arithm-expr-evaluator"),
+		cl::desc("Name of the used evaluator of arithmetical expressions (set to "
+			"'help' to list all the supported evaluators, the default is 'c')."),
+		cl::init(getDefaults().arithmExprEvaluator),
+		cl::cat(category)),
+	forcedModuleName(name("force-module-name"),
+		cl::desc("If nonempty, overwrites the module name that was detected/generated by the front-end. "
+			"This includes the identifier of the input LLVM IR module as well as module names in debug information."),
+		cl::init(getDefaults().forcedModuleName),
+		cl::cat(category)),
+	strictFPUSemantics(name("strict-fpu-semantics"),
+		cl::desc("Forces strict FPU semantics to be used. "
+			"This option may result into more correct code, although slightly less readable."),
+		cl::init(getDefaults().strictFPUSemantics),
+		cl::cat(category)),
+	optimizerThreads(name("optimizer-threads"),
+		cl::desc("Number of threads optimizing functions in parallel (0 = number of CPUs)."),
+		cl::init(getDefaults().optimizerThreads),
+		cl::cat(category)) {
+	if (targetHllRequired) {
+		targetHll.setNumOccurrencesFlag(cl::Required);
+	}
+}
+
+/**
+* @brief Returns the decompilation options given on the command line.
+*
+* The path to the config and the output file are left empty.
+*/
+DecompilerOptions DecompilerCommandLine::getOptions() const {
+	DecompilerOptions options;
+	options.targetHll = targetHll;
+	options.debug = debug;
+	options.semantics = semantics;
+	options.emitDebugComments = emitDebugComments;
+	options.enabledOpts = enabledOpts;
+	options.disabledOpts = disabledOpts;
+	options.noOpts = noOpts;
+	options.aggressiveOpts = aggressiveOpts;
+	options.noVarRenaming = noVarRenaming;
+	options.noSymbolicNames = noSymbolicNames;
+	options.keepAllBrackets = keepAllBrackets;
+	options.keepLibraryFunctions = keepLibraryFunctions;
+	options.noTimeVaryingInfo = noTimeVaryingInfo;
+	options.noCompoundOperators = noCompoundOperators;
+	options.validateModule = validateModule;
+	options.findPatterns = findPatterns;
+	options.aliasAnalysis = aliasAnalysis;
+	options.varNameGen = varNameGen;
+	options.varNameGenPrefix = varNameGenPrefix;
+	options.varRenamer = varRenamer;
+	options.emitCFGs = emitCFGs;
+	options.cfgWriter = cfgWriter;
+	options.emitCG = emitCG;
+	options.cgWriter = cgWriter;
+	options.callInfoObtainer = callInfoObtainer;
+	options.arithmExprEvaluator = arithmExprEvaluator;
+	options.forcedModuleName = forcedModuleName;
+	options.strictFPUSemantics = strictFPUSemantics;
+	options.optimizerThreads = optimizerThreads;
+	return options;
+}
+
+/**
+* @brief Returns the name of @a option with the prefix.
+*/
+StringRef DecompilerCommandLine::name(const std::string &option) {
+	names.push_back(prefix + option);
+	return names.back();
+}
+
+} // namespace llvmir2hll
+} // namespace retdec
@@ -83,6 +83,9 @@ bool IntType::isBool() const {
 ShPtr<IntType> IntType::create(unsigned size, bool isSigned) {
 	PRECONDITION(size > 0, "invalid size " << size);
 
+	// Functions may be optimized in parallel, so guard the maps.
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
+
 	// There are two maps, one for signed integers and one for unsigned integers.
 	if (isSigned) {
 		// To reduce the amount of created types, we use a set of already created
@@ -113,6 +116,7 @@ void IntType::accept(Visitor *v) {
 // Static variables and constants definitions.
 std::map<unsigned, ShPtr<IntType>> IntType::createdSignedTypes;
 std::map<unsigned, ShPtr<IntType>> IntType::createdUnsignedTypes;
+std::mutex IntType::createdTypesMutex;
 
 } // namespace llvmir2hll
 } // namespace retdec
@@ -45,6 +45,43 @@ void FuncOptimizer::doOptimization() {
 	}
 }
 
+/**
+* @brief Does the module-wide work that precedes optimizations of single
+*        functions by optimizeFunc().
+*
+* This function calls doInitialization(). When functions are optimized in
+* parallel, it is called only once, on an instance that does not optimize any
+* function, so doInitialization() may only work with module-wide data and may
+* not prepare a state that runOnFunction() depends on.
+*/
+void FuncOptimizer::initFuncsOptimization() {
+	doInitialization();
+}
+
+/**
+* @brief Optimizes only the given function.
+*
+* @param[in,out] func Function to be optimized.
+*
+* Unlike optimize(), this function calls only runOnFunction(). It is used to
+* optimize functions in parallel, with one instance of the optimizer per
+* thread, so the optimizer may not depend on doOptimization() being run.
+*/
+void FuncOptimizer::optimizeFunc(ShPtr<Function> func) {
+	runOnFunction(func);
+}
+
+/**
+* @brief Does the module-wide work that follows optimizations of single
+*        functions by optimizeFunc().
+*
+* This function calls doFinalization(). See initFuncsOptimization() for the
+* restrictions that apply when functions are optimized in parallel.
+*/
+void FuncOptimizer::finishFuncsOptimization() {
+	doFinalization();
+}
+
 /**
 * @brief Performs all optimizations on the given function.
 *
@@ -4,11 +4,21 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 #include "retdec/llvmir2hll/analysis/value_analysis.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluator.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluator_factory.h"
 #include "retdec/llvmir2hll/graphs/cg/cg_builder.h"
 #include "retdec/llvmir2hll/hll/bir_writer.h"
 #include "retdec/llvmir2hll/hll/hll_writer.h"
+#include "retdec/llvmir2hll/ir/module.h"
 #include "retdec/llvmir2hll/obtainer/call_info_obtainer.h"
+#include "retdec/llvmir2hll/optimizer/func_optimizer.h"
 #include "retdec/llvmir2hll/optimizer/optimizer_manager.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/aggressive_deref_optimizer.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/aggressive_global_to_local_optimizer.h"
@@ -47,6 +57,7 @@
 #include "retdec/llvmir2hll/optimizer/optimizers/while_true_to_while_cond_optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
 #include "retdec/utils/container.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/system.h"
 
@@ -54,6 +65,8 @@ using namespace retdec::llvm_support;
 using namespace std::string_literals;
 
 using retdec::utils::hasItem;
+using retdec::utils::joinStrings;
+using retdec::utils::Profiler;
 using retdec::utils::sleep;
 using retdec::utils::startsWith;
 
@@ -87,6 +100,30 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 	return result;
 }
 
+/**
+* @brief Returns an argument of a function optimization run in a thread with
+*        the given @a analyses.
+*
+* Analyses with an internal state are replaced with the ones owned by the
+* thread. Other arguments are used as they are.
+*/
+template<typename Analyses, typename T>
+T argForThread(const T &arg, const Analyses &) {
+	return arg;
+}
+
+template<typename Analyses>
+ShPtr<ValueAnalysis> argForThread(const ShPtr<ValueAnalysis> &,
+		const Analyses &analyses) {
+	return analyses.va;
+}
+
+template<typename Analyses>
+ShPtr<ArithmExprEvaluator> argForThread(const ShPtr<ArithmExprEvaluator> &,
+		const Analyses &analyses) {
+	return analyses.arithmExprEvaluator;
+}
+
 } // anonymous namespace
 
 /**
@@ -102,6 +139,7 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 * @param[in] arithmExprEvaluator Used evaluator of arithmetical expressions.
 * @param[in] enableAggressiveOpts Enables aggressive optimizations.
 * @param[in] enableDebug Enables emission of debug messages.
+* @param[in] numThreads Number of threads optimizing functions in parallel.
 *
 * To perform the actual optimizations, call optimize(). To get a list of
 * available optimizations and their names, see our wiki.
@@ -118,6 +156,10 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 * @a hllWriter, @a va, and @a cio are needed in some optimizations, so they
 * have to be provided.
 *
+* If @a numThreads is greater than one, optimizations that work only with the
+* function they optimize are run on that many functions at once. The result
+* is the same as when they are run sequentially.
+*
 * @par Preconditions
 *  - @a hllWriter, @a va, @a cio, and @a arithmExprEvaluator are non-null
 */
@@ -125,13 +167,14 @@ OptimizerManager::OptimizerManager(const StringSet &enabledOpts,
 	const StringSet &disabledOpts, ShPtr<HLLWriter> hllWriter,
 	ShPtr<ValueAnalysis> va, ShPtr<CallInfoObtainer> cio,
 	ShPtr<ArithmExprEvaluator> arithmExprEvaluator,
-	bool enableAggressiveOpts, bool enableDebug):
+	bool enableAggressiveOpts, bool enableDebug, unsigned numThreads):
 		enabledOpts(trimOptimizerSuffix(enabledOpts)),
 		disabledOpts(trimOptimizerSuffix(disabledOpts)),
 		hllWriter(hllWriter), va(va), cio(cio),
 		arithmExprEvaluator(arithmExprEvaluator),
 		enableAggressiveOpts(enableAggressiveOpts), enableDebug(enableDebug),
-		recoverFromOutOfMemory(true), backendRunOpts() {
+		recoverFromOutOfMemory(true), backendRunOpts(),
+		numThreads(numThreads), queuedFuncOpts(), profilerLevel(0) {
 			PRECONDITION_NON_NULL(hllWriter);
 			PRECONDITION_NON_NULL(va);
 			PRECONDITION_NON_NULL(cio);
@@ -147,6 +190,12 @@ OptimizerManager::~OptimizerManager() {}
 * @brief Runs the optimizations over @a m.
 */
 void OptimizerManager::optimize(ShPtr<Module> m) {
+	// Optimizations are profiled as sub-phases of the running phase.
+	auto &profiler = Profiler::getInstance();
+	if (profiler.isEnabled()) {
+		profilerLevel = profiler.getNumOfRunningPhases();
+	}
+
 	// All optimizations should be run in order from the one that eliminates
 	// most statements/expressions to the one that eliminates least number of
 	// statements/expressions.
@@ -154,12 +203,18 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// Of course, if some optimization depend on another one, the order is
 	// clear.
 
+	// Optimizations run by runOnFuncs() only work with the function they
+	// optimize, so they may be run on several functions in parallel. The
+	// other ones are barriers. Data-flow optimizations, like CopyPropagation,
+	// are barriers because their analyses (call info, def-use chains, uses of
+	// variables) are computed for the whole module and cached.
+
 	//
 	// Perform initial, HLL-dependent optimizations.
 	//
 	if (hllWriter->getId() == "py") {
 		// Optimizations for Python'.
-		run<RemoveAllCastsOptimizer>(m);
+		runOnFuncs<RemoveAllCastsOptimizer>(m);
 	}
 
 	//
@@ -168,16 +223,16 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	if (!enableDebug) {
 		// Since we will not emit debug comments, empty statements are useless,
 		// so we can remove them.
-		run<EmptyStmtOptimizer>(m);
+		runOnFuncs<EmptyStmtOptimizer>(m);
 	}
 
-	run<GotoStmtOptimizer>(m);
-	run<RemoveUselessCastsOptimizer>(m);
+	runOnFuncs<GotoStmtOptimizer>(m);
+	runOnFuncs<RemoveUselessCastsOptimizer>(m);
 
 	// The first part of removal of non-compound statements. The other part
 	// should be run after structure optimizations because they may introduce
 	// constructs that can be optimized.
-	run<AggressiveDerefOptimizer>(m);
+	runOnFuncs<AggressiveDerefOptimizer>(m);
 	run<AggressiveGlobalToLocalOptimizer>(m);
 
 	// Data-flow optimizations.
@@ -191,16 +246,16 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	run<AuxiliaryVariablesOptimizer>(m, va, cio);
 
 	// SimplifyArithmExprOptimizer should be run before loop optimizations.
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runOnFuncs<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
 
 	// Structure optimizations.
 	// IfStructureOptimizer should be run before loop optimizations because
 	// it may make induction variables easier to find.
-	run<IfStructureOptimizer>(m);
+	runOnFuncs<IfStructureOptimizer>(m);
 	// LoopLastContinueOptimizer should be run after IfStructureOptimizer
 	// because IfBeforeLoopOptimizer may introduce continue statements to the
 	// end of loops.
-	run<LoopLastContinueOptimizer>(m);
+	runOnFuncs<LoopLastContinueOptimizer>(m);
 	// PreWhileTrueLoopConvOptimizer should be run before other `while True`
 	// loop optimizers.
 	run<PreWhileTrueLoopConvOptimizer>(m, va);
@@ -218,20 +273,20 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 		run<WhileTrueToUForLoopOptimizer>(m, va);
 	}
 	#endif
-	run<WhileTrueToWhileCondOptimizer>(m);
+	runOnFuncs<WhileTrueToWhileCondOptimizer>(m);
 	run<IfBeforeLoopOptimizer>(m, va);
 
 	// The second part of removal of non-compound statements.
 	run<LLVMIntrinsicsOptimizer>(m);
-	run<VoidReturnOptimizer>(m);
-	run<BreakContinueReturnOptimizer>(m);
+	runOnFuncs<VoidReturnOptimizer>(m);
+	runOnFuncs<BreakContinueReturnOptimizer>(m);
 
 	// Expression optimizations.
 	run<BitShiftOptimizer>(m);
-	run<DerefAddressOptimizer>(m);
+	runOnFuncs<DerefAddressOptimizer>(m);
 	run<EmptyArrayToStringOptimizer>(m);
-	run<BitOpToLogOpOptimizer>(m, va);
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runOnFuncs<BitOpToLogOpOptimizer>(m, va);
+	runOnFuncs<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
 
 	// Data-flow optimizations.
 	// Run the CopyPropagationOptimizer once more to produce more readable
@@ -247,7 +302,7 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// This is best to be run after DeadLocalAssignOptimizer and
 	// CopyPropagationOptimizer because it can get rid of statements like `v =
 	// v`, where v is a variable.
-	run<SelfAssignOptimizer>(m);
+	runOnFuncs<SelfAssignOptimizer>(m);
 
 	// VarDefForLoopOptimizer and VarDefStmtOptimizer are utilized also if the
 	// output is Python because in this way, we may emit addresses of
@@ -255,23 +310,23 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// Indeed, recall that in Python, we do not emit definitions without an
 	// initializer, so if we didn't move the definitions to the usages, there
 	// wouldn't be initializers.
-	run<VarDefForLoopOptimizer>(m);
+	runOnFuncs<VarDefForLoopOptimizer>(m);
 	run<VarDefStmtOptimizer>(m, va);
 
-	run<EmptyStmtOptimizer>(m);
-	run<GotoStmtOptimizer>(m);
+	runOnFuncs<EmptyStmtOptimizer>(m);
+	runOnFuncs<GotoStmtOptimizer>(m);
 
 	// SimplifyArithmExprOptimizer should be run at the end to produce the most
 	// readable output.
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runOnFuncs<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
 
 	// DeadCodeOptimizer should be run at the end because it is better when
 	// SimplifyArithmExprOptimizer optimizes expressions in conditions and then
 	// DeadCodeOptimizer is called. The same holds for
 	// DerefToArrayIndexOptimizer and IfToSwitchOptimizer.
-	run<DeadCodeOptimizer>(m, arithmExprEvaluator);
+	runOnFuncs<DeadCodeOptimizer>(m, arithmExprEvaluator);
 	run<DerefToArrayIndexOptimizer>(m);
-	run<IfToSwitchOptimizer>(m, va);
+	runOnFuncs<IfToSwitchOptimizer>(m, va);
 
 	//
 	// Perform final, HLL-dependent optimizations.
@@ -279,10 +334,17 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	if (hllWriter->getId() == "c") {
 		// Optimizations for C.
 		run<CCastOptimizer>(m);
-		run<CArrayArgOptimizer>(m);
+		runOnFuncs<CArrayArgOptimizer>(m);
 	} else if (hllWriter->getId() == "py") {
 		// Optimizations for Python'.
-		run<NoInitVarDefOptimizer>(m);
+		runOnFuncs<NoInitVarDefOptimizer>(m);
+	}
+
+	runQueuedFuncOptimizers(m);
+
+	printCacheStatistics();
+	if (profiler.isEnabled()) {
+		profiler.endPhases(profilerLevel);
 	}
 }
 
@@ -319,6 +381,7 @@ void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimi
 	}
 
 	printOptimization(OPT_ID);
+	profileOptimization(OPT_ID + OPT_SUFFIX);
 
 	if (recoverFromOutOfMemory) {
 		// Some optimizations, most notable CopyPropagation, may run out of
@@ -353,6 +416,36 @@ void OptimizerManager::printOptimization(const std::string &optId) const {
 	}
 }
 
+/**
+* @brief Records the currently run optimization(s) in the profiler.
+*
+* If the profiler is disabled, this function does nothing.
+*/
+void OptimizerManager::profileOptimization(const std::string &phaseName) const {
+	auto &profiler = Profiler::getInstance();
+	if (profiler.isEnabled()) {
+		profiler.startPhase(phaseName, profilerLevel, "llvmir2hll");
+	}
+}
+
+/**
+* @brief Prints how often the shared analysis of values found a cached result.
+*
+* If @c enableDebug is @c false, this function does nothing.
+*/
+void OptimizerManager::printCacheStatistics() const {
+	if (!enableDebug) {
+		return;
+	}
+
+	std::size_t hits = va->getNumOfCacheHits();
+	std::size_t lookups = hits + va->getNumOfCacheMisses();
+	std::size_t hitRate = lookups > 0 ? hits * 100 / lookups : 0;
+	printSubPhase("value analysis cache: "s + std::to_string(hits) +
+		" hits out of " + std::to_string(lookups) + " lookups (" +
+		std::to_string(hitRate) + "%)");
+}
+
 /**
 * @brief Returns @c true if a second pass of CopyPropagation should be run,
 *        @c false otherwise.
@@ -392,10 +485,172 @@ bool OptimizerManager::shouldSecondCopyPropagationBeRun() const {
 */
 template<typename Optimization, typename... Args>
 void OptimizerManager::run(ShPtr<Module> m, Args &&... args) {
+	// The queued optimizations have to be finished first.
+	runQueuedFuncOptimizers(m);
+
 	auto optimizer = std::make_shared<Optimization>(m,
 		std::forward<Args>(args)...);
 	runOptimizerProvidedItShouldBeRun(optimizer);
 }
 
+/**
+* @brief Runs the given function optimization (specified in the template
+*        parameter) over @a m with the given arguments.
+*
+* @tparam Optimization Optimization to be performed. It has to work only with
+*                      the function it optimizes and do all its work on the
+*                      function in FuncOptimizer::runOnFunction().
+*
+* @param[in] m Module to be optimized.
+* @param[in] args Arguments to be passed to the optimization.
+*
+* When only one thread is used, this is the same as run(). Otherwise, the
+* optimization is queued and run later by runQueuedFuncOptimizers(), together
+* with the other function optimizations that directly follow it.
+*
+* Expression::replaceExpression() and Statement::replaceStatement() notify all
+* the observers of the replaced expression or statement, wherever they are.
+* The only parts of the IR shared by several functions are variables (global
+* variables and functions) and types. Therefore, an optimization run in
+* parallel may replace statements and compound expressions, like casts or
+* operators, because their observers are in the optimized function. It may not
+* replace a variable because that would change other functions as well.
+*/
+template<typename Optimization, typename... Args>
+void OptimizerManager::runOnFuncs(ShPtr<Module> m, Args &&... args) {
+	if (numThreads <= 1) {
+		run<Optimization>(m, std::forward<Args>(args)...);
+		return;
+	}
+
+	auto optimizer = std::make_shared<Optimization>(m, args...);
+	const std::string OPT_ID = optimizer->getId();
+	if (!optShouldBeRun(OPT_ID)) {
+		return;
+	}
+
+	queuedFuncOpts.push_back({OPT_ID, optimizer,
+		[m, args...](const ThreadAnalyses &analyses) -> ShPtr<FuncOptimizer> {
+			return std::make_shared<Optimization>(m,
+				argForThread(args, analyses)...);
+		}
+	});
+	backendRunOpts.insert(OPT_ID);
+}
+
+/**
+* @brief Runs the queued function optimizations over all functions in @a m.
+*
+* Functions are handed out to threads one by one, so a thread that has
+* finished a function takes the next one. All the queued optimizations are
+* run on a function before the thread moves to another one. Every thread has
+* its own instances of the optimizers and of the analyses with an internal
+* state.
+*
+* The module-wide work of the optimizations (see
+* FuncOptimizer::initFuncsOptimization() and
+* FuncOptimizer::finishFuncsOptimization()) is done in the calling thread
+* before and after the functions are optimized.
+*/
+void OptimizerManager::runQueuedFuncOptimizers(ShPtr<Module> m) {
+	if (queuedFuncOpts.empty()) {
+		return;
+	}
+
+	StringVector optNames;
+	for (const auto &opt : queuedFuncOpts) {
+		printOptimization(opt.id);
+		optNames.push_back(opt.id + OPT_SUFFIX);
+	}
+	// The queued optimizations run interleaved, so they are profiled together.
+	profileOptimization(joinStrings(optNames) + " (in parallel)");
+
+	const FuncVector funcs(m->func_begin(), m->func_end());
+	std::atomic<std::size_t> next(0);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	try {
+		for (const auto &opt : queuedFuncOpts) {
+			opt.optimizer->initFuncsOptimization();
+		}
+	} catch (...) {
+		// Do not optimize the functions at all.
+		next = funcs.size();
+		error = std::current_exception();
+	}
+	auto optimizeFuncs = [&]() {
+		try {
+			auto analyses = createThreadAnalyses();
+			std::vector<ShPtr<FuncOptimizer>> optimizers;
+			for (const auto &opt : queuedFuncOpts) {
+				optimizers.push_back(opt.create(analyses));
+			}
+
+			for (std::size_t i = next++; i < funcs.size(); i = next++) {
+				for (const auto &optimizer : optimizers) {
+					optimizer->optimizeFunc(funcs[i]);
+				}
+			}
+		} catch (...) {
+			// Stop the other threads and let the error be handled in the
+			// calling thread.
+			next = funcs.size();
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	};
+
+	std::size_t threadCount = std::min<std::size_t>(numThreads, funcs.size());
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back(optimizeFuncs);
+	}
+	optimizeFuncs();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	if (!error) {
+		try {
+			for (const auto &opt : queuedFuncOpts) {
+				opt.optimizer->finishFuncsOptimization();
+			}
+		} catch (...) {
+			error = std::current_exception();
+		}
+	}
+	queuedFuncOpts.clear();
+
+	// The shared analysis of values has not seen the changes done by the
+	// threads, so its cache may be out of date.
+	va->clearCache();
+
+	if (!error) {
+		return;
+	}
+	try {
+		std::rethrow_exception(error);
+	} catch (const std::bad_alloc &) {
+		if (!recoverFromOutOfMemory) {
+			throw;
+		}
+		// See runOptimizerProvidedItShouldBeRun().
+		printWarningMessage("out of memory; trying to recover");
+		sleep(1);
+	}
+}
+
+/**
+* @brief Creates analyses for one thread optimizing functions in parallel.
+*/
+OptimizerManager::ThreadAnalyses OptimizerManager::createThreadAnalyses() const {
+	ThreadAnalyses analyses;
+	analyses.va = ValueAnalysis::create(va->getAliasAnalysis(), true);
+	analyses.arithmExprEvaluator = ArithmExprEvaluatorFactory::getInstance()
+		.createObject(arithmExprEvaluator->getId());
+	return analyses;
+}
+
 } // namespace llvmir2hll
 } // namespace retdec
@@ -53,14 +53,9 @@ void AuxiliaryVariablesOptimizer::doOptimization() {
 	}
 	cio->init(CGBuilder::getCG(module), va);
 
-	// Perform the optimization on all functions.
+	// Perform the optimization on all functions. The cache of va is updated
+	// for every changed function, so va stays in a valid state.
 	FuncOptimizer::doOptimization();
-
-	// Currently, we do not update the used analysis of values (va) during this
-	// optimization, so here, at the end of the optimization, we have to put it
-	// into an invalid state.
-	// TODO Regularly update the cache of va so we do not have to invalidate it.
-	va->invalidateState();
 }
 
 void AuxiliaryVariablesOptimizer::runOnFunction(ShPtr<Function> func) {
@@ -73,6 +68,13 @@ void AuxiliaryVariablesOptimizer::runOnFunction(ShPtr<Function> func) {
 	for (const auto &var : auxVars) {
 		func->removeLocalVar(var);
 	}
+
+	// Only the results for the changed function are out of date. They have to
+	// be removed before the optimization because afterwards, the removed
+	// statements are no longer reachable from the body of the function.
+	if (!auxVars.empty()) {
+		va->removeFuncFromCache(func);
+	}
 	visitStmt(func->getBody());
 }
 
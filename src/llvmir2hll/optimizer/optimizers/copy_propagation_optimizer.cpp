@@ -299,6 +299,7 @@ void CopyPropagationOptimizer::performOptimization() {
 		ducs->cfg->replaceStmt(stmt, newStmts);
 	}
 	for (const auto &stmt : ordered(toEntirelyRemoveStmts)) {
+		va->removeFromCache(stmt, true);
 		Statement::removeStatementButKeepDebugComment(stmt);
 		ducs->cfg->removeStmt(stmt);
 	}
@@ -400,7 +401,7 @@ void CopyPropagationOptimizer::handleCaseEmptyUses(ShPtr<Statement> stmt,
 	// Eliminate the statement.
 	toRemoveStmtsPreserveCalls.insert(stmt);
 	modifiedStmts.insert(stmt);
-	va->removeFromCache(stmt);
+	va->removeFromCache(stmt, true);
 	vuv->stmtHasBeenRemoved(stmt, ducs->func);
 	codeChanged = true;
 }
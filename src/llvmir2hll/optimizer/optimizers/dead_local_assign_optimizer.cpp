@@ -123,9 +123,9 @@ bool DeadLocalAssignOptimizer::tryToOptimize(ShPtr<Function> func) {
 		// varUses->dirUses, we have to create a copy of this set and iterate
 		// over this copy.
 		for (const auto &use : StmtSet(varUses->dirUses)) {
+			va->removeFromCache(use, true);
 			removeVarDefOrAssignStatement(use, func);
 			codeChanged = true;
-			va->removeFromCache(use);
 			vuv->stmtHasBeenRemoved(use, func);
 		}
 	}
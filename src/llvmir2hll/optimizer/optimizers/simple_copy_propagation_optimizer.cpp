@@ -322,9 +322,11 @@ void SimpleCopyPropagationOptimizer::tryOptimizationCase1(
 	// Do the optimization.
 	replaceVarWithExprInStmt(lhsVar, rhs, firstUseStmt);
 	va->removeFromCache(firstUseStmt);
+	va->removeFromCache(stmt, true);
 	Statement::removeStatementButKeepDebugComment(stmt);
 	currCFG->removeStmt(stmt);
 	if (lhsDefStmt) {
+		va->removeFromCache(lhsDefStmt, true);
 		removeVarDefOrAssignStatement(lhsDefStmt, currFunc);
 		currCFG->removeStmt(lhsDefStmt);
 	}
@@ -379,9 +381,11 @@ void SimpleCopyPropagationOptimizer::tryOptimizationCase2(
 		replaceVarWithExprInStmt(lhsVar, getRhs(stmt), lhsUse);
 		va->removeFromCache(lhsUse);
 	}
+	va->removeFromCache(stmt, true);
 	removeVarDefOrAssignStatement(stmt);
 	currCFG->removeStmt(stmt);
 	if (lhsDefStmt) {
+		va->removeFromCache(lhsDefStmt, true);
 		removeVarDefOrAssignStatement(lhsDefStmt, currFunc);
 		currCFG->removeStmt(lhsDefStmt);
 	}
@@ -47,7 +47,7 @@ namespace llvmir2hll {
 */
 SimplifyArithmExprOptimizer::SimplifyArithmExprOptimizer(ShPtr<Module> module,
 		ShPtr<ArithmExprEvaluator> arithmExprEvaluator):
-			Optimizer(module) {
+			FuncOptimizer(module) {
 	PRECONDITION_NON_NULL(module);
 	PRECONDITION_NON_NULL(arithmExprEvaluator);
 
@@ -59,7 +59,7 @@ SimplifyArithmExprOptimizer::SimplifyArithmExprOptimizer(ShPtr<Module> module,
 */
 SimplifyArithmExprOptimizer::~SimplifyArithmExprOptimizer() {}
 
-void SimplifyArithmExprOptimizer::doOptimization() {
+void SimplifyArithmExprOptimizer::doInitialization() {
 	// Visit the initializer of all global variables.
 	for (auto i = module->global_var_begin(), e = module->global_var_end();
 			i != e; ++i) {
@@ -71,17 +71,20 @@ void SimplifyArithmExprOptimizer::doOptimization() {
 			}
 		} while (codeChanged);
 	}
+}
 
-	// Visit all functions.
-	for (auto i = module->func_definition_begin(),
-			e = module->func_definition_end(); i != e; ++i) {
-		// Keep optimizing until there are no changes.
-		do {
-			codeChanged = false;
-			restart();
-			(*i)->accept(this);
-		} while (codeChanged);
+void SimplifyArithmExprOptimizer::runOnFunction(ShPtr<Function> func) {
+	if (func->isDeclaration()) {
+		return;
 	}
+
+	currFunc = func;
+	// Keep optimizing until there are no changes.
+	do {
+		codeChanged = false;
+		restart();
+		func->accept(this);
+	} while (codeChanged);
 }
 
 void SimplifyArithmExprOptimizer::visit(ShPtr<AddOpExpr> expr) {
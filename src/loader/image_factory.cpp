@@ -61,6 +61,7 @@ std::unique_ptr<Image> createImageImpl(const std::shared_ptr<retdec::fileformat:
  * Create instance of Image class from path to file.
  * If the input file cannot be loaded, function will return @c nullptr.
  * Loaded image becomes owner of the provided @c FileFormat.
+ * Content of the input file is mapped into memory rather than copied.
  *
  * @param filePath Path to input file.
  * @param isRaw Is the input a raw binary file format?
@@ -71,7 +72,10 @@ std::unique_ptr<Image> createImage(const std::string& filePath, bool isRaw)
 {
 	std::unique_ptr<retdec::fileformat::FileFormat> fileFormat = retdec::fileformat::createFileFormat(
 			filePath,
-			isRaw);
+			isRaw,
+			static_cast<retdec::fileformat::LoadFlags>(
+					retdec::fileformat::LoadFlags::MEMORY_MAP_INPUT
+					| retdec::fileformat::LoadFlags::DECOMPILATION));
 	std::shared_ptr<retdec::fileformat::FileFormat> fileFormatShared(std::move(fileFormat)); // Obtain ownership.
 	return createImageImpl(fileFormatShared);
 }
@@ -4,14 +4,18 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #include "retdec/stacofin/stacofin.h"
-#include "yaracpp/yara_detector/yara_detector.h"
 #include "retdec/loader/loader/image.h"
 #include "retdec/utils/string.h"
+#include "retdec/yara-cache/yara_cache.h"
 
 /**
  * Set \c debug_enabled to \c true to enable this LOG macro.
@@ -22,7 +26,6 @@
 static bool debug_enabled = false;
 
 using namespace retdec::utils;
-using namespace yaracpp;
 using namespace retdec::loader;
 
 namespace retdec {
@@ -607,49 +610,119 @@ const DetectedFunctionsPtrMap& Finder::getConfirmedDetections() const
 void Finder::search(
 	const Image& image,
 	const std::string& yaraFile)
+{
+	search(image, std::set<std::string>{yaraFile});
+}
+
+/**
+ * Search for static code in input file.
+ *
+ * Rules are loaded sequentially, because YARA initialization and rule
+ * compilation are not thread-safe. Scanning, which takes most of the time,
+ * runs concurrently for all signature files over the loaded bytes of the
+ * input, which are scanned in place. Results are then merged in the order of
+ * @p yaraFiles, so detections are the same as if the files were searched one
+ * by one.
+ *
+ * @param image input file image
+ * @param yaraFiles static code signature files
+ */
+void Finder::search(
+	const retdec::loader::Image& image,
+	const std::set<std::string>& yaraFiles)
 {
 	// Get FileFormat instance.
 	const auto* fileFormat = image.getFileFormat();
-	if (!fileFormat)
+	if (!fileFormat || yaraFiles.empty())
 	{
 		return;
 	}
 
-	// Start Yara detector.
-	YaraDetector detector;
-	detector.addRuleFile(yaraFile);
-	auto inputBytes = fileFormat->getLoadedBytes();
-	detector.analyze(inputBytes);
-	if (!detector.isInValidState())
+	// Load rules.
+	std::vector<std::string> paths(yaraFiles.begin(), yaraFiles.end());
+	std::vector<std::unique_ptr<yara_cache::CompiledRules>> rules;
+	rules.reserve(paths.size());
+	for (const auto& path : paths)
 	{
-		return;
+		rules.emplace_back(new yara_cache::CompiledRules(path));
+	}
+
+	const auto loadedBytes = fileFormat->getLoadedBytes();
+	std::vector<std::vector<yara_cache::MatchedRule>> matched(rules.size());
+	std::vector<char> scanned(rules.size(), false);
+
+	std::atomic<std::size_t> next(0);
+	auto scan = [&]()
+	{
+		for (std::size_t i = next++; i < rules.size(); i = next++)
+		{
+			scanned[i] = rules[i]->scanMemory(
+					loadedBytes.data(),
+					loadedBytes.size(),
+					matched[i]);
+		}
+	};
+
+	std::size_t threadCount = std::min<std::size_t>(
+			std::max(std::thread::hardware_concurrency(), 1u),
+			rules.size());
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < threadCount; ++i)
+	{
+		threads.emplace_back(scan);
+	}
+	scan();
+	for (auto& t : threads)
+	{
+		t.join();
 	}
 
+	for (std::size_t i = 0; i < rules.size(); ++i)
+	{
+		if (scanned[i])
+		{
+			collectDetections(*fileFormat, matched[i], paths[i]);
+		}
+	}
+}
+
+/**
+ * Store rules matched by a scan into found detections.
+ *
+ * @param fileFormat input file format
+ * @param matched rules matched in the input
+ * @param yaraFile static code signature file with the rules
+ */
+void Finder::collectDetections(
+	const retdec::fileformat::FileFormat& fileFormat,
+	const std::vector<yara_cache::MatchedRule>& matched,
+	const std::string& yaraFile)
+{
 	// Iterate over detected rules.
-	for (const YaraRule &detectedRule : detector.getDetectedRules())
+	for (const auto& detectedRule : matched)
 	{
 		DetectedFunction detectedFunction;
 		detectedFunction.signaturePath = yaraFile;
 
-		for (const YaraMeta &ruleMeta : detectedRule.getMetas())
+		for (const auto& ruleMeta : detectedRule.metas)
 		{
-			if (ruleMeta.getId() == "name")
+			if (ruleMeta.id == "name")
 			{
-				detectedFunction.names.push_back(ruleMeta.getStringValue());
+				detectedFunction.names.push_back(ruleMeta.stringValue);
 			}
-			if (ruleMeta.getId() == "size")
+			if (ruleMeta.id == "size")
 			{
-				detectedFunction.size = ruleMeta.getIntValue();
+				detectedFunction.size = ruleMeta.intValue;
 			}
-			if (ruleMeta.getId() == "refs")
+			if (ruleMeta.id == "refs")
 			{
-				const auto &refs = ruleMeta.getStringValue();
+				const auto &refs = ruleMeta.stringValue;
 				detectedFunction.setReferences(refs);
 			}
-			if (ruleMeta.getId() == "altNames")
+			if (ruleMeta.id == "altNames")
 			{
 				std::string name;
-				const auto &altNames = ruleMeta.getStringValue();
+				const auto &altNames = ruleMeta.stringValue;
 				std::istringstream ss(altNames, std::istringstream::in);
 				while(ss >> name)
 				{
@@ -659,12 +732,12 @@ void Finder::search(
 		}
 
 		// Iterate over all matches.
-		for (const YaraMatch &ruleMatch : detectedRule.getMatches())
+		for (const auto offset : detectedRule.offsets)
 		{
 			// This is different for every match.
-			detectedFunction.offset = ruleMatch.getOffset();
+			detectedFunction.offset = offset;
 			unsigned long long address = 0;
-			if (!fileFormat->getAddressFromOffset(
+			if (!fileFormat.getAddressFromOffset(
 						address, detectedFunction.offset))
 			{
 				// Cannot get address. Maybe report error?
@@ -682,22 +755,6 @@ void Finder::search(
 	}
 }
 
-/**
- * Search for static code in input file.
- *
- * @param image input file image
- * @param yaraFiles static code signature files
- */
-void Finder::search(
-	const retdec::loader::Image& image,
-	const std::set<std::string>& yaraFiles)
-{
-	for (const auto& f : yaraFiles)
-	{
-		search(image, f);
-	}
-}
-
 /**
  * Search for static code in input file based on information in config file.
  *
@@ -37,6 +37,13 @@ Address::Address(uint64_t a) :
 Address::Address(const std::string &a) :
 		address(Address::getUndef)
 {
+	// Avoid the costly exception thrown by std::stoull() for empty strings,
+	// which are common (e.g. missing addresses in config).
+	if (a.empty())
+	{
+		return;
+	}
+
 	try
 	{
 		size_t idx = 0;
@@ -5,13 +5,20 @@
 */
 
 #include <cstddef>
+#include <fstream>
+#include <string>
 
 #include "retdec/utils/memory.h"
 #include "retdec/utils/os.h"
 
 #ifdef OS_WINDOWS
 	#include <windows.h>
-#elif defined(OS_MACOS) || defined(OS_BSD)
+	#include <psapi.h>
+#elif defined(OS_MACOS)
+	#include <mach/mach.h>
+	#include <sys/types.h>
+	#include <sys/sysctl.h>
+#elif defined(OS_BSD)
 	#include <sys/types.h>
 	#include <sys/sysctl.h>
 #else
@@ -41,6 +48,18 @@ bool limitSystemMemoryOnPOSIX(std::size_t limit) {
 	return rc == 0;
 }
 
+#if defined(OS_MACOS) || defined(OS_BSD)
+/**
+* @brief Returns the peak resident set size as reported by @c getrusage() (in
+*        the units used by the system).
+*/
+std::size_t getMaxRSSOnPOSIX() {
+	struct rusage usage;
+	auto rc = getrusage(RUSAGE_SELF, &usage);
+	return rc == 0 ? static_cast<std::size_t>(usage.ru_maxrss) : 0;
+}
+#endif
+
 #endif
 
 #ifdef OS_WINDOWS
@@ -98,6 +117,20 @@ bool limitSystemMemoryOnWindows(std::size_t limit) {
 	return succeeded;
 }
 
+/**
+* @brief Implementation of @c getCurrentMemoryUsage() and
+*        @c getPeakMemoryUsage() on Windows.
+*/
+std::size_t getMemoryUsageOnWindows(bool peak) {
+	PROCESS_MEMORY_COUNTERS counters;
+	bool succeeded = GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+		sizeof(counters));
+	if (!succeeded) {
+		return 0;
+	}
+	return peak ? counters.PeakWorkingSetSize : counters.WorkingSetSize;
+}
+
 #elif defined(OS_MACOS)
 
 /**
@@ -121,6 +154,17 @@ bool limitSystemMemoryOnMacOS(std::size_t limit) {
 	return limitSystemMemoryOnPOSIX(limit);
 }
 
+/**
+* @brief Implementation of @c getCurrentMemoryUsage() on MacOS.
+*/
+std::size_t getCurrentMemoryUsageOnMacOS() {
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	auto rc = task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+		reinterpret_cast<task_info_t>(&info), &count);
+	return rc == KERN_SUCCESS ? info.resident_size : 0;
+}
+
 #elif defined(OS_BSD)
 
 /**
@@ -163,6 +207,29 @@ bool limitSystemMemoryOnLinux(std::size_t limit) {
 	return limitSystemMemoryOnPOSIX(limit);
 }
 
+/**
+* @brief Returns the value of the given field from @c /proc/self/status (in
+*        bytes).
+*
+* When the field cannot be read, it returns @c 0.
+*/
+std::size_t getProcStatusSizeOnLinux(const std::string &field) {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, field.size(), field) == 0
+				&& line.size() > field.size() && line[field.size()] == ':') {
+			// The value is in kB, e.g. "VmRSS:     1234 kB".
+			try {
+				return std::stoull(line.substr(field.size() + 1)) * 1024;
+			} catch (...) {
+				return 0;
+			}
+		}
+	}
+	return 0;
+}
+
 #endif
 
 } // anonymous namespace
@@ -222,5 +289,69 @@ bool limitSystemMemoryToHalfOfTotalSystemMemory() {
 	return limitSystemMemory(totalSize / 2);
 }
 
+/**
+* @brief Returns the size of physical memory currently used by the process (in
+*        bytes).
+*
+* When the size cannot be obtained, it returns @c 0.
+*/
+std::size_t getCurrentMemoryUsage() {
+#ifdef OS_WINDOWS
+	return getMemoryUsageOnWindows(/* peak */ false);
+#elif defined(OS_MACOS)
+	return getCurrentMemoryUsageOnMacOS();
+#elif defined(OS_BSD)
+	// There is no simple way of obtaining the current resident set size.
+	return 0;
+#else
+	return getProcStatusSizeOnLinux("VmRSS");
+#endif
+}
+
+/**
+* @brief Returns the peak size of physical memory used by the process (in
+*        bytes).
+*
+* The peak is measured since the start of the process or since the last
+* successful call to resetPeakMemoryUsage(). When the size cannot be obtained,
+* it returns @c 0.
+*/
+std::size_t getPeakMemoryUsage() {
+#ifdef OS_WINDOWS
+	return getMemoryUsageOnWindows(/* peak */ true);
+#elif defined(OS_MACOS)
+	// ru_maxrss is in bytes on MacOS.
+	return getMaxRSSOnPOSIX();
+#elif defined(OS_BSD)
+	// ru_maxrss is in kilobytes on *BSD.
+	return getMaxRSSOnPOSIX() * 1024;
+#else
+	return getProcStatusSizeOnLinux("VmHWM");
+#endif
+}
+
+/**
+* @brief Resets the peak size of physical memory used by the process to its
+*        current size.
+*
+* @return @c true if the reset succeeded, @c false otherwise.
+*
+* The reset is supported only on Linux (since 4.0). On other systems, the peak
+* can only grow and this function returns @c false.
+*
+* The peak is a property of the whole process, so the reset is visible to all
+* its threads and to everybody who reads the peak afterwards.
+*/
+bool resetPeakMemoryUsage() {
+#if defined(OS_WINDOWS) || defined(OS_MACOS) || defined(OS_BSD)
+	return false;
+#else
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+	clearRefs.flush();
+	return static_cast<bool>(clearRefs);
+#endif
+}
+
 } // namespace utils
 } // namespace retdec
@@ -0,0 +1,348 @@
+/**
+* @file src/utils/profiler.cpp
+* @brief Recording of time and memory spent in phases of a program.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+
+#include "retdec/utils/memory.h"
+#include "retdec/utils/profiler.h"
+#include "retdec/utils/time.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/**
+* @brief Prints @a str to @a out as a JSON string, including the quotes.
+*/
+void printJsonString(std::ostream &out, const std::string &str) {
+	out << '"';
+	for (unsigned char c : str) {
+		switch (c) {
+			case '"': out << "\\\""; break;
+			case '\\': out << "\\\\"; break;
+			case '\n': out << "\\n"; break;
+			case '\r': out << "\\r"; break;
+			case '\t': out << "\\t"; break;
+			default:
+				if (c < 0x20) {
+					char buf[8];
+					std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+					out << buf;
+				} else {
+					out << c;
+				}
+		}
+	}
+	out << '"';
+}
+
+/**
+* @brief Prints @a sizes to @a out as members of a JSON object, each prefixed
+*        with @a prefix.
+*/
+void printJsonSizes(std::ostream &out, const Profiler::Sizes &sizes,
+		const std::string &prefix = std::string()) {
+	bool first = true;
+	for (const auto &size : sizes) {
+		out << (first ? "" : ", ");
+		printJsonString(out, prefix + size.first);
+		out << ": " << size.second;
+		first = false;
+	}
+}
+
+/**
+* @brief Converts the given time in seconds into microseconds.
+*/
+long long toMicroseconds(double seconds) {
+	return static_cast<long long>(seconds * 1000000.0);
+}
+
+} // anonymous namespace
+
+/**
+* @brief Creates a new disabled profiler.
+*/
+Profiler::Profiler(): epoch(std::chrono::steady_clock::now()) {}
+
+/**
+* @brief Returns the profiler shared by the whole program.
+*/
+Profiler &Profiler::getInstance() {
+	static Profiler instance;
+	return instance;
+}
+
+/**
+* @brief Enables the profiler.
+*
+* Times of phases are measured relatively to the moment of the first
+* enabling.
+*/
+void Profiler::enable() {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (enabled) {
+		return;
+	}
+
+	epoch = std::chrono::steady_clock::now();
+	peakResettable = resetPeakMemoryUsage();
+	enabled = true;
+}
+
+/**
+* @brief Returns @c true if the profiler is enabled, @c false otherwise.
+*/
+bool Profiler::isEnabled() const {
+	return enabled;
+}
+
+/**
+* @brief Sets the getter of the sizes of the processed code.
+*
+* An empty getter means that no sizes are recorded.
+*/
+void Profiler::setSizesGetter(SizesGetter getter) {
+	std::lock_guard<std::mutex> lock(mutex);
+	sizesGetter = std::move(getter);
+}
+
+/**
+* @brief Returns the getter of the sizes of the processed code.
+*/
+Profiler::SizesGetter Profiler::getSizesGetter() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return sizesGetter;
+}
+
+/**
+* @brief Starts a new phase.
+*
+* @param[in] name Name of the phase.
+* @param[in] level Level of the phase. All running phases on this or a deeper
+*                  level are ended.
+* @param[in] category Category of the phase, e.g. the name of the tool.
+*
+* If the profiler is disabled, this function does nothing.
+*/
+void Profiler::startPhase(const std::string &name, unsigned level,
+		const std::string &category) {
+	if (!enabled) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	endPhasesUnlocked(level);
+
+	samplePeakMemory();
+	if (peakResettable) {
+		resetPeakMemoryUsage();
+	}
+
+	Phase phase;
+	phase.name = name;
+	phase.category = category;
+	phase.level = level;
+	phase.sizesStart = getSizes();
+	phase.memoryStart = getCurrentMemoryUsage();
+	phase.start = getWallTime();
+
+	RunningPhase r;
+	r.index = phases.size();
+	r.peakStart = getPeakMemoryUsage();
+	r.peak = r.peakStart;
+	r.cpuStart = getElapsedTime();
+
+	phases.push_back(std::move(phase));
+	running.push_back(r);
+}
+
+/**
+* @brief Ends all running phases on the given or a deeper level.
+*
+* Calling it with @c 0 ends all running phases.
+*/
+void Profiler::endPhases(unsigned level) {
+	std::lock_guard<std::mutex> lock(mutex);
+	endPhasesUnlocked(level);
+}
+
+/**
+* @brief Returns the number of running phases.
+*
+* It is the level on which sub-phases of the deepest running phase should be
+* started.
+*/
+unsigned Profiler::getNumOfRunningPhases() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return static_cast<unsigned>(running.size());
+}
+
+/**
+* @brief Returns the recorded phases, in the order of their starts.
+*
+* Phases that are still running are incomplete.
+*/
+std::vector<Profiler::Phase> Profiler::getPhases() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return phases;
+}
+
+/**
+* @brief Removes all recorded phases, including the running ones.
+*/
+void Profiler::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	running.clear();
+	phases.clear();
+}
+
+/**
+* @brief Prints the recorded phases to @a out in JSON.
+*
+* The output is an object with a single member, @c phases, which is an array of
+* objects with the members of Profiler::Phase.
+*/
+void Profiler::printJson(std::ostream &out) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+	out << std::fixed << std::setprecision(6);
+
+	out << "{\n\t\"phases\": [";
+	bool first = true;
+	for (const auto &phase : phases) {
+		out << (first ? "\n" : ",\n") << "\t\t{ \"name\": ";
+		printJsonString(out, phase.name);
+		out << ", \"category\": ";
+		printJsonString(out, phase.category);
+		out << ", \"level\": " << phase.level
+			<< ", \"start\": " << phase.start
+			<< ", \"wallTime\": " << phase.wallTime
+			<< ", \"cpuTime\": " << phase.cpuTime
+			<< ", \"memoryStart\": " << phase.memoryStart
+			<< ", \"memoryEnd\": " << phase.memoryEnd
+			<< ", \"peakMemoryDelta\": " << phase.peakMemoryDelta
+			<< ", \"sizesStart\": { ";
+		printJsonSizes(out, phase.sizesStart);
+		out << " }, \"sizesEnd\": { ";
+		printJsonSizes(out, phase.sizesEnd);
+		out << " } }";
+		first = false;
+	}
+	out << "\n\t]\n}\n";
+
+	out.flags(flags);
+	out.precision(precision);
+}
+
+/**
+* @brief Prints the recorded phases to @a out in the Chrome trace event format.
+*
+* The output can be loaded into @c chrome://tracing or other trace viewers.
+* Every phase is a complete event whose arguments are the measured values. The
+* memory usage is also emitted as a counter.
+*/
+void Profiler::printChromeTrace(std::ostream &out) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	out << "{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [";
+	bool first = true;
+	for (const auto &phase : phases) {
+		out << (first ? "\n" : ",\n") << "{ \"name\": ";
+		printJsonString(out, phase.name);
+		out << ", \"cat\": ";
+		printJsonString(out, phase.category.empty() ? "default" : phase.category);
+		out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+			<< ", \"ts\": " << toMicroseconds(phase.start)
+			<< ", \"dur\": " << toMicroseconds(phase.wallTime)
+			<< ", \"args\": { \"cpuTimeUs\": " << toMicroseconds(phase.cpuTime)
+			<< ", \"memoryStart\": " << phase.memoryStart
+			<< ", \"memoryEnd\": " << phase.memoryEnd
+			<< ", \"peakMemoryDelta\": " << phase.peakMemoryDelta;
+		if (!phase.sizesStart.empty()) {
+			out << ", ";
+			printJsonSizes(out, phase.sizesStart, "start.");
+		}
+		if (!phase.sizesEnd.empty()) {
+			out << ", ";
+			printJsonSizes(out, phase.sizesEnd, "end.");
+		}
+		out << " } }";
+
+		out << ",\n{ \"name\": \"memory\", \"ph\": \"C\", \"pid\": 1"
+			<< ", \"ts\": " << toMicroseconds(phase.start)
+			<< ", \"args\": { \"rss\": " << phase.memoryStart << " } }";
+		first = false;
+	}
+	out << "\n]\n}\n";
+}
+
+/**
+* @brief Returns the wall-clock time since the profiler was enabled (in
+*        seconds).
+*/
+double Profiler::getWallTime() const {
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - epoch).count();
+}
+
+/**
+* @brief Returns the current sizes of the processed code.
+*/
+Profiler::Sizes Profiler::getSizes() const {
+	return sizesGetter ? sizesGetter() : Sizes();
+}
+
+/**
+* @brief Updates the peaks of all running phases with the current peak memory
+*        usage.
+*
+* It has to be called before the peak is reset.
+*/
+void Profiler::samplePeakMemory() {
+	if (running.empty()) {
+		return;
+	}
+
+	auto peak = getPeakMemoryUsage();
+	for (auto &r : running) {
+		r.peak = std::max(r.peak, peak);
+	}
+}
+
+/**
+* @brief Ends all running phases on the given or a deeper level.
+*
+* @c mutex has to be locked by the caller.
+*/
+void Profiler::endPhasesUnlocked(unsigned level) {
+	while (!running.empty() && phases[running.back().index].level >= level) {
+		endLastPhase();
+	}
+}
+
+/**
+* @brief Ends the deepest running phase.
+*/
+void Profiler::endLastPhase() {
+	samplePeakMemory();
+
+	auto r = running.back();
+	running.pop_back();
+
+	auto &phase = phases[r.index];
+	phase.wallTime = getWallTime() - phase.start;
+	phase.cpuTime = getElapsedTime() - r.cpuStart;
+	phase.memoryEnd = getCurrentMemoryUsage();
+	phase.peakMemoryDelta = r.peak - r.peakStart;
+	phase.sizesEnd = getSizes();
+}
+
+} // namespace utils
+} // namespace retdec
@@ -49,14 +49,33 @@ std::string getTime(const std::tm *cTime) {
 	return time.str();
 }
 
+/**
+* @brief Converts @a timestamp into the local time stored into @a result.
+*
+* Unlike @c std::localtime(), it does not use a static buffer shared among
+* threads, so it can be called from several threads at once.
+*
+* @return @a result on success, @c nullptr otherwise.
+*/
+std::tm *toLocalTime(std::time_t timestamp, std::tm *result) {
+#ifdef OS_WINDOWS
+	return localtime_s(result, &timestamp) == 0 ? result : nullptr;
+#else
+	return localtime_r(&timestamp, result);
+#endif
+}
+
 } // anonymous namespace
 
 /**
 * @brief Returns the current timestamp.
+*
+* The returned timestamp is stored in a buffer owned by the calling thread, so
+* it is valid until the next call from the same thread.
 */
 std::tm *getCurrentTimestamp() {
-	auto now = std::time(nullptr);
-	return std::localtime(&now);
+	thread_local std::tm now;
+	return toLocalTime(std::time(nullptr), &now);
 }
 
 /**
@@ -78,6 +97,9 @@ std::string getCurrentTime() {
 */
 std::string getCurrentYear() {
 	auto now = getCurrentTimestamp();
+	if (!now) {
+		return "";
+	}
 	return std::to_string(now->tm_year + 1900);
 }
 
@@ -107,7 +129,8 @@ std::string timestampToDate(std::tm *tm) {
 * @param timestamp Timestamp for conversion.
 */
 std::string timestampToDate(std::time_t timestamp) {
-	return timestampToDate(std::localtime(&timestamp));
+	std::tm tm;
+	return timestampToDate(toLocalTime(timestamp, &tm));
 }
 
 /**
@@ -0,0 +1,693 @@
+/**
+ * @file src/yara-cache/yara_cache.cpp
+ * @brief Cache of compiled YARA rules.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <sys/stat.h>
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <yara.h>
+
+#include "retdec/crypto/crypto.h"
+#include "retdec/utils/filesystem_path.h"
+#include "retdec/utils/string.h"
+#include "retdec/yara-cache/yara_cache.h"
+#include "yaracpp/yara_detector/yara_detector.h"
+
+namespace retdec {
+namespace yara_cache {
+
+namespace {
+
+const std::string compiledSuffix = ".yarac";
+const std::size_t nameSpaceHashLength = 8;
+const std::size_t hashLength = 16;
+/// Number of rules kept by a reused detector from its previous scans after
+/// which the detector is created again.
+const std::size_t maxKeptRules = 1 << 16;
+
+/**
+ * Size and modification time of one source file of compiled rules.
+ */
+struct FileStamp
+{
+	std::string path;
+	long long size = -1;
+	long long mtime = -1;
+};
+
+/**
+ * Compiled rule file remembered for one (rule file, namespace) pair.
+ */
+struct CacheEntry
+{
+	std::vector<FileStamp> sources;
+	std::string compiledFile;
+};
+
+std::mutex cacheMutex;
+std::map<std::pair<std::string, std::string>, CacheEntry> cache;
+
+bool getFileStamp(const std::string& path, long long& size, long long& mtime)
+{
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0)
+	{
+		return false;
+	}
+
+	size = static_cast<long long>(st.st_size);
+	mtime = static_cast<long long>(st.st_mtime);
+	return true;
+}
+
+/**
+ * Stamp of @p path. Missing file has size and time -1, so its later
+ * creation is noticed as well.
+ */
+FileStamp getFileStamp(const std::string& path)
+{
+	FileStamp stamp;
+	stamp.path = path;
+	getFileStamp(path, stamp.size, stamp.mtime);
+	return stamp;
+}
+
+bool isUpToDate(const std::vector<FileStamp>& sources)
+{
+	for (const auto& source : sources)
+	{
+		auto current = getFileStamp(source.path);
+		if (current.size != source.size || current.mtime != source.mtime)
+		{
+			return false;
+		}
+	}
+	return !sources.empty();
+}
+
+bool isFile(const std::string& path)
+{
+	long long size, mtime;
+	return getFileStamp(path, size, mtime);
+}
+
+std::string getDirectory(const std::string& path)
+{
+	auto slash = path.find_last_of("/\\");
+	return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+std::string getFileName(const std::string& path)
+{
+	auto slash = path.find_last_of("/\\");
+	return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+bool isHexString(const std::string& str, std::size_t pos, std::size_t length)
+{
+	if (pos + length > str.size())
+	{
+		return false;
+	}
+	for (auto i = pos; i < pos + length; ++i)
+	{
+		if (!std::isxdigit(static_cast<unsigned char>(str[i])))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string getHash(const std::string& data, std::size_t length)
+{
+	return crypto::getSha256(
+			reinterpret_cast<const unsigned char*>(data.data()),
+			data.size()).substr(0, length);
+}
+
+/**
+ * Paths of files included by rules @p content from @p ruleFile.
+ *
+ * YARA resolves relative paths against the directory of the including file.
+ * Directives in comments are reported too, which only makes the cache key
+ * depend on one more file.
+ */
+std::vector<std::string> getIncludedFiles(
+		const std::string& ruleFile,
+		const std::string& content)
+{
+	std::vector<std::string> result;
+	std::istringstream lines(content);
+	std::string line;
+	while (std::getline(lines, line))
+	{
+		auto pos = line.find_first_not_of(" \t");
+		if (pos == std::string::npos || line.compare(pos, 7, "include") != 0)
+		{
+			continue;
+		}
+
+		auto open = line.find_first_not_of(" \t", pos + 7);
+		if (open == std::string::npos || open == pos + 7 || line[open] != '"')
+		{
+			continue;
+		}
+		auto close = line.find('"', open + 1);
+		if (close == std::string::npos)
+		{
+			continue;
+		}
+
+		auto path = line.substr(open + 1, close - open - 1);
+		if (!path.empty() && !utils::FilesystemPath(path).isAbsolute())
+		{
+			path = getDirectory(ruleFile) + path;
+		}
+		result.push_back(path);
+	}
+	return result;
+}
+
+/**
+ * Append content of @p ruleFile and of all files it includes to @p key
+ * and remember their stamps in @p sources.
+ */
+bool readSources(
+		const std::string& ruleFile,
+		std::string& key,
+		std::vector<FileStamp>& sources,
+		std::set<std::string>& visited)
+{
+	if (!visited.insert(ruleFile).second)
+	{
+		return true;
+	}
+
+	sources.push_back(getFileStamp(ruleFile));
+	key += ruleFile;
+	key.push_back('\0');
+
+	std::ifstream stream(ruleFile, std::ios::in | std::ios::binary);
+	if (!stream)
+	{
+		// Missing included file makes compilation fail later, but it
+		// still has to be a part of the key.
+		return false;
+	}
+	std::ostringstream content;
+	content << stream.rdbuf();
+	key += content.str();
+	key.push_back('\0');
+
+	for (const auto& include : getIncludedFiles(ruleFile, content.str()))
+	{
+		readSources(include, key, sources, visited);
+	}
+	return true;
+}
+
+/**
+ * Prefix of names of all compiled versions of @p ruleFile in @p nameSpace.
+ */
+std::string getCompiledPrefix(
+		const std::string& ruleFile,
+		const std::string& nameSpace)
+{
+	auto base = ruleFile;
+	auto slash = base.find_last_of("/\\");
+	auto dot = base.find_last_of('.');
+	if (dot != std::string::npos
+			&& (slash == std::string::npos || dot > slash))
+	{
+		base.erase(dot);
+	}
+
+	return base + "." + getHash(nameSpace, nameSpaceHashLength) + ".";
+}
+
+/**
+ * Name of compiled rules for @p ruleFile with sources @p key.
+ *
+ * Namespace is compiled into the rules, so it is a part of the name.
+ * It has its own part of the name, so that outdated rules can be told
+ * from the rules of the same file compiled for another namespace.
+ */
+std::string getCompiledName(
+		const std::string& ruleFile,
+		const std::string& key,
+		const std::string& nameSpace)
+{
+	return getCompiledPrefix(ruleFile, nameSpace)
+			+ getHash(key, hashLength) + compiledSuffix;
+}
+
+/**
+ * Remove rules of @p ruleFile in @p nameSpace compiled from older sources
+ * than @p compiledFile.
+ */
+void removeOutdatedFiles(
+		const std::string& ruleFile,
+		const std::string& nameSpace,
+		const std::string& compiledFile)
+{
+	auto prefix = getFileName(getCompiledPrefix(ruleFile, nameSpace));
+	auto directory = getDirectory(ruleFile);
+	utils::FilesystemPath dir(directory.empty() ? "." : directory);
+	if (!dir.isDirectory())
+	{
+		return;
+	}
+
+	auto keep = getFileName(compiledFile);
+	for (const auto* subpath : dir)
+	{
+		auto name = getFileName(subpath->getPath());
+		if (name != keep
+				&& name.size() == prefix.size() + hashLength + compiledSuffix.size()
+				&& utils::startsWith(name, prefix)
+				&& utils::endsWith(name, compiledSuffix)
+				&& isHexString(name, prefix.size(), hashLength)
+				&& subpath->isFile())
+		{
+			std::remove(subpath->getPath().c_str());
+		}
+	}
+}
+
+/**
+ * Compile text rules from @p ruleFile.
+ *
+ * The YARA library must be initialized.
+ *
+ * @return Compiled rules or @c nullptr if they can not be compiled.
+ */
+YR_RULES* compileRules(
+		const std::string& ruleFile,
+		const std::string& nameSpace)
+{
+	YR_COMPILER* compiler = nullptr;
+	YR_RULES* rules = nullptr;
+	FILE* file = nullptr;
+	if (yr_compiler_create(&compiler) == ERROR_SUCCESS
+			&& (file = std::fopen(ruleFile.c_str(), "r")))
+	{
+		auto errors = yr_compiler_add_file(
+				compiler,
+				file,
+				nameSpace.empty() ? nullptr : nameSpace.c_str(),
+				ruleFile.c_str());
+		if (errors != 0
+				|| yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
+		{
+			rules = nullptr;
+		}
+	}
+
+	if (file)
+	{
+		std::fclose(file);
+	}
+	if (compiler)
+	{
+		yr_compiler_destroy(compiler);
+	}
+	return rules;
+}
+
+/**
+ * Compile @p ruleFile into @p outFile.
+ *
+ * Rules are saved under a temporary name first and then renamed, so other
+ * processes working on the same databases never see a partial file.
+ */
+bool compileRuleFile(
+		const std::string& ruleFile,
+		const std::string& nameSpace,
+		const std::string& outFile)
+{
+	{
+		std::lock_guard<std::mutex> lock(getLibraryMutex());
+		if (yr_initialize() != ERROR_SUCCESS)
+		{
+			return false;
+		}
+	}
+
+	bool ok = false;
+	if (auto* rules = compileRules(ruleFile, nameSpace))
+	{
+		std::ostringstream tmp;
+		tmp << outFile << ".tmp."
+			<< std::hash<std::thread::id>()(std::this_thread::get_id())
+			<< "." << std::chrono::steady_clock::now().time_since_epoch().count();
+		const auto tmpFile = tmp.str();
+
+		if (yr_rules_save(rules, tmpFile.c_str()) == ERROR_SUCCESS)
+		{
+			// Rename fails on some systems if the target exists, which
+			// means someone else has stored the very same rules.
+			ok = std::rename(tmpFile.c_str(), outFile.c_str()) == 0
+					|| isFile(outFile);
+		}
+		std::remove(tmpFile.c_str());
+		yr_rules_destroy(rules);
+	}
+
+	std::lock_guard<std::mutex> lock(getLibraryMutex());
+	yr_finalize();
+	return ok;
+}
+
+/**
+ * Drop compiled rules of @p ruleFile that could not be loaded.
+ *
+ * Compiled rules may come from an incompatible YARA version or may be
+ * damaged, so the text rules are used instead.
+ */
+void dropCompiledRuleFile(
+		const std::string& ruleFile,
+		const std::string& nameSpace,
+		const std::string& compiledFile)
+{
+	std::remove(compiledFile.c_str());
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cache.erase(std::make_pair(ruleFile, nameSpace));
+}
+
+/**
+ * Store rule matched by a scan into the vector of matched rules.
+ */
+#if YR_MAJOR_VERSION >= 4
+int scanCallback(
+		YR_SCAN_CONTEXT* context,
+		int message,
+		void* messageData,
+		void* userData)
+#else
+int scanCallback(int message, void* messageData, void* userData)
+#endif
+{
+	if (message != CALLBACK_MSG_RULE_MATCHING)
+	{
+		return CALLBACK_CONTINUE;
+	}
+
+	auto* rule = static_cast<YR_RULE*>(messageData);
+	MatchedRule matched;
+	matched.name = rule->identifier;
+
+	YR_META* meta = nullptr;
+	yr_rule_metas_foreach(rule, meta)
+	{
+		MatchedRule::Meta value;
+		value.id = meta->identifier;
+		if (meta->type == META_TYPE_STRING)
+		{
+			value.stringValue = meta->string;
+		}
+		else
+		{
+			value.intValue = meta->integer;
+		}
+		matched.metas.push_back(std::move(value));
+	}
+
+	YR_STRING* string = nullptr;
+	YR_MATCH* match = nullptr;
+	yr_rule_strings_foreach(rule, string)
+	{
+#if YR_MAJOR_VERSION >= 4
+		yr_string_matches_foreach(context, string, match)
+#else
+		yr_string_matches_foreach(string, match)
+#endif
+		{
+			matched.offsets.push_back(match->base + match->offset);
+		}
+	}
+
+	static_cast<std::vector<MatchedRule>*>(userData)->push_back(
+			std::move(matched));
+	return CALLBACK_CONTINUE;
+}
+
+/**
+ * Detector reused by all scans of one thread with the same rule files.
+ */
+struct ThreadDetector
+{
+	std::unique_ptr<yaracpp::YaraDetector> detector;
+
+	~ThreadDetector()
+	{
+		reset();
+	}
+
+	void reset()
+	{
+		std::lock_guard<std::mutex> lock(getLibraryMutex());
+		detector.reset();
+	}
+};
+
+std::unique_ptr<yaracpp::YaraDetector> createDetector(const RuleFiles& ruleFiles)
+{
+	std::unique_ptr<yaracpp::YaraDetector> detector;
+	{
+		std::lock_guard<std::mutex> lock(getLibraryMutex());
+		detector.reset(new yaracpp::YaraDetector());
+	}
+
+	for (const auto& ruleFile : ruleFiles)
+	{
+		addRuleFile(*detector, ruleFile.first, ruleFile.second);
+	}
+	return detector;
+}
+
+/**
+ * Store pointers to rules from @p rules starting at @p first into @p result.
+ */
+void getRules(
+		const std::vector<yaracpp::YaraRule>& rules,
+		std::size_t first,
+		std::vector<const yaracpp::YaraRule*>& result)
+{
+	result.clear();
+	// Results of previous scans may have been dropped by the detector.
+	for (auto i = first <= rules.size() ? first : 0; i < rules.size(); ++i)
+	{
+		result.push_back(&rules[i]);
+	}
+}
+
+} // anonymous namespace
+
+std::mutex& getLibraryMutex()
+{
+	static std::mutex libraryMutex;
+	return libraryMutex;
+}
+
+std::string getCompiledRuleFile(
+		const std::string& ruleFile,
+		const std::string& nameSpace)
+{
+	if (utils::endsWith(ruleFile, compiledSuffix) || !isFile(ruleFile))
+	{
+		return ruleFile;
+	}
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	auto& entry = cache[std::make_pair(ruleFile, nameSpace)];
+	if (isUpToDate(entry.sources) && isFile(entry.compiledFile))
+	{
+		return entry.compiledFile;
+	}
+
+	std::string key;
+	std::vector<FileStamp> sources;
+	std::set<std::string> visited;
+	if (!readSources(ruleFile, key, sources, visited))
+	{
+		return ruleFile;
+	}
+	key += nameSpace;
+
+	auto compiledFile = getCompiledName(ruleFile, key, nameSpace);
+	if (!isFile(compiledFile))
+	{
+		if (!compileRuleFile(ruleFile, nameSpace, compiledFile))
+		{
+			return ruleFile;
+		}
+		removeOutdatedFiles(ruleFile, nameSpace, compiledFile);
+	}
+
+	entry.sources = sources;
+	entry.compiledFile = compiledFile;
+	return compiledFile;
+}
+
+bool isCachedRuleFile(const std::string& path)
+{
+	if (!utils::endsWith(path, compiledSuffix))
+	{
+		return false;
+	}
+
+	// <name>.<namespace hash>.<hash>.yarac
+	auto end = path.size() - compiledSuffix.size();
+	auto hashStart = end - hashLength;
+	auto nameSpaceStart = hashStart - 1 - nameSpaceHashLength;
+	return end >= hashLength + nameSpaceHashLength + 3
+			&& path[hashStart - 1] == '.'
+			&& path[nameSpaceStart - 1] == '.'
+			&& isHexString(path, hashStart, hashLength)
+			&& isHexString(path, nameSpaceStart, nameSpaceHashLength);
+}
+
+bool addRuleFile(
+		yaracpp::YaraDetector& detector,
+		const std::string& ruleFile,
+		const std::string& nameSpace)
+{
+	auto compiledFile = getCompiledRuleFile(ruleFile, nameSpace);
+	if (compiledFile != ruleFile
+			&& detector.addRuleFile(compiledFile, nameSpace))
+	{
+		return true;
+	}
+
+	if (compiledFile != ruleFile)
+	{
+		dropCompiledRuleFile(ruleFile, nameSpace, compiledFile);
+	}
+	return detector.addRuleFile(ruleFile, nameSpace);
+}
+
+CompiledRules::CompiledRules(
+		const std::string& ruleFile,
+		const std::string& nameSpace)
+{
+	{
+		std::lock_guard<std::mutex> lock(getLibraryMutex());
+		initialized = yr_initialize() == ERROR_SUCCESS;
+	}
+	if (!initialized)
+	{
+		return;
+	}
+
+	YR_RULES* loaded = nullptr;
+	auto compiledFile = getCompiledRuleFile(ruleFile, nameSpace);
+	if (compiledFile != ruleFile
+			&& yr_rules_load(compiledFile.c_str(), &loaded) == ERROR_SUCCESS)
+	{
+		rules = loaded;
+		return;
+	}
+
+	if (compiledFile != ruleFile)
+	{
+		dropCompiledRuleFile(ruleFile, nameSpace, compiledFile);
+	}
+	rules = compileRules(ruleFile, nameSpace);
+}
+
+CompiledRules::~CompiledRules()
+{
+	if (rules)
+	{
+		yr_rules_destroy(static_cast<YR_RULES*>(rules));
+	}
+	if (initialized)
+	{
+		std::lock_guard<std::mutex> lock(getLibraryMutex());
+		yr_finalize();
+	}
+}
+
+bool CompiledRules::isValid() const
+{
+	return rules != nullptr;
+}
+
+bool CompiledRules::scanMemory(
+		const std::uint8_t* data,
+		std::size_t size,
+		std::vector<MatchedRule>& matched) const
+{
+	matched.clear();
+	if (!rules)
+	{
+		return false;
+	}
+
+	return yr_rules_scan_mem(
+			static_cast<YR_RULES*>(rules),
+			data,
+			size,
+			0,
+			scanCallback,
+			&matched,
+			0) == ERROR_SUCCESS;
+}
+
+void scanFile(
+		const RuleFiles& ruleFiles,
+		const std::string& path,
+		std::vector<const yaracpp::YaraRule*>& detected,
+		std::vector<const yaracpp::YaraRule*>* undetected)
+{
+	thread_local std::map<RuleFiles, ThreadDetector> detectors;
+
+	auto& entry = detectors[ruleFiles];
+	if (entry.detector
+			&& entry.detector->getDetectedRules().size()
+				+ entry.detector->getUndetectedRules().size() > maxKeptRules)
+	{
+		entry.reset();
+	}
+	if (!entry.detector)
+	{
+		entry.detector = createDetector(ruleFiles);
+	}
+
+	auto& yara = *entry.detector;
+	const auto detectedStart = yara.getDetectedRules().size();
+	const auto undetectedStart = yara.getUndetectedRules().size();
+	yara.analyze(path, undetected != nullptr);
+
+	getRules(yara.getDetectedRules(), detectedStart, detected);
+	if (undetected)
+	{
+		getRules(yara.getUndetectedRules(), undetectedStart, *undetected);
+	}
+}
+
+void clearCache()
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cache.clear();
+}
+
+} // namespace yara_cache
+} // namespace retdec
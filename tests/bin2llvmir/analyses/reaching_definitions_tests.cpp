@@ -16,10 +16,6 @@ namespace tests {
 
 /**
  * Test reaching definition analysis.
- *
- * Richt now, this is just an example, how to create LLVM Module from string,
- * instead of manually constructing it instruction by instruction.
- * => Nowhing useful is tested at the moment.
  */
 class ReachingDefinitionsTests: public LlvmIrTests
 {
@@ -44,6 +40,123 @@ DummyTest)
 	EXPECT_EQ( nullptr, module->getGlobalVariable("glob1") );
 }
 
+TEST_F(ReachingDefinitionsTests,
+useHasDefinitionsFromAllPredecessors)
+{
+	parseInput(R"(
+		@glob0 = global i32 0
+		define void @func1(i1 %c) {
+		entry:
+			br i1 %c, label %left, label %right
+		left:
+			store i32 1, i32* @glob0
+			br label %end
+		right:
+			store i32 2, i32* @glob0
+			br label %end
+		end:
+			%x = load i32, i32* @glob0
+			store i32 3, i32* @glob0
+			%y = load i32, i32* @glob0
+			ret void
+		}
+	)");
+
+	RDA.runOnModule(*module);
+
+	auto* x = getInstructionByName("x");
+	auto* y = getInstructionByName("y");
+	auto* s3 = y->getPrevNode();
+	EXPECT_EQ(2, RDA.defsFromUse(x).size());
+	ASSERT_EQ(1, RDA.defsFromUse(y).size());
+	EXPECT_EQ(s3, (*RDA.defsFromUse(y).begin())->def);
+	EXPECT_EQ(1, RDA.usesFromDef(s3).size());
+}
+
+TEST_F(ReachingDefinitionsTests,
+definitionInLoopReachesUseAtLoopHeader)
+{
+	parseInput(R"(
+		@glob0 = global i32 0
+		define void @func1(i1 %c) {
+		entry:
+			store i32 0, i32* @glob0
+			br label %loop
+		loop:
+			%x = load i32, i32* @glob0
+			store i32 1, i32* @glob0
+			br i1 %c, label %loop, label %end
+		end:
+			ret void
+		}
+	)");
+
+	RDA.runOnModule(*module);
+
+	auto* x = getInstructionByName("x");
+	EXPECT_EQ(2, RDA.defsFromUse(x).size());
+	EXPECT_EQ(1, RDA.usesFromDef(x->getNextNode()).size());
+}
+
+TEST_F(ReachingDefinitionsTests,
+rerunRecomputesOnlyChangedFunctions)
+{
+	parseInput(R"(
+		@glob0 = global i32 0
+		define void @func1() {
+			store i32 1, i32* @glob0
+			%x = load i32, i32* @glob0
+			ret void
+		}
+		define void @func2() {
+			store i32 2, i32* @glob0
+			%y = load i32, i32* @glob0
+			ret void
+		}
+	)");
+	auto* x = getInstructionByName("x");
+	auto* y = getInstructionByName("y");
+
+	RDA.runOnModule(*module);
+	auto* xDef = RDA.getDef(x->getPrevNode());
+	auto* yDef = RDA.getDef(y->getPrevNode());
+	ASSERT_NE(nullptr, xDef);
+	ASSERT_NE(nullptr, yDef);
+
+	auto* s = new StoreInst(
+			ConstantInt::get(x->getType(), 3),
+			getGlobalByName("glob0"),
+			x);
+
+	RDA.runOnModule(*module);
+
+	EXPECT_EQ(yDef, RDA.getDef(y->getPrevNode()));
+	ASSERT_EQ(1, RDA.defsFromUse(x).size());
+	EXPECT_EQ(s, (*RDA.defsFromUse(x).begin())->def);
+	EXPECT_TRUE(RDA.usesFromDef(s->getPrevNode()).empty());
+}
+
+TEST_F(ReachingDefinitionsTests,
+invalidatedFunctionIsRecomputed)
+{
+	parseInput(R"(
+		@glob0 = global i32 0
+		define void @func1() {
+			store i32 1, i32* @glob0
+			%x = load i32, i32* @glob0
+			ret void
+		}
+	)");
+	auto* x = getInstructionByName("x");
+
+	RDA.runOnModule(*module);
+	RDA.invalidate(getFunctionByName("func1"));
+	RDA.runOnModule(*module);
+
+	ASSERT_EQ(1, RDA.defsFromUse(x).size());
+	EXPECT_EQ(x->getPrevNode(), (*RDA.defsFromUse(x).begin())->def);
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
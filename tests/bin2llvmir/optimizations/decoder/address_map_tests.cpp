@@ -0,0 +1,183 @@
+/**
+* @file tests/bin2llvmir/optimizations/decoder/address_map_tests.cpp
+* @brief Tests for the @c AddressMap class.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "retdec/bin2llvmir/optimizations/decoder/address_map.h"
+
+using namespace ::testing;
+using namespace retdec::utils;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+class AddressMapTests : public Test
+{
+	protected:
+		AddressMap<int> map;
+};
+
+TEST_F(AddressMapTests, EmptyMapFindsNothing)
+{
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(0, map.size());
+	EXPECT_EQ(nullptr, map.at(0x1000));
+	EXPECT_EQ(nullptr, map.after(0x1000));
+	EXPECT_EQ(nullptr, map.beforeOrAt(0x1000));
+}
+
+TEST_F(AddressMapTests, AtFindsOnlyExactAddress)
+{
+	map.insert(0x1000, 1);
+	map.insert(0x2000, 2);
+
+	ASSERT_NE(nullptr, map.at(0x1000));
+	EXPECT_EQ(1, map.at(0x1000)->second);
+	ASSERT_NE(nullptr, map.at(0x2000));
+	EXPECT_EQ(2, map.at(0x2000)->second);
+	EXPECT_EQ(nullptr, map.at(0x1001));
+	EXPECT_EQ(2, map.size());
+}
+
+TEST_F(AddressMapTests, InsertReplacesValueOnExistingAddress)
+{
+	map.insert(0x1000, 1);
+	map.insert(0x1000, 2);
+
+	EXPECT_EQ(1, map.size());
+	EXPECT_EQ(2, map.at(0x1000)->second);
+}
+
+TEST_F(AddressMapTests, AfterAndBeforeOrAtFindNeighbours)
+{
+	map.insert(0x3000, 3);
+	map.insert(0x1000, 1);
+	map.insert(0x2000, 2);
+
+	EXPECT_EQ(nullptr, map.beforeOrAt(0x0fff));
+	EXPECT_EQ(1, map.beforeOrAt(0x1000)->second);
+	EXPECT_EQ(1, map.beforeOrAt(0x1fff)->second);
+	EXPECT_EQ(3, map.beforeOrAt(0x5000)->second);
+
+	EXPECT_EQ(1, map.after(0x0fff)->second);
+	EXPECT_EQ(2, map.after(0x1000)->second);
+	EXPECT_EQ(Address(0x3000), map.after(0x2000)->first);
+	EXPECT_EQ(nullptr, map.after(0x3000));
+}
+
+TEST_F(AddressMapTests, LookupsAreSameAsInStdMapAcrossMerges)
+{
+	std::map<Address, int> ref;
+	for (int i = 0; i < 5000; ++i)
+	{
+		// Scattered addresses, some of them repeated.
+		Address a = (i * 7919) % 3001 * 4;
+		map.insert(a, i);
+		ref[a] = i;
+	}
+
+	EXPECT_EQ(ref.size(), map.size());
+	for (Address a = 0; a < 3001 * 4 + 8; ++a)
+	{
+		auto it = ref.find(a);
+		auto* p = map.at(a);
+		ASSERT_EQ(it != ref.end(), p != nullptr);
+		if (p)
+		{
+			EXPECT_EQ(it->second, p->second);
+		}
+
+		auto after = ref.upper_bound(a);
+		auto* pAfter = map.after(a);
+		ASSERT_EQ(after != ref.end(), pAfter != nullptr);
+		if (pAfter)
+		{
+			EXPECT_EQ(after->first, pAfter->first);
+		}
+
+		auto* pBefore = map.beforeOrAt(a);
+		ASSERT_EQ(after != ref.begin(), pBefore != nullptr);
+		if (pBefore)
+		{
+			EXPECT_EQ(std::prev(after)->first, pBefore->first);
+		}
+	}
+}
+
+/**
+ * Decoder-like workload: random inserts interleaved with before-or-at
+ * lookups (100k entries, 1M lookups), run on both @c AddressMap and
+ * @c std::map. Results must be the same. Both times are printed, so they can
+ * be compared on the machine running the tests. The test fails only if
+ * @c AddressMap is several times slower, e.g. if merging of batches stops
+ * working and inserts become linear.
+ */
+TEST_F(AddressMapTests, InterleavedInsertsAndLookupsScaleLikeStdMap)
+{
+	const std::size_t entries = 100000;
+	const std::size_t lookupsPerInsert = 10;
+
+	std::mt19937_64 gen(42);
+	std::uniform_int_distribution<uint64_t> dist(0, 0xffffff);
+	std::vector<Address> inserts(entries);
+	std::vector<Address> lookups(entries * lookupsPerInsert);
+	for (auto& a : inserts) a = dist(gen);
+	for (auto& a : lookups) a = dist(gen);
+
+	using Clock = std::chrono::steady_clock;
+
+	auto start = Clock::now();
+	uint64_t mapSum = 0;
+	for (std::size_t i = 0; i < entries; ++i)
+	{
+		map.insert(inserts[i], static_cast<int>(i));
+		for (std::size_t j = 0; j < lookupsPerInsert; ++j)
+		{
+			if (auto* p = map.beforeOrAt(lookups[i * lookupsPerInsert + j]))
+			{
+				mapSum += p->second;
+			}
+		}
+	}
+	auto mapTime = Clock::now() - start;
+
+	start = Clock::now();
+	std::map<Address, int> ref;
+	uint64_t refSum = 0;
+	for (std::size_t i = 0; i < entries; ++i)
+	{
+		ref[inserts[i]] = static_cast<int>(i);
+		for (std::size_t j = 0; j < lookupsPerInsert; ++j)
+		{
+			auto it = ref.upper_bound(lookups[i * lookupsPerInsert + j]);
+			if (it != ref.begin())
+			{
+				refSum += std::prev(it)->second;
+			}
+		}
+	}
+	auto refTime = Clock::now() - start;
+
+	using std::chrono::milliseconds;
+	using std::chrono::duration_cast;
+	std::cout << "AddressMap: " << duration_cast<milliseconds>(mapTime).count()
+			<< " ms, std::map: " << duration_cast<milliseconds>(refTime).count()
+			<< " ms" << std::endl;
+
+	EXPECT_EQ(ref.size(), map.size());
+	EXPECT_EQ(refSum, mapSum);
+	EXPECT_LT(mapTime, refTime * 5);
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
@@ -0,0 +1,187 @@
+/**
+* @file tests/bin2llvmir/optimizations/decoder/linear_sweep_tests.cpp
+* @brief Tests for the @c LinearSweepTable class.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+
+#include "retdec/bin2llvmir/optimizations/decoder/linear_sweep.h"
+
+using namespace ::testing;
+using namespace retdec::utils;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+class LinearSweepTableTests : public Test
+{
+	protected:
+		LinearSweepTable table;
+};
+
+TEST_F(LinearSweepTableTests, EmptyTableHasNoEntries)
+{
+	EXPECT_TRUE(table.empty());
+	EXPECT_EQ(0, table.size());
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x1000));
+}
+
+TEST_F(LinearSweepTableTests, ChunkHasEntryForEveryAddress)
+{
+	table.addChunk(CS_MODE_32, AddressRange(0x1000, 0x1010), 1);
+
+	EXPECT_FALSE(table.empty());
+	EXPECT_EQ(0x10, table.size());
+	for (Address a = 0x1000; a < 0x1010; ++a)
+	{
+		auto* insn = table.get(CS_MODE_32, a);
+		ASSERT_NE(nullptr, insn) << a;
+		EXPECT_FALSE(insn->isKnown());
+	}
+}
+
+TEST_F(LinearSweepTableTests, EntriesAreDistinctAndKeepTheirValues)
+{
+	table.addChunk(CS_MODE_32, AddressRange(0x1000, 0x1010), 1);
+
+	table.get(CS_MODE_32, 0x1000)->size = 3;
+	table.get(CS_MODE_32, 0x1000)->flags = LinearSweepTable::KNOWN;
+
+	auto* insn = table.get(CS_MODE_32, 0x1000);
+	ASSERT_NE(nullptr, insn);
+	EXPECT_TRUE(insn->isKnown());
+	EXPECT_EQ(3, insn->size);
+	EXPECT_FALSE(table.get(CS_MODE_32, 0x1001)->isKnown());
+}
+
+TEST_F(LinearSweepTableTests, AddressOutsideEveryChunkHasNoEntry)
+{
+	table.addChunk(CS_MODE_32, AddressRange(0x1000, 0x1010), 1);
+	table.addChunk(CS_MODE_32, AddressRange(0x2000, 0x2010), 1);
+
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x0));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0xfff));
+	EXPECT_NE(nullptr, table.get(CS_MODE_32, 0x100f));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x1010));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x1800));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x1fff));
+	EXPECT_NE(nullptr, table.get(CS_MODE_32, 0x2000));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x2010));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0xffffffff));
+}
+
+TEST_F(LinearSweepTableTests, ChunkOfOtherModeIsNotUsed)
+{
+	table.addChunk(CS_MODE_ARM, AddressRange(0x1000, 0x1010), 4);
+
+	EXPECT_NE(nullptr, table.get(CS_MODE_ARM, 0x1000));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_THUMB, 0x1000));
+
+	// The same range in another mode has its own entries.
+	table.addChunk(CS_MODE_THUMB, AddressRange(0x1000, 0x1010), 2);
+	EXPECT_EQ(4 + 8, table.size());
+	ASSERT_NE(nullptr, table.get(CS_MODE_THUMB, 0x1000));
+	EXPECT_NE(table.get(CS_MODE_ARM, 0x1000), table.get(CS_MODE_THUMB, 0x1000));
+	EXPECT_NE(nullptr, table.get(CS_MODE_THUMB, 0x1002));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1002));
+}
+
+TEST_F(LinearSweepTableTests, OnlyAlignedAddressesHaveEntries)
+{
+	table.addChunk(CS_MODE_ARM, AddressRange(0x1000, 0x1010), 4);
+
+	EXPECT_EQ(4, table.size());
+	EXPECT_NE(nullptr, table.get(CS_MODE_ARM, 0x1000));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1001));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1002));
+	EXPECT_NE(nullptr, table.get(CS_MODE_ARM, 0x100c));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x100e));
+}
+
+TEST_F(LinearSweepTableTests, UnalignedRangeStartsOnAlignedAddress)
+{
+	table.addChunk(CS_MODE_ARM, AddressRange(0x1002, 0x1012), 4);
+
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1002));
+	EXPECT_NE(nullptr, table.get(CS_MODE_ARM, 0x1004));
+	EXPECT_NE(nullptr, table.get(CS_MODE_ARM, 0x1010));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1014));
+	EXPECT_EQ(4, table.size());
+}
+
+TEST_F(LinearSweepTableTests, RangeSmallerThanAlignmentHasNoEntry)
+{
+	table.addChunk(CS_MODE_ARM, AddressRange(0x1001, 0x1003), 4);
+
+	EXPECT_TRUE(table.empty());
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1000));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1004));
+}
+
+TEST_F(LinearSweepTableTests, ZeroAlignmentIsTheSameAsOne)
+{
+	table.addChunk(CS_MODE_32, AddressRange(0x1000, 0x1004), 0);
+
+	EXPECT_EQ(4, table.size());
+	EXPECT_NE(nullptr, table.get(CS_MODE_32, 0x1003));
+}
+
+TEST_F(LinearSweepTableTests, OverlappingChunkAddsOnlyUncoveredAddresses)
+{
+	table.addChunk(CS_MODE_32, AddressRange(0x1000, 0x1010), 1);
+	auto* first = table.get(CS_MODE_32, 0x1008);
+	first->flags = LinearSweepTable::KNOWN;
+
+	table.addChunk(CS_MODE_32, AddressRange(0x1008, 0x1020), 1);
+
+	EXPECT_EQ(0x20, table.size());
+	EXPECT_EQ(first, table.get(CS_MODE_32, 0x1008));
+	EXPECT_TRUE(table.get(CS_MODE_32, 0x1008)->isKnown());
+	EXPECT_NE(nullptr, table.get(CS_MODE_32, 0x1010));
+	EXPECT_NE(nullptr, table.get(CS_MODE_32, 0x101f));
+
+	// Range in front of an existing chunk.
+	table.addChunk(CS_MODE_32, AddressRange(0xff8, 0x1004), 1);
+	EXPECT_EQ(0x28, table.size());
+	EXPECT_NE(nullptr, table.get(CS_MODE_32, 0xff8));
+	EXPECT_EQ(first, table.get(CS_MODE_32, 0x1008));
+
+	// Range inside of an existing chunk.
+	table.addChunk(CS_MODE_32, AddressRange(0x1002, 0x1006), 1);
+	EXPECT_EQ(0x28, table.size());
+}
+
+TEST_F(LinearSweepTableTests, RangeOverSeveralChunksFillsAllGaps)
+{
+	table.addChunk(CS_MODE_32, AddressRange(0x1010, 0x1020), 1);
+	table.addChunk(CS_MODE_32, AddressRange(0x1030, 0x1040), 1);
+	auto* inside = table.get(CS_MODE_32, 0x1030);
+
+	table.addChunk(CS_MODE_32, AddressRange(0x1000, 0x1050), 1);
+
+	EXPECT_EQ(0x50, table.size());
+	for (Address a = 0x1000; a < 0x1050; ++a)
+	{
+		EXPECT_NE(nullptr, table.get(CS_MODE_32, a)) << a;
+	}
+	EXPECT_EQ(inside, table.get(CS_MODE_32, 0x1030));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x1050));
+}
+
+TEST_F(LinearSweepTableTests, ClearRemovesAllChunks)
+{
+	table.addChunk(CS_MODE_32, AddressRange(0x1000, 0x1010), 1);
+	table.addChunk(CS_MODE_ARM, AddressRange(0x1000, 0x1010), 4);
+
+	table.clear();
+
+	EXPECT_TRUE(table.empty());
+	EXPECT_EQ(nullptr, table.get(CS_MODE_32, 0x1000));
+	EXPECT_EQ(nullptr, table.get(CS_MODE_ARM, 0x1000));
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
@@ -0,0 +1,203 @@
+/**
+* @file tests/bin2llvmir/optimizations/fixpoint/fixpoint_tests.cpp
+* @brief Tests for the @c FixpointPassGroup pass.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/GlobalVariable.h>
+
+#include "retdec/bin2llvmir/optimizations/fixpoint/fixpoint.h"
+#include "bin2llvmir/utils/llvmir_tests.h"
+
+using namespace ::testing;
+using namespace llvm;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * Adds a global variable in each of its first @c changes runs.
+ */
+class AddGlobalPass : public ModulePass
+{
+	public:
+		static char ID;
+		AddGlobalPass(unsigned* runs, unsigned changes, bool reportChange) :
+				ModulePass(ID),
+				_runs(runs),
+				_changes(changes),
+				_reportChange(reportChange)
+		{
+
+		}
+
+		bool runOnModule(Module& M) override
+		{
+			if ((*_runs)++ < _changes)
+			{
+				new GlobalVariable(
+						M,
+						Type::getInt32Ty(M.getContext()),
+						false,
+						GlobalValue::ExternalLinkage,
+						nullptr,
+						"g");
+			}
+			return _reportChange;
+		}
+
+	private:
+		unsigned* _runs = nullptr;
+		unsigned _changes = 0;
+		bool _reportChange = true;
+};
+
+char AddGlobalPass::ID = 0;
+
+/**
+ * @brief Tests for the @c FixpointPassGroup pass.
+ */
+class FixpointPassGroupTests: public LlvmIrTests
+{
+	protected:
+		bool runGroup(
+				unsigned changes,
+				unsigned maxIterations,
+				bool reportChange = true)
+		{
+			FixpointPassGroup group(
+					TargetLibraryInfoImpl(Triple(module->getTargetTriple())),
+					maxIterations);
+			group.getPassManager().add(
+					new AddGlobalPass(&runs, changes, reportChange));
+			bool changed = group.runOnModule(*module);
+			iterations = group.getNumOfIterations();
+			return changed;
+		}
+
+	protected:
+		unsigned runs = 0;
+		unsigned iterations = 0;
+};
+
+TEST_F(FixpointPassGroupTests, groupIsRunAgainWhileItChangesModule)
+{
+	bool changed = runGroup(2, 5);
+
+	EXPECT_TRUE(changed);
+	EXPECT_EQ(3, iterations);
+	EXPECT_EQ(3, runs);
+	EXPECT_EQ(2, module->global_size());
+}
+
+TEST_F(FixpointPassGroupTests, groupIsRunAtMostMaxIterationsTimes)
+{
+	runGroup(10, 2);
+
+	EXPECT_EQ(2, iterations);
+	EXPECT_EQ(2, runs);
+}
+
+TEST_F(FixpointPassGroupTests, groupIsNotRunAgainIfFingerprintIsSame)
+{
+	// The pass reports a change, but it does not change anything.
+	runGroup(0, 5);
+
+	EXPECT_EQ(1, iterations);
+}
+
+TEST_F(FixpointPassGroupTests, groupIsNotRunAgainIfNoChangeIsReported)
+{
+	bool changed = runGroup(3, 5, false);
+
+	EXPECT_FALSE(changed);
+	EXPECT_EQ(1, iterations);
+}
+
+TEST_F(FixpointPassGroupTests, fingerprintChangesWhenOperandIsReplaced)
+{
+	parseInput(R"(
+		@g = global i32 0
+		define i32 @fnc() {
+			%a = load i32, i32* @g
+			%b = add i32 %a, 1
+			ret i32 %b
+		}
+	)");
+	auto* b = llvm::cast<Instruction>(getValueByName("b"));
+	auto before = FixpointPassGroup::getFingerprint(*module);
+
+	b->setOperand(1, ConstantInt::get(b->getType(), 2));
+
+	EXPECT_NE(before, FixpointPassGroup::getFingerprint(*module));
+}
+
+TEST_F(FixpointPassGroupTests, fingerprintChangesWhenPredicateIsChanged)
+{
+	parseInput(R"(
+		define i1 @fnc(i32 %a) {
+			%b = icmp slt i32 %a, 1
+			ret i1 %b
+		}
+	)");
+	auto* b = llvm::cast<CmpInst>(getValueByName("b"));
+	auto before = FixpointPassGroup::getFingerprint(*module);
+
+	b->setPredicate(CmpInst::ICMP_ULT);
+
+	EXPECT_NE(before, FixpointPassGroup::getFingerprint(*module));
+}
+
+TEST_F(FixpointPassGroupTests, fingerprintChangesWhenFlagIsChanged)
+{
+	parseInput(R"(
+		define i32 @fnc(i32 %a) {
+			%b = add i32 %a, 1
+			ret i32 %b
+		}
+	)");
+	auto* b = llvm::cast<Instruction>(getValueByName("b"));
+	auto before = FixpointPassGroup::getFingerprint(*module);
+
+	b->setHasNoSignedWrap(true);
+
+	EXPECT_NE(before, FixpointPassGroup::getFingerprint(*module));
+}
+
+TEST_F(FixpointPassGroupTests, fingerprintChangesWhenTypeIsChanged)
+{
+	parseInput(R"(
+		@g = global i32 0
+		define void @fnc() {
+			%a = bitcast i32* @g to i8*
+			ret void
+		}
+	)");
+	auto* a = llvm::cast<Instruction>(getValueByName("a"));
+	auto before = FixpointPassGroup::getFingerprint(*module);
+
+	a->mutateType(Type::getInt16PtrTy(context));
+
+	EXPECT_NE(before, FixpointPassGroup::getFingerprint(*module));
+}
+
+TEST_F(FixpointPassGroupTests, fingerprintIsSameForUnchangedModule)
+{
+	parseInput(R"(
+		define i1 @fnc(i32 %a) {
+			%b = add nsw i32 %a, 1
+			%c = icmp eq i32 %b, 0
+			ret i1 %c
+		}
+	)");
+
+	EXPECT_EQ(
+			FixpointPassGroup::getFingerprint(*module),
+			FixpointPassGroup::getFingerprint(*module));
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
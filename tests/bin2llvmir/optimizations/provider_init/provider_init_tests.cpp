@@ -0,0 +1,163 @@
+/**
+* @file tests/bin2llvmir/optimizations/provider_init/provider_init_tests.cpp
+* @brief Tests for the @c clearProviders() and concurrent use of providers.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
+#include "retdec/bin2llvmir/providers/abi/abi.h"
+#include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/providers/demangler.h"
+#include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/bin2llvmir/providers/names.h"
+#include "bin2llvmir/utils/llvmir_tests.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+
+using namespace ::testing;
+using namespace llvm;
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * @brief Tests for the @c clearProviders().
+ */
+class ProviderInitTests: public LlvmIrTests
+{
+	protected:
+		struct ModuleProviders
+		{
+			Config* config = nullptr;
+			Abi* abi = nullptr;
+			FileImage* image = nullptr;
+			NameContainer* names = nullptr;
+		};
+
+		/**
+		 * Add config, ABI, file image and names for @a m, the same way
+		 * @c ProviderInitialization does it.
+		 */
+		static ModuleProviders addProviders(Module* m, std::size_t i)
+		{
+			ModuleProviders r;
+			r.config = ConfigProvider::addConfigJsonString(m, "{}");
+			r.config->getConfig().architecture.setIsX86();
+			r.config->getConfig().architecture.setBitSize(32);
+
+			r.abi = AbiProvider::addAbi(m, r.config);
+
+			std::stringstream emptySs;
+			std::shared_ptr<FileFormat> format =
+					std::make_unique<RawDataFormat>(emptySs);
+			r.image = FileImageProvider::addFileImage(m, format, r.config);
+
+			auto* d = DemanglerProvider::addDemangler(
+					m,
+					r.config->getConfig().tools);
+			r.names = NamesProvider::addNames(
+					m,
+					r.config,
+					nullptr,
+					r.image,
+					d,
+					nullptr);
+			r.names->addNameForAddress(
+					0x1000,
+					"fnc_" + std::to_string(i),
+					Name::eType::CONFIG_FUNCTION);
+			return r;
+		}
+
+		static bool hasProviders(Module* m)
+		{
+			return ConfigProvider::getConfig(m)
+					|| AbiProvider::getAbi(m)
+					|| FileImageProvider::getFileImage(m)
+					|| NamesProvider::getNames(m);
+		}
+};
+
+TEST_F(ProviderInitTests, clearProvidersRemovesOnlyDataOfTheGivenModule)
+{
+	LLVMContext otherContext;
+	Module other("other", otherContext);
+	addProviders(module.get(), 0);
+	addProviders(&other, 1);
+
+	clearProviders(module.get());
+
+	EXPECT_FALSE(hasProviders(module.get()));
+	EXPECT_NE(nullptr, ConfigProvider::getConfig(&other));
+	EXPECT_NE(nullptr, AbiProvider::getAbi(&other));
+	EXPECT_NE(nullptr, FileImageProvider::getFileImage(&other));
+	EXPECT_NE(nullptr, NamesProvider::getNames(&other));
+
+	clearProviders(&other);
+	EXPECT_FALSE(hasProviders(&other));
+}
+
+TEST_F(ProviderInitTests, providersOfModulesInDifferentThreadsAreIndependent)
+{
+	const std::size_t threadCount = 8;
+	std::vector<std::unique_ptr<LLVMContext>> contexts;
+	std::vector<std::unique_ptr<Module>> modules;
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		contexts.emplace_back(std::make_unique<LLVMContext>());
+		modules.emplace_back(std::make_unique<Module>(
+				"m" + std::to_string(i),
+				*contexts.back()));
+	}
+
+	std::vector<ModuleProviders> added(threadCount);
+	std::vector<ModuleProviders> got(threadCount);
+	std::vector<std::string> names(threadCount);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		threads.emplace_back([&, i] ()
+		{
+			auto* m = modules[i].get();
+			added[i] = addProviders(m, i);
+			got[i].config = ConfigProvider::getConfig(m);
+			got[i].abi = AbiProvider::getAbi(m);
+			got[i].image = FileImageProvider::getFileImage(m);
+			got[i].names = NamesProvider::getNames(m);
+			if (got[i].names)
+			{
+				names[i] = got[i].names->getPreferredNameForAddress(
+						0x1000).getName();
+			}
+		});
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		EXPECT_NE(nullptr, added[i].config);
+		EXPECT_NE(nullptr, added[i].abi);
+		EXPECT_NE(nullptr, added[i].image);
+		EXPECT_NE(nullptr, added[i].names);
+		EXPECT_EQ(added[i].config, got[i].config);
+		EXPECT_EQ(added[i].abi, got[i].abi);
+		EXPECT_EQ(added[i].image, got[i].image);
+		EXPECT_EQ(added[i].names, got[i].names);
+		EXPECT_EQ(added[i].config, added[i].abi->getConfig());
+		EXPECT_EQ("fnc_" + std::to_string(i), names[i]);
+		clearProviders(modules[i].get());
+		EXPECT_FALSE(hasProviders(modules[i].get()));
+	}
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
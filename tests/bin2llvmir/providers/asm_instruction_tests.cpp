@@ -4,6 +4,8 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
@@ -1706,6 +1708,155 @@ TEST_F(AsmInstructionTests, getInstructionFirstReturnsNullptrIfItDoesNotContainI
 	EXPECT_EQ(nullptr, ai.getInstructionFirst<llvm::CallInst>());
 }
 
+//
+// CapstoneInsnStore
+//
+
+class CapstoneInsnStoreTests: public Test
+{
+	protected:
+		/// Decode x86 instruction @p bytes at @p addr in @p mode and insert
+		/// it into @c store.
+		void insertX86(
+				const std::vector<uint8_t>& bytes,
+				uint64_t addr,
+				cs_mode mode = CS_MODE_32,
+				bool nop = false)
+		{
+			csh handle = 0;
+			ASSERT_EQ(CS_ERR_OK, cs_open(CS_ARCH_X86, mode, &handle));
+			cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+			cs_insn* insn = cs_malloc(handle);
+			const uint8_t* code = bytes.data();
+			std::size_t size = bytes.size();
+			ASSERT_TRUE(cs_disasm_iter(handle, &code, &size, &addr, insn));
+			store.insert(insn, CS_ARCH_X86, mode, nop);
+
+			cs_free(insn, 1);
+			cs_close(&handle);
+		}
+
+	protected:
+		CapstoneInsnStore store;
+};
+
+TEST_F(CapstoneInsnStoreTests, compactInformationIsKept)
+{
+	insertX86({0x55}, 0x1000);
+
+	EXPECT_EQ(1, store.size());
+	EXPECT_TRUE(store.contains(0x1000));
+	EXPECT_EQ(X86_INS_PUSH, store.getId(0x1000));
+	EXPECT_EQ(1, store.getByteSize(0x1000));
+	EXPECT_EQ("push ebp", store.getDsm(0x1000));
+}
+
+TEST_F(CapstoneInsnStoreTests, fullInstructionIsDisassembledAgain)
+{
+	insertX86({0xb8, 0x01, 0x00, 0x00, 0x00}, 0x1000);
+
+	auto insn = store.getCapstoneInsn(0x1000);
+
+	ASSERT_NE(nullptr, insn);
+	EXPECT_EQ(X86_INS_MOV, insn->id);
+	EXPECT_EQ(0x1000, insn->address);
+	EXPECT_EQ(5, insn->size);
+	ASSERT_NE(nullptr, insn->detail);
+	EXPECT_EQ(2, insn->detail->x86.op_count);
+	EXPECT_EQ(X86_OP_IMM, insn->detail->x86.operands[1].type);
+	EXPECT_EQ(1, insn->detail->x86.operands[1].imm);
+}
+
+TEST_F(CapstoneInsnStoreTests, unknownAddressIsNotFound)
+{
+	insertX86({0x55}, 0x1000);
+
+	EXPECT_FALSE(store.contains(0x1001));
+	EXPECT_EQ(0, store.getId(0x1001));
+	EXPECT_EQ(nullptr, store.getCapstoneInsn(0x1001));
+}
+
+TEST_F(CapstoneInsnStoreTests, returnedInstructionsAreOwnedByCaller)
+{
+	insertX86({0x55}, 0x1000);
+	insertX86({0xb8, 0x01, 0x00, 0x00, 0x00}, 0x1001);
+
+	std::vector<CapstoneInsnPtr> insns;
+	for (int i = 0; i < 8; ++i)
+	{
+		insns.push_back(store.getCapstoneInsn(i % 2 ? 0x1001 : 0x1000));
+	}
+	store.clear();
+
+	for (int i = 0; i < 8; ++i)
+	{
+		ASSERT_NE(nullptr, insns[i]);
+		EXPECT_EQ(i % 2 ? X86_INS_MOV : X86_INS_PUSH, insns[i]->id);
+		EXPECT_EQ(i % 2 ? 0x1001 : 0x1000, insns[i]->address);
+	}
+}
+
+TEST_F(CapstoneInsnStoreTests, nopFlagIsKept)
+{
+	insertX86({0x90}, 0x1000, CS_MODE_32, true);
+	insertX86({0x55}, 0x1001);
+
+	EXPECT_TRUE(store.isNop(0x1000));
+	EXPECT_FALSE(store.isNop(0x1001));
+	EXPECT_FALSE(store.isNop(0x1002));
+}
+
+TEST_F(CapstoneInsnStoreTests, instructionsAreKeptForEachMode)
+{
+	// 32-bit: inc eax; 64-bit: REX prefix of push rbp.
+	insertX86({0x40, 0x55}, 0x1000, CS_MODE_32);
+	insertX86({0x40, 0x55}, 0x1000, CS_MODE_64);
+
+	EXPECT_EQ(2, store.size());
+	EXPECT_TRUE(store.contains(0x1000, CS_MODE_32));
+	EXPECT_TRUE(store.contains(0x1000, CS_MODE_64));
+	EXPECT_FALSE(store.contains(0x1000, CS_MODE_16));
+
+	// The last inserted one is used if no mode is given.
+	EXPECT_EQ(X86_INS_PUSH, store.getId(0x1000));
+	EXPECT_EQ(2, store.getByteSize(0x1000));
+
+	auto insn32 = store.getCapstoneInsn(0x1000, CS_MODE_32);
+	ASSERT_NE(nullptr, insn32);
+	EXPECT_EQ(X86_INS_INC, insn32->id);
+	EXPECT_EQ(1, insn32->size);
+	auto insn64 = store.getCapstoneInsn(0x1000, CS_MODE_64);
+	ASSERT_NE(nullptr, insn64);
+	EXPECT_EQ(X86_INS_PUSH, insn64->id);
+	EXPECT_EQ(nullptr, store.getCapstoneInsn(0x1000, CS_MODE_16));
+}
+
+TEST_F(CapstoneInsnStoreTests, instructionInTheSameModeIsReplaced)
+{
+	insertX86({0x40, 0x55}, 0x1000, CS_MODE_32);
+	insertX86({0x40, 0x55}, 0x1000, CS_MODE_64);
+	insertX86({0x55}, 0x1000, CS_MODE_32);
+
+	EXPECT_EQ(2, store.size());
+	EXPECT_EQ(X86_INS_PUSH, store.getId(0x1000));
+	EXPECT_EQ(1, store.getByteSize(0x1000));
+
+	auto insn64 = store.getCapstoneInsn(0x1000, CS_MODE_64);
+	ASSERT_NE(nullptr, insn64);
+	EXPECT_EQ(2, insn64->size);
+}
+
+TEST_F(CapstoneInsnStoreTests, clearRemovesAllInstructions)
+{
+	insertX86({0x55}, 0x1000);
+
+	store.clear();
+
+	EXPECT_EQ(0, store.size());
+	EXPECT_FALSE(store.contains(0x1000));
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
@@ -4,6 +4,9 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <thread>
+#include <vector>
+
 #include "retdec/bin2llvmir/providers/config.h"
 #include "bin2llvmir/utils/llvmir_tests.h"
 
@@ -650,6 +653,56 @@ TEST_F(ConfigProviderTests, clearRemovesAllData)
 	EXPECT_EQ(nullptr, r2);
 }
 
+TEST_F(ConfigProviderTests, clearOfModuleRemovesOnlyItsData)
+{
+	Module other("other", context);
+	ConfigProvider::addConfigJsonString(module.get(), "{}");
+	ConfigProvider::addConfigJsonString(&other, "{}");
+
+	ConfigProvider::clear(module.get());
+
+	EXPECT_EQ(nullptr, ConfigProvider::getConfig(module.get()));
+	EXPECT_NE(nullptr, ConfigProvider::getConfig(&other));
+}
+
+TEST_F(ConfigProviderTests, configsOfModulesInDifferentThreadsAreIndependent)
+{
+	const std::size_t threadCount = 8;
+	std::vector<std::unique_ptr<LLVMContext>> contexts;
+	std::vector<std::unique_ptr<Module>> modules;
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		contexts.emplace_back(std::make_unique<LLVMContext>());
+		modules.emplace_back(std::make_unique<Module>(
+				"m" + std::to_string(i),
+				*contexts.back()));
+	}
+
+	std::vector<Config*> added(threadCount, nullptr);
+	std::vector<Config*> got(threadCount, nullptr);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		threads.emplace_back([&, i] ()
+		{
+			auto* m = modules[i].get();
+			added[i] = ConfigProvider::addConfigJsonString(m, "{}");
+			got[i] = ConfigProvider::getConfig(m);
+		});
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		EXPECT_NE(nullptr, added[i]);
+		EXPECT_EQ(added[i], got[i]);
+		ConfigProvider::clear(modules[i].get());
+	}
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
@@ -75,6 +75,17 @@ TEST_F(BaseSequentialContainerTests, SequentialGetElementByIdWorks)
 	EXPECT_EQ(obj4, *objs.getElementById(obj4.getName()));
 }
 
+TEST_F(BaseSequentialContainerTests, SequentialIndexingWorks)
+{
+	EXPECT_EQ(obj1, objs[0]);
+	EXPECT_EQ(obj2, objs[1]);
+	EXPECT_EQ(obj3, objs[2]);
+	EXPECT_EQ(obj4, objs[3]);
+
+	const auto& cobjs = objs;
+	EXPECT_EQ(obj4, cobjs[3]);
+}
+
 TEST_F(BaseSequentialContainerTests, SequentialInsertWorks)
 {
 	// This object is unique -> must be added.
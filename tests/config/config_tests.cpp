@@ -4,6 +4,8 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <cstdio>
+
 #include <gtest/gtest.h>
 
 #include "retdec/config/config.h"
@@ -80,6 +82,87 @@ TEST_F(ConfigTests, ClassesGetElementByIdReturnsNullPointerWhenThereIsNoSuchClas
 	ASSERT_EQ(nullptr, config.classes.getElementById("ClassName"));
 }
 
+TEST_F(ConfigTests, BinaryStringRoundTripKeepsConfigData)
+{
+	config.setInputFile("/input/file");
+	config.setEntryPoint(0x1000);
+	config.parameters.abiPaths.insert("/abi/path");
+	Function fnc("fnc");
+	fnc.setStartEnd(0x1000, 0x1100);
+	fnc.setRealName("real");
+	fnc.locals.insert(Object("local", Storage::onStack(-20)));
+	config.functions.insert(fnc);
+	config.globals.insert(Object("global", Storage::inMemory(0x2000)));
+
+	auto binary = config.generateBinaryString();
+	ASSERT_TRUE(Config::isBinaryString(binary));
+
+	Config read;
+	ASSERT_NO_THROW(read.readBinaryString(binary));
+
+	EXPECT_TRUE(read.isBinary());
+	EXPECT_EQ("/input/file", read.getInputFile());
+	EXPECT_EQ(0x1000, read.getEntryPoint());
+	EXPECT_EQ(config.parameters.abiPaths, read.parameters.abiPaths);
+	auto* f = read.functions.getFunctionByStartAddress(0x1000);
+	ASSERT_NE(nullptr, f);
+	EXPECT_EQ("real", f->getRealName());
+	EXPECT_EQ(0x1100, f->getEnd());
+	auto* l = f->locals.getObjectByName("local");
+	ASSERT_NE(nullptr, l);
+	EXPECT_EQ(-20, l->getStorage().getStackOffset());
+	EXPECT_NE(nullptr, read.globals.getObjectByAddress(0x2000));
+}
+
+TEST_F(ConfigTests, JsonStringIsNotBinaryString)
+{
+	EXPECT_FALSE(Config::isBinaryString(config.generateJsonString()));
+}
+
+TEST_F(ConfigTests, ParsingBadBinaryInputThrowsAnException)
+{
+	auto binary = config.generateBinaryString();
+
+	ASSERT_THROW(config.readBinaryString("{}"), ParseException);
+	ASSERT_THROW(config.readBinaryString(binary.substr(0, binary.size() - 1)), ParseException);
+	ASSERT_THROW(config.readBinaryString(binary + "x"), ParseException);
+}
+
+TEST_F(ConfigTests, GenerateBinaryFileUsesConfigBinExtensionByDefault)
+{
+	config.setInputFile("config_tests_input");
+
+	auto path = config.generateBinaryFile("");
+
+	EXPECT_EQ("config_tests_input.config.bin", path);
+	Config read;
+	ASSERT_NO_THROW(read.readFile(path));
+	EXPECT_TRUE(read.isBinary());
+
+	std::remove(path.c_str());
+}
+
+TEST_F(ConfigTests, ReadFileDetectsFormatAndGenerateFileKeepsIt)
+{
+	std::string path = "config_tests_binary_config.json";
+	config.setInputFile("/input/file");
+	config.generateBinaryFile(path);
+
+	Config read;
+	ASSERT_NO_THROW(read.readFile(path));
+	EXPECT_TRUE(read.isBinary());
+	EXPECT_EQ("/input/file", read.getInputFile());
+	EXPECT_EQ(path, read.getConfigFileName());
+
+	read.setIsBinary(false);
+	read.generateFile(path);
+	ASSERT_NO_THROW(read.readFile(path));
+	EXPECT_FALSE(read.isBinary());
+	EXPECT_EQ("/input/file", read.getInputFile());
+
+	std::remove(path.c_str());
+}
+
 } // namespace tests
 } // namespace config
 } // namespace retdec
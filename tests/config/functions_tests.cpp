@@ -4,6 +4,8 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include "retdec/config/functions.h"
@@ -90,6 +92,135 @@ TEST_F(FunctionContainerTests, TestGetFunctionByStartAddress)
 	ASSERT_TRUE(n == nullptr);
 }
 
+TEST_F(FunctionContainerTests, TestGetFunctionByRealName)
+{
+	Function fnc5("fnc5");
+	fnc5.setRealName("real");
+	funcs.insert(fnc5);
+
+	// found
+	auto* f = funcs.getFunctionByRealName("real");
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( fnc5.getName(), f->getName() );
+
+	// not found
+	auto* n = funcs.getFunctionByRealName("unreal");
+	ASSERT_TRUE(n == nullptr);
+}
+
+TEST_F(FunctionContainerTests, GetFunctionByStartAddressReturnsFunctionWithLowestName)
+{
+	Function fnc0("fnc0");
+	fnc0.setStart(fnc4.getStart());
+	funcs.insert(fnc0);
+
+	auto* f = funcs.getFunctionByStartAddress(fnc4.getStart());
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( fnc0.getName(), f->getName() );
+}
+
+TEST_F(FunctionContainerTests, ReinsertedFunctionIsFoundByNewStartAddress)
+{
+	fnc2.setStart(0x5000);
+	funcs.insert(fnc2);
+
+	EXPECT_EQ( 4, funcs.size() );
+	EXPECT_TRUE(funcs.getFunctionByStartAddress(0x2000) == nullptr);
+	auto* f = funcs.getFunctionByStartAddress(0x5000);
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( fnc2.getName(), f->getName() );
+}
+
+TEST_F(FunctionContainerTests, ErasedFunctionIsNotFoundByStartAddress)
+{
+	EXPECT_EQ( 1, funcs.erase(fnc3.getName()) );
+	EXPECT_EQ( 0, funcs.erase(fnc3.getName()) );
+
+	EXPECT_TRUE(funcs.getFunctionByStartAddress(fnc3.getStart()) == nullptr);
+}
+
+TEST_F(FunctionContainerTests, FunctionModifiedInPlaceIsNotFoundByOldStartAddress)
+{
+	funcs.getFunctionByName(fnc1.getName())->setStart(0x6000);
+
+	EXPECT_TRUE(funcs.getFunctionByStartAddress(fnc1.getStart()) == nullptr);
+}
+
+TEST_F(FunctionContainerTests, SetFunctionStartEndUpdatesStartAddressIndex)
+{
+	auto* f = funcs.setFunctionStartEnd(fnc1.getName(), 0x6000, 0x6010);
+
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( retdec::utils::Address(0x6010), f->getEnd() );
+	EXPECT_TRUE(funcs.getFunctionByStartAddress(0x1000) == nullptr);
+	EXPECT_EQ( f, funcs.getFunctionByStartAddress(0x6000) );
+}
+
+TEST_F(FunctionContainerTests, SetFunctionRealNameUpdatesRealNameIndex)
+{
+	funcs.setFunctionRealName(fnc1.getName(), "old");
+	auto* f = funcs.setFunctionRealName(fnc1.getName(), "new");
+
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_TRUE(funcs.getFunctionByRealName("old") == nullptr);
+	EXPECT_EQ( f, funcs.getFunctionByRealName("new") );
+}
+
+TEST_F(FunctionContainerTests, SettersReturnNullptrForUnknownFunction)
+{
+	EXPECT_TRUE(funcs.setFunctionStartEnd("unknown", 0x1, 0x2) == nullptr);
+	EXPECT_TRUE(funcs.setFunctionRealName("unknown", "real") == nullptr);
+}
+
+/**
+ * Lookups in a container with many functions. Scanning all the functions for
+ * each lookup (as done before indexes were added) makes this test run for
+ * minutes, indexes make it finish in a fraction of a second.
+ */
+TEST_F(FunctionContainerTests, LookupsInManyFunctionsAreFast)
+{
+	const std::size_t n = 100000;
+	FunctionContainer many;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		Function f("f" + std::to_string(i));
+		f.setStart(0x10000 + i * 0x10);
+		f.setRealName("real_f" + std::to_string(i));
+		many.insert(f);
+	}
+
+	std::size_t found = 0;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		auto* byAddr = many.getFunctionByStartAddress(0x10000 + i * 0x10);
+		auto* byName = many.getFunctionByRealName("real_f" + std::to_string(i));
+		if (byAddr && byAddr == byName)
+		{
+			++found;
+		}
+	}
+	EXPECT_EQ( n, found );
+	EXPECT_TRUE(many.getFunctionByStartAddress(0x8) == nullptr);
+}
+
+TEST_F(FunctionContainerTests, ClearedContainerFindsNothing)
+{
+	funcs.clear();
+
+	EXPECT_TRUE(funcs.empty());
+	EXPECT_TRUE(funcs.getFunctionByStartAddress(fnc1.getStart()) == nullptr);
+}
+
+TEST_F(FunctionContainerTests, CopiedContainerFindsFunctionsByStartAddress)
+{
+	FunctionContainer copy = funcs;
+
+	auto* f = copy.getFunctionByStartAddress(fnc2.getStart());
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( fnc2.getName(), f->getName() );
+	EXPECT_NE( funcs.getFunctionByStartAddress(fnc2.getStart()), f );
+}
+
 } // namespace tests
 } // namespace config
 } // namespace retdec
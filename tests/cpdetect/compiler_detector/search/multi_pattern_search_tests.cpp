@@ -0,0 +1,328 @@
+/**
+* @file tests/cpdetect/compiler_detector/search/multi_pattern_search_tests.cpp
+* @brief Tests for the @c multi_pattern_search module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/compiler_detector/search/multi_pattern_search.h"
+#include "retdec/cpdetect/compiler_detector/search/search.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+
+using namespace ::testing;
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+/**
+ * Tests for the @c multi_pattern_search module.
+ */
+class MultiPatternSearchTests : public Test
+{
+	protected:
+		static llvm::ArrayRef<std::uint8_t> toBytes(const std::string &str)
+		{
+			return llvm::ArrayRef<std::uint8_t>(reinterpret_cast<const std::uint8_t*>(str.data()), str.length());
+		}
+
+		/**
+		 * Scan @a data and check hits of all strings on all offsets
+		 * against @c std::string::find().
+		 */
+		static void expectStringsFoundAsByFind(
+				MultiPatternSearch &search,
+				const std::vector<std::string> &strings,
+				const std::string &data)
+		{
+			search.scan(toBytes(data), toBytes(data));
+			ASSERT_TRUE(search.isScanned());
+
+			for(std::size_t i = 0, e = strings.size(); i < e; ++i)
+			{
+				for(std::size_t offset = 0; offset <= data.length() + 1; ++offset)
+				{
+					const auto expected = data.find(strings[i], offset);
+					EXPECT_EQ(expected == std::string::npos ? MultiPatternSearch::npos : expected, search.findString(i, offset))
+						<< "string " << strings[i] << " data " << data << " offset " << offset;
+				}
+			}
+		}
+
+		/**
+		 * Find first nibble offset on or after @a startNibble on which
+		 * @a signPattern matches @a data.
+		 */
+		static std::size_t referenceFindSignature(
+				const std::string &signPattern,
+				const std::vector<std::uint8_t> &data,
+				std::size_t startNibble)
+		{
+			const SignaturePattern pattern(signPattern);
+			const auto &part = pattern.getUnslashed();
+			for(std::size_t nibble = startNibble; nibble < 2 * data.size(); ++nibble)
+			{
+				if(part.matches(data, nibble))
+				{
+					return nibble;
+				}
+			}
+
+			return MultiPatternSearch::npos;
+		}
+};
+
+TEST_F(MultiPatternSearchTests, OverlappingStringsAreAllFound)
+{
+	const std::vector<std::string> strings = {"abcd", "bcde", "cd", "aa"};
+	MultiPatternSearch search;
+	for(const auto &str : strings)
+	{
+		search.addString(str);
+	}
+
+	search.scan(toBytes("xabcdefaaaa"), toBytes("xabcdefaaaa"));
+	EXPECT_EQ(1, search.findString(0, 0));
+	EXPECT_EQ(2, search.findString(1, 0));
+	EXPECT_EQ(3, search.findString(2, 0));
+	EXPECT_EQ(7, search.findString(3, 0));
+	EXPECT_EQ(8, search.findString(3, 8));
+	EXPECT_EQ(9, search.findString(3, 9));
+	EXPECT_EQ(MultiPatternSearch::npos, search.findString(3, 10));
+
+	expectStringsFoundAsByFind(search, strings, "xabcdefaaaa");
+	expectStringsFoundAsByFind(search, strings, "abcdbcdeabcde");
+}
+
+TEST_F(MultiPatternSearchTests, SuffixPatternIsFoundThroughOutputLinks)
+{
+	// Automaton is inside of the longest key when shorter keys end.
+	const std::vector<std::string> strings = {"abcdef", "cdef", "def", "f", "bcx"};
+	MultiPatternSearch search;
+	for(const auto &str : strings)
+	{
+		search.addString(str);
+	}
+
+	search.scan(toBytes("abcdef"), toBytes("abcdef"));
+	EXPECT_EQ(0, search.findString(0, 0));
+	EXPECT_EQ(2, search.findString(1, 0));
+	EXPECT_EQ(3, search.findString(2, 0));
+	EXPECT_EQ(5, search.findString(3, 0));
+	EXPECT_EQ(MultiPatternSearch::npos, search.findString(4, 0));
+
+	// Failure from the "abc" branch into the "bcx" branch and back.
+	expectStringsFoundAsByFind(search, strings, "abcxabcdefbcdef");
+}
+
+TEST_F(MultiPatternSearchTests, SuffixSignatureIsFoundThroughOutputLinks)
+{
+	const std::vector<std::uint8_t> data = {0x55, 0x8B, 0xEC, 0x83, 0xEC};
+	MultiPatternSearch search;
+	const auto prologue = search.addSignature("558BEC83EC");
+	const auto suffix = search.addSignature("EC83EC");
+	const auto shifted = search.addSignature("BEC83");
+
+	search.scan(data, data);
+	EXPECT_EQ(0, search.findSignature(prologue, 0));
+	EXPECT_EQ(4, search.findSignature(suffix, 0));
+	EXPECT_EQ(MultiPatternSearch::npos, search.findSignature(suffix, 5));
+	EXPECT_EQ(3, search.findSignature(shifted, 0));
+}
+
+TEST_F(MultiPatternSearchTests, RepeatedRegistrationGivesSeparateIndexes)
+{
+	MultiPatternSearch search;
+	const auto first = search.addString("ab");
+	const auto second = search.addString("ab");
+	const auto firstSignature = search.addSignature("6162");
+	const auto secondSignature = search.addSignature("6162");
+	EXPECT_NE(first, second);
+	EXPECT_NE(firstSignature, secondSignature);
+
+	search.scan(toBytes("xab"), toBytes("xab"));
+	EXPECT_EQ(1, search.findString(first, 0));
+	EXPECT_EQ(1, search.findString(second, 0));
+	EXPECT_EQ(2, search.findSignature(firstSignature, 0));
+	EXPECT_EQ(2, search.findSignature(secondSignature, 0));
+}
+
+TEST_F(MultiPatternSearchTests, RegistrationAfterScanInvalidatesHits)
+{
+	MultiPatternSearch search;
+	const auto first = search.addString("ab");
+	search.scan(toBytes("abcd"), toBytes("abcd"));
+	ASSERT_TRUE(search.isScanned());
+
+	const auto second = search.addString("cd");
+	EXPECT_FALSE(search.isScanned());
+
+	search.scan(toBytes("abcd"), toBytes("abcd"));
+	EXPECT_TRUE(search.isScanned());
+	EXPECT_EQ(0, search.findString(first, 0));
+	EXPECT_EQ(2, search.findString(second, 0));
+}
+
+TEST_F(MultiPatternSearchTests, SignaturesAreFoundOnBothAlignments)
+{
+	const std::vector<std::uint8_t> data = {0x12, 0x34, 0x56, 0x12, 0x34, 0x56};
+	MultiPatternSearch search;
+	const auto aligned = search.addSignature("3456");
+	const auto unaligned = search.addSignature("2345");
+	const auto wildcards = search.addSignature("-345-");
+
+	search.scan(data, data);
+	EXPECT_EQ(2, search.findSignature(aligned, 0));
+	EXPECT_EQ(8, search.findSignature(aligned, 3));
+	EXPECT_EQ(1, search.findSignature(unaligned, 0));
+	EXPECT_EQ(7, search.findSignature(unaligned, 2));
+	EXPECT_EQ(MultiPatternSearch::npos, search.findSignature(unaligned, 8));
+	EXPECT_EQ(1, search.findSignature(wildcards, 0));
+}
+
+TEST_F(MultiPatternSearchTests, SignatureWithoutSignificantByteIsNotIndexed)
+{
+	MultiPatternSearch search;
+	EXPECT_TRUE(search.isSignatureIndexed(search.addSignature("558B")));
+	EXPECT_FALSE(search.isSignatureIndexed(search.addSignature("1-3-")));
+	EXPECT_FALSE(search.isSignatureIndexed(search.addSignature("-12-")));
+	EXPECT_FALSE(search.isSignatureIndexed(search.addSignature("55X")));
+	EXPECT_FALSE(search.isSignatureIndexed(42));
+}
+
+TEST_F(MultiPatternSearchTests, StringsAndSignaturesAreSearchedInTheirOwnData)
+{
+	const std::vector<std::uint8_t> plain = {0x01, 0x02, 0x03, 0x04};
+	const std::vector<std::uint8_t> swapped = {0x04, 0x03, 0x02, 0x01};
+	MultiPatternSearch search;
+	const auto str = search.addString(std::string("\x03\x04", 2));
+	const auto signature = search.addSignature("0304");
+
+	search.scan(plain, swapped);
+	EXPECT_EQ(2, search.findString(str, 0));
+	EXPECT_EQ(MultiPatternSearch::npos, search.findSignature(signature, 0));
+}
+
+TEST_F(MultiPatternSearchTests, RandomPatternsGiveSameResultsAsPerPatternSearch)
+{
+	std::mt19937 gen(42);
+	const std::uint8_t values[] = {0x00, 0x0A, 0xA0, 0xAA};
+	const std::string patternChars = "0A0A-";
+
+	for(std::size_t round = 0; round < 100; ++round)
+	{
+		std::vector<std::uint8_t> data(1 + gen() % 24);
+		for(auto &b : data)
+		{
+			b = values[gen() % 4];
+		}
+
+		MultiPatternSearch search;
+		std::vector<std::string> strings;
+		std::vector<std::string> signatures;
+		for(std::size_t i = 0, e = 1 + gen() % 8; i < e; ++i)
+		{
+			std::string str;
+			for(std::size_t j = 0, f = 1 + gen() % 4; j < f; ++j)
+			{
+				str.push_back(static_cast<char>(values[gen() % 4]));
+			}
+			strings.push_back(str);
+			search.addString(str);
+
+			std::string signature;
+			for(std::size_t j = 0, f = 1 + gen() % 8; j < f; ++j)
+			{
+				signature.push_back(patternChars[gen() % patternChars.size()]);
+			}
+			signatures.push_back(signature);
+			search.addSignature(signature);
+		}
+
+		const std::string plain(data.begin(), data.end());
+		expectStringsFoundAsByFind(search, strings, plain);
+
+		for(std::size_t i = 0, e = signatures.size(); i < e; ++i)
+		{
+			if(!search.isSignatureIndexed(i))
+			{
+				continue;
+			}
+
+			for(std::size_t nibble = 0; nibble <= 2 * data.size(); ++nibble)
+			{
+				EXPECT_EQ(referenceFindSignature(signatures[i], data, nibble), search.findSignature(i, nibble))
+					<< "signature " << signatures[i] << " start " << nibble;
+			}
+		}
+	}
+}
+
+TEST_F(MultiPatternSearchTests, RegisteredPatternsGiveSameResultsInSearch)
+{
+	std::mt19937 gen(7);
+	const std::uint8_t values[] = {0x55, 0x8B, 0xEC, 0x90};
+	const std::string patternChars = "58BEC9-";
+
+	for(std::size_t round = 0; round < 50; ++round)
+	{
+		std::vector<std::uint8_t> data(1 + gen() % 16);
+		for(auto &b : data)
+		{
+			b = values[gen() % 4];
+		}
+
+		std::vector<std::string> strings;
+		std::vector<std::string> signatures;
+		for(std::size_t i = 0; i < 4; ++i)
+		{
+			std::string str;
+			for(std::size_t j = 0, f = 1 + gen() % 3; j < f; ++j)
+			{
+				str.push_back(static_cast<char>(values[gen() % 4]));
+			}
+			strings.push_back(str);
+
+			std::string signature;
+			for(std::size_t j = 0, f = 2 + gen() % 6; j < f; ++j)
+			{
+				signature.push_back(patternChars[gen() % patternChars.size()]);
+			}
+			signatures.push_back(signature);
+		}
+
+		RawDataFormat format(data.data(), data.size());
+		Search single(format);
+		Search multi(format);
+		for(std::size_t i = 0; i < strings.size(); ++i)
+		{
+			multi.registerString(strings[i]);
+			multi.registerSignature(signatures[i]);
+		}
+
+		for(std::size_t i = 0; i < strings.size(); ++i)
+		{
+			for(std::size_t offset = 0; offset <= data.size(); ++offset)
+			{
+				EXPECT_EQ(single.findString(strings[i], offset), multi.findString(strings[i], offset))
+					<< "string " << i << " offset " << offset;
+
+				for(std::size_t stop = offset; stop <= data.size(); ++stop)
+				{
+					EXPECT_EQ(single.findUnslashedSignature(signatures[i], offset, stop), multi.findUnslashedSignature(signatures[i], offset, stop))
+						<< "signature " << signatures[i] << " area " << offset << "-" << stop;
+				}
+			}
+		}
+	}
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
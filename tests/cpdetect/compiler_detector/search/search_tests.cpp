@@ -0,0 +1,320 @@
+/**
+* @file tests/cpdetect/compiler_detector/search/search_tests.cpp
+* @brief Tests for the @c search module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/compiler_detector/search/search.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+
+using namespace ::testing;
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+/**
+ * Matcher of signatures used before signatures were compiled. It searches
+ * hexadecimal string made of the whole input and knows relative jumps of
+ * x86 (@c EB with one byte and @c E9 with four bytes after).
+ */
+class ReferenceSearch
+{
+	private:
+		std::vector<std::uint8_t> bytes;
+		std::string nibbles;
+		bool slashes;
+
+		bool getRelativeJump(std::size_t fileIndex, std::size_t &jumpNibbles) const
+		{
+			static const std::vector<std::pair<std::string, std::size_t>> jumps = {{"EB", 1}, {"E9", 4}};
+
+			for(const auto &jump : jumps)
+			{
+				const auto nibblesAfter = 2 * jump.second;
+				if(fileIndex >= nibbles.size()
+						|| nibbles.size() - fileIndex < jump.first.size()
+						|| nibbles.compare(fileIndex, jump.first.size(), jump.first)
+						|| fileIndex + jump.first.size() + nibblesAfter - 1 >= nibbles.size())
+				{
+					continue;
+				}
+
+				// Value is read from the byte following the byte with slash.
+				const auto valueOffset = fileIndex / 2 + 1;
+				if(valueOffset + jump.second > bytes.size())
+				{
+					continue;
+				}
+
+				std::uint64_t value = 0;
+				for(std::size_t i = 0; i < jump.second; ++i)
+				{
+					value |= static_cast<std::uint64_t>(bytes[valueOffset + i]) << (8 * i);
+				}
+
+				std::int64_t moveSize = jump.second == 1
+						? static_cast<std::int8_t>(value)
+						: static_cast<std::int32_t>(value);
+				jumpNibbles = jump.first.size() + nibblesAfter + 2 * moveSize;
+				return true;
+			}
+
+			return false;
+		}
+	public:
+		ReferenceSearch(const std::vector<std::uint8_t> &data, bool haveSlashes) :
+			bytes(data), slashes(haveSlashes)
+		{
+			for(const auto b : bytes)
+			{
+				nibbles.push_back("0123456789ABCDEF"[b >> 4]);
+				nibbles.push_back("0123456789ABCDEF"[b & 0x0F]);
+			}
+		}
+
+		unsigned long long countImpNibbles(const std::string &signPattern) const
+		{
+			unsigned long long count = 0;
+			for(const auto c : signPattern)
+			{
+				if(c == '/')
+				{
+					count += slashes ? 2 : 0;
+				}
+				else if(c != '-' && c != '?' && c != ';')
+				{
+					++count;
+				}
+			}
+			return count;
+		}
+
+		unsigned long long exactComparison(const std::string &signPattern, std::size_t fileOffset, std::size_t shift) const
+		{
+			for(std::size_t sigIndex = 0, fileIndex = 2 * fileOffset + shift, fileLen = nibbles.length();
+				fileIndex < fileLen; ++sigIndex, ++fileIndex)
+			{
+				if(sigIndex == signPattern.length() || signPattern[sigIndex] == ';')
+				{
+					return countImpNibbles(signPattern);
+				}
+				else if(signPattern[sigIndex] == '/')
+				{
+					std::size_t jumpNibbles = 0;
+					if(!getRelativeJump(fileIndex, jumpNibbles))
+					{
+						if(!slashes)
+						{
+							--fileIndex;
+							continue;
+						}
+
+						return 0;
+					}
+
+					fileIndex += jumpNibbles - 1;
+				}
+				else if(signPattern[sigIndex] != nibbles[fileIndex] && signPattern[sigIndex] != '-' && signPattern[sigIndex] != '?')
+				{
+					return 0;
+				}
+			}
+
+			return 0;
+		}
+
+		unsigned long long findSlashedSignature(const std::string &signPattern, std::size_t startOffset, std::size_t stopOffset) const
+		{
+			if(startOffset > stopOffset)
+			{
+				return 0;
+			}
+
+			const auto areaSize = 2 * (stopOffset - startOffset + 1);
+			const auto signSize = signPattern.length() - std::count(signPattern.begin(), signPattern.end(), ';');
+			if(areaSize < signSize)
+			{
+				return 0;
+			}
+			const auto iters = (startOffset == stopOffset) ? 1 : areaSize - signSize + 1;
+
+			for(std::size_t i = 0; i < iters; ++i)
+			{
+				const auto result = exactComparison(signPattern, startOffset, i);
+				if(result)
+				{
+					return result;
+				}
+			}
+
+			return 0;
+		}
+
+		unsigned long long findUnslashedSignature(const std::string &signPattern, std::size_t startOffset, std::size_t stopOffset) const
+		{
+			if(startOffset > stopOffset)
+			{
+				return 0;
+			}
+
+			const auto startIterator = nibbles.begin() + 2 * startOffset;
+			const auto stopIndex = 2 * stopOffset + 1;
+			const auto stopIterator = stopIndex < nibbles.size() ? nibbles.begin() + stopIndex : nibbles.end();
+			const auto it = std::search(startIterator, stopIterator, signPattern.begin(), signPattern.end(),
+				[] (const char fileNibble, const char signatureNibble)
+				{
+					return fileNibble == signatureNibble || signatureNibble == '-' || signatureNibble == '?' || signatureNibble == ';';
+				}
+			);
+
+			return (it != stopIterator) ? countImpNibbles(signPattern) : 0;
+		}
+};
+
+/**
+ * Tests for the @c search module.
+ */
+class SearchTests : public Test
+{
+	protected:
+		/**
+		 * Check that all signature search methods give the same results
+		 * as the reference matcher.
+		 */
+		static void expectSameAsReference(
+				const std::vector<std::uint8_t> &bytes,
+				const std::string &pattern,
+				Architecture arch = Architecture::X86)
+		{
+			RawDataFormat format(bytes.data(), bytes.size());
+			format.setTargetArchitecture(arch);
+			Search search(format);
+			ReferenceSearch reference(bytes, arch == Architecture::X86);
+
+			for(std::size_t offset = 0; offset < bytes.size(); ++offset)
+			{
+				for(std::size_t shift = 0; shift < 2; ++shift)
+				{
+					EXPECT_EQ(reference.exactComparison(pattern, offset, shift), search.exactComparison(pattern, offset, shift))
+						<< "pattern " << pattern << " offset " << offset << " shift " << shift;
+				}
+
+				for(std::size_t stop = offset; stop < bytes.size() + 2; ++stop)
+				{
+					EXPECT_EQ(reference.findSlashedSignature(pattern, offset, stop), search.findSlashedSignature(pattern, offset, stop))
+						<< "pattern " << pattern << " area " << offset << "-" << stop;
+					EXPECT_EQ(reference.findUnslashedSignature(pattern, offset, stop), search.findUnslashedSignature(pattern, offset, stop))
+						<< "pattern " << pattern << " area " << offset << "-" << stop;
+				}
+			}
+		}
+};
+
+TEST_F(SearchTests, ShortJumpIsFollowed)
+{
+	// push ebp; jmp short +2; nop; nop; mov ebp, esp; ret
+	const std::vector<std::uint8_t> bytes = {0x55, 0xEB, 0x02, 0x90, 0x90, 0x8B, 0xEC, 0xC3};
+	RawDataFormat format(bytes.data(), bytes.size());
+	Search search(format);
+
+	EXPECT_EQ(8, search.exactComparison("55/8BEC", 0));
+	EXPECT_EQ(0, search.exactComparison("55/8BED", 0));
+	EXPECT_EQ(8, search.findSlashedSignature("55/8BEC", 0, bytes.size() - 1));
+	expectSameAsReference(bytes, "55/8BEC");
+	expectSameAsReference(bytes, "55/8B--");
+	expectSameAsReference(bytes, "-5/8BEC;90");
+}
+
+TEST_F(SearchTests, NearJumpIsFollowedBackwards)
+{
+	// nop; nop; jmp near -7 (to offset 0); ret
+	const std::vector<std::uint8_t> bytes = {0x90, 0x90, 0xE9, 0xF9, 0xFF, 0xFF, 0xFF, 0xC3};
+	expectSameAsReference(bytes, "9090/9090");
+	expectSameAsReference(bytes, "90/90");
+	expectSameAsReference(bytes, "9090/C3");
+}
+
+TEST_F(SearchTests, JumpOnOddNibbleIsFollowed)
+{
+	const std::vector<std::uint8_t> bytes = {0x5E, 0xB0, 0x12, 0x34, 0x56, 0x78, 0x9A};
+	expectSameAsReference(bytes, "5/2345");
+	expectSameAsReference(bytes, "5/-");
+	expectSameAsReference(bytes, "5/;");
+}
+
+TEST_F(SearchTests, MissingJumpFailsComparison)
+{
+	const std::vector<std::uint8_t> bytes = {0x55, 0x90, 0x8B, 0xEC, 0xC3};
+	RawDataFormat format(bytes.data(), bytes.size());
+	Search search(format);
+
+	EXPECT_EQ(0, search.exactComparison("55/8BEC", 0));
+	expectSameAsReference(bytes, "55/8BEC");
+}
+
+TEST_F(SearchTests, JumpsAreIgnoredOnArchitectureWithoutJumps)
+{
+	const std::vector<std::uint8_t> bytes = {0x55, 0x8B, 0xEC, 0xC3};
+	RawDataFormat format(bytes.data(), bytes.size());
+	format.setTargetArchitecture(Architecture::ARM);
+	Search search(format);
+
+	EXPECT_EQ(6, search.exactComparison("55/8BEC", 0));
+	expectSameAsReference(bytes, "55/8BEC", Architecture::ARM);
+	expectSameAsReference(bytes, "/55//8B/", Architecture::ARM);
+}
+
+TEST_F(SearchTests, PatternAtTheVeryEndOfData)
+{
+	const std::vector<std::uint8_t> bytes = {0x00, 0x55, 0x8B, 0xEC};
+	RawDataFormat format(bytes.data(), bytes.size());
+	Search search(format);
+
+	// Exact comparison has always required one more nibble after the pattern.
+	EXPECT_EQ(0, search.exactComparison("558BEC", 1));
+	EXPECT_EQ(5, search.exactComparison("558BE", 1));
+	EXPECT_EQ(6, search.findUnslashedSignature("558BEC", 0, bytes.size()));
+	expectSameAsReference(bytes, "558BEC");
+	expectSameAsReference(bytes, "8BEC");
+	expectSameAsReference(bytes, "EC");
+	expectSameAsReference(bytes, "EC-");
+	expectSameAsReference(bytes, "-EC");
+	expectSameAsReference(bytes, "8BEC;");
+}
+
+TEST_F(SearchTests, RandomPatternsGiveSameResultsAsHexStringMatcher)
+{
+	std::mt19937 gen(42);
+	const std::uint8_t values[] = {0x55, 0xEB, 0xE9, 0x01, 0x02, 0xFE, 0x8B, 0x00};
+	const std::string patternChars = "5EB9012F8--/;";
+
+	for(std::size_t round = 0; round < 300; ++round)
+	{
+		std::vector<std::uint8_t> bytes(1 + gen() % 16);
+		for(auto &b : bytes)
+		{
+			b = values[gen() % 8];
+		}
+
+		std::string pattern;
+		for(std::size_t i = 0, e = 1 + gen() % 8; i < e; ++i)
+		{
+			pattern.push_back(patternChars[gen() % patternChars.size()]);
+		}
+
+		expectSameAsReference(bytes, pattern);
+	}
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
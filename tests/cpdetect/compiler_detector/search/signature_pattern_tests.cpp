@@ -0,0 +1,294 @@
+/**
+* @file tests/cpdetect/compiler_detector/search/signature_pattern_tests.cpp
+* @brief Tests for the @c signature_pattern module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/compiler_detector/search/signature_pattern.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+/**
+ * Tests for the @c signature_pattern module.
+ *
+ * Results are compared with the matcher used before signatures were
+ * compiled, which searched a hexadecimal string made of the whole input.
+ */
+class SignaturePatternTests : public Test
+{
+	protected:
+		/**
+		 * Hexadecimal representation of @a bytes (upper case).
+		 */
+		static std::string toNibbles(const std::vector<std::uint8_t> &bytes)
+		{
+			std::string result;
+			for(const auto b : bytes)
+			{
+				result.push_back("0123456789ABCDEF"[b >> 4]);
+				result.push_back("0123456789ABCDEF"[b & 0x0F]);
+			}
+			return result;
+		}
+
+		/**
+		 * Original search of unslashed signature in nibbles
+		 * [@a startNibble, @a stopNibble).
+		 */
+		static bool referenceFind(
+				const std::string &nibbles,
+				const std::string &pattern,
+				std::size_t startNibble,
+				std::size_t stopNibble)
+		{
+			if(startNibble > nibbles.size())
+			{
+				return false;
+			}
+
+			const auto startIt = nibbles.begin() + startNibble;
+			const auto stopIt = stopNibble < nibbles.size() ? nibbles.begin() + stopNibble : nibbles.end();
+			if(startIt > stopIt)
+			{
+				return false;
+			}
+
+			return std::search(startIt, stopIt, pattern.begin(), pattern.end(),
+				[] (const char fileNibble, const char signatureNibble)
+				{
+					return fileNibble == signatureNibble || signatureNibble == '-'
+						|| signatureNibble == '?' || signatureNibble == ';';
+				}
+			) != stopIt || pattern.empty();
+		}
+
+		/**
+		 * Original comparison of unslashed signature on nibble offset.
+		 */
+		static bool referenceMatches(
+				const std::string &nibbles,
+				const std::string &pattern,
+				std::size_t nibbleOffset)
+		{
+			if(nibbleOffset > nibbles.size() || nibbles.size() - nibbleOffset < pattern.size())
+			{
+				return false;
+			}
+
+			for(std::size_t i = 0; i < pattern.size(); ++i)
+			{
+				const auto c = pattern[i];
+				if(c != '-' && c != '?' && c != ';' && c != nibbles[nibbleOffset + i])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * Check that compiled pattern gives the same results as the original
+		 * matcher on every offset and every area of @a bytes.
+		 */
+		static void expectSameAsReference(
+				const std::vector<std::uint8_t> &bytes,
+				const std::string &pattern)
+		{
+			const auto nibbles = toNibbles(bytes);
+			const SignaturePattern compiled(pattern);
+			const auto &part = compiled.getUnslashed();
+
+			for(std::size_t offset = 0; offset <= nibbles.size() + 1; ++offset)
+			{
+				EXPECT_EQ(referenceMatches(nibbles, pattern, offset), part.matches(bytes, offset))
+					<< "pattern " << pattern << " data " << nibbles << " offset " << offset;
+			}
+
+			for(std::size_t start = 0; start <= nibbles.size(); ++start)
+			{
+				for(std::size_t stop = start; stop <= nibbles.size() + 2; ++stop)
+				{
+					EXPECT_EQ(referenceFind(nibbles, pattern, start, stop), part.find(bytes, start, stop))
+						<< "pattern " << pattern << " data " << nibbles << " area " << start << "-" << stop;
+				}
+			}
+		}
+};
+
+TEST_F(SignaturePatternTests, PatternStartingOnHighNibbleIsFound)
+{
+	const std::vector<std::uint8_t> bytes = {0x12, 0x34, 0x56, 0x78};
+	const SignaturePattern pattern("3456");
+
+	EXPECT_TRUE(pattern.getUnslashed().matches(bytes, 2));
+	EXPECT_FALSE(pattern.getUnslashed().matches(bytes, 3));
+	EXPECT_TRUE(pattern.getUnslashed().find(bytes, 0, 8));
+	EXPECT_FALSE(pattern.getUnslashed().find(bytes, 3, 8));
+	expectSameAsReference(bytes, "3456");
+}
+
+TEST_F(SignaturePatternTests, PatternStartingOnLowNibbleIsFound)
+{
+	const std::vector<std::uint8_t> bytes = {0x12, 0x34, 0x56, 0x78};
+	const SignaturePattern pattern("2345");
+
+	EXPECT_TRUE(pattern.getUnslashed().matches(bytes, 1));
+	EXPECT_FALSE(pattern.getUnslashed().matches(bytes, 2));
+	EXPECT_TRUE(pattern.getUnslashed().find(bytes, 1, 5));
+	EXPECT_FALSE(pattern.getUnslashed().find(bytes, 1, 4));
+	EXPECT_FALSE(pattern.getUnslashed().find(bytes, 2, 8));
+	expectSameAsReference(bytes, "2345");
+	expectSameAsReference(bytes, "234567");
+}
+
+TEST_F(SignaturePatternTests, WildcardsAtBothEndsAreMatched)
+{
+	const std::vector<std::uint8_t> bytes = {0x00, 0x12, 0x34, 0x56, 0x00, 0x34};
+
+	for(const auto &pattern : {"--34--", "?34?", "-34", "34-", "---34---", "?3-5?", "--00"})
+	{
+		expectSameAsReference(bytes, pattern);
+	}
+}
+
+TEST_F(SignaturePatternTests, PatternWithoutSignificantByteIsMatched)
+{
+	const std::vector<std::uint8_t> bytes = {0x12, 0x34, 0x56};
+
+	// No byte is fully specified, so memchr() anchor can not be used.
+	for(const auto &pattern : {"----", "1-3-", "-2-4", "?", "1?3", "-", "--------"})
+	{
+		expectSameAsReference(bytes, pattern);
+	}
+}
+
+TEST_F(SignaturePatternTests, PatternAtTheVeryEndOfDataIsFound)
+{
+	const std::vector<std::uint8_t> bytes = {0xAA, 0xBB, 0xCC, 0xDD};
+
+	EXPECT_TRUE(SignaturePattern("CCDD").getUnslashed().find(bytes, 0, 8));
+	EXPECT_TRUE(SignaturePattern("CDD").getUnslashed().find(bytes, 0, 8));
+	EXPECT_TRUE(SignaturePattern("CCD").getUnslashed().find(bytes, 0, 8));
+	EXPECT_FALSE(SignaturePattern("CCDD").getUnslashed().find(bytes, 0, 7));
+	EXPECT_FALSE(SignaturePattern("DD--").getUnslashed().find(bytes, 0, 8));
+
+	for(const auto &pattern : {"CCDD", "CDD", "D", "DD", "DD-", "-DD", "AABBCCDD", "AABBCCDD-"})
+	{
+		expectSameAsReference(bytes, pattern);
+	}
+}
+
+TEST_F(SignaturePatternTests, RelativeJumpsSplitPatternIntoParts)
+{
+	const SignaturePattern pattern("55/8BEC/--");
+
+	ASSERT_EQ(3, pattern.getParts().size());
+	EXPECT_EQ(2, pattern.getParts()[0].getNibbleLength());
+	EXPECT_EQ(4, pattern.getParts()[1].getNibbleLength());
+	EXPECT_EQ(2, pattern.getParts()[2].getNibbleLength());
+	EXPECT_EQ(2, pattern.getNumberOfJumps());
+	EXPECT_EQ(6, pattern.getNumberOfSignificantNibbles());
+}
+
+TEST_F(SignaturePatternTests, TerminatorEndsPartsButNotUnslashedPattern)
+{
+	const std::vector<std::uint8_t> bytes = {0x55, 0x8B, 0xEC, 0x90};
+	const SignaturePattern pattern("558B;9/9");
+
+	ASSERT_EQ(1, pattern.getParts().size());
+	EXPECT_EQ(4, pattern.getParts()[0].getNibbleLength());
+	EXPECT_EQ(8, pattern.getUnslashed().getNibbleLength());
+	EXPECT_EQ(1, pattern.getNumberOfJumps());
+	EXPECT_EQ(6, pattern.getNumberOfSignificantNibbles());
+
+	// Terminators are wildcards in unslashed search.
+	expectSameAsReference(bytes, "558B;E");
+	expectSameAsReference(bytes, "558B;;C90");
+}
+
+TEST_F(SignaturePatternTests, InvalidCharacterNeverMatches)
+{
+	const std::vector<std::uint8_t> bytes = {0x55, 0x8B, 0xEC, 0x90};
+
+	for(const auto &pattern : {"55X", "558b", "5 5", "X"})
+	{
+		const SignaturePattern compiled(pattern);
+		EXPECT_FALSE(compiled.getUnslashed().isValid()) << pattern;
+		EXPECT_FALSE(compiled.getParts()[0].isValid()) << pattern;
+		expectSameAsReference(bytes, pattern);
+	}
+}
+
+TEST_F(SignaturePatternTests, InvalidCharacterAfterTerminatorInvalidatesOnlyUnslashedPattern)
+{
+	const SignaturePattern pattern("558B;X");
+
+	EXPECT_TRUE(pattern.getParts()[0].isValid());
+	EXPECT_FALSE(pattern.getUnslashed().isValid());
+}
+
+TEST_F(SignaturePatternTests, EmptyAreaOrAreaOutsideDataIsNotSearched)
+{
+	const std::vector<std::uint8_t> bytes = {0x12, 0x34};
+	const SignaturePattern pattern("12");
+
+	EXPECT_FALSE(pattern.getUnslashed().find(bytes, 2, 1));
+	EXPECT_FALSE(pattern.getUnslashed().find(bytes, 4, 8));
+	EXPECT_FALSE(pattern.getUnslashed().find(bytes, 0, 1));
+	EXPECT_FALSE(pattern.getUnslashed().find({}, 0, 8));
+}
+
+TEST_F(SignaturePatternTests, LongestLiteralIsFoundForBothAlignments)
+{
+	const SignaturePattern pattern("12--3456-7");
+	std::size_t offset = 0;
+
+	auto literal = pattern.getUnslashed().getLongestLiteral(0, offset);
+	EXPECT_EQ(2, offset);
+	EXPECT_EQ(std::vector<std::uint8_t>({0x34, 0x56}), std::vector<std::uint8_t>(literal.begin(), literal.end()));
+
+	// Shifted by one nibble: -1 2- -3 45 6- 7
+	literal = pattern.getUnslashed().getLongestLiteral(1, offset);
+	EXPECT_EQ(3, offset);
+	EXPECT_EQ(std::vector<std::uint8_t>({0x45}), std::vector<std::uint8_t>(literal.begin(), literal.end()));
+}
+
+TEST_F(SignaturePatternTests, RandomPatternsGiveSameResultsAsHexStringMatcher)
+{
+	std::mt19937 gen(42);
+	// Small alphabet, so that patterns are often found.
+	const std::uint8_t values[] = {0x0, 0x5, 0xA, 0xF};
+	const std::string patternChars = "05AF05AF-?;";
+
+	for(std::size_t round = 0; round < 200; ++round)
+	{
+		std::vector<std::uint8_t> bytes(1 + gen() % 12);
+		for(auto &b : bytes)
+		{
+			b = (values[gen() % 4] << 4) | values[gen() % 4];
+		}
+
+		std::string pattern;
+		for(std::size_t i = 0, e = 1 + gen() % 6; i < e; ++i)
+		{
+			pattern.push_back(patternChars[gen() % patternChars.size()]);
+		}
+
+		expectSameAsReference(bytes, pattern);
+	}
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
@@ -0,0 +1,132 @@
+/**
+* @file tests/crypto/multi_hash_tests.cpp
+* @brief Tests for the @c multi_hash module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/crypto/crypto.h"
+#include "retdec/crypto/multi_hash.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace crypto {
+namespace tests {
+
+class MultiHashTests: public Test {
+protected:
+	static std::vector<std::uint8_t> createData(std::size_t size) {
+		std::vector<std::uint8_t> data(size);
+		for (std::size_t i = 0; i < size; ++i) {
+			data[i] = static_cast<std::uint8_t>(i * 7 + i / 251);
+		}
+		return data;
+	}
+};
+
+TEST_F(MultiHashTests,
+ComputeReturnsSameHashesAsSingleAlgorithmFunctions) {
+	// Larger than one chunk and not a multiple of its size.
+	auto data = createData(100 * 1024 + 3);
+
+	auto hashes = MultiHash::compute(data.data(), data.size(),
+		MultiHash::CRC32 | MultiHash::MD5 | MultiHash::SHA1 | MultiHash::SHA256);
+
+	EXPECT_EQ(getCrc32(data.data(), data.size()), hashes.crc32);
+	EXPECT_EQ(getMd5(data.data(), data.size()), hashes.md5);
+	EXPECT_EQ(getSha1(data.data(), data.size()), hashes.sha1);
+	EXPECT_EQ(getSha256(data.data(), data.size()), hashes.sha256);
+}
+
+TEST_F(MultiHashTests,
+ComputeLeavesHashesOfNotRequestedAlgorithmsEmpty) {
+	auto data = createData(10);
+
+	auto hashes = MultiHash::compute(data.data(), data.size(), MultiHash::MD5);
+
+	EXPECT_TRUE(hashes.crc32.empty());
+	EXPECT_EQ(getMd5(data.data(), data.size()), hashes.md5);
+	EXPECT_TRUE(hashes.sha1.empty());
+	EXPECT_TRUE(hashes.sha256.empty());
+}
+
+TEST_F(MultiHashTests,
+AddingDataInPartsGivesSameHashesAsAddingThemAtOnce) {
+	auto data = createData(1000);
+
+	MultiHash multiHash;
+	multiHash.addData(data.data(), 300);
+	multiHash.addData(data.data() + 300, 700);
+	auto hashes = multiHash.getHashes();
+
+	auto expected = MultiHash::compute(data.data(), data.size());
+	EXPECT_EQ(expected.crc32, hashes.crc32);
+	EXPECT_EQ(expected.md5, hashes.md5);
+	EXPECT_EQ(expected.sha256, hashes.sha256);
+}
+
+TEST_F(MultiHashTests,
+ComputeOfEmptyDataReturnsHashesOfEmptyData) {
+	auto hashes = MultiHash::compute(nullptr, 0);
+
+	EXPECT_EQ("00000000", hashes.crc32);
+	EXPECT_EQ("d41d8cd98f00b204e9800998ecf8427e", hashes.md5);
+	EXPECT_EQ(
+		"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+		hashes.sha256);
+}
+
+TEST_F(MultiHashTests,
+ComputeOfRangesReturnsHashesOfEachRangeInOrder) {
+	// Large enough to be hashed in parallel.
+	auto data = createData(4 * 1024 * 1024);
+	std::vector<MultiHash::Range> ranges;
+	for (std::size_t i = 0; i < 8; ++i) {
+		ranges.emplace_back(data.data() + i * 512 * 1024, 512 * 1024 - i);
+	}
+	ranges.emplace_back(data.data(), 0);
+
+	auto hashes = MultiHash::compute(ranges);
+
+	ASSERT_EQ(ranges.size(), hashes.size());
+	for (std::size_t i = 0; i < ranges.size(); ++i) {
+		auto expected = MultiHash::compute(ranges[i].first, ranges[i].second);
+		EXPECT_EQ(expected.crc32, hashes[i].crc32);
+		EXPECT_EQ(expected.md5, hashes[i].md5);
+		EXPECT_EQ(expected.sha256, hashes[i].sha256);
+	}
+}
+
+TEST_F(MultiHashTests,
+ComputeOfNoRangesReturnsNoHashes) {
+	EXPECT_TRUE(MultiHash::compute(std::vector<MultiHash::Range>()).empty());
+}
+
+TEST_F(MultiHashTests,
+ComputeOfRangesWithLimitedThreadsReturnsSameHashes) {
+	auto data = createData(4 * 1024 * 1024);
+	std::vector<MultiHash::Range> ranges;
+	for (std::size_t i = 0; i < 8; ++i) {
+		ranges.emplace_back(data.data() + i * 512 * 1024, 512 * 1024);
+	}
+
+	auto expected = MultiHash::compute(ranges);
+
+	for (unsigned maxThreads : {1u, 2u, 16u}) {
+		auto hashes = MultiHash::compute(ranges, MultiHash::DEFAULT, maxThreads);
+		ASSERT_EQ(ranges.size(), hashes.size());
+		for (std::size_t i = 0; i < ranges.size(); ++i) {
+			EXPECT_EQ(expected[i].crc32, hashes[i].crc32) << maxThreads;
+			EXPECT_EQ(expected[i].md5, hashes[i].md5) << maxThreads;
+			EXPECT_EQ(expected[i].sha256, hashes[i].sha256) << maxThreads;
+		}
+	}
+}
+
+} // namespace tests
+} // namespace crypto
+} // namespace retdec
@@ -0,0 +1,169 @@
+/**
+* @file tests/ctypesparser/indexed_ctypes_parser_tests.cpp
+* @brief Tests for the @c indexed_ctypes_parser module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/ctypes/context.h"
+#include "retdec/ctypes/function.h"
+#include "retdec/ctypes/module.h"
+#include "retdec/ctypes/pointer_type.h"
+#include "retdec/ctypes/struct_type.h"
+#include "retdec/ctypesparser/indexed_ctypes_parser.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace ctypesparser {
+namespace tests {
+
+class IndexedCTypesParserTests : public Test
+{
+	public:
+		IndexedCTypesParserTests()
+		{
+			json = R"(
+				{
+					"functions": {
+						"ff": {
+							"decl": "int ff(struct s *p);",
+							"header": "CHeader.h",
+							"name": "ff",
+							"params": [
+								{
+									"name": "p",
+									"type": "ptr_s"
+								}
+							],
+							"ret_type": "int"
+						},
+						"gg": {
+							"decl": "void gg(void);",
+							"header": "CHeader.h",
+							"name": "gg",
+							"params": [],
+							"ret_type": "void"
+						}
+					},
+					"types": {
+						"int": {
+							"name": "int",
+							"type": "integral_type"
+						},
+						"void": {
+							"type": "void"
+						},
+						"s": {
+							"members": [
+								{
+									"name": "next",
+									"type": "ptr_s"
+								}
+							],
+							"name": "s",
+							"type": "structure"
+						},
+						"ptr_s": {
+							"pointed_type": "s",
+							"type": "pointer"
+						}
+					}
+				}
+			)";
+			std::stringstream jsonStream(json);
+			std::stringstream out;
+			createCTypesIndex(jsonStream, out, JSON_MODIFICATION_TIME);
+			index = out.str();
+		}
+
+	protected:
+		/// Modification time of the JSON file the index is created from.
+		static const std::uint64_t JSON_MODIFICATION_TIME = 0x123456789ull;
+
+		std::string json;
+		std::string index;
+		IndexedCTypesParser parser;
+};
+
+TEST_F(IndexedCTypesParserTests,
+CreatingIndexFromBadInputThrowsException)
+{
+	std::stringstream json(R"({ "types": {} })");
+	std::stringstream out;
+
+	ASSERT_THROW(createCTypesIndex(json, out), CTypesParseError);
+}
+
+TEST_F(IndexedCTypesParserTests,
+OpeningDataThatAreNotIndexThrowsException)
+{
+	auto context = std::make_shared<retdec::ctypes::Context>();
+	std::string data = R"({ "functions": {}, "types": {} })";
+
+	ASSERT_THROW(
+		parser.open(data.data(), data.size(), context),
+		CTypesParseError
+	);
+}
+
+TEST_F(IndexedCTypesParserTests,
+FunctionsAreParsedOnlyWhenRequested)
+{
+	auto context = std::make_shared<retdec::ctypes::Context>();
+	parser.open(index.data(), index.size(), context, {{"int", 32}});
+
+	EXPECT_TRUE(parser.hasFunction("ff"));
+	EXPECT_TRUE(parser.hasFunction("gg"));
+	EXPECT_FALSE(parser.hasFunction("hh"));
+	EXPECT_FALSE(context->hasFunctionWithName("ff"));
+
+	auto func = parser.getFunction("ff");
+
+	ASSERT_TRUE(func);
+	EXPECT_EQ("ff", func->getName());
+	EXPECT_EQ(32, func->getReturnType()->getBitWidth());
+	EXPECT_TRUE(func->getParameterType(1)->isPointer());
+	EXPECT_TRUE(context->hasFunctionWithName("ff"));
+	EXPECT_FALSE(context->hasFunctionWithName("gg"));
+}
+
+TEST_F(IndexedCTypesParserTests,
+GetFunctionReturnsNullptrForUnknownFunction)
+{
+	auto context = std::make_shared<retdec::ctypes::Context>();
+	parser.open(index.data(), index.size(), context);
+
+	EXPECT_EQ(nullptr, parser.getFunction("hh"));
+}
+
+TEST_F(IndexedCTypesParserTests,
+ParseIntoParsesAllFunctionsToPassedModule)
+{
+	std::stringstream stream(index);
+	auto module = std::make_unique<retdec::ctypes::Module>(
+		std::make_shared<retdec::ctypes::Context>());
+
+	parser.parseInto(stream, module);
+
+	EXPECT_TRUE(module->hasFunctionWithName("ff"));
+	EXPECT_TRUE(module->hasFunctionWithName("gg"));
+}
+
+TEST_F(IndexedCTypesParserTests,
+IndexIsCreatedFromJsonOfTheSameSizeAndModificationTime)
+{
+	auto context = std::make_shared<retdec::ctypes::Context>();
+	parser.open(index.data(), index.size(), context);
+
+	EXPECT_TRUE(parser.isCreatedFrom(json.size(), JSON_MODIFICATION_TIME));
+	EXPECT_FALSE(parser.isCreatedFrom(json.size(), JSON_MODIFICATION_TIME + 1));
+	EXPECT_FALSE(parser.isCreatedFrom(json.size() + 1, JSON_MODIFICATION_TIME));
+}
+
+} // namespace tests
+} // namespace ctypesparser
+} // namespace retdec
@@ -0,0 +1,135 @@
+/**
+* @file tests/decompiler/decompiler_tests.cpp
+* @brief Smoke tests of the in-process decompiler.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+
+#include "retdec/decompiler/decompiler.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace decompiler {
+namespace tests {
+
+/**
+ * x86 ELF which writes "Hi World" by the write syscall and exits.
+ */
+const std::vector<uint8_t> elfBytes = {
+	0x7f, 0x45, 0x4c, 0x46, 0x01, 0x01, 0x01, 0x48, 0x69, 0x20, 0x57, 0x6f, 0x72, 0x6c, 0x64, 0x0a,
+	0x02, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x80, 0x80, 0x04, 0x08, 0x34, 0x00, 0x00, 0x00,
+	0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34, 0x00, 0x20, 0x00, 0x02, 0x00, 0x28, 0x00,
+	0x05, 0x00, 0x04, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x04, 0x08,
+	0x00, 0x80, 0x04, 0x08, 0xa2, 0x00, 0x00, 0x00, 0xa2, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xa4, 0x00, 0x00, 0x00, 0xa4, 0x90, 0x04, 0x08,
+	0xa4, 0x90, 0x04, 0x08, 0x09, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xba, 0x09, 0x00, 0x00, 0x00, 0xb9, 0x07, 0x90, 0x04, 0x08, 0xbb, 0x01, 0x00, 0x00, 0x00, 0xb8,
+	0x04, 0x00, 0x00, 0x00, 0xcd, 0x80, 0xbb, 0x00, 0x00, 0x00, 0x00, 0xb8, 0x01, 0x00, 0x00, 0x00,
+	0xcd, 0x80, 0x00, 0x00
+};
+
+/**
+ * Smoke tests of the in-process decompiler.
+ *
+ * The whole pipeline runs without the support directory, i.e. without
+ * signatures of statically linked code and type information.
+ */
+class DecompilerTests : public Test
+{
+	protected:
+		std::vector<std::string> tmpFiles;
+
+		virtual void TearDown() override
+		{
+			for (const auto& file : tmpFiles)
+			{
+				llvm::sys::fs::remove(file);
+			}
+		}
+
+		std::string createTmpFile(
+				const std::string& suffix,
+				const std::vector<uint8_t>& bytes = {})
+		{
+			llvm::SmallString<128> path;
+			if (llvm::sys::fs::createTemporaryFile("retdec-tests-decompiler", suffix, path))
+			{
+				return {};
+			}
+			tmpFiles.push_back(path.str());
+
+			std::ofstream stream(path.str(), std::ios::out | std::ios::binary);
+			stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+			return path.str();
+		}
+
+		static std::string readFile(const std::string& path)
+		{
+			std::ifstream stream(path, std::ios::in | std::ios::binary);
+			std::ostringstream content;
+			content << stream.rdbuf();
+			return content.str();
+		}
+
+		DecompilationParams createParams()
+		{
+			DecompilationParams params;
+			params.inputFile = createTmpFile("elf", elfBytes);
+			params.outputFile = createTmpFile("c");
+			params.noDefaultStaticSignatures = true;
+			params.backendOptions.debug = false;
+			params.backendOptions.validateModule = true;
+			return params;
+		}
+};
+
+TEST_F(DecompilerTests, ExecutableIsDecompiledIntoC)
+{
+	auto params = createParams();
+	params.outputConfigFile = createTmpFile("json");
+	retdec::config::Config config;
+
+	ASSERT_NO_THROW(decompile(params, config));
+
+	EXPECT_TRUE(config.architecture.isX86());
+	EXPECT_TRUE(config.fileFormat.isElf());
+	EXPECT_FALSE(config.functions.empty());
+
+	auto output = readFile(params.outputFile);
+	EXPECT_NE(std::string::npos, output.find("entry_point"));
+	EXPECT_FALSE(readFile(params.outputConfigFile).empty());
+}
+
+TEST_F(DecompilerTests, ExecutableIsDecompiledIntoPython)
+{
+	auto params = createParams();
+	params.backendOptions.targetHll = "py";
+	params.keepUnreachableFuncs = true;
+	retdec::config::Config config;
+
+	ASSERT_NO_THROW(decompile(params, config));
+	EXPECT_NE(std::string::npos, readFile(params.outputFile).find("def "));
+}
+
+TEST_F(DecompilerTests, UnknownFileFormatThrows)
+{
+	auto params = createParams();
+	params.inputFile = createTmpFile("bin", {'n', 'o', 't', ' ', 'a', 'n', ' ', 'e', 'x', 'e'});
+	retdec::config::Config config;
+
+	EXPECT_THROW(decompile(params, config), DecompilationError);
+}
+
+} // namespace tests
+} // namespace decompiler
+} // namespace retdec
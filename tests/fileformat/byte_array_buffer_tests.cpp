@@ -0,0 +1,102 @@
+/**
+* @file tests/fileformat/byte_array_buffer_tests.cpp
+* @brief Tests for the @c byte_array_buffer module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/utils/byte_array_buffer.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+class ByteArrayBufferTests : public Test
+{
+	protected:
+		const std::vector<std::uint8_t> data = {'a', 'b', 'c', 'd', 'e', 'f'};
+};
+
+TEST_F(ByteArrayBufferTests, ReadOfMultipleBytesReturnsThem)
+{
+	byte_array_buffer buff(data.data(), data.size());
+	std::istream stream(&buff);
+
+	char read[4] = {};
+	stream.read(read, 3);
+
+	EXPECT_EQ(3, stream.gcount());
+	EXPECT_EQ("abc", std::string(read));
+	EXPECT_EQ('d', stream.get());
+}
+
+TEST_F(ByteArrayBufferTests, ReadPastEndSetsEofAndReturnsRemainingBytes)
+{
+	byte_array_buffer buff(data.data(), data.size());
+	std::istream stream(&buff);
+	stream.seekg(4);
+
+	char read[4] = {};
+	stream.read(read, 3);
+
+	EXPECT_TRUE(stream.eof());
+	EXPECT_EQ(2, stream.gcount());
+	EXPECT_EQ("ef", std::string(read));
+}
+
+TEST_F(ByteArrayBufferTests, SeekRelativeToAllDirectionsMovesReadPosition)
+{
+	byte_array_buffer buff(data.data(), data.size());
+	std::istream stream(&buff);
+
+	stream.seekg(2, std::ios_base::beg);
+	EXPECT_EQ('c', stream.get());
+	stream.seekg(1, std::ios_base::cur);
+	EXPECT_EQ('e', stream.get());
+	stream.seekg(-5, std::ios_base::end);
+	EXPECT_EQ('b', stream.get());
+	stream.seekg(0, std::ios_base::end);
+	EXPECT_EQ(6, stream.tellg());
+}
+
+TEST_F(ByteArrayBufferTests, SeekOutsideOfDataFails)
+{
+	byte_array_buffer buff(data.data(), data.size());
+	std::istream stream(&buff);
+
+	stream.seekg(7);
+
+	EXPECT_TRUE(stream.fail());
+}
+
+TEST_F(ByteArrayBufferTests, UngetAfterReadReturnsPreviousByte)
+{
+	byte_array_buffer buff(data.data(), data.size());
+	std::istream stream(&buff);
+	stream.get();
+	stream.get();
+
+	stream.unget();
+
+	EXPECT_EQ('b', stream.get());
+}
+
+TEST_F(ByteArrayBufferTests, EmptyDataReadsNothing)
+{
+	byte_array_buffer buff(nullptr, std::size_t(0));
+	std::istream stream(&buff);
+
+	EXPECT_EQ(std::istream::traits_type::eof(), stream.get());
+	EXPECT_TRUE(stream.eof());
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -4,7 +4,12 @@
 * @copyright (c) 2019 Avast Software, licensed under the MIT license
 */
 
+#include <cstdio>
+#include <fstream>
+
 #include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
 
 #include "retdec/fileformat/fileformat.h"
 #include "retdec/fileformat/format_factory.h"
@@ -88,6 +93,69 @@ TEST_F(FileFormatFactoryTests, CreatePe_data)
 			createFileFormat(peBytes.data(), peBytes.size()).get()));
 }
 
+/**
+ * Write @p bytes into a new temporary file
+ * @return Path to the created file
+ */
+std::string writeTemporaryFile(const std::vector<uint8_t>& bytes)
+{
+	llvm::SmallString<128> path;
+	EXPECT_FALSE(llvm::sys::fs::createTemporaryFile(
+			"retdec-tests-fileformat-mmap", "exe", path));
+
+	std::ofstream file(path.str().str(), std::ios::binary);
+	file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	return path.str().str();
+}
+
+TEST_F(FileFormatFactoryTests, CreatePe_mmap)
+{
+	// Small files are read into memory by LLVM, so make the input large
+	// enough to be really mapped. Zeros at the end form an overlay.
+	auto bytes = peBytes;
+	bytes.resize(1024 * 1024);
+	const auto path = writeTemporaryFile(bytes);
+
+	auto format = createFileFormat(path, false, LoadFlags::MEMORY_MAP_INPUT);
+	EXPECT_TRUE(dynamic_cast<PeFormat*>(format.get()));
+	EXPECT_TRUE(format->isMemoryMapped());
+	EXPECT_EQ(bytes, std::vector<uint8_t>(
+			format->getBytes().begin(), format->getBytes().end()));
+
+	format.reset();
+	std::remove(path.c_str());
+}
+
+TEST_F(FileFormatFactoryTests, CreatePe_mmapSmallFileIsRead)
+{
+	const auto path = writeTemporaryFile(peBytes);
+
+	auto format = createFileFormat(path, false, LoadFlags::MEMORY_MAP_INPUT);
+	EXPECT_TRUE(dynamic_cast<PeFormat*>(format.get()));
+	EXPECT_FALSE(format->isMemoryMapped());
+	EXPECT_EQ(peBytes, std::vector<uint8_t>(
+			format->getBytes().begin(), format->getBytes().end()));
+
+	format.reset();
+	std::remove(path.c_str());
+}
+
+TEST_F(FileFormatFactoryTests, CreatePe_noMmapWithoutFlag)
+{
+	auto bytes = peBytes;
+	bytes.resize(1024 * 1024);
+	const auto path = writeTemporaryFile(bytes);
+
+	auto format = createFileFormat(path);
+	EXPECT_TRUE(dynamic_cast<PeFormat*>(format.get()));
+	EXPECT_FALSE(format->isMemoryMapped());
+	EXPECT_EQ(bytes, std::vector<uint8_t>(
+			format->getBytes().begin(), format->getBytes().end()));
+
+	format.reset();
+	std::remove(path.c_str());
+}
+
 TEST_F(FileFormatFactoryTests, CreateIhex_istream)
 {
 	std::stringstream stream;
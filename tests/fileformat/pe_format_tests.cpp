@@ -5,6 +5,8 @@
 */
 
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -204,6 +206,347 @@ TEST_F(PeFormatTests_data, DataInterpretationDefault)
 	EXPECT_EQ(0x105d0040103805c7, res);
 }
 
+/**
+ * PE file with one resource (RT_RCDATA) and a valid Authenticode signature
+ * with a self-signed certificate.
+ */
+const std::vector<uint8_t> signedPeBytes =
+{
+	0x4d, 0x5a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x00, 0x00, 0x00, 0x50, 0x45, 0x00, 0x00, 0x4c, 0x01, 0x02, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0x00, 0x02, 0x01, 0x0b, 0x01, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x30, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00,
+	0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00,
+	0x58, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x06, 0x00, 0x00, 0x68, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x2e, 0x74, 0x65, 0x78, 0x74, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x20, 0x00, 0x00, 0x60, 0x2e, 0x72, 0x73, 0x72, 0x63, 0x00, 0x00, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc3, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0a, 0x00, 0x00, 0x00,
+	0x18, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x30, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x09, 0x04, 0x00, 0x00,
+	0x48, 0x00, 0x00, 0x00, 0x60, 0x20, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x52, 0x65, 0x74, 0x44, 0x65, 0x63, 0x20, 0x72,
+	0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 0x64, 0x61, 0x74, 0x61,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x61, 0x03, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00, 0x30, 0x82, 0x03, 0x55,
+	0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x02, 0xa0,
+	0x82, 0x03, 0x46, 0x30, 0x82, 0x03, 0x42, 0x02, 0x01, 0x01, 0x31, 0x0f,
+	0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02,
+	0x01, 0x05, 0x00, 0x30, 0x56, 0x06, 0x0a, 0x2b, 0x06, 0x01, 0x04, 0x01,
+	0x82, 0x37, 0x02, 0x01, 0x04, 0xa0, 0x48, 0x30, 0x46, 0x30, 0x11, 0x06,
+	0x0a, 0x2b, 0x06, 0x01, 0x04, 0x01, 0x82, 0x37, 0x02, 0x01, 0x0f, 0x30,
+	0x03, 0x03, 0x01, 0x00, 0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86,
+	0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20, 0xf5,
+	0xee, 0xe5, 0xea, 0xb1, 0xf6, 0x17, 0xac, 0x23, 0xa1, 0x62, 0x80, 0x75,
+	0x48, 0x7b, 0xdd, 0xc0, 0x0c, 0xea, 0x53, 0x5d, 0x21, 0x1b, 0x53, 0x99,
+	0x21, 0x4b, 0x07, 0x04, 0xa7, 0x09, 0x3d, 0xa0, 0x82, 0x01, 0xb3, 0x30,
+	0x82, 0x01, 0xaf, 0x30, 0x82, 0x01, 0x18, 0xa0, 0x03, 0x02, 0x01, 0x02,
+	0x02, 0x02, 0x12, 0x34, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+	0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x1d, 0x31, 0x1b, 0x30,
+	0x19, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x12, 0x52, 0x65, 0x74, 0x44,
+	0x65, 0x63, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x53, 0x69, 0x67, 0x6e,
+	0x65, 0x72, 0x30, 0x1e, 0x17, 0x0d, 0x31, 0x39, 0x30, 0x31, 0x30, 0x31,
+	0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x34, 0x39, 0x30,
+	0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30, 0x1d,
+	0x31, 0x1b, 0x30, 0x19, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x12, 0x52,
+	0x65, 0x74, 0x44, 0x65, 0x63, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x53,
+	0x69, 0x67, 0x6e, 0x65, 0x72, 0x30, 0x81, 0x9f, 0x30, 0x0d, 0x06, 0x09,
+	0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03,
+	0x81, 0x8d, 0x00, 0x30, 0x81, 0x89, 0x02, 0x81, 0x81, 0x00, 0xcb, 0xd2,
+	0x80, 0x06, 0xcc, 0x79, 0x51, 0x12, 0x51, 0x71, 0xe6, 0x73, 0xff, 0x31,
+	0xbc, 0x6a, 0x5b, 0xe0, 0xa7, 0x6e, 0x1b, 0xd3, 0xa1, 0x01, 0x13, 0x15,
+	0xe3, 0x86, 0xdb, 0x90, 0xbd, 0xc3, 0x76, 0x9a, 0x6a, 0x72, 0x1a, 0xf7,
+	0x26, 0x22, 0x8b, 0x55, 0xe0, 0xe9, 0x2d, 0x33, 0x8c, 0x65, 0xee, 0xf6,
+	0xa5, 0x85, 0xc0, 0x8a, 0x00, 0xd3, 0xca, 0x93, 0xcb, 0x49, 0x05, 0x71,
+	0xdc, 0xf5, 0x90, 0x56, 0x5b, 0xa4, 0x94, 0xd0, 0x10, 0x54, 0x2d, 0xf9,
+	0xdb, 0xb1, 0x49, 0x69, 0x5c, 0x28, 0x63, 0xbf, 0x38, 0x8e, 0xad, 0x24,
+	0x62, 0x73, 0x16, 0x22, 0xf6, 0x4e, 0xd6, 0x5a, 0xd0, 0xa6, 0xa6, 0x0c,
+	0x44, 0x99, 0xca, 0xcc, 0xe7, 0x1b, 0x01, 0x4c, 0xbe, 0x73, 0xe4, 0x5c,
+	0xd0, 0xa0, 0x49, 0xce, 0x74, 0x44, 0x17, 0xb5, 0x4c, 0x04, 0x8c, 0xcf,
+	0xdc, 0x45, 0x6d, 0x2b, 0x8a, 0x17, 0x02, 0x03, 0x01, 0x00, 0x01, 0x30,
+	0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b,
+	0x05, 0x00, 0x03, 0x81, 0x81, 0x00, 0x48, 0x0b, 0x79, 0xa9, 0x7a, 0x09,
+	0x04, 0x0c, 0x9f, 0xab, 0x19, 0xe4, 0x36, 0xdd, 0x4d, 0x28, 0x49, 0xc7,
+	0x23, 0x37, 0x5e, 0x6e, 0x53, 0xe7, 0xb8, 0xa2, 0xae, 0x59, 0xf1, 0x43,
+	0xd7, 0x8e, 0x1a, 0x2d, 0x9d, 0x38, 0xb4, 0xaa, 0x07, 0x2c, 0x17, 0xec,
+	0xda, 0xde, 0x4b, 0x26, 0x48, 0x05, 0x1c, 0x8c, 0xe1, 0x85, 0x7c, 0x41,
+	0x2f, 0xd4, 0x5e, 0xe4, 0xa7, 0xee, 0x8e, 0x45, 0xa8, 0xf5, 0xb8, 0x77,
+	0x53, 0x97, 0x94, 0x0d, 0xfc, 0x1a, 0x5f, 0x37, 0xea, 0x6f, 0xf4, 0x67,
+	0x3a, 0xa7, 0x6c, 0xf9, 0xdb, 0x06, 0xa2, 0xde, 0x4f, 0xce, 0x6f, 0xea,
+	0x8c, 0xb1, 0xae, 0xe2, 0xa4, 0xc3, 0x74, 0x91, 0xdf, 0x45, 0x2e, 0x2a,
+	0x9b, 0xaa, 0xa1, 0xce, 0xa9, 0x8a, 0xf7, 0x53, 0xdb, 0x52, 0x76, 0x4d,
+	0x6e, 0x30, 0xbb, 0x18, 0xfd, 0xfa, 0x20, 0xa4, 0x3e, 0xda, 0x99, 0x5d,
+	0xed, 0x56, 0x31, 0x82, 0x01, 0x1b, 0x30, 0x82, 0x01, 0x17, 0x02, 0x01,
+	0x01, 0x30, 0x23, 0x30, 0x1d, 0x31, 0x1b, 0x30, 0x19, 0x06, 0x03, 0x55,
+	0x04, 0x03, 0x0c, 0x12, 0x52, 0x65, 0x74, 0x44, 0x65, 0x63, 0x20, 0x54,
+	0x65, 0x73, 0x74, 0x20, 0x53, 0x69, 0x67, 0x6e, 0x65, 0x72, 0x02, 0x02,
+	0x12, 0x34, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03,
+	0x04, 0x02, 0x01, 0x05, 0x00, 0xa0, 0x4c, 0x30, 0x19, 0x06, 0x09, 0x2a,
+	0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x09, 0x03, 0x31, 0x0c, 0x06, 0x0a,
+	0x2b, 0x06, 0x01, 0x04, 0x01, 0x82, 0x37, 0x02, 0x01, 0x04, 0x30, 0x2f,
+	0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x09, 0x04, 0x31,
+	0x22, 0x04, 0x20, 0x22, 0x4c, 0x4f, 0xc1, 0xd3, 0x13, 0xd5, 0x6e, 0xf4,
+	0xed, 0x4b, 0x05, 0x4b, 0x0e, 0x0d, 0xb1, 0x24, 0x2f, 0x79, 0x84, 0x7a,
+	0x65, 0x13, 0x27, 0x41, 0xfd, 0x96, 0x29, 0x96, 0x57, 0xa0, 0x62, 0x30,
+	0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01,
+	0x05, 0x00, 0x04, 0x81, 0x80, 0x46, 0x0e, 0x3a, 0x1d, 0x55, 0xd8, 0xee,
+	0xf9, 0x94, 0x87, 0x41, 0x7f, 0x22, 0x1b, 0x32, 0xad, 0x4d, 0xf4, 0xe3,
+	0x72, 0xfd, 0xf0, 0x65, 0xfa, 0x93, 0x66, 0x66, 0x3c, 0x23, 0x63, 0xdc,
+	0xc9, 0x24, 0x1a, 0x29, 0x4b, 0x1e, 0xd5, 0x93, 0xe6, 0x10, 0xb9, 0x83,
+	0xd6, 0x2f, 0x9a, 0x2b, 0xa5, 0x57, 0xc1, 0xb8, 0x77, 0x4c, 0x1c, 0x26,
+	0xae, 0xf1, 0xb0, 0x47, 0x69, 0xee, 0x20, 0xa7, 0xe2, 0x70, 0x11, 0x89,
+	0x29, 0x3f, 0xbe, 0xf4, 0xec, 0x5f, 0x03, 0x6b, 0x81, 0x7a, 0xc7, 0x50,
+	0x94, 0xd4, 0xb2, 0x3d, 0xcd, 0xf6, 0x2d, 0x15, 0xeb, 0xf8, 0xf8, 0xfd,
+	0x03, 0x82, 0xb4, 0x00, 0xce, 0x20, 0x71, 0x68, 0xb3, 0x9d, 0x9a, 0x9a,
+	0xed, 0x92, 0x0a, 0x15, 0xe6, 0x3a, 0x8a, 0xa7, 0x82, 0x92, 0x5a, 0xef,
+	0xda, 0xa5, 0x4c, 0x1e, 0x80, 0x68, 0x41, 0xff, 0x30, 0xb8, 0x01, 0x07,
+	0xd4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+/**
+ * Tests for the @c pe_format module - lazy loading of components.
+ */
+class PeFormatTests_lazy : public Test
+{
+	protected:
+		std::unique_ptr<PeFormat> eagerParser;
+		std::unique_ptr<PeFormat> lazyParser;
+	public:
+		PeFormatTests_lazy()
+		{
+			eagerParser = std::make_unique<PeFormat>(
+					signedPeBytes.data(),
+					signedPeBytes.size());
+			lazyParser = std::make_unique<PeFormat>(
+					signedPeBytes.data(),
+					signedPeBytes.size(),
+					LoadFlags::LAZY_COMPONENTS);
+		}
+};
+
+TEST_F(PeFormatTests_lazy, ResourceTableIsSame)
+{
+	auto* eager = eagerParser->getResourceTable();
+	auto* lazy = lazyParser->getResourceTable();
+
+	ASSERT_NE(nullptr, eager);
+	ASSERT_NE(nullptr, lazy);
+	ASSERT_EQ(1, eager->getNumberOfResources());
+	ASSERT_EQ(eager->getNumberOfResources(), lazy->getNumberOfResources());
+	for(std::size_t i = 0; i < eager->getNumberOfResources(); ++i)
+	{
+		auto* eagerRes = eager->getResource(i);
+		auto* lazyRes = lazy->getResource(i);
+		std::size_t eagerType = 0, lazyType = 0;
+		EXPECT_TRUE(eagerRes->getTypeId(eagerType));
+		EXPECT_TRUE(lazyRes->getTypeId(lazyType));
+		EXPECT_EQ(eagerType, lazyType);
+		EXPECT_EQ(eagerRes->getName(), lazyRes->getName());
+		EXPECT_EQ(eagerRes->getLanguage(), lazyRes->getLanguage());
+		EXPECT_EQ(eagerRes->getOffset(), lazyRes->getOffset());
+		EXPECT_EQ(eagerRes->getSizeInFile(), lazyRes->getSizeInFile());
+		EXPECT_EQ(eagerRes->getBytes(), lazyRes->getBytes());
+	}
+}
+
+TEST_F(PeFormatTests_lazy, CertificateTableIsSame)
+{
+	auto* eager = eagerParser->getCertificateTable();
+	auto* lazy = lazyParser->getCertificateTable();
+
+	ASSERT_NE(nullptr, eager);
+	ASSERT_NE(nullptr, lazy);
+	ASSERT_EQ(1, eager->getNumberOfCertificates());
+	ASSERT_EQ(eager->getNumberOfCertificates(), lazy->getNumberOfCertificates());
+	EXPECT_EQ(eager->getSignerCertificateIndex(), lazy->getSignerCertificateIndex());
+	for(std::size_t i = 0; i < eager->getNumberOfCertificates(); ++i)
+	{
+		auto* eagerCert = eager->getCertificate(i);
+		auto* lazyCert = lazy->getCertificate(i);
+		EXPECT_EQ(eagerCert->getSerialNumber(), lazyCert->getSerialNumber());
+		EXPECT_EQ(eagerCert->getRawSubject(), lazyCert->getRawSubject());
+		EXPECT_EQ(eagerCert->getRawIssuer(), lazyCert->getRawIssuer());
+		EXPECT_EQ(eagerCert->getPublicKey(), lazyCert->getPublicKey());
+	}
+}
+
+TEST_F(PeFormatTests_lazy, SignatureIsVerified)
+{
+	EXPECT_TRUE(eagerParser->isSignaturePresent());
+	EXPECT_TRUE(lazyParser->isSignaturePresent());
+	EXPECT_TRUE(eagerParser->isSignatureVerified());
+	EXPECT_TRUE(lazyParser->isSignatureVerified());
+}
+
+TEST_F(PeFormatTests_lazy, NonDecodableAddressRangesAreSame)
+{
+	const auto& eager = eagerParser->getNonDecodableAddressRanges();
+	const auto& lazy = lazyParser->getNonDecodableAddressRanges();
+
+	// The resource directory is not decodable.
+	EXPECT_FALSE(eager.empty());
+	ASSERT_EQ(eager.size(), lazy.size());
+	for(std::size_t i = 0; i < eager.size(); ++i)
+	{
+		EXPECT_EQ(eager[i].getStart(), lazy[i].getStart());
+		EXPECT_EQ(eager[i].getEnd(), lazy[i].getEnd());
+	}
+}
+
+TEST_F(PeFormatTests_lazy, DotnetAndVisualBasicInformationIsSame)
+{
+	unsigned long long eagerVersion = 0, lazyVersion = 0;
+
+	EXPECT_FALSE(eagerParser->isDotNet());
+	EXPECT_FALSE(lazyParser->isDotNet());
+	EXPECT_EQ(eagerParser->isPackedDotNet(), lazyParser->isPackedDotNet());
+	EXPECT_EQ(eagerParser->getCLRHeader(), lazyParser->getCLRHeader());
+	EXPECT_EQ(
+			eagerParser->isVisualBasic(eagerVersion),
+			lazyParser->isVisualBasic(lazyVersion));
+	EXPECT_EQ(
+			eagerParser->getVisualBasicInfo()->getProjectName(),
+			lazyParser->getVisualBasicInfo()->getProjectName());
+}
+
+TEST_F(PeFormatTests_lazy, FirstAccessFromSeveralThreadsLoadsComponentsOnce)
+{
+	std::vector<std::thread> threads;
+	std::vector<const ResourceTable*> resourceTables(8);
+	std::vector<const CertificateTable*> certificateTables(8);
+	for(std::size_t i = 0; i < resourceTables.size(); ++i)
+	{
+		threads.emplace_back([&, i]() {
+			resourceTables[i] = lazyParser->getResourceTable();
+			certificateTables[i] = lazyParser->getCertificateTable();
+		});
+	}
+	for(auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for(std::size_t i = 0; i < resourceTables.size(); ++i)
+	{
+		EXPECT_NE(nullptr, resourceTables[i]);
+		EXPECT_EQ(resourceTables[0], resourceTables[i]);
+		EXPECT_NE(nullptr, certificateTables[i]);
+		EXPECT_EQ(certificateTables[0], certificateTables[i]);
+	}
+}
+
 } // namespace tests
 } // namespace fileformat
 } // namespace retdec
@@ -0,0 +1,172 @@
+/**
+ * @file tests/fileformat/string_scanner_tests.cpp
+ * @brief Tests for the @c string_scanner module.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/strings/string.h"
+#include "retdec/fileformat/types/strings/string_scanner.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+class StringScannerTests : public Test
+{
+	protected:
+		static std::vector<std::uint8_t> toBytes(const std::string &str)
+		{
+			return std::vector<std::uint8_t>(str.begin(), str.end());
+		}
+
+		/**
+		 * Runs found by the character iterator (the original algorithm
+		 * of FileFormat::loadStrings()).
+		 */
+		static std::vector<StringRun> findRunsByIterator(const std::vector<std::uint8_t> &data, std::size_t size,
+			std::size_t charSize, CharacterEndianness endian)
+		{
+			std::vector<StringRun> runs;
+			auto begin = data.begin(), end = data.begin() + size;
+			for (auto itr = begin; itr != end;)
+			{
+				if (makeCharacterIterator(itr, begin, end, charSize).pointsToValidCharacter(endian))
+				{
+					auto stringBeginItr = makeCharacterIterator(itr, begin, end, charSize);
+					auto stringDataEndItr = makeCharacterIterator(end, begin, end, charSize);
+					auto stringEndItr = stringBeginItr + 1;
+					while (stringEndItr != stringDataEndItr && stringEndItr.pointsToValidCharacter(endian))
+						++stringEndItr;
+
+					auto length = static_cast<std::size_t>(stringEndItr - stringBeginItr);
+					if (length >= 4)
+						runs.push_back({static_cast<std::size_t>(itr - begin), length});
+
+					itr = stringEndItr.getUnderlyingIterator();
+				}
+				else
+					++itr;
+			}
+			return runs;
+		}
+
+		static void expectSameRuns(const std::vector<StringRun> &expected, const std::vector<StringRun> &runs)
+		{
+			ASSERT_EQ(expected.size(), runs.size());
+			for (std::size_t i = 0; i < runs.size(); ++i)
+			{
+				EXPECT_EQ(expected[i].offset, runs[i].offset);
+				EXPECT_EQ(expected[i].length, runs[i].length);
+			}
+		}
+};
+
+TEST_F(StringScannerTests, AsciiRunsShorterThanMinimalLengthAreNotFound)
+{
+	auto data = toBytes(std::string("abc\0abcd\x01xy\x7F" "hello world", 23));
+	StringScanner scanner(data.data(), data.size());
+
+	auto runs = scanner.findAsciiRuns(4);
+
+	expectSameRuns({{4, 4}, {12, 11}}, runs);
+}
+
+TEST_F(StringScannerTests, LittleEndianWideRunsAreFound)
+{
+	auto data = toBytes(std::string("\xFF" "a\0b\0c\0d\0\xFF\xFF" "x\0y\0", 15));
+	StringScanner scanner(data.data(), data.size());
+
+	auto runs = scanner.findWideRuns(4, CharacterEndianness::Little);
+
+	expectSameRuns({{1, 4}}, runs);
+}
+
+TEST_F(StringScannerTests, BigEndianWideRunsAreFound)
+{
+	auto data = toBytes(std::string("\0a\0b\0c\0d\0e", 10));
+	StringScanner scanner(data.data(), data.size());
+
+	auto runs = scanner.findWideRuns(4, CharacterEndianness::Big);
+
+	expectSameRuns({{0, 5}}, runs);
+}
+
+TEST_F(StringScannerTests, RunsReachingEndOfDataAreFound)
+{
+	// More than one block of bytes.
+	std::string str(100, 'a');
+	auto data = toBytes(str);
+	StringScanner scanner(data.data(), data.size());
+
+	expectSameRuns({{0, 100}}, scanner.findAsciiRuns(4));
+	expectSameRuns({}, scanner.findWideRuns(4, CharacterEndianness::Little));
+}
+
+TEST_F(StringScannerTests, EmptyDataContainNoRuns)
+{
+	StringScanner scanner(nullptr, 0);
+
+	EXPECT_TRUE(scanner.findAsciiRuns(4).empty());
+	EXPECT_TRUE(scanner.findWideRuns(4, CharacterEndianness::Little).empty());
+}
+
+TEST_F(StringScannerTests, RunsAreSameAsRunsFoundByCharacterIterator)
+{
+	// Mix of random bytes, ASCII and wide strings, with sizes not aligned
+	// to blocks of the scanner.
+	std::vector<std::uint8_t> data;
+	std::uint32_t seed = 12345;
+	auto random = [&]() { seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7FFF; };
+	while (data.size() < 10000)
+	{
+		auto kind = random() % 4;
+		auto length = random() % 20;
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			auto c = static_cast<std::uint8_t>(0x20 + random() % 0x5F);
+			if (kind == 0)
+				data.push_back(static_cast<std::uint8_t>(random()));
+			else if (kind == 1)
+				data.push_back(c);
+			else
+			{
+				data.push_back(kind == 2 ? c : 0);
+				data.push_back(kind == 2 ? 0 : c);
+			}
+		}
+	}
+	auto size = data.size();
+	// The character iterator may look at the byte after the end of data.
+	data.push_back(0xFF);
+
+	StringScanner scanner(data.data(), size);
+
+	expectSameRuns(findRunsByIterator(data, size, 1, CharacterEndianness::Little),
+		scanner.findAsciiRuns(4));
+	expectSameRuns(findRunsByIterator(data, size, 2, CharacterEndianness::Little),
+		scanner.findWideRuns(4, CharacterEndianness::Little));
+	expectSameRuns(findRunsByIterator(data, size, 2, CharacterEndianness::Big),
+		scanner.findWideRuns(4, CharacterEndianness::Big));
+}
+
+TEST_F(StringScannerTests, StringFromScannedDataOutlivesData)
+{
+	auto data = std::make_unique<std::string>("h\0e\0l\0l\0o\0", 10);
+	String str(StringType::Wide, 0, ".data", data->data(), 5, 2);
+	data.reset();
+
+	EXPECT_EQ("hello", str.getContent());
+	EXPECT_EQ(String(StringType::Wide, 0, ".data", "hello"), str);
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,186 @@
+/**
+* @file tests/fileinfo/batch_input_tests.cpp
+* @brief Tests for the @c batch_input module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fileinfo/batch_input/batch_input.h"
+
+using namespace ::testing;
+
+namespace fileinfo {
+namespace tests {
+
+/**
+ * Tests for the @c batch_input module.
+ *
+ * Each test works in its own temporary directory.
+ */
+class BatchInputTests : public Test
+{
+	protected:
+		std::string dir;
+		std::vector<std::string> created;
+		BatchInput input;
+
+		virtual void SetUp() override
+		{
+			char name[] = "/tmp/retdec-tests-fileinfo-XXXXXX";
+			ASSERT_NE(nullptr, mkdtemp(name));
+			dir = name;
+		}
+
+		virtual void TearDown() override
+		{
+			// Created files and directories in reverse order, so every
+			// directory is empty when it is removed.
+			for(auto it = created.rbegin(); it != created.rend(); ++it)
+			{
+				std::remove(it->c_str());
+			}
+			rmdir(dir.c_str());
+		}
+
+		std::string makeDir(const std::string &name)
+		{
+			auto path = dir + "/" + name;
+			mkdir(path.c_str(), 0755);
+			created.push_back(path);
+			return path;
+		}
+
+		std::string writeFile(const std::string &name)
+		{
+			auto path = dir + "/" + name;
+			std::ofstream(path) << name;
+			created.push_back(path);
+			return path;
+		}
+
+		std::vector<std::string> readAll()
+		{
+			std::vector<std::string> result;
+			std::string path;
+			while(input.next(path))
+			{
+				result.push_back(path);
+			}
+			return result;
+		}
+};
+
+TEST_F(BatchInputTests, FilesFromCommandLineComeBeforeFilesFromList)
+{
+	std::istringstream list("c\nd\n");
+	input.init({"a", "b"}, &list);
+
+	EXPECT_EQ(std::vector<std::string>({"a", "b", "c", "d"}), readAll());
+}
+
+TEST_F(BatchInputTests, EmptyLinesAndCarriageReturnsInListAreSkipped)
+{
+	std::istringstream list("a\r\n\n\r\nb\nc");
+	input.init({}, &list);
+
+	EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), readAll());
+}
+
+TEST_F(BatchInputTests, MissingFilesAreReturnedAsTheyAre)
+{
+	input.init({dir + "/missing"}, nullptr);
+
+	EXPECT_EQ(std::vector<std::string>({dir + "/missing"}), readAll());
+}
+
+TEST_F(BatchInputTests, FilesInDirectoriesAreFoundRecursively)
+{
+	makeDir("sub");
+	makeDir("sub/nested");
+	auto first = writeFile("first");
+	auto second = writeFile("sub/second");
+	auto third = writeFile("sub/nested/third");
+	input.init({dir}, nullptr);
+
+	auto files = readAll();
+	std::sort(files.begin(), files.end());
+	std::vector<std::string> expected = {first, second, third};
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(expected, files);
+}
+
+TEST_F(BatchInputTests, ListIsReadFromFile)
+{
+	auto list = writeFile("list");
+	std::ofstream(list) << "a\nb\n";
+
+	ASSERT_TRUE(input.init({}, list));
+	EXPECT_EQ(std::vector<std::string>({"a", "b"}), readAll());
+}
+
+TEST_F(BatchInputTests, MissingListCanNotBeOpened)
+{
+	EXPECT_FALSE(input.init({}, dir + "/missing"));
+}
+
+TEST_F(BatchInputTests, EveryFileIsReturnedOnceToSeveralThreads)
+{
+	const std::size_t NUM_OF_FILES = 1000;
+	const std::size_t NUM_OF_THREADS = 8;
+	std::vector<std::string> files;
+	std::ostringstream listContent;
+	for(std::size_t i = 0; i < NUM_OF_FILES; ++i)
+	{
+		files.push_back("cmd" + std::to_string(i));
+		listContent << "list" << i << "\n";
+	}
+	std::istringstream list(listContent.str());
+	input.init(files, &list);
+
+	std::vector<std::vector<std::string>> results(NUM_OF_THREADS);
+	std::vector<std::thread> threads;
+	for(std::size_t t = 0; t < NUM_OF_THREADS; ++t)
+	{
+		threads.emplace_back([&, t]()
+		{
+			std::string path;
+			while(input.next(path))
+			{
+				results[t].push_back(path);
+			}
+		});
+	}
+	for(auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	std::vector<std::string> all;
+	for(const auto &result : results)
+	{
+		all.insert(all.end(), result.begin(), result.end());
+	}
+	for(std::size_t i = 0; i < NUM_OF_FILES; ++i)
+	{
+		files.push_back("list" + std::to_string(i));
+	}
+	std::sort(all.begin(), all.end());
+	std::sort(files.begin(), files.end());
+	EXPECT_EQ(files, all);
+}
+
+} // namespace tests
+} // namespace fileinfo
@@ -0,0 +1,80 @@
+/**
+* @file tests/fileinfo/json_presentation_tests.cpp
+* @brief Tests for the @c json_presentation module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <json/json.h>
+
+#include "fileinfo/file_presentation/json_presentation.h"
+
+using namespace ::testing;
+using namespace retdec::cpdetect;
+
+namespace fileinfo {
+namespace tests {
+
+/**
+ * Tests for the @c json_presentation module.
+ */
+class JsonPresentationTests : public Test
+{
+	protected:
+		FileInformation fileinfo;
+
+		static bool parse(const std::string &line, Json::Value &root)
+		{
+			Json::CharReaderBuilder builder;
+			std::istringstream stream(line);
+			std::string errors;
+			return Json::parseFromStream(builder, stream, &root, &errors);
+		}
+};
+
+TEST_F(JsonPresentationTests, JsonLineIsOneValidObjectWithoutNewLines)
+{
+	fileinfo.setPathToFile("dir\nwith\r\nnew lines/file.exe");
+	fileinfo.setStatus(ReturnCode::FILE_NOT_EXIST);
+	fileinfo.setLoaderStatusMessage("first line\nsecond line");
+
+	for(bool verbose : {false, true})
+	{
+		auto line = JsonPresentation(fileinfo, verbose).getJsonLine();
+
+		EXPECT_EQ(std::string::npos, line.find('\n')) << line;
+		EXPECT_EQ(std::string::npos, line.find('\r')) << line;
+		Json::Value root;
+		ASSERT_TRUE(parse(line, root)) << line;
+		ASSERT_TRUE(root.isObject());
+		EXPECT_EQ("dir\nwith\r\nnew lines/file.exe", root["inputFile"].asString());
+	}
+}
+
+TEST_F(JsonPresentationTests, JsonLinesOfSeveralFilesFormNewlineDelimitedJson)
+{
+	FileInformation other;
+	fileinfo.setPathToFile("first");
+	other.setPathToFile("second");
+
+	std::istringstream output(JsonPresentation(fileinfo, false).getJsonLine() + "\n"
+		+ JsonPresentation(other, false).getJsonLine() + "\n");
+
+	std::vector<std::string> paths;
+	std::string line;
+	while(std::getline(output, line))
+	{
+		Json::Value root;
+		ASSERT_TRUE(parse(line, root)) << line;
+		ASSERT_TRUE(root.isObject());
+		paths.push_back(root["inputFile"].asString());
+	}
+	EXPECT_EQ(std::vector<std::string>({"first", "second"}), paths);
+}
+
+} // namespace tests
+} // namespace fileinfo
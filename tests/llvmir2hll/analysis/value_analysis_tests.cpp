@@ -1224,6 +1224,66 @@ DelegationOfMethodsToAliasAnalysis) {
 	va->initAliasAnalysis(module);
 }
 
+TEST_F(ValueAnalysisTests,
+CachedResultIsReturnedAndCountedAsHit) {
+	// Set-up the module.
+	//
+	// def test():
+	//    a
+	//
+	ShPtr<Variable> varA(Variable::create("a", IntType::create(32)));
+	ShPtr<VarDefStmt> varDefStmt(VarDefStmt::create(varA));
+	testFunc->setBody(varDefStmt);
+
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(true);
+
+	ShPtr<ValueData> data1(va->getValueData(varDefStmt));
+	ShPtr<ValueData> data2(va->getValueData(varDefStmt));
+	EXPECT_EQ(data1, data2);
+	EXPECT_EQ(1, va->getNumOfCacheHits());
+	EXPECT_EQ(1, va->getNumOfCacheMisses());
+}
+
+TEST_F(ValueAnalysisTests,
+RemoveFuncFromCacheRemovesOnlyValuesInThatFunction) {
+	// Set-up the module.
+	//
+	// def test():
+	//    a
+	//    a = 1
+	//
+	// def other():
+	//    b
+	//
+	ShPtr<Variable> varA(Variable::create("a", IntType::create(32)));
+	ShPtr<VarDefStmt> varDefStmtA(VarDefStmt::create(varA));
+	ShPtr<AssignStmt> assignStmtA(AssignStmt::create(varA,
+		ConstInt::create(1, 32)));
+	varDefStmtA->setSuccessor(assignStmtA);
+	testFunc->setBody(varDefStmtA);
+	ShPtr<Variable> varB(Variable::create("b", IntType::create(32)));
+	ShPtr<VarDefStmt> varDefStmtB(VarDefStmt::create(varB));
+	ShPtr<Function> otherFunc(addFuncDef("other"));
+	otherFunc->setBody(varDefStmtB);
+
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(true);
+
+	ShPtr<ValueData> dataA1(va->getValueData(varDefStmtA));
+	ShPtr<ValueData> dataAssignA1(va->getValueData(assignStmtA));
+	ShPtr<ValueData> dataB1(va->getValueData(varDefStmtB));
+
+	va->removeFuncFromCache(testFunc);
+
+	// Values in test() have to be computed again.
+	EXPECT_NE(dataA1, va->getValueData(varDefStmtA));
+	EXPECT_NE(dataAssignA1, va->getValueData(assignStmtA));
+	// Values in other() are still cached.
+	EXPECT_EQ(dataB1, va->getValueData(varDefStmtB));
+	EXPECT_EQ(1, va->getNumOfCacheHits());
+	EXPECT_EQ(5, va->getNumOfCacheMisses());
+	EXPECT_TRUE(va->isInValidState());
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
@@ -0,0 +1,174 @@
+/**
+* @file tests/llvmir2hll/optimizer/optimizer_manager_tests.cpp
+* @brief Tests for the @c optimizer_manager module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "llvmir2hll/analysis/tests_with_value_analysis.h"
+#include "llvmir2hll/hll/hll_writers/hll_writer_tests.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluators/c_arithm_expr_evaluator.h"
+#include "retdec/llvmir2hll/hll/hll_writer.h"
+#include "retdec/llvmir2hll/hll/hll_writers/c_hll_writer.h"
+#include "retdec/llvmir2hll/ir/add_op_expr.h"
+#include "retdec/llvmir2hll/ir/address_op_expr.h"
+#include "retdec/llvmir2hll/ir/assign_stmt.h"
+#include "retdec/llvmir2hll/ir/call_expr.h"
+#include "retdec/llvmir2hll/ir/const_int.h"
+#include "retdec/llvmir2hll/ir/deref_op_expr.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/function_builder.h"
+#include "retdec/llvmir2hll/ir/if_stmt.h"
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/lt_op_expr.h"
+#include "retdec/llvmir2hll/ir/module.h"
+#include "retdec/llvmir2hll/ir/mul_op_expr.h"
+#include "retdec/llvmir2hll/ir/return_stmt.h"
+#include "retdec/llvmir2hll/ir/var_def_stmt.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/obtainer/call_info_obtainers/optim_call_info_obtainer.h"
+#include "retdec/llvmir2hll/optimizer/optimizer_manager.h"
+#include "retdec/llvmir2hll/support/types.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c optimizer_manager module.
+*
+* The default actions of the mocks needed to emit the code are taken from
+* HLLWriterTests.
+*/
+class OptimizerManagerTests: public HLLWriterTests {
+protected:
+	ShPtr<Module> createModuleWithFuncs(std::size_t numOfFuncs);
+	std::string optimizeAndEmit(ShPtr<Module> m, unsigned numThreads);
+};
+
+/**
+* @brief Creates a new module with @a numOfFuncs functions that give the
+*        optimizations something to do.
+*
+* The module has a global variable @c g initialized to @c 2 + 3. Every function @c fN (except the first one) looks like
+* @code
+* int fN(int a) {
+*     int b = a + N;
+*     int c = b * 2;
+*     int d = fN-1(c);
+*     if (c < 10) {
+*         return c;
+*     }
+*     g = *&g + (d + 0);
+*     return b;
+* }
+* @endcode
+*/
+ShPtr<Module> OptimizerManagerTests::createModuleWithFuncs(
+		std::size_t numOfFuncs) {
+	auto m = std::make_shared<Module>(&llvmModule,
+		llvmModule.getModuleIdentifier(), semanticsMock, configMock);
+
+	ShPtr<Variable> varG(Variable::create("g", IntType::create(32)));
+	m->addGlobalVar(varG, AddOpExpr::create(ConstInt::create(2, 32),
+		ConstInt::create(3, 32)));
+
+	ShPtr<Function> prevFunc;
+	for (std::size_t i = 0; i < numOfFuncs; ++i) {
+		ShPtr<Variable> varA(Variable::create("a", IntType::create(32)));
+		ShPtr<Variable> varB(Variable::create("b", IntType::create(32)));
+		ShPtr<Variable> varC(Variable::create("c", IntType::create(32)));
+		ShPtr<Variable> varD(Variable::create("d", IntType::create(32)));
+
+		// The global variable g is shared by all the functions, so its
+		// observers are changed from several threads at once.
+		ShPtr<Statement> tail(AssignStmt::create(varG,
+			AddOpExpr::create(
+				DerefOpExpr::create(AddressOpExpr::create(varG)),
+				AddOpExpr::create(varD, ConstInt::create(0, 32))),
+			ReturnStmt::create(varB)));
+		ShPtr<IfStmt> ifStmt(IfStmt::create(
+			LtOpExpr::create(varC, ConstInt::create(10, 32)),
+			ReturnStmt::create(varC), tail));
+		ShPtr<Expression> initD(prevFunc
+			? ShPtr<Expression>(CallExpr::create(prevFunc->getAsVar(),
+				ExprVector{varC}))
+			: ShPtr<Expression>(ConstInt::create(0, 32)));
+		ShPtr<VarDefStmt> varDefD(VarDefStmt::create(varD, initD, ifStmt));
+		ShPtr<VarDefStmt> varDefC(VarDefStmt::create(varC,
+			MulOpExpr::create(varB, ConstInt::create(2, 32)), varDefD));
+		ShPtr<VarDefStmt> varDefB(VarDefStmt::create(varB,
+			AddOpExpr::create(varA, ConstInt::create(i, 32)), varDefC));
+
+		ShPtr<Function> func(FunctionBuilder("f" + std::to_string(i))
+			.definitionWithBody(varDefB)
+			.withRetType(IntType::create(32))
+			.withParam(varA)
+			.withLocalVar(varB)
+			.withLocalVar(varC)
+			.withLocalVar(varD)
+			.build());
+		m->addFunc(func);
+		prevFunc = func;
+	}
+	return m;
+}
+
+/**
+* @brief Optimizes @a m by using @a numThreads threads and returns the code
+*        emitted for it.
+*/
+std::string OptimizerManagerTests::optimizeAndEmit(ShPtr<Module> m,
+		unsigned numThreads) {
+	std::string emittedCode;
+	llvm::raw_string_ostream emittedCodeStream(emittedCode);
+	ShPtr<HLLWriter> hllWriter(CHLLWriter::create(emittedCodeStream));
+	hllWriter->setOptionEmitTimeVaryingInfo(false);
+
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(m);
+	OptimizerManager optimizerManager(StringSet(), StringSet(), hllWriter,
+		va, OptimCallInfoObtainer::create(), CArithmExprEvaluator::create(),
+		false, false, numThreads);
+	optimizerManager.optimize(m);
+
+	hllWriter->emitTargetCode(m);
+	return emittedCodeStream.str();
+}
+
+TEST_F(OptimizerManagerTests,
+OptimizingFunctionsInParallelGivesSameCodeAsOptimizingThemSequentially) {
+	const std::size_t NUM_OF_FUNCS = 16;
+
+	auto sequentialCode = optimizeAndEmit(
+		createModuleWithFuncs(NUM_OF_FUNCS), 1);
+	auto parallelCode = optimizeAndEmit(
+		createModuleWithFuncs(NUM_OF_FUNCS), 4);
+
+	ASSERT_FALSE(sequentialCode.empty());
+	EXPECT_EQ(sequentialCode, parallelCode);
+}
+
+TEST_F(OptimizerManagerTests,
+GlobalVarInitializersAreOptimizedWhenFunctionsAreOptimizedInParallel) {
+	auto parallelCode = optimizeAndEmit(createModuleWithFuncs(4), 4);
+
+	EXPECT_EQ(std::string::npos, parallelCode.find("2 + 3"));
+}
+
+TEST_F(OptimizerManagerTests,
+MoreThreadsThanFunctionsGiveSameCodeAsOneThread) {
+	auto sequentialCode = optimizeAndEmit(createModuleWithFuncs(2), 1);
+	auto parallelCode = optimizeAndEmit(createModuleWithFuncs(2), 8);
+
+	EXPECT_EQ(sequentialCode, parallelCode);
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
@@ -396,6 +396,39 @@ DoNotOptimizeWhenAuxiliaryVariableIsExternal) {
 		"expected `" << returnB << "`, got `" << stmt3 << "`";
 }
 
+TEST_F(AuxiliaryVariablesOptimizerTests,
+RemovedStatementsAreRemovedFromCache) {
+	// Add a body to the testing function:
+	//
+	//   a = 1  (VarDefStmt)
+	//   b = a  (VarDefStmt)
+	//   return b
+	//
+	ShPtr<Variable> varA(Variable::create("a", IntType::create(16)));
+	ShPtr<Variable> varB(Variable::create("b", IntType::create(16)));
+	ShPtr<ConstInt> constInt1(ConstInt::create(llvm::APInt(16, 1)));
+	ShPtr<ReturnStmt> returnB(ReturnStmt::create(varB));
+	ShPtr<VarDefStmt> varDefB(
+		VarDefStmt::create(varB, varA, returnB));
+	ShPtr<VarDefStmt> varDefA(
+		VarDefStmt::create(varA, constInt1, varDefB));
+	testFunc->setBody(varDefA);
+
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(module);
+	va->enableCaching();
+	va->getValueData(varDefB);
+	ASSERT_TRUE(va->isInCache(varDefB));
+
+	// Optimize the module.
+	Optimizer::optimize<AuxiliaryVariablesOptimizer>(module, va,
+		OptimCallInfoObtainer::create());
+
+	// Check that the removed statement is no longer cached.
+	ASSERT_EQ(returnB, varDefA->getSuccessor()) <<
+		"expected `" << returnB << "`, got `" << varDefA->getSuccessor() << "`";
+	EXPECT_FALSE(va->isInCache(varDefB));
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
@@ -0,0 +1,198 @@
+/**
+* @file tests/llvmir2hll/support/subject_tests.cpp
+* @brief Tests for the @c subject module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/llvmir2hll/support/observer.h"
+#include "retdec/llvmir2hll/support/smart_ptr.h"
+#include "retdec/llvmir2hll/support/subject.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+namespace {
+
+/**
+* @brief A subject that can tell how many observers it has.
+*/
+class TestSubject: public Subject<TestSubject>,
+		public SharableFromThis<TestSubject> {
+public:
+	virtual ShPtr<TestSubject> getSelf() override {
+		return shared_from_this();
+	}
+
+	std::size_t getNumOfObservers() const {
+		return std::distance(observer_begin(), observer_end());
+	}
+};
+
+/**
+* @brief An observer that counts its notifications.
+*
+* Notifications are appended to @c order (if given), so their order can be
+* checked.
+*/
+class CountingObserver: public Observer<TestSubject> {
+public:
+	explicit CountingObserver(int id = 0, std::vector<int> *order = nullptr):
+		id(id), order(order) {}
+
+	virtual void update(ShPtr<TestSubject> subject,
+			ShPtr<TestSubject> arg) override {
+		++numOfUpdates;
+		if (order) {
+			order->push_back(id);
+		}
+	}
+
+	std::atomic<std::size_t> numOfUpdates{0};
+
+private:
+	int id;
+	std::vector<int> *order;
+};
+
+} // anonymous namespace
+
+/**
+* @brief Tests for the @c subject module.
+*/
+class SubjectTests: public Test {
+protected:
+	/// Number of threads used in tests of locking.
+	static const std::size_t NUM_OF_THREADS = 8;
+
+	/// Number of observers added by every thread.
+	static const std::size_t NUM_OF_OBSERVERS_PER_THREAD = 500;
+};
+
+TEST_F(SubjectTests,
+ObserversAreNotifiedInOrderOfAddition) {
+	auto subject = std::make_shared<TestSubject>();
+	std::vector<int> order;
+	auto first = std::make_shared<CountingObserver>(1, &order);
+	auto second = std::make_shared<CountingObserver>(2, &order);
+	auto third = std::make_shared<CountingObserver>(3, &order);
+	subject->addObserver(second);
+	subject->addObserver(first);
+	subject->addObserver(third);
+
+	subject->notifyObservers();
+
+	EXPECT_EQ(std::vector<int>({2, 1, 3}), order);
+}
+
+TEST_F(SubjectTests,
+RemovedObserverIsNotNotified) {
+	auto subject = std::make_shared<TestSubject>();
+	auto kept = std::make_shared<CountingObserver>();
+	auto removed = std::make_shared<CountingObserver>();
+	subject->addObserver(kept);
+	subject->addObserver(removed);
+
+	subject->removeObserver(removed);
+	subject->notifyObservers();
+
+	EXPECT_EQ(1, subject->getNumOfObservers());
+	EXPECT_EQ(1, kept->numOfUpdates);
+	EXPECT_EQ(0, removed->numOfUpdates);
+}
+
+TEST_F(SubjectTests,
+RemovingObserverThatWasNotAddedKeepsOtherObservers) {
+	auto subject = std::make_shared<TestSubject>();
+	auto first = std::make_shared<CountingObserver>();
+	auto second = std::make_shared<CountingObserver>();
+	subject->addObserver(first);
+	subject->addObserver(second);
+
+	subject->removeObserver(std::make_shared<CountingObserver>());
+
+	EXPECT_EQ(2, subject->getNumOfObservers());
+}
+
+TEST_F(SubjectTests,
+AllNonExistingObserversAreRemovedUponNotification) {
+	auto subject = std::make_shared<TestSubject>();
+	auto kept = std::make_shared<CountingObserver>();
+	subject->addObserver(std::make_shared<CountingObserver>());
+	subject->addObserver(kept);
+	subject->addObserver(std::make_shared<CountingObserver>());
+	subject->addObserver(std::make_shared<CountingObserver>());
+
+	subject->notifyObservers();
+
+	EXPECT_EQ(1, subject->getNumOfObservers());
+	EXPECT_EQ(1, kept->numOfUpdates);
+}
+
+TEST_F(SubjectTests,
+ObserversAddedFromSeveralThreadsAreAllKept) {
+	auto subject = std::make_shared<TestSubject>();
+	std::vector<ShPtr<CountingObserver>> observers;
+	for (std::size_t i = 0; i < NUM_OF_THREADS * NUM_OF_OBSERVERS_PER_THREAD; ++i) {
+		observers.push_back(std::make_shared<CountingObserver>());
+	}
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < NUM_OF_THREADS; ++t) {
+		threads.emplace_back([&, t]() {
+			for (std::size_t i = 0; i < NUM_OF_OBSERVERS_PER_THREAD; ++i) {
+				subject->addObserver(
+					observers[t * NUM_OF_OBSERVERS_PER_THREAD + i]);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(observers.size(), subject->getNumOfObservers());
+	subject->notifyObservers();
+	for (const auto &observer : observers) {
+		EXPECT_EQ(1, observer->numOfUpdates);
+	}
+}
+
+TEST_F(SubjectTests,
+AddingRemovingAndNotifyingFromSeveralThreadsKeepsOtherObservers) {
+	// Every thread adds and removes its own observers while the subject is
+	// being notified, so only the observers added beforehand remain.
+	auto subject = std::make_shared<TestSubject>();
+	auto kept = std::make_shared<CountingObserver>();
+	subject->addObserver(kept);
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < NUM_OF_THREADS; ++t) {
+		threads.emplace_back([&]() {
+			for (std::size_t i = 0; i < NUM_OF_OBSERVERS_PER_THREAD; ++i) {
+				auto observer = std::make_shared<CountingObserver>();
+				subject->addObserver(observer);
+				subject->notifyObservers();
+				subject->removeObserver(observer);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(1, subject->getNumOfObservers());
+	EXPECT_EQ(NUM_OF_THREADS * NUM_OF_OBSERVERS_PER_THREAD, kept->numOfUpdates);
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
@@ -73,6 +73,17 @@ LimitSystemMemoryToHalfOfTotalSystemMemoryReturnsTrue) {
 	ASSERT_TRUE(limitSystemMemoryToHalfOfTotalSystemMemory());
 }
 
+#ifdef OS_LINUX
+TEST_F(MemoryTests,
+GetCurrentAndPeakMemoryUsageReturnNonZeroSizesOnLinux) {
+	auto current = getCurrentMemoryUsage();
+	auto peak = getPeakMemoryUsage();
+
+	ASSERT_GT(current, 0);
+	ASSERT_GE(peak, current);
+}
+#endif
+
 } // namespace tests
 } // namespace utils
 } // namespace retdec
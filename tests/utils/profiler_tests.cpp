@@ -0,0 +1,164 @@
+/**
+* @file tests/utils/profiler_tests.cpp
+* @brief Tests for the @c profiler module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/profiler.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c profiler module.
+*/
+class ProfilerTests: public Test {
+protected:
+	Profiler profiler;
+};
+
+TEST_F(ProfilerTests,
+DisabledProfilerRecordsNothing) {
+	profiler.startPhase("a");
+	profiler.endPhases();
+
+	ASSERT_FALSE(profiler.isEnabled());
+	ASSERT_TRUE(profiler.getPhases().empty());
+}
+
+TEST_F(ProfilerTests,
+StartingPhaseEndsPhasesOnSameAndDeeperLevels) {
+	profiler.enable();
+
+	profiler.startPhase("a", 0, "tool");
+	profiler.startPhase("a1", 1);
+	profiler.startPhase("a2", 1);
+	profiler.startPhase("b", 0);
+	profiler.endPhases();
+
+	auto phases = profiler.getPhases();
+	ASSERT_EQ(4, phases.size());
+	EXPECT_EQ("a", phases[0].name);
+	EXPECT_EQ("tool", phases[0].category);
+	EXPECT_EQ("a1", phases[1].name);
+	EXPECT_EQ(1, phases[1].level);
+	EXPECT_EQ("a2", phases[2].name);
+	EXPECT_EQ("b", phases[3].name);
+	// The parent phase ends only after its last sub-phase.
+	EXPECT_LE(phases[2].start + phases[2].wallTime,
+		phases[0].start + phases[0].wallTime);
+	EXPECT_LE(phases[0].start + phases[0].wallTime, phases[3].start);
+}
+
+TEST_F(ProfilerTests,
+GetNumOfRunningPhasesReturnsLevelForSubPhases) {
+	profiler.enable();
+
+	profiler.startPhase("a");
+	profiler.startPhase("b", profiler.getNumOfRunningPhases());
+
+	EXPECT_EQ(2, profiler.getNumOfRunningPhases());
+	EXPECT_EQ(1, profiler.getPhases()[1].level);
+	profiler.endPhases(1);
+	EXPECT_EQ(1, profiler.getNumOfRunningPhases());
+}
+
+TEST_F(ProfilerTests,
+SizesAreRecordedAtStartAndEndOfPhase) {
+	std::size_t size = 1;
+	profiler.enable();
+	profiler.setSizesGetter([&size]() {
+		return Profiler::Sizes{{"instructions", size}};
+	});
+
+	profiler.startPhase("a");
+	size = 5;
+	profiler.endPhases();
+
+	auto phases = profiler.getPhases();
+	ASSERT_EQ(1, phases.size());
+	ASSERT_EQ(1, phases[0].sizesStart.size());
+	EXPECT_EQ("instructions", phases[0].sizesStart[0].first);
+	EXPECT_EQ(1, phases[0].sizesStart[0].second);
+	ASSERT_EQ(1, phases[0].sizesEnd.size());
+	EXPECT_EQ(5, phases[0].sizesEnd[0].second);
+}
+
+TEST_F(ProfilerTests,
+PrintJsonEscapesNamesOfPhases) {
+	profiler.enable();
+	profiler.startPhase("a \"b\"\n");
+	profiler.endPhases();
+	std::stringstream out;
+
+	profiler.printJson(out);
+
+	EXPECT_NE(std::string::npos, out.str().find(R"("name": "a \"b\"\n")"));
+	EXPECT_NE(std::string::npos, out.str().find(R"("sizesEnd": {  })"));
+}
+
+TEST_F(ProfilerTests,
+PrintChromeTraceEmitsCompleteEventForEveryPhase) {
+	profiler.enable();
+	profiler.setSizesGetter([]() {
+		return Profiler::Sizes{{"functions", 2}};
+	});
+	profiler.startPhase("a", 0, "tool");
+	profiler.endPhases();
+	std::stringstream out;
+
+	profiler.printChromeTrace(out);
+
+	EXPECT_NE(std::string::npos, out.str().find(R"("traceEvents": [)"));
+	EXPECT_NE(std::string::npos,
+		out.str().find(R"("name": "a", "cat": "tool", "ph": "X")"));
+	EXPECT_NE(std::string::npos, out.str().find(R"("end.functions": 2)"));
+}
+
+TEST_F(ProfilerTests,
+ClearRemovesAllPhases) {
+	profiler.enable();
+	profiler.startPhase("a");
+	profiler.startPhase("b", 1);
+
+	profiler.clear();
+
+	ASSERT_TRUE(profiler.getPhases().empty());
+}
+
+TEST_F(ProfilerTests,
+PhasesCanBeRecordedFromSeveralThreads) {
+	const std::size_t threadCount = 4;
+	const std::size_t phaseCount = 200;
+	profiler.enable();
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < threadCount; ++i) {
+		threads.emplace_back([&]() {
+			for (std::size_t j = 0; j < phaseCount; ++j) {
+				profiler.startPhase("a", profiler.getNumOfRunningPhases());
+				profiler.endPhases(1);
+			}
+		});
+	}
+	for (auto &t : threads) {
+		t.join();
+	}
+	profiler.endPhases();
+
+	EXPECT_EQ(threadCount * phaseCount, profiler.getPhases().size());
+	EXPECT_EQ(0, profiler.getNumOfRunningPhases());
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
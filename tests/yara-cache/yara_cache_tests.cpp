@@ -0,0 +1,325 @@
+/**
+* @file tests/yara-cache/yara_cache_tests.cpp
+* @brief Tests for the @c yara_cache module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/filesystem_path.h"
+#include "retdec/utils/string.h"
+#include "retdec/yara-cache/yara_cache.h"
+#include "yaracpp/yara_detector/yara_detector.h"
+
+using namespace ::testing;
+using namespace retdec::utils;
+
+namespace retdec {
+namespace yara_cache {
+namespace tests {
+
+/**
+ * Tests for the @c yara_cache module.
+ *
+ * Each test works in its own temporary directory with rule files.
+ */
+class YaraCacheTests : public Test
+{
+	protected:
+		std::string dir;
+
+		virtual void SetUp() override
+		{
+			char name[] = "/tmp/retdec-tests-yara-cache-XXXXXX";
+			ASSERT_NE(nullptr, mkdtemp(name));
+			dir = name;
+			clearCache();
+		}
+
+		virtual void TearDown() override
+		{
+			clearCache();
+			chmod(dir.c_str(), 0755);
+			for (const auto& file : listFiles())
+			{
+				std::remove(file.c_str());
+			}
+			rmdir(dir.c_str());
+		}
+
+		std::string writeFile(const std::string& name, const std::string& content)
+		{
+			auto path = dir + "/" + name;
+			std::ofstream(path, std::ios::out | std::ios::binary) << content;
+			return path;
+		}
+
+		static std::string readFile(const std::string& path)
+		{
+			std::ifstream stream(path, std::ios::in | std::ios::binary);
+			std::ostringstream content;
+			content << stream.rdbuf();
+			return content.str();
+		}
+
+		static bool exists(const std::string& path)
+		{
+			struct stat st;
+			return stat(path.c_str(), &st) == 0;
+		}
+
+		std::vector<std::string> listFiles() const
+		{
+			std::vector<std::string> result;
+			FilesystemPath path(dir);
+			for (const auto* subpath : path)
+			{
+				result.push_back(subpath->getPath());
+			}
+			return result;
+		}
+
+		std::size_t countCachedFiles() const
+		{
+			std::size_t result = 0;
+			for (const auto& file : listFiles())
+			{
+				result += isCachedRuleFile(file);
+			}
+			return result;
+		}
+
+		static std::vector<std::string> getNames(
+				const std::vector<const yaracpp::YaraRule*>& rules)
+		{
+			std::vector<std::string> result;
+			for (const auto* rule : rules)
+			{
+				result.push_back(rule->getName());
+			}
+			return result;
+		}
+};
+
+TEST_F(YaraCacheTests, CompiledRulesAreStoredNextToTextRules)
+{
+	auto rules = writeFile("rules.yar", "rule a { condition: true }");
+
+	auto compiled = getCompiledRuleFile(rules);
+	EXPECT_NE(rules, compiled);
+	EXPECT_TRUE(isCachedRuleFile(compiled));
+	EXPECT_TRUE(startsWith(compiled, dir + "/rules."));
+	EXPECT_TRUE(exists(compiled));
+	EXPECT_EQ(1, countCachedFiles());
+}
+
+TEST_F(YaraCacheTests, CompiledRulesAreReusedWithoutCompilation)
+{
+	auto rules = writeFile("rules.yar", "rule a { condition: true }");
+	auto compiled = getCompiledRuleFile(rules);
+	ASSERT_NE(rules, compiled);
+
+	// Content is not checked on a hit, so the marker survives.
+	writeFile(compiled.substr(dir.size() + 1), "marker");
+	EXPECT_EQ(compiled, getCompiledRuleFile(rules));
+	EXPECT_EQ("marker", readFile(compiled));
+
+	// Hit on disk in a new process.
+	clearCache();
+	EXPECT_EQ(compiled, getCompiledRuleFile(rules));
+	EXPECT_EQ("marker", readFile(compiled));
+}
+
+TEST_F(YaraCacheTests, EditedRulesAreCompiledAgainAndOutdatedRulesAreRemoved)
+{
+	auto rules = writeFile("rules.yar", "rule a { condition: true }");
+	auto compiled = getCompiledRuleFile(rules);
+	ASSERT_NE(rules, compiled);
+
+	writeFile("rules.yar", "rule a { condition: true }\nrule b { condition: false }");
+	auto recompiled = getCompiledRuleFile(rules);
+	EXPECT_NE(rules, recompiled);
+	EXPECT_NE(compiled, recompiled);
+	EXPECT_TRUE(exists(recompiled));
+	EXPECT_FALSE(exists(compiled));
+	EXPECT_EQ(1, countCachedFiles());
+}
+
+TEST_F(YaraCacheTests, EditedIncludedFileChangesCompiledRules)
+{
+	writeFile("common.yar", "rule common { condition: true }");
+	auto rules = writeFile("rules.yar", "include \"common.yar\"\nrule a { condition: common }");
+	auto compiled = getCompiledRuleFile(rules);
+	ASSERT_NE(rules, compiled);
+
+	writeFile("common.yar", "rule common { condition: false }");
+	auto recompiled = getCompiledRuleFile(rules);
+	EXPECT_NE(rules, recompiled);
+	EXPECT_NE(compiled, recompiled);
+	EXPECT_FALSE(exists(compiled));
+}
+
+TEST_F(YaraCacheTests, RulesCompiledForOtherNamespaceAreKept)
+{
+	auto rules = writeFile("rules.yar", "rule a { condition: true }");
+	auto first = getCompiledRuleFile(rules, "first");
+	auto second = getCompiledRuleFile(rules, "second");
+	ASSERT_NE(rules, first);
+	ASSERT_NE(rules, second);
+	EXPECT_NE(first, second);
+
+	writeFile("rules.yar", "rule a { condition: false }\n");
+	auto recompiled = getCompiledRuleFile(rules, "first");
+	EXPECT_NE(first, recompiled);
+	EXPECT_FALSE(exists(first));
+	EXPECT_TRUE(exists(second));
+}
+
+TEST_F(YaraCacheTests, InvalidRulesAreNotCompiled)
+{
+	auto rules = writeFile("rules.yar", "this is not a rule");
+	EXPECT_EQ(rules, getCompiledRuleFile(rules));
+	EXPECT_EQ(0, countCachedFiles());
+}
+
+TEST_F(YaraCacheTests, MissingOrCompiledRulesAreUsedAsTheyAre)
+{
+	EXPECT_EQ(dir + "/missing.yar", getCompiledRuleFile(dir + "/missing.yar"));
+
+	auto compiled = writeFile("rules.yarac", "compiled");
+	EXPECT_EQ(compiled, getCompiledRuleFile(compiled));
+}
+
+TEST_F(YaraCacheTests, TextRulesAreUsedInReadOnlyDirectory)
+{
+	auto rules = writeFile("rules.yar", "rule a { condition: true }");
+	ASSERT_EQ(0, chmod(dir.c_str(), 0555));
+
+	// Permissions do not apply to privileged users.
+	auto probe = dir + "/probe";
+	if (std::ofstream(probe))
+	{
+		std::remove(probe.c_str());
+		return;
+	}
+
+	EXPECT_EQ(rules, getCompiledRuleFile(rules));
+	EXPECT_EQ(0, countCachedFiles());
+}
+
+TEST_F(YaraCacheTests, ScanReturnsOnlyRulesOfThisScan)
+{
+	RuleFiles ruleFiles = {{writeFile("rules.yar",
+			"rule a { strings: $a = \"AAAA\" condition: $a }\n"
+			"rule b { condition: true }"), ""}};
+	auto withA = writeFile("a.bin", "xxAAAAxx");
+	auto withoutA = writeFile("b.bin", "xxxxxxxx");
+
+	std::vector<const yaracpp::YaraRule*> detected, undetected;
+	scanFile(ruleFiles, withA, detected, &undetected);
+	EXPECT_EQ(std::vector<std::string>({"a", "b"}), getNames(detected));
+	EXPECT_TRUE(undetected.empty());
+
+	// The same detector is used again.
+	scanFile(ruleFiles, withoutA, detected, &undetected);
+	EXPECT_EQ(std::vector<std::string>({"b"}), getNames(detected));
+	EXPECT_EQ(std::vector<std::string>({"a"}), getNames(undetected));
+
+	scanFile(ruleFiles, withA, detected);
+	EXPECT_EQ(std::vector<std::string>({"a", "b"}), getNames(detected));
+}
+
+TEST_F(YaraCacheTests, ScansInSeveralThreadsGiveSameResults)
+{
+	RuleFiles ruleFiles = {{writeFile("rules.yar",
+			"rule a { strings: $a = \"AAAA\" condition: $a }"), "ns"}};
+	auto withA = writeFile("a.bin", "xxAAAAxx");
+	auto withoutA = writeFile("b.bin", "xxxxxxxx");
+
+	std::vector<std::thread> threads;
+	std::vector<int> errors(4, 0);
+	for (std::size_t t = 0; t < errors.size(); ++t)
+	{
+		threads.emplace_back([&, t]()
+		{
+			std::vector<const yaracpp::YaraRule*> detected;
+			for (int i = 0; i < 50; ++i)
+			{
+				scanFile(ruleFiles, i % 2 ? withoutA : withA, detected);
+				errors[t] += detected.size() != (i % 2 ? 0u : 1u);
+			}
+		});
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	EXPECT_EQ(std::vector<int>(errors.size(), 0), errors);
+}
+
+TEST_F(YaraCacheTests, CompiledRulesScanMemoryInPlace)
+{
+	auto ruleFile = writeFile("rules.yar",
+			"rule a {\n"
+			"  meta: name = \"first\" size = 4 altNames = \"x y\"\n"
+			"  strings: $a = \"AAAA\"\n"
+			"  condition: $a\n"
+			"}\n"
+			"rule b { strings: $b = \"BBBB\" condition: $b }");
+	const std::string data = "xxAAAAxxAAAA";
+
+	CompiledRules rules(ruleFile);
+	ASSERT_TRUE(rules.isValid());
+	std::vector<MatchedRule> matched;
+	ASSERT_TRUE(rules.scanMemory(
+			reinterpret_cast<const std::uint8_t*>(data.data()),
+			data.size(),
+			matched));
+
+	ASSERT_EQ(1, matched.size());
+	EXPECT_EQ("a", matched[0].name);
+	EXPECT_EQ(std::vector<std::uint64_t>({2, 8}), matched[0].offsets);
+	ASSERT_EQ(3, matched[0].metas.size());
+	EXPECT_EQ("name", matched[0].metas[0].id);
+	EXPECT_EQ("first", matched[0].metas[0].stringValue);
+	EXPECT_EQ("size", matched[0].metas[1].id);
+	EXPECT_EQ(4, matched[0].metas[1].intValue);
+	EXPECT_EQ("altNames", matched[0].metas[2].id);
+	EXPECT_EQ("x y", matched[0].metas[2].stringValue);
+}
+
+TEST_F(YaraCacheTests, InvalidCompiledRulesCanNotScan)
+{
+	CompiledRules rules(writeFile("rules.yar", "this is not a rule"));
+	EXPECT_FALSE(rules.isValid());
+
+	std::vector<MatchedRule> matched;
+	EXPECT_FALSE(rules.scanMemory(nullptr, 0, matched));
+}
+
+TEST_F(YaraCacheTests, CachedRuleFilesAreRecognized)
+{
+	EXPECT_TRUE(isCachedRuleFile("rules.0123abcd.0123456789abcdef.yarac"));
+	EXPECT_TRUE(isCachedRuleFile("/path/rules.v2.0123abcd.0123456789ABCDEF.yarac"));
+	EXPECT_FALSE(isCachedRuleFile("rules.yarac"));
+	EXPECT_FALSE(isCachedRuleFile("rules.0123456789abcdef.yarac"));
+	EXPECT_FALSE(isCachedRuleFile("rules.0123abcd.0123456789abcdeg.yarac"));
+	EXPECT_FALSE(isCachedRuleFile("rules.0123abcd.0123456789abcdef.yar"));
+	EXPECT_FALSE(isCachedRuleFile("0123abcd.0123456789abcdef.yarac"));
+}
+
+} // namespace tests
+} // namespace yara_cache
+} // namespace retdec